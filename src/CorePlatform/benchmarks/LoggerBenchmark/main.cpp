@@ -0,0 +1,343 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "CorePlatform/Logger.h"
+#include "CorePlatform/JsonUtils.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// 被测的输出配置
+enum class SinkKind {
+    File,       // 同步写文本文件
+    AsyncFile,  // 异步写文本文件
+    BinaryFile, // 二进制延迟格式化文件
+    Console,    // 只写控制台
+    JsonLines,  // 结构化日志写入 JSON Lines 文件，与 File 比较字段格式化的开销
+    Disabled    // 级别被过滤，测量关闭日志时调用点的开销
+};
+
+struct SinkInfo {
+    SinkKind kind;
+    const char* name;
+};
+
+constexpr SinkInfo kSinks[] = {
+    {SinkKind::File, "file"},
+    {SinkKind::AsyncFile, "async-file"},
+    {SinkKind::BinaryFile, "binary-file"},
+    {SinkKind::Console, "console"},
+    {SinkKind::JsonLines, "json-lines"},
+    {SinkKind::Disabled, "disabled"},
+};
+
+struct Options {
+    unsigned maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    size_t messagesPerThread = 100000;
+    std::vector<size_t> messageSizes{16, 256, 4096};
+    std::vector<SinkKind> sinks{SinkKind::File, SinkKind::AsyncFile, SinkKind::BinaryFile, SinkKind::Disabled};
+    std::string directory = "logger-benchmark";
+    std::string output = "logger-benchmark.json";
+};
+
+struct Result {
+    const char* sink;
+    unsigned threads;
+    size_t messageSize;
+    uint64_t messages;
+    double elapsedSeconds;
+    double messagesPerSecond;
+    double meanNs;
+    int64_t p50Ns;
+    int64_t p99Ns;
+    int64_t p999Ns;
+    int64_t maxNs;
+};
+
+void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [options]\n"
+              << "  Measure Logger throughput (messages/s) and per-call latency percentiles.\n"
+              << "  --threads N      run with 1, 2, 4, ... up to N threads (default: hardware threads)\n"
+              << "  --messages N     messages per thread per run (default: 100000)\n"
+              << "  --sizes A,B,...  message payload sizes in bytes (default: 16,256,4096)\n"
+              << "  --sinks A,B,...  file, async-file, binary-file, console, json-lines, disabled\n"
+              << "                   (default: file,async-file,binary-file,disabled)\n"
+              << "  --dir PATH       directory for the log files (default: logger-benchmark)\n"
+              << "  --output PATH    JSON result file, '-' for stdout (default: logger-benchmark.json)\n";
+}
+
+std::vector<std::string> splitList(const std::string& text) {
+    std::vector<std::string> items;
+    size_t start = 0;
+    while (start <= text.size()) {
+        const size_t comma = text.find(',', start);
+        const size_t end = comma == std::string::npos ? text.size() : comma;
+        if (end > start) {
+            items.push_back(text.substr(start, end - start));
+        }
+        if (comma == std::string::npos) break;
+        start = comma + 1;
+    }
+    return items;
+}
+
+bool parseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "-h" || arg == "--help") {
+            printUsage(argv[0]);
+            std::exit(0);
+        }
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << arg << "\n";
+            return false;
+        }
+        const std::string value = argv[++i];
+        try {
+            if (arg == "--threads") {
+                options.maxThreads = static_cast<unsigned>(std::max(1, std::stoi(value)));
+            } else if (arg == "--messages") {
+                options.messagesPerThread = std::max<size_t>(1, std::stoull(value));
+            } else if (arg == "--sizes") {
+                options.messageSizes.clear();
+                for (const auto& item : splitList(value)) {
+                    options.messageSizes.push_back(std::stoull(item));
+                }
+            } else if (arg == "--sinks") {
+                options.sinks.clear();
+                for (const auto& item : splitList(value)) {
+                    auto it = std::find_if(std::begin(kSinks), std::end(kSinks),
+                                           [&](const SinkInfo& sink) { return item == sink.name; });
+                    if (it == std::end(kSinks)) {
+                        std::cerr << "Unknown sink: " << item << "\n";
+                        return false;
+                    }
+                    options.sinks.push_back(it->kind);
+                }
+            } else if (arg == "--dir") {
+                options.directory = value;
+            } else if (arg == "--output") {
+                options.output = value;
+            } else {
+                std::cerr << "Unknown option: " << arg << "\n";
+                return false;
+            }
+        } catch (const std::exception&) {
+            std::cerr << "Invalid value for " << arg << ": " << value << "\n";
+            return false;
+        }
+    }
+    return !options.messageSizes.empty() && !options.sinks.empty();
+}
+
+const char* sinkName(SinkKind kind) {
+    for (const auto& sink : kSinks) {
+        if (sink.kind == kind) return sink.name;
+    }
+    return "unknown";
+}
+
+// 按被测输出配置 Logger，返回每条日志使用的级别
+CorePlatform::LogLevel configureLogger(SinkKind kind, const std::string& logPath) {
+    CorePlatform::Logger& logger = CorePlatform::Logger::getInstance();
+    logger.setAsyncMode(false);
+    logger.setLevel(CorePlatform::LogLevel::INFO);
+    logger.setConsoleOutput(false);
+    logger.clearSinks();
+    std::filesystem::remove(logPath);
+
+    switch (kind) {
+        case SinkKind::File:
+            logger.setLogFile(logPath);
+            break;
+        case SinkKind::AsyncFile:
+            logger.setLogFile(logPath);
+            logger.setAsyncMode(true);
+            break;
+        case SinkKind::BinaryFile:
+            logger.setLogFile(logPath, CorePlatform::LogFileFormat::Binary);
+            break;
+        case SinkKind::Console:
+            // 空路径关闭文件输出
+            logger.setLogFile("");
+            logger.setConsoleOutput(true);
+            break;
+        case SinkKind::JsonLines:
+            logger.setLogFile("");
+            logger.addSink(std::make_shared<CorePlatform::JsonLinesSink>(logPath));
+            break;
+        case SinkKind::Disabled:
+            logger.setLogFile(logPath);
+            return CorePlatform::LogLevel::DEBUG;
+    }
+    return CorePlatform::LogLevel::INFO;
+}
+
+// 已排序样本的百分位数（最近秩法）
+int64_t percentile(const std::vector<int64_t>& sorted, double fraction) {
+    if (sorted.empty()) return 0;
+    const size_t rank = static_cast<size_t>(fraction * static_cast<double>(sorted.size()));
+    return sorted[std::min(rank, sorted.size() - 1)];
+}
+
+// 两次连续读取时钟的耗时中位数，延迟样本都包含这部分开销
+int64_t measureTimerOverhead() {
+    std::vector<int64_t> samples(10000);
+    for (auto& sample : samples) {
+        const auto begin = Clock::now();
+        sample = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - begin).count();
+    }
+    std::sort(samples.begin(), samples.end());
+    return percentile(samples, 0.50);
+}
+
+Result runCase(SinkKind kind, unsigned threads, size_t messageSize, const Options& options) {
+    const std::string logPath = (std::filesystem::path(options.directory) / "bench.log").string();
+    const CorePlatform::LogLevel level = configureLogger(kind, logPath);
+    CorePlatform::Logger& logger = CorePlatform::Logger::getInstance();
+
+    const std::string payload(messageSize, 'x');
+    std::vector<std::vector<int64_t>> latencies(threads);
+    std::atomic<unsigned> ready{0};
+    std::atomic<bool> start{false};
+
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            std::vector<int64_t>& samples = latencies[t];
+            samples.resize(options.messagesPerThread);
+            // 所有线程就绪后同时开始，避免先启动的线程独占输出
+            ready.fetch_add(1);
+            while (!start.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            for (size_t i = 0; i < options.messagesPerThread; ++i) {
+                const auto begin = Clock::now();
+                if (kind == SinkKind::JsonLines) {
+                    CP_LOG_FIELDS(level, "bench", {"thread", t}, {"seq", i}, {"payload", payload});
+                } else {
+                    CP_LOG(level, "bench thread {} seq {} {}", t, i, payload);
+                }
+                samples[i] = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - begin).count();
+            }
+        });
+    }
+    while (ready.load() < threads) {
+        std::this_thread::yield();
+    }
+
+    const auto begin = Clock::now();
+    start.store(true, std::memory_order_release);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    // 吞吐量包含把已提交的日志写出的时间，异步模式不会因为只入队而虚高
+    logger.flush();
+    const double elapsed = std::chrono::duration<double>(Clock::now() - begin).count();
+
+    std::vector<int64_t> all;
+    all.reserve(static_cast<size_t>(threads) * options.messagesPerThread);
+    for (auto& samples : latencies) {
+        all.insert(all.end(), samples.begin(), samples.end());
+        std::vector<int64_t>().swap(samples);
+    }
+    std::sort(all.begin(), all.end());
+    double total = 0;
+    for (int64_t sample : all) {
+        total += static_cast<double>(sample);
+    }
+
+    Result result{};
+    result.sink = sinkName(kind);
+    result.threads = threads;
+    result.messageSize = messageSize;
+    result.messages = all.size();
+    result.elapsedSeconds = elapsed;
+    result.messagesPerSecond = elapsed > 0 ? static_cast<double>(all.size()) / elapsed : 0;
+    result.meanNs = all.empty() ? 0 : total / static_cast<double>(all.size());
+    result.p50Ns = percentile(all, 0.50);
+    result.p99Ns = percentile(all, 0.99);
+    result.p999Ns = percentile(all, 0.999);
+    result.maxNs = all.empty() ? 0 : all.back();
+    return result;
+}
+
+nlohmann::json toJson(const Result& result) {
+    return nlohmann::json{
+        {"sink", result.sink},
+        {"threads", result.threads},
+        {"message_size", result.messageSize},
+        {"messages", result.messages},
+        {"elapsed_seconds", result.elapsedSeconds},
+        {"messages_per_second", result.messagesPerSecond},
+        {"latency_ns", {
+            {"mean", result.meanNs},
+            {"p50", result.p50Ns},
+            {"p99", result.p99Ns},
+            {"p999", result.p999Ns},
+            {"max", result.maxNs},
+        }},
+    };
+}
+
+} // 匿名命名空间
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 2;
+    }
+    std::error_code ec;
+    std::filesystem::create_directories(options.directory, ec);
+
+    std::vector<unsigned> threadCounts;
+    for (unsigned threads = 1; threads < options.maxThreads; threads *= 2) {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(options.maxThreads);
+
+    nlohmann::json results = nlohmann::json::array();
+    for (SinkKind sink : options.sinks) {
+        for (size_t size : options.messageSizes) {
+            for (unsigned threads : threadCounts) {
+                const Result result = runCase(sink, threads, size, options);
+                // 进度写到 stderr，stdout 留给控制台输出和 "--output -"
+                std::cerr << result.sink << " threads=" << result.threads << " size=" << result.messageSize
+                          << " msgs/s=" << static_cast<uint64_t>(result.messagesPerSecond)
+                          << " p50=" << result.p50Ns << "ns p99=" << result.p99Ns
+                          << "ns p999=" << result.p999Ns << "ns\n";
+                results.push_back(toJson(result));
+            }
+        }
+    }
+
+    CorePlatform::Logger& logger = CorePlatform::Logger::getInstance();
+    logger.setAsyncMode(false);
+    logger.setConsoleOutput(false);
+    logger.clearSinks();
+    logger.setLogFile("");
+    std::filesystem::remove(std::filesystem::path(options.directory) / "bench.log", ec);
+
+    nlohmann::json report{
+        {"benchmark", "logger"},
+        {"messages_per_thread", options.messagesPerThread},
+        {"hardware_threads", std::thread::hardware_concurrency()},
+        {"timer_overhead_ns", measureTimerOverhead()},
+        {"results", std::move(results)},
+    };
+    if (options.output == "-") {
+        std::cout << CorePlatform::JsonUtils::ToString(report) << std::endl;
+    } else if (!CorePlatform::JsonUtils::WriteToFile(options.output, report)) {
+        std::cerr << "Unable to write results: " << options.output << "\n";
+        return 1;
+    }
+    return 0;
+}
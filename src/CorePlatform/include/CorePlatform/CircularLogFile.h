@@ -0,0 +1,132 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <cstdint>
+#include "CorePlatform/Export.h"
+#include "CorePlatform/LogSink.h"
+#include "CorePlatform/Internal/PlatformDetection.h"
+
+namespace CorePlatform {
+
+/**
+ * @brief 固定大小、内存映射的环形日志文件
+ *
+ * 文件在打开时预分配为 kHeaderSize + capacity 字节，之后大小不再变化，磁盘占用不需要轮转来控制。
+ * 每条日志是一行文本，写入只是向映射的页面 memcpy；数据区写满后回到开头覆盖最旧的日志，
+ * 一条日志不会跨越数据区末尾。文件头记录写入位置、最旧一条完整日志的位置和回绕时的数据末尾，
+ * 每次写入后按不会产生不一致状态的顺序更新，进程在任意时刻崩溃后重新打开都能从文件头恢复。
+ *
+ * 写入的内容只有在 sync() 之后才保证落盘（进程崩溃不受影响，掉电时丢失上次 sync 之后的内容）。
+ * 文件头按本机字节序存储。重新打开已存在的文件时继续写入；文件不是环形日志文件或容量不同时重新初始化。
+ *
+ * 读取接口按时间顺序（从旧到新）返回日志；单条超过容量的日志被截断。
+ * 本对象的所有方法都是线程安全的；其他进程读取正在写入的文件时，最旧的一行可能是被覆盖了一半的内容。
+ */
+class CORE_PLATFORM_API CircularLogFile {
+public:
+    static constexpr size_t kHeaderSize = 64;
+    static constexpr size_t kMinCapacity = 4096;
+
+    /**
+     * @brief 打开或创建环形日志文件
+     * @param capacity 数据区字节数，小于 kMinCapacity 时按 kMinCapacity
+     * @param error 失败时的错误描述
+     * @return 失败时返回 nullptr
+     */
+    static std::unique_ptr<CircularLogFile> open(const std::string& path, size_t capacity,
+                                                 std::string* error = nullptr);
+
+    /**
+     * @brief 以只读方式按时间顺序读出环形日志文件的全部内容（每行以换行符结尾）
+     *
+     * 用于离线查看或崩溃后分析，不修改文件。
+     * @return 文件不存在或不是环形日志文件时返回 false
+     */
+    static bool readFile(const std::string& path, std::string& contents, std::string* error = nullptr);
+
+    ~CircularLogFile();
+
+    CP_DISABLE_COPY_MOVE(CircularLogFile);
+
+    const std::string& path() const { return path_; }
+    size_t capacity() const { return capacity_; }
+
+    // 数据区写满后回到开头的次数（跨重新打开累计）
+    uint64_t wrapCount() const;
+
+    // 追加一行（自动加换行符）；text 中的换行写为 "\\n"，每条日志在文件中恰好占一行
+    void append(std::string_view text);
+
+    // 将上次 sync 之后修改的页面同步写回磁盘，失败时返回 false
+    bool sync();
+
+    // 按时间顺序返回全部内容
+    std::string readContents() const;
+
+    // 按时间顺序返回全部日志行
+    std::vector<std::string> readAllLines() const;
+
+    // 返回最近的最多 maxLines 行，按时间顺序排列
+    std::vector<std::string> readLastLines(size_t maxLines) const;
+
+private:
+    struct Header;
+
+    CircularLogFile() = default;
+
+    // 校验已映射的文件头，无效时按 capacity_ 重新初始化
+    void initialize();
+    void markDirty(size_t begin, size_t end);
+
+    std::string path_;
+    size_t capacity_ = 0;
+    size_t mappedSize_ = 0;
+    Header* header_ = nullptr;
+    char* data_ = nullptr;
+#if defined(CP_PLATFORM_WINDOWS)
+    void* file_ = nullptr;
+    void* mapping_ = nullptr;
+#else
+    int fd_ = -1;
+#endif
+
+    mutable std::mutex mutex_;
+    // 上次 sync 之后修改过的数据区范围
+    size_t dirtyBegin_ = SIZE_MAX;
+    size_t dirtyEnd_ = 0;
+};
+
+/**
+ * @brief 写入环形日志文件的输出，适合存储空间有限的设备
+ *
+ * 示例:
+ *   auto file = CircularLogFile::open("/data/app.log.ring", 4 * 1024 * 1024);
+ *   LogSinkOptions options;
+ *   options.flushInterval = std::chrono::seconds(5);   // 每 5 秒 msync 一次，ERROR 及以上立即 msync
+ *   Logger::getInstance().addSink(std::make_shared<CircularFileSink>(std::move(file), options));
+ *
+ * 刷新即 msync：flushInterval 为 0（默认）时每条日志都会同步写回，在闪存上应设置刷新间隔。
+ * Logger::readAllLogs() 和 readLogsInTimeRange() 只读取 setLogFile() 设置的日志文件，不包含本输出的内容；
+ * 本输出的内容通过 file()->readAllLines() 或 CircularLogFile::readFile() 读取。
+ */
+class CORE_PLATFORM_API CircularFileSink : public LogSink {
+public:
+    explicit CircularFileSink(std::shared_ptr<CircularLogFile> file,
+                              const LogSinkOptions& options = LogSinkOptions());
+    ~CircularFileSink() override;
+
+    const std::shared_ptr<CircularLogFile>& file() const { return file_; }
+
+protected:
+    void write(LogLevel level, std::string_view formatted) override;
+    void flushOutput() override;
+
+private:
+    const std::shared_ptr<CircularLogFile> file_;
+};
+
+} // namespace CorePlatform
@@ -1,7 +1,14 @@
 #pragma once
 #include <string>
+#include <string_view>
 #include <vector>
+#include <span>
 #include <chrono>
+#include <functional>
+#include <memory>
+#include <iterator>
+#include <cstdint>
+#include <cstddef>
 #include <system_error>
 #include "CorePlatform/Export.h"
 
@@ -130,7 +137,7 @@ public:
     // 获取文件大小（字节）
     static uint64_t GetFileSize(const std::string& path);
     
-    // 获取文件创建时间
+    // 获取文件创建时间，文件系统不记录创建时间时返回修改时间
     static std::chrono::system_clock::time_point GetCreationTime(const std::string& path);
     
     // 获取文件修改时间
@@ -140,27 +147,152 @@ public:
     static bool SetModificationTime(const std::string& path, 
                                    const std::chrono::system_clock::time_point& time);
     
+    // GetFileInfo 的字段，可以按位组合
+    enum InfoField : uint32_t {
+        InfoType             = 0x001,
+        InfoSize             = 0x002,
+        InfoPermissions      = 0x004,
+        InfoLinks            = 0x008,
+        InfoOwner            = 0x010,   // uid 和 gid（Windows 上不支持）
+        InfoInode            = 0x020,   // 设备号和 inode 号
+        InfoAccessTime       = 0x040,
+        InfoModificationTime = 0x080,
+        InfoChangeTime       = 0x100,   // 元数据修改时间
+        InfoCreationTime     = 0x200,
+        InfoBasic            = InfoType | InfoSize | InfoModificationTime,
+        InfoAll              = 0x3ff
+    };
+    
+    // 文件元数据，不跟随符号链接
+    struct FileInfo {
+        uint32_t fields = 0;            // 实际获取到的字段；文件系统不提供的字段（如创建时间）对应位为 0
+        FileType type = FileType::Other;
+        uint64_t size = 0;
+        int permissions = 0;            // 与 GetPermissions 相同的权限位
+        uint32_t links = 0;
+        uint32_t uid = 0;
+        uint32_t gid = 0;
+        uint64_t device = 0;            // Windows 上为卷序列号
+        uint64_t inode = 0;             // Windows 上为文件索引
+        std::chrono::system_clock::time_point accessTime;
+        std::chrono::system_clock::time_point modificationTime;
+        std::chrono::system_clock::time_point changeTime;
+        std::chrono::system_clock::time_point creationTime;
+        
+        bool Has(uint32_t field) const { return (fields & field) == field; }
+    };
+    
+    /**
+     * @brief 一次系统调用获取文件元数据
+     *
+     * 代替连续调用 Exists、IsRegularFile、GetFileSize、GetModificationTime（每个都是一次 lstat）。
+     * Linux 上使用 statx，只向文件系统请求 fields 中的字段（对网络文件系统可以省去不需要的属性获取），
+     * 并且能获取文件系统记录的创建时间。
+     * @param fields InfoField 的组合
+     * @return 失败时返回 false，原因见 errno（Windows 上为 GetLastError()）
+     */
+    static bool GetFileInfo(const std::string& path, FileInfo& info, uint32_t fields = InfoBasic);
+    
+    /**
+     * @brief 多个线程并行获取一批文件的元数据
+     *
+     * @param infos 与 paths 一一对应，失败的项 fields 为 0
+     * @param threads 并行线程数（含调用线程），0 表示按 CPU 核数
+     * @param errors 可选，与 paths 一一对应的错误，成功的项为空
+     * @return 全部成功时返回 true
+     */
+    static bool GetFileInfos(std::span<const std::string> paths, std::vector<FileInfo>& infos,
+                             uint32_t fields = InfoBasic, unsigned threads = 0,
+                             std::vector<std::error_code>* errors = nullptr);
+    
     // 读取整个文件内容（二进制）
     static std::vector<uint8_t> ReadFile(const std::string& path);
     
-    // 写入整个文件内容（二进制）
-    static bool WriteFile(const std::string& path, const std::vector<uint8_t>& data);
+    /**
+     * @brief 读取整个文件内容到调用者提供的缓冲区（二进制）
+     *
+     * 缓冲区被替换为文件内容；容量足够时不分配内存，反复读取同一类文件时可以复用缓冲区。
+     * 大小未知（/proc 等）或读取期间增长的文件读到末尾为止。
+     * @return 失败时返回 false，原因见 errno（Windows 上为 GetLastError()）
+     */
+    static bool ReadFile(const std::string& path, std::vector<uint8_t>& buffer);
+    
+    // 从文件开头读取最多 buffer.size() 字节，返回读取的字节数（小于 buffer.size() 说明已到文件末尾），失败时返回 -1
+    static int64_t ReadFile(const std::string& path, std::span<uint8_t> buffer);
+    
+    // 写入整个文件内容（二进制），处理部分写入；std::vector 等连续容器可直接传入
+    static bool WriteFile(const std::string& path, std::span<const uint8_t> data);
     
     // 追加内容到文件（二进制）
-    static bool AppendFile(const std::string& path, const std::vector<uint8_t>& data);
+    static bool AppendFile(const std::string& path, std::span<const uint8_t> data);
     
     // 读取整个文件内容（文本）
     static std::string ReadTextFile(const std::string& path);
     
-    // 写入整个文件内容（文本）
-    static bool WriteTextFile(const std::string& path, const std::string& content);
+    // 读取整个文件内容到调用者提供的字符串，容量足够时不分配内存，失败时返回 false
+    static bool ReadTextFile(const std::string& path, std::string& content);
+    
+    // 写入整个文件内容（文本），直接写出 content，不复制
+    static bool WriteTextFile(const std::string& path, std::string_view content);
     
     // 删除文件
     static bool RemoveFile(const std::string& path);
     
-    // 复制文件
+    // 复制文件（使用下面的复制引擎，按默认选项）
     static bool DuplicateFile(const std::string& from, const std::string& to, bool overwrite = false);
     
+    // 复制时实际使用的方式
+    enum class CopyMethod {
+        None,           // 未复制任何数据（失败或空文件）
+        Reflink,        // 共享数据块的写时复制克隆（Linux FICLONE、macOS clonefile）
+        CopyFileRange,  // Linux copy_file_range，在内核中复制，部分文件系统可在服务端或存储层完成
+        SendFile,       // Linux sendfile，在内核中复制
+        Buffered,       // 用户态缓冲区读写
+        System          // 系统复制接口（Windows CopyFileEx）
+    };
+    
+    // 复制进度回调：参数为已处理的字节数（含跳过的空洞）和文件总大小，返回 false 取消复制
+    using CopyProgress = std::function<bool(uint64_t copiedBytes, uint64_t totalBytes)>;
+    
+    struct CopyOptions {
+        bool overwrite = false;         // 目标已存在时覆盖
+        bool allowReflink = true;       // 允许克隆数据块；目标与源共享存储，修改时才真正复制
+        bool allowKernelCopy = true;    // 允许 copy_file_range/sendfile，关闭后使用缓冲区复制
+        bool preserveSparse = true;     // 按 SEEK_DATA/SEEK_HOLE 跳过空洞，目标保持稀疏
+        bool copyMetadata = false;      // 复制权限位、访问/修改时间，有权限时复制属主
+        size_t bufferSize = 1024 * 1024;   // 缓冲区复制时的缓冲区大小
+        CopyProgress progress;          // 可选的进度回调，在复制线程中调用
+    };
+    
+    struct CopyResult {
+        CopyMethod method = CopyMethod::None;
+        uint64_t bytesCopied = 0;       // 实际复制的数据字节数（不含空洞；克隆时为文件大小）
+        uint64_t totalBytes = 0;        // 源文件大小
+    };
+    
+    /**
+     * @brief 复制文件内容
+     *
+     * 依次尝试克隆数据块、copy_file_range、sendfile 和缓冲区读写，前一种不被支持时自动回退；
+     * 每种方式都循环处理部分复制，大文件不受单次调用的 2GB 限制。在 XFS、btrfs 等支持克隆的
+     * 文件系统上复制多 GB 的文件几乎是瞬间完成的。源文件中的空洞不读不写，目标文件保持相同的大小。
+     *
+     * 复制失败或被进度回调取消时删除不完整的目标文件，返回 false，原因见 errno
+     * （取消时为 ECANCELED；Windows 上为 GetLastError()）。目标与源是同一个文件时失败。
+     * @param result 可选，返回实际使用的复制方式和字节数
+     *
+     * 示例:
+     *   FileSystem::CopyOptions options;
+     *   options.overwrite = true;
+     *   options.progress = [](uint64_t copied, uint64_t total) {
+     *       printf("\r%3d%%", total ? int(copied * 100 / total) : 100);
+     *       return true;
+     *   };
+     *   FileSystem::DuplicateFile("disk.img", "backup/disk.img", options);
+     */
+    static bool DuplicateFile(const std::string& from, const std::string& to,
+                              const CopyOptions& options, CopyResult* result = nullptr);
+    
     // 移动/重命名文件
     static bool RelocateFile(const std::string& from, const std::string& to);
     
@@ -175,7 +307,7 @@ public:
     // 删除目录（空目录）
     static bool DeleteDirectory(const std::string& path);
     
-    // 删除目录及其所有内容
+    // 删除目录及其所有内容（在调用线程中执行 DeleteTree，需要并行时直接调用 DeleteTree）
     static bool DeleteDirectoriesRecursive(const std::string& path);
     
     // 列出目录内容
@@ -184,6 +316,417 @@ public:
     // 递归列出目录内容
     static bool ListDirectoryRecursive(const std::string& path, std::vector<std::string>& entries);
     
+    // ===== 目录树操作 =====
+    
+    struct TreeOptions {
+        unsigned threads = 0;           // 并行线程数（含调用线程），0 表示按 CPU 核数
+        bool overwrite = false;         // CopyTree：覆盖目标中已存在的文件，否则记为错误
+        bool copyMetadata = true;       // CopyTree：复制文件和目录的权限位、时间戳
+        bool stopOnError = false;       // 出错后不再处理尚未开始的目录
+    };
+    
+    struct TreeError {
+        std::string path;
+        std::error_code error;
+    };
+    
+    struct TreeResult {
+        uint64_t files = 0;             // 复制或删除的非目录项（文件、符号链接等）数
+        uint64_t directories = 0;       // 复制或删除的目录数（含根目录）
+        uint64_t bytes = 0;             // CopyTree 复制的数据字节数
+        std::vector<TreeError> errors;  // 所有失败的项，顺序不确定
+    };
+    
+    /**
+     * @brief 并行复制目录树
+     *
+     * 各目录由工作线程并行处理，目录内的项相对于已打开的目录描述符访问（openat/fstatat），
+     * 不重复解析完整路径；文件使用 DuplicateFile 的复制引擎。符号链接复制为链接本身，FIFO 重新创建，
+     * 其他特殊文件记为错误。目标目录已存在时合并。目录的权限和时间在其内容复制完成后设置。
+     * 出错的项记录在 result->errors 中并继续处理其他项。
+     * @return 所有项都成功时返回 true；根目录无法读取或目标位于源目录内时返回 false 并设置 errno
+     */
+    static bool CopyTree(const std::string& from, const std::string& to,
+                         const TreeOptions& options, TreeResult* result = nullptr);
+    
+    // 按默认选项并行复制目录树
+    static bool CopyTree(const std::string& from, const std::string& to);
+    
+    /**
+     * @brief 并行删除目录树
+     *
+     * 各目录由工作线程并行处理，目录项相对于目录描述符删除（unlinkat），通常不需要 stat；
+     * 目录在其内容全部删除后删除。不跟随符号链接；path 本身是文件或符号链接时直接删除。
+     * @return 全部删除时返回 true；失败的项记录在 result->errors 中，其上层目录保留
+     */
+    static bool DeleteTree(const std::string& path, const TreeOptions& options, TreeResult* result = nullptr);
+    
+    // ===== 目录遍历 =====
+    
+    // 遍历到的一项；path 和 name 指向遍历器内部的缓冲区，只在回调期间（或下一次 Next 之前）有效
+    struct WalkEntry {
+        std::string_view path;              // root 与相对路径拼接成的路径
+        std::string_view name;              // 文件名
+        FileType type = FileType::Other;    // 来自目录项的类型，文件系统不提供时才 stat；不跟随符号链接
+        int depth = 0;                      // root 的直接子项为 1
+    };
+    
+    // 访问回调的返回值
+    enum class WalkAction {
+        Continue,       // 继续遍历
+        SkipSubtree,    // 不进入当前目录（对非目录项等同于 Continue）
+        Stop            // 结束遍历
+    };
+    
+    // 过滤条件只决定哪些项被返回；不被返回的目录仍然会进入
+    struct WalkOptions {
+        std::string pattern;        // 文件名的 glob 模式（见 StringUtils::matchGlob），空表示不过滤
+        int maxDepth = -1;          // 最大深度，1 表示只返回 root 的直接子项，-1 表示不限
+        bool files = true;          // 返回普通文件
+        bool directories = true;    // 返回目录
+        bool symlinks = true;       // 返回符号链接（从不跟随）
+        bool others = true;         // 返回其他类型
+        unsigned threads = 1;       // Walk 使用的线程数，0 表示按 CPU 核数；Walker 总是单线程
+    };
+    
+    using WalkVisitor = std::function<WalkAction(const WalkEntry& entry)>;
+    
+    /**
+     * @brief 按需遍历目录树的迭代器（先序、深度优先）
+     *
+     * 每层目录只打开一次，子目录相对于父目录的描述符打开（openat），Linux 上用大缓冲区的
+     * getdents64 批量读取目录项，按目录项中的类型区分文件和目录，不需要逐项 lstat。
+     * 路径在一个缓冲区中拼接，遍历过程中不为每一项分配内存。
+     * 无法读取的子目录记录在 Errors() 中并跳过，遍历继续。
+     *
+     * 示例:
+     *   FileSystem::WalkOptions options;
+     *   options.pattern = "*.log";
+     *   options.directories = false;
+     *   FileSystem::Walker walker("/var/log", options);
+     *   FileSystem::WalkEntry entry;
+     *   while (walker.Next(entry)) {
+     *       printf("%.*s\n", int(entry.path.size()), entry.path.data());
+     *   }
+     */
+    class CORE_PLATFORM_API Walker {
+    public:
+        explicit Walker(const std::string& root);
+        Walker(const std::string& root, const WalkOptions& options);
+        ~Walker();
+        
+        Walker(Walker&& other) noexcept;
+        Walker& operator=(Walker&& other) noexcept;
+        Walker(const Walker&) = delete;
+        Walker& operator=(const Walker&) = delete;
+        
+        // 取下一项，遍历结束时返回 false；返回的目录在下一次调用时才进入
+        bool Next(WalkEntry& entry);
+        
+        // 不进入上一次 Next 返回的目录
+        void SkipSubtree();
+        
+        // 遍历过程中无法读取的目录（包括 root 本身）
+        const std::vector<TreeError>& Errors() const;
+        
+    private:
+        struct State;
+        std::unique_ptr<State> state;
+    };
+    
+    /**
+     * @brief 遍历目录树，对每个符合过滤条件的项调用 visitor
+     *
+     * options.threads 为 1 时按 Walker 的顺序在调用线程中访问；大于 1 时各目录由多个线程并行读取，
+     * 空闲线程从其他线程窃取尚未处理的子目录，visitor 会在多个线程中并发调用，项的顺序不确定。
+     * @param errors 可选，返回无法读取的目录
+     * @return 所有目录都读取成功时返回 true（包括被 visitor 提前结束的情况）
+     */
+    static bool Walk(const std::string& root, const WalkOptions& options, const WalkVisitor& visitor,
+                     std::vector<TreeError>* errors = nullptr);
+    
+    class RecursiveDirectoryIterator;
+    
+    /**
+     * @brief 目录迭代器返回的一项
+     *
+     * 类型来自目录项，不需要 stat；大小和修改时间在第一次访问时 lstat 一次并缓存（不跟随符号链接），
+     * 不访问就没有额外的系统调用。可以复制保存，与迭代器的位置无关。
+     */
+    class CORE_PLATFORM_API DirectoryEntry {
+    public:
+        const std::string& Path() const { return path; }
+        std::string_view Name() const { return std::string_view(path).substr(nameOffset); }
+        FileType Type() const { return type; }
+        int Depth() const { return depth; }
+        
+        bool IsRegularFile() const { return type == FileType::Regular; }
+        bool IsDirectory() const { return type == FileType::Directory; }
+        bool IsSymlink() const { return type == FileType::Symlink; }
+        
+        // 文件大小（字节），获取失败时返回 0
+        uint64_t Size() const;
+        
+        // 修改时间，获取失败时返回 time_point()
+        std::chrono::system_clock::time_point ModificationTime() const;
+        
+    private:
+        friend class RecursiveDirectoryIterator;
+        
+        void Assign(const WalkEntry& entry);
+        void LoadStatus() const;
+        
+        std::string path;
+        size_t nameOffset = 0;
+        FileType type = FileType::Other;
+        int depth = 0;
+        mutable bool statusLoaded = false;
+        mutable uint64_t size = 0;
+        mutable std::chrono::system_clock::time_point modificationTime;
+    };
+    
+    /**
+     * @brief 按需读取目录树的输入迭代器，可直接用于范围 for
+     *
+     * 每次前进只读取下一项，不在内存中构建整个列表；提前 break 即可结束遍历并释放目录描述符。
+     * 迭代器的副本共享同一个遍历位置（与 std::filesystem 的目录迭代器相同）。
+     * 目录无法打开时跳过（根目录无法打开时迭代器直接等于结束迭代器），原因见 Errors()。
+     *
+     * 示例:
+     *   for (auto it = FileSystem::RecursiveDirectoryIterator("/data"); it != FileSystem::RecursiveDirectoryIterator(); ++it) {
+     *       if (it->IsDirectory() && it->Name() == ".git") {
+     *           it.SkipSubtree();
+     *       } else if (it->IsRegularFile() && it->Size() > limit) {
+     *           ...
+     *       }
+     *   }
+     */
+    class CORE_PLATFORM_API RecursiveDirectoryIterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = DirectoryEntry;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const DirectoryEntry*;
+        using reference = const DirectoryEntry&;
+        
+        // 结束迭代器
+        RecursiveDirectoryIterator() = default;
+        explicit RecursiveDirectoryIterator(const std::string& path);
+        // 按 options 过滤和限制深度（options.threads 不起作用）
+        RecursiveDirectoryIterator(const std::string& path, const WalkOptions& options);
+        
+        const DirectoryEntry& operator*() const;
+        const DirectoryEntry* operator->() const { return &**this; }
+        RecursiveDirectoryIterator& operator++();
+        void operator++(int) { ++*this; }
+        
+        // 都到达结尾时相等
+        bool operator==(const RecursiveDirectoryIterator& other) const;
+        bool operator!=(const RecursiveDirectoryIterator& other) const { return !(*this == other); }
+        
+        // 不进入当前目录
+        void SkipSubtree();
+        
+        // 当前项的深度，root 的直接子项为 1
+        int Depth() const;
+        
+        // 到目前为止无法读取的目录
+        const std::vector<TreeError>& Errors() const;
+        
+        friend RecursiveDirectoryIterator begin(RecursiveDirectoryIterator it) { return it; }
+        friend RecursiveDirectoryIterator end(const RecursiveDirectoryIterator&) { return RecursiveDirectoryIterator(); }
+        
+    private:
+        struct State;
+        std::shared_ptr<State> state;
+    };
+    
+    /**
+     * @brief 按需读取单个目录的输入迭代器，可直接用于范围 for
+     *
+     * 与 RecursiveDirectoryIterator 相同，但只返回目录的直接子项。
+     *
+     * 示例:
+     *   for (const auto& entry : FileSystem::DirectoryIterator("/var/log")) {
+     *       if (entry.IsRegularFile()) total += entry.Size();
+     *   }
+     */
+    class CORE_PLATFORM_API DirectoryIterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = DirectoryEntry;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const DirectoryEntry*;
+        using reference = const DirectoryEntry&;
+        
+        DirectoryIterator() = default;
+        explicit DirectoryIterator(const std::string& path);
+        // 按 options 过滤（options.maxDepth 和 options.threads 不起作用）
+        DirectoryIterator(const std::string& path, const WalkOptions& options);
+        
+        const DirectoryEntry& operator*() const { return *iterator; }
+        const DirectoryEntry* operator->() const { return &*iterator; }
+        DirectoryIterator& operator++() { ++iterator; return *this; }
+        void operator++(int) { ++iterator; }
+        
+        bool operator==(const DirectoryIterator& other) const { return iterator == other.iterator; }
+        bool operator!=(const DirectoryIterator& other) const { return !(*this == other); }
+        
+        const std::vector<TreeError>& Errors() const { return iterator.Errors(); }
+        
+        friend DirectoryIterator begin(DirectoryIterator it) { return it; }
+        friend DirectoryIterator end(const DirectoryIterator&) { return DirectoryIterator(); }
+        
+    private:
+        RecursiveDirectoryIterator iterator;
+    };
+    
+    // ===== 元数据缓存 =====
+    
+    struct MetadataCacheOptions {
+        // 条目的最长有效期。变化通知无法覆盖的情况（上级目录被重命名、父目录不存在无法监视、
+        // 非 Linux 平台）靠它兜底；0 表示不缓存
+        std::chrono::milliseconds ttl{10000};
+        size_t maxEntries = 65536;      // 条目数上限，达到时先删除过期条目，仍然满则清空
+        bool watchChanges = true;       // Linux 上用 inotify 在文件变化时立即使条目失效
+    };
+    
+    struct MetadataCacheStats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t invalidations = 0;     // 因变化通知、Invalidate() 或 Clear() 删除的条目数
+        uint64_t expirations = 0;       // 因超过 ttl 删除的条目数
+        size_t entries = 0;
+        size_t watches = 0;             // 监视中的目录数
+    };
+    
+    /**
+     * @brief 元数据查询的缓存，用于反复查询同一批路径（如日志采集轮询）
+     *
+     * 按传入的路径字符串缓存（不做规范化，相对路径按首次查询时的工作目录解释），不跟随符号链接，
+     * 文件不存在的结果同样缓存。Linux 上监视每个缓存路径所在的目录（缓存的目录本身也被监视，
+     * 以便其中增删文件时修改时间失效），后台线程读取 inotify 事件并删除对应条目；
+     * 事件队列溢出时清空缓存。命中时只查找哈希表和读取单调时钟（vDSO），没有系统调用。
+     * 多线程安全，命中的查询只持有共享锁，并发查询互不阻塞。
+     *
+     * 示例:
+     *   FileSystem::MetadataCache cache;
+     *   while (running) {
+     *       for (const auto& path : paths) {
+     *           if (cache.GetModificationTime(path) != lastSeen[path]) { ... }
+     *       }
+     *   }
+     */
+    class CORE_PLATFORM_API MetadataCache {
+    public:
+        MetadataCache();
+        explicit MetadataCache(const MetadataCacheOptions& options);
+        ~MetadataCache();
+        
+        MetadataCache(const MetadataCache&) = delete;
+        MetadataCache& operator=(const MetadataCache&) = delete;
+        
+        // 与 FileSystem 中的同名函数相同（不存在时分别返回 false、Other、0、time_point()）
+        bool Exists(const std::string& path);
+        FileType GetFileType(const std::string& path);
+        uint64_t GetFileSize(const std::string& path);
+        std::chrono::system_clock::time_point GetModificationTime(const std::string& path);
+        
+        // 类型、大小和修改时间（InfoBasic）；失败时返回 false，原因见 errno（Windows 上为 GetLastError()），命中时同样设置
+        bool GetFileInfo(const std::string& path, FileInfo& info);
+        
+        // 删除一个条目，调用者自己修改了文件且不能等待变化通知时使用
+        void Invalidate(const std::string& path);
+        
+        // 删除所有条目
+        void Clear();
+        
+        MetadataCacheStats Stats() const;
+        
+    private:
+        struct State;
+        std::unique_ptr<State> state;
+    };
+    
+    // ===== 目录监视 =====
+    
+    enum class WatchEventType {
+        Created,
+        Deleted,
+        Modified,       // 内容或属性变化
+        Renamed,        // 在监视范围内重命名或移动，oldPath 为原路径
+        Rescan          // 内核事件队列溢出，部分事件丢失；监视已重新建立，调用者应重新检查 path 下的内容
+    };
+    
+    struct WatchEvent {
+        WatchEventType type = WatchEventType::Modified;
+        std::string path;
+        std::string oldPath;
+        bool isDirectory = false;
+    };
+    
+    // 一批合并后的事件，按首次发生的顺序排列
+    using WatchCallback = std::function<void(const std::vector<WatchEvent>& events)>;
+    
+    struct WatchOptions {
+        bool recursive = true;                      // 监视整个目录树，新建和移入的子目录自动加入
+        std::chrono::milliseconds latency{50};      // 第一个事件到达后等待多久再投递，期间同一路径的事件合并
+        // Linux：用 fanotify 标记 root 所在的整个文件系统（需要 CAP_SYS_ADMIN），不必为每个目录添加监视，
+        // 不受 max_user_watches 限制，不跨越挂载点。与 inotify 一样报告 Renamed 和 root 自身的删除或移走；
+        // 早于 5.17 的内核没有 FAN_RENAME，重命名报告为 Deleted 和 Created。没有权限时使用 inotify
+        bool useFanotify = false;
+        // 回调跟不上时后续批次并入尚未投递的事件继续合并；合并后仍超过此数时丢弃它们，改为投递一个 Rescan
+        size_t maxPendingEvents = 65536;
+    };
+    
+    /**
+     * @brief 监视目录树中的变化，代替轮询 GetModificationTime
+     *
+     * Linux 上使用 inotify（或 fanotify，见 WatchOptions）。后台线程读取事件并按路径合并：
+     * 创建后修改仍是 Created，创建后删除的临时文件不报告，多次修改只报告一次；
+     * 合并后的一批事件在单独的回调线程中投递，回调较慢时不会导致内核事件队列溢出。
+     * 新建的子目录加入监视时扫描其内容，添加监视之前已经创建的项同样报告为 Created。
+     * 事件队列溢出时重新扫描目录树恢复监视，并投递一个 Rescan 事件。
+     * 其他平台上 Start 返回 false。
+     *
+     * 示例:
+     *   FileSystem::Watcher watcher;
+     *   watcher.Start("/var/log/app", [](const std::vector<FileSystem::WatchEvent>& events) {
+     *       for (const auto& event : events) { ... }
+     *   });
+     */
+    class CORE_PLATFORM_API Watcher {
+    public:
+        Watcher();
+        ~Watcher();
+        
+        Watcher(Watcher&& other) noexcept;
+        Watcher& operator=(Watcher&& other) noexcept;
+        Watcher(const Watcher&) = delete;
+        Watcher& operator=(const Watcher&) = delete;
+        
+        /**
+         * @brief 开始监视 root，正在监视时先停止
+         * @return 失败时返回 false，原因见 errno；子目录无法监视（如达到 max_user_watches）时跳过
+         */
+        bool Start(const std::string& root, WatchCallback callback);
+        bool Start(const std::string& root, const WatchOptions& options, WatchCallback callback);
+        
+        // 停止监视，等待正在执行的回调返回，尚未投递的事件被丢弃；
+        // 在回调中调用时不等待，回调返回后不再投递，后台线程自行退出
+        void Stop();
+        
+        bool IsRunning() const;
+        bool UsesFanotify() const;
+        
+        // 监视中的目录数（fanotify 为 1）
+        size_t WatchCount() const;
+        
+    private:
+        struct State;
+        std::unique_ptr<State> state;
+    };
+    
     // ===== 符号链接操作 =====
     
     // 创建符号链接
@@ -256,6 +799,98 @@ public:
             int fileDescriptor = -1;
         #endif
     };
+
+    // ===== 内存映射文件 =====
+
+    // 映射方式
+    enum class MapMode {
+        ReadOnly,       // 只读
+        ReadWrite,      // 读写，修改写回文件
+        CopyOnWrite     // 私有写时复制，修改只对当前映射可见，不写回文件
+    };
+
+    // 访问模式提示
+    enum class MapAdvice {
+        Normal,
+        Sequential,     // 顺序访问：加大预读，读过的页面可以尽早回收
+        Random,         // 随机访问：不预读
+        WillNeed        // 即将访问：立即开始预读
+    };
+
+    struct MapOptions {
+        MapMode mode = MapMode::ReadOnly;
+        MapAdvice advice = MapAdvice::Normal;   // 映射后立即对整个文件应用的提示
+        bool hugePages = false;                 // 尽量使用大页映射，不支持时使用普通页面
+        uint64_t size = 0;                      // ReadWrite 时文件不存在则创建，小于该大小则扩展；0 表示按文件当前大小映射
+    };
+
+    /**
+     * @brief 内存映射文件（RAII）
+     *
+     * 映射整个文件，析构时解除映射，读取不需要把文件复制到缓冲区。映射期间文件被其他进程截断时，
+     * 访问超出新文件末尾的页面会触发 SIGBUS（Windows 上为访问异常）。空文件可以打开，数据为空。
+     *
+     * 大页：Linux 上 hugetlbfs 中的文件总是使用大页（UsesHugePages() 返回 true）；普通文件通过
+     * madvise(MADV_HUGEPAGE) 请求透明大页，是否生效由内核决定。其他平台忽略该选项。
+     *
+     * 示例:
+     *   FileSystem::MappedFile file("data.bin", {.advice = FileSystem::MapAdvice::Sequential});
+     *   if (file.IsOpen()) {
+     *       for (uint8_t byte : file.Bytes()) { ... }
+     *   }
+     */
+    class CORE_PLATFORM_API MappedFile {
+    public:
+        MappedFile() = default;
+        explicit MappedFile(const std::string& path);
+        MappedFile(const std::string& path, const MapOptions& options);
+        ~MappedFile();
+
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        // 映射文件（已映射时先解除），失败时返回 false，原因见 errno（Windows 上为 GetLastError()）
+        bool Open(const std::string& path);
+        bool Open(const std::string& path, const MapOptions& options);
+
+        // 解除映射，ReadWrite 映射的修改由系统写回文件
+        void Close();
+
+        bool IsOpen() const { return isOpen; }
+        MapMode GetMode() const { return mapMode; }
+        size_t Size() const { return mappedSize; }
+        bool UsesHugePages() const { return hugePages; }
+
+        const uint8_t* Data() const { return data; }
+        // 可写的数据，只读映射时返回 nullptr
+        uint8_t* MutableData() { return mapMode == MapMode::ReadOnly ? nullptr : data; }
+
+        std::span<const uint8_t> Bytes() const { return {data, mappedSize}; }
+        // 可写的数据，只读映射时为空
+        std::span<uint8_t> MutableBytes() { return {MutableData(), MutableData() ? mappedSize : 0}; }
+        std::string_view Text() const { return {reinterpret_cast<const char*>(data), mappedSize}; }
+
+        // 对 [offset, offset + length) 应用访问模式提示，范围超出文件时截断
+        bool Advise(MapAdvice advice, size_t offset = 0, size_t length = SIZE_MAX);
+
+        // 将 ReadWrite 映射的修改写回文件，wait 为 true 时等待写入磁盘完成；其他映射方式直接返回 true
+        bool Flush(bool wait = true);
+
+    private:
+        uint8_t* data = nullptr;
+        size_t mappedSize = 0;
+        size_t mappedLength = 0;    // 实际映射的字节数（大页映射时按大页向上取整）
+        MapMode mapMode = MapMode::ReadOnly;
+        bool isOpen = false;
+        bool hugePages = false;
+
+        #if CP_PLATFORM_WINDOWS
+            void* fileHandle = nullptr;
+            void* mappingHandle = nullptr;
+        #endif
+    };
 };
 
 } // namespace CorePlatform
\ No newline at end of file
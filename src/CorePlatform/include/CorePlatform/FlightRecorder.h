@@ -0,0 +1,84 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include "CorePlatform/Export.h"
+#include "CorePlatform/LogSink.h"
+#include "CorePlatform/TimeUtils.h"
+#include "CorePlatform/Internal/PlatformDetection.h"
+
+namespace CorePlatform {
+
+// 飞行记录器配置
+struct FlightRecorderOptions {
+    size_t recordsPerThread = 1024;       // 每个线程保留的最近日志条数
+    LogLevel level = LogLevel::TRACE;     // 记录的最低级别，可以低于写入磁盘的级别
+    std::string dumpPath;                 // 导出文件路径，为空时为 "<日志文件>.flight"（未设置日志文件时为 flight-recorder.log）
+    bool dumpOnFatal = true;              // 记录 FATAL 日志后导出
+    bool installCrashHandler = true;      // 在 SIGSEGV/SIGABRT/SIGBUS/SIGFPE/SIGILL 时导出
+};
+
+/**
+ * @brief 崩溃安全的内存日志记录器（飞行记录器）
+ *
+ * 每个线程独占一个固定大小的环形缓冲区，保留最近 recordsPerThread 条日志。写入只涉及当前线程的
+ * 缓冲区：不加锁、不分配内存，每个槽位用序号（seqlock）标记写入中/已完成，导出时跳过正在写入的槽位。
+ * 线程退出后其缓冲区保留到被新线程复用，期间仍可导出。超过 kMaxMessageSize 的消息被截断。
+ *
+ * 导出格式为 "[时间] [级别] [线程号] 消息"。dump() 按时间合并所有线程；
+ * dumpSignalSafe() 只使用异步信号安全的系统调用，按线程分段输出，时间为 UTC。
+ *
+ * 安装崩溃处理函数后，记录过日志的线程各自带有备用信号栈，栈溢出引起的崩溃也能导出。
+ */
+class CORE_PLATFORM_API FlightRecorder {
+public:
+    static constexpr size_t kMaxMessageSize = 232;
+
+    FlightRecorder(size_t recordsPerThread, LogLevel level);
+    ~FlightRecorder();
+
+    CP_DISABLE_COPY_MOVE(FlightRecorder);
+
+    bool shouldRecord(LogLevel level) const { return level >= level_.load(std::memory_order_relaxed); }
+    LogLevel level() const { return level_.load(std::memory_order_relaxed); }
+    size_t recordsPerThread() const { return capacity_; }
+
+    // 记录一条日志到当前线程的缓冲区
+    void record(LogLevel level, std::chrono::system_clock::time_point time, std::string_view message);
+
+    // 丢弃此前的记录并更改记录级别，用于复用记录器；与之并发的记录可能保留也可能被丢弃
+    void reset(LogLevel level);
+
+    // 按时间顺序导出所有线程的记录，失败时返回 false
+    bool dump(const std::string& path, TimestampFormat format = TimestampFormat::LocalMillis) const;
+
+    // 异步信号安全的导出：不加锁、不分配内存，可在崩溃信号处理函数中调用
+    bool dumpSignalSafe(const char* path) const noexcept;
+
+    /**
+     * @brief 安装崩溃信号处理函数，在崩溃时将 recorder 导出到 path
+     *
+     * 处理函数导出后恢复原有的处理方式并重新发送信号，不影响 core dump 和上层的处理函数。
+     * 重复调用时替换导出目标；recorder 为 nullptr 时仅取消导出（处理函数保留）。
+     */
+    static void installCrashHandler(const FlightRecorder* recorder, const std::string& path);
+
+private:
+    struct Slot;
+    struct ThreadRing;
+
+    // 当前线程的缓冲区，第一次调用时获取空闲缓冲区或新建
+    ThreadRing* localRing();
+
+    const size_t capacity_;
+    std::atomic<LogLevel> level_;
+    const uint64_t id_;
+    // 所有线程缓冲区组成的无锁链表，只增不减，析构时释放
+    std::atomic<ThreadRing*> rings_{nullptr};
+};
+
+} // namespace CorePlatform
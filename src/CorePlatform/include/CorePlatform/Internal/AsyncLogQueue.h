@@ -0,0 +1,198 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "CorePlatform/LogSink.h"
+#include "CorePlatform/Internal/BoundedQueue.h"
+#include "CorePlatform/Internal/PlatformDetection.h"
+
+namespace CorePlatform {
+namespace Internal {
+
+/**
+ * @brief 日志异步写出的公共部分：有界队列、溢出策略、后台写线程和 flush 等待
+ *
+ * Logger 的异步模式和异步 LogSink 共用。记录按批交给 consume 回调写出，通常在后台线程上；
+ * 停止之后由提交或等待的线程自行写出，因此 consume 可能被多个线程同时调用，需要自行加锁。
+ * 队列为空时后台线程调用 idle 回调（可为空），其返回值为下次检查之前的最长睡眠时间。
+ */
+template<typename Record>
+class AsyncLogQueue {
+public:
+    using Consumer = std::function<void(std::vector<Record>& batch)>;
+    using IdleHandler = std::function<std::chrono::steady_clock::duration()>;
+
+    AsyncLogQueue(size_t capacity, LogOverflowPolicy policy, Consumer consume, IdleHandler idle = IdleHandler())
+        : queue_(capacity), policy_(policy), consume_(std::move(consume)), idle_(std::move(idle)) {}
+
+    ~AsyncLogQueue() {
+        stop();
+    }
+
+    CP_DISABLE_COPY_MOVE(AsyncLogQueue);
+
+    size_t capacity() const { return queue_.capacity(); }
+    LogOverflowPolicy policy() const { return policy_; }
+    uint64_t droppedCount() const { return dropped_.load(std::memory_order_relaxed); }
+    bool running() const { return running_.load(std::memory_order_acquire); }
+
+    // 启动后台写线程，stop() 之后可以再次启动
+    void start() {
+        running_.store(true, std::memory_order_release);
+        thread_ = std::thread([this] { run(); });
+    }
+
+    // 停止后台写线程，并在当前线程写完剩余记录
+    void stop() {
+        if (!running_.exchange(false, std::memory_order_acq_rel)) {
+            return;
+        }
+        wakeWriter(true);
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+        drainAll();
+    }
+
+    // 提交一条记录，urgent 时总是唤醒写线程；已停止时返回 false（此时 record 不会被移动），由调用者同步写出
+    bool submit(Record&& record, bool urgent) {
+        if (!running_.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        // 先计数再入队，保证 waitUntilDrained() 取到的目标值覆盖所有已入队的记录
+        submitted_.fetch_add(1, std::memory_order_relaxed);
+
+        for (int attempt = 0; !queue_.tryPush(std::move(record)); ++attempt) {
+            switch (policy_) {
+            case LogOverflowPolicy::Drop:
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                completed_.fetch_add(1, std::memory_order_release);
+                return true;
+            case LogOverflowPolicy::DropOldest: {
+                Record oldest;
+                if (queue_.tryPop(oldest)) {
+                    dropped_.fetch_add(1, std::memory_order_relaxed);
+                    completed_.fetch_add(1, std::memory_order_release);
+                }
+                break;
+            }
+            case LogOverflowPolicy::Block:
+                wakeWriter(true);
+                if (attempt < kSpinAttempts) {
+                    std::this_thread::yield();
+                } else {
+                    std::unique_lock<std::mutex> lock(waitMutex_);
+                    progressCv_.wait_for(lock, std::chrono::milliseconds(1));
+                }
+                break;
+            }
+        }
+
+        wakeWriter(urgent);
+
+        // 入队期间写线程被停止：自行写出，避免记录滞留在队列中
+        if (!running_.load(std::memory_order_acquire)) {
+            drainAll();
+        }
+        return true;
+    }
+
+    // 等待调用前已提交的记录全部写出
+    void waitUntilDrained() {
+        const uint64_t target = submitted_.load(std::memory_order_acquire);
+        while (completed_.load(std::memory_order_acquire) < target) {
+            if (!running_.load(std::memory_order_acquire)) {
+                drainAll();
+                continue;
+            }
+            wakeWriter(true);
+            std::unique_lock<std::mutex> lock(waitMutex_);
+            progressCv_.wait_for(lock, std::chrono::milliseconds(5));
+        }
+    }
+
+private:
+    static constexpr size_t kMaxBatch = 256;
+    static constexpr int kSpinAttempts = 64;
+    static constexpr auto kIdleWait = std::chrono::milliseconds(100);
+
+    void run() {
+        std::vector<Record> batch;
+        batch.reserve(kMaxBatch);
+        while (running_.load(std::memory_order_acquire)) {
+            if (drainOnce(batch) > 0) {
+                continue;
+            }
+
+            std::chrono::steady_clock::duration wait = kIdleWait;
+            if (idle_) {
+                wait = std::min(wait, idle_());
+            }
+            std::unique_lock<std::mutex> lock(waitMutex_);
+            writerIdle_.store(true, std::memory_order_seq_cst);
+            if (queue_.empty() && running_.load(std::memory_order_acquire)) {
+                wakeCv_.wait_for(lock, wait);
+            }
+            writerIdle_.store(false, std::memory_order_relaxed);
+        }
+    }
+
+    void wakeWriter(bool force) {
+        if (force || writerIdle_.load(std::memory_order_seq_cst)) {
+            std::lock_guard<std::mutex> lock(waitMutex_);
+            wakeCv_.notify_one();
+        }
+    }
+
+    void drainAll() {
+        std::vector<Record> batch;
+        while (drainOnce(batch) > 0) {}
+    }
+
+    // 取出一批记录并写出，返回本批条数
+    size_t drainOnce(std::vector<Record>& batch) {
+        batch.clear();
+        Record record;
+        while (batch.size() < kMaxBatch && queue_.tryPop(record)) {
+            batch.push_back(std::move(record));
+        }
+        if (batch.empty()) {
+            return 0;
+        }
+
+        consume_(batch);
+
+        const size_t count = batch.size();
+        completed_.fetch_add(count, std::memory_order_release);
+        progressCv_.notify_all();
+        return count;
+    }
+
+    BoundedQueue<Record> queue_;
+    const LogOverflowPolicy policy_;
+    const Consumer consume_;
+    const IdleHandler idle_;
+    std::thread thread_;
+
+    std::atomic<bool> running_{false};
+    std::atomic<bool> writerIdle_{false};
+    std::atomic<uint64_t> submitted_{0};
+    std::atomic<uint64_t> completed_{0};
+    std::atomic<uint64_t> dropped_{0};
+
+    std::mutex waitMutex_;
+    std::condition_variable wakeCv_;     // 唤醒空闲的写线程
+    std::condition_variable progressCv_; // 通知阻塞的生产者和 flush 等待者
+};
+
+} // namespace Internal
+} // namespace CorePlatform
@@ -0,0 +1,263 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <condition_variable>
+#include "CorePlatform/Export.h"
+#include "CorePlatform/TimeUtils.h"
+#include "CorePlatform/Internal/LogFormat.h"
+#include "CorePlatform/Internal/PlatformDetection.h"
+
+namespace CorePlatform {
+namespace Internal {
+
+/**
+ * 二进制日志文件格式（字节序与写入方主机相同）：
+ *
+ *   文件头    8 字节魔数 kBinaryLogMagic
+ *   字典帧    u8 kind=1 | u32 formatId | u8 argCount | argCount 个 u8 参数类型 | u32 长度 | 格式串
+ *   数据帧    u8 kind=2 | u32 streamId | u32 长度 | 若干条记录
+ *
+ * 每条记录为 u32 formatId | u8 level | i64 纳秒时间戳 | 参数。参数按字典中的类型依次存放：
+ * 定长类型直接存原始字节，字符串为 u32 长度加内容（长度为 0xFFFFFFFF 表示空指针）。
+ * 同一 streamId 的记录按写入顺序排列；不同线程的 streamId 不同，解码时按时间戳合并。
+ */
+constexpr char kBinaryLogMagic[8] = {'C', 'P', 'B', 'L', 'O', 'G', '\0', '\1'};
+
+enum class BinaryArgType : uint8_t {
+    Bool, Char,
+    Int8, UInt8, Int16, UInt16, Int32, UInt32, Int64, UInt64,
+    Float, Double, LongDouble,
+    String, Pointer, Null
+};
+
+// 记录头：formatId + level + 时间戳
+constexpr size_t kBinaryRecordHeaderSize = sizeof(uint32_t) + sizeof(uint8_t) + sizeof(int64_t);
+constexpr uint32_t kBinaryNullString = 0xFFFFFFFFu;
+
+// 参数类型编码，与 appendLogArg 的分派规则保持一致
+template<typename T>
+constexpr BinaryArgType binaryArgTypeOf() {
+    using U = std::remove_cvref_t<T>;
+    if constexpr (std::is_same_v<U, bool>) {
+        return BinaryArgType::Bool;
+    } else if constexpr (std::is_same_v<U, char>) {
+        return BinaryArgType::Char;
+    } else if constexpr (std::is_integral_v<U>) {
+        constexpr bool isSigned = std::is_signed_v<U>;
+        if constexpr (sizeof(U) == 1) return isSigned ? BinaryArgType::Int8 : BinaryArgType::UInt8;
+        else if constexpr (sizeof(U) == 2) return isSigned ? BinaryArgType::Int16 : BinaryArgType::UInt16;
+        else if constexpr (sizeof(U) == 4) return isSigned ? BinaryArgType::Int32 : BinaryArgType::UInt32;
+        else return isSigned ? BinaryArgType::Int64 : BinaryArgType::UInt64;
+    } else if constexpr (std::is_same_v<U, float>) {
+        return BinaryArgType::Float;
+    } else if constexpr (std::is_same_v<U, double>) {
+        return BinaryArgType::Double;
+    } else if constexpr (std::is_floating_point_v<U>) {
+        return BinaryArgType::LongDouble;
+    } else if constexpr (std::is_enum_v<U>) {
+        return binaryArgTypeOf<std::underlying_type_t<U>>();
+    } else if constexpr (std::is_null_pointer_v<U>) {
+        return BinaryArgType::Null;
+    } else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+        return BinaryArgType::String;
+    } else {
+        return BinaryArgType::Pointer;
+    }
+}
+
+// 参数编码后的字节数
+template<typename T>
+size_t binaryArgSize(const T& value) {
+    constexpr BinaryArgType type = binaryArgTypeOf<T>();
+    if constexpr (type == BinaryArgType::String) {
+        if constexpr (std::is_pointer_v<std::remove_cvref_t<T>>) {
+            if (value == nullptr) return sizeof(uint32_t);
+        }
+        return sizeof(uint32_t) + std::string_view(value).size();
+    } else if constexpr (type == BinaryArgType::Null) {
+        return 0;
+    } else if constexpr (type == BinaryArgType::Pointer) {
+        return sizeof(uintptr_t);
+    } else if constexpr (std::is_enum_v<std::remove_cvref_t<T>>) {
+        return sizeof(std::underlying_type_t<std::remove_cvref_t<T>>);
+    } else {
+        return sizeof(std::remove_cvref_t<T>);
+    }
+}
+
+// 将参数编码到 out，返回写入之后的位置
+template<typename T>
+char* encodeBinaryArg(char* out, const T& value) {
+    using U = std::remove_cvref_t<T>;
+    constexpr BinaryArgType type = binaryArgTypeOf<T>();
+    if constexpr (type == BinaryArgType::String) {
+        if constexpr (std::is_pointer_v<std::remove_cvref_t<T>>) {
+            if (value == nullptr) {
+                std::memcpy(out, &kBinaryNullString, sizeof(uint32_t));
+                return out + sizeof(uint32_t);
+            }
+        }
+        const std::string_view text(value);
+        const uint32_t length = static_cast<uint32_t>(text.size());
+        std::memcpy(out, &length, sizeof(length));
+        std::memcpy(out + sizeof(length), text.data(), text.size());
+        return out + sizeof(length) + text.size();
+    } else if constexpr (type == BinaryArgType::Null) {
+        return out;
+    } else if constexpr (type == BinaryArgType::Pointer) {
+        const uintptr_t address = reinterpret_cast<uintptr_t>(value);
+        std::memcpy(out, &address, sizeof(address));
+        return out + sizeof(address);
+    } else if constexpr (std::is_enum_v<U>) {
+        const auto raw = static_cast<std::underlying_type_t<U>>(value);
+        std::memcpy(out, &raw, sizeof(raw));
+        return out + sizeof(raw);
+    } else {
+        std::memcpy(out, &value, sizeof(U));
+        return out + sizeof(U);
+    }
+}
+
+/**
+ * @brief 延迟格式化的二进制日志输出
+ *
+ * 调用线程只写入格式串 ID 和参数的原始字节：记录先进入当前线程独占的暂存环形缓冲区
+ * （单生产者单消费者，无锁），由后台线程批量写入文件。格式串在第一次使用时登记到进程级字典，
+ * 字典条目在引用它的记录之前写入文件。文件需要用 decodeBinaryLog 或解码工具还原为文本。
+ *
+ * 暂存缓冲区已满时调用线程等待后台线程腾出空间，不会丢弃日志。后台线程空闲时睡眠，
+ * 由提交记录的线程唤醒。
+ *
+ * stop() 之后对象可以用 open() 重新打开到另一个文件：仍持有旧指针的调用线程不会访问已释放的内存，
+ * 停止时释放的暂存缓冲区由各线程在下次写入时换成新的。
+ */
+class CORE_PLATFORM_API BinaryLogSink {
+public:
+    explicit BinaryLogSink(const std::string& path);
+    ~BinaryLogSink();
+
+    CP_DISABLE_COPY_MOVE(BinaryLogSink);
+
+    // 重新打开到 path 并启动后台线程，调用前必须已 stop()；失败时返回 false
+    bool open(const std::string& path);
+
+    bool isOpen() const { return open_; }
+    const std::string& path() const { return path_; }
+
+    // 记录一条日志（不做任何格式化）
+    template<typename... Args>
+    void write(uint8_t level, std::string_view fmt, const Args&... args);
+
+    // 等待此前提交的记录全部写入文件
+    void flush();
+
+    // 写完剩余记录并停止后台线程，释放暂存缓冲区，之后的写入被忽略
+    void stop();
+
+    // 每个线程暂存缓冲区的容量
+    static constexpr size_t kStagingCapacity = 1u << 20;
+
+private:
+    class StagingBuffer;
+
+    // 查找或登记格式串，返回其 ID（同一调用点在当前线程内只登记一次）
+    static uint32_t formatId(std::string_view fmt, const BinaryArgType* types, size_t count);
+
+    // 在当前线程的暂存缓冲区中预留连续空间，空间不连续或不足时返回 nullptr
+    char* tryReserve(size_t size, StagingBuffer*& buffer);
+    void commit(StagingBuffer* buffer, size_t size);
+
+    // 预留失败时的慢路径：写入可能跨越环形缓冲区末尾或超过其容量的记录
+    void writeSlow(const char* data, size_t size);
+
+    // 当前线程的暂存缓冲区，已停止时返回 nullptr
+    StagingBuffer* localBuffer();
+    // 写出尚未写入文件的字典条目，调用者必须持有 fileMutex_
+    bool writeDictionaryUnlocked();
+    void run();
+    bool drainOnce();
+    // 是否还有未写出的记录
+    bool hasPending();
+    // 后台线程空闲时唤醒它
+    void wakeWriter();
+    void writeFrame(uint8_t kind, uint32_t id, const char* first, size_t firstSize,
+                    const char* second, size_t secondSize);
+
+    std::string path_;
+    std::ofstream file_;
+    bool open_ = false;
+    // 每次打开分配新的 ID，线程据此发现缓冲区属于已停止的那次打开
+    std::atomic<uint64_t> sinkId_{0};
+
+    std::mutex buffersMutex_;
+    std::vector<std::shared_ptr<StagingBuffer>> buffers_;
+    uint32_t nextStreamId_ = 0;
+
+    // 写文件由后台线程完成，超大记录的慢路径也需要持有此锁
+    std::mutex fileMutex_;
+    size_t dictionaryWritten_ = 0;
+
+    std::atomic<bool> running_{false};
+    std::atomic<bool> writerIdle_{false};
+    std::mutex waitMutex_;
+    std::condition_variable wakeCv_;
+    std::condition_variable passCv_;
+    uint64_t passCount_ = 0;
+    std::thread thread_;
+};
+
+template<typename... Args>
+void BinaryLogSink::write(uint8_t level, std::string_view fmt, const Args&... args) {
+    // 末尾的 Null 仅用于避免零长度数组
+    static constexpr BinaryArgType types[] = {binaryArgTypeOf<Args>()..., BinaryArgType::Null};
+    const uint32_t id = formatId(fmt, types, sizeof...(Args));
+    const int64_t timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    const size_t size = kBinaryRecordHeaderSize + (binaryArgSize(args) + ... + size_t{0});
+
+    auto encode = [&](char* out) {
+        std::memcpy(out, &id, sizeof(id));
+        out += sizeof(id);
+        *out++ = static_cast<char>(level);
+        std::memcpy(out, &timestamp, sizeof(timestamp));
+        out += sizeof(timestamp);
+        ((out = encodeBinaryArg(out, args)), ...);
+    };
+
+    StagingBuffer* buffer = nullptr;
+    if (char* out = tryReserve(size, buffer)) {
+        encode(out);
+        commit(buffer, size);
+        return;
+    }
+
+    thread_local std::string scratch;
+    scratch.resize(size);
+    encode(scratch.data());
+    writeSlow(scratch.data(), size);
+}
+
+/**
+ * @brief 将二进制日志还原为 "[时间] [级别] 消息" 文本行，按时间戳排序
+ * @param lines 输出的文本行
+ * @param error 失败时的错误描述
+ * @return 文件无法打开或格式损坏时返回 false（已解码的行仍保留在 lines 中）
+ */
+CORE_PLATFORM_API bool decodeBinaryLog(const std::string& path,
+                                       std::vector<std::string>& lines,
+                                       TimestampFormat format = TimestampFormat::LocalMillis,
+                                       std::string* error = nullptr);
+
+} // namespace Internal
+} // namespace CorePlatform
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <memory>
+#include "CorePlatform/Internal/PlatformDetection.h"
+
+namespace CorePlatform {
+namespace Internal {
+
+/**
+ * @brief 基于内存映射的日志文件读取器
+ *
+ * 只读映射日志文件，并维护一个稀疏的行偏移索引（每 kIndexStride 行记录一个起始偏移）。
+ * 文件增长时索引只扫描新追加的部分，因此按行号读取的代价与返回的行数成正比；
+ * 读取末尾若干行时直接从文件尾部反向扫描，不需要建立索引。
+ *
+ * 末尾没有换行符的不完整行视为最后一行（与 std::getline 的行为一致），但不进入索引，
+ * 待写入方补全后再计入。
+ *
+ * POSIX 上映射长度预留到文件大小之外，文件增长时通常只需更新可见的大小，不重新映射；
+ * 已索引部分的末尾字节留有副本，截断后又增长（例如 copytruncate 式轮转）时据此发现内容已变并重建索引。
+ * 映射是共享的：若其他进程在 refresh() 之后、读取之前截断文件，访问新末尾之后的页会产生 SIGBUS。
+ * Logger 自己只追加和改名轮转，不会截断；外部工具截断正在读取的日志文件时需要避开读取。
+ * Windows 上文件被映射期间不能截断，没有这个问题。
+ *
+ * 该类本身不是线程安全的，由调用者串行化访问；它不与日志写入方共享任何锁。
+ */
+class LogFileReader {
+public:
+    explicit LogFileReader(std::string path);
+    ~LogFileReader();
+
+    CP_DISABLE_COPY_MOVE(LogFileReader);
+
+    // 读取已在内存中的内容（例如解压后的轮转分段），refresh() 对其无效果
+    static std::unique_ptr<LogFileReader> fromBuffer(std::string path, std::string contents);
+
+    const std::string& path() const { return path_; }
+
+    // 将映射同步到文件当前大小；文件被截断、替换或截断后又写入时重建索引
+    // 文件无法打开时抛出 std::runtime_error
+    void refresh();
+
+    // 是否与 other 映射的是同一个文件（按设备号和 inode / 文件索引判断）
+    bool isSameFile(const LogFileReader& other) const;
+
+    // 当前映射内容
+    std::string_view contents() const { return std::string_view(data_, static_cast<size_t>(size_)); }
+
+    // 总行数（会把索引补全到文件末尾）
+    size_t lineCount();
+
+    // 读取第 [first, last) 行（0-based）
+    std::vector<std::string> readLines(size_t first, size_t last);
+
+    // 从开头读取最多 maxLines 行
+    std::vector<std::string> readHead(size_t maxLines);
+
+    // 从末尾反向扫描读取最多 maxLines 行，按文件顺序返回
+    std::vector<std::string> readTail(size_t maxLines);
+
+    /**
+     * @brief 依次访问第 [first, last) 行，不复制数据
+     * @param visit 可调用对象 bool(size_t lineIndex, std::string_view line)，返回 false 时提前结束
+     * @return 是否访问完整个范围（未被 visit 中断）
+     */
+    template<typename Visitor>
+    bool forEachLine(size_t first, size_t last, Visitor&& visit);
+
+    // 第 [first, last) 行在映射中的连续区域（包含行间的换行符），范围为空时返回空视图
+    std::string_view linesView(size_t first, size_t last);
+
+    // 第 index 行的起始偏移（index 必须小于 lineCount()）
+    uint64_t lineOffset(size_t index);
+
+private:
+    static constexpr size_t kIndexStride = 64;
+    // 已索引部分末尾保留副本的字节数
+    static constexpr size_t kTailFingerprintSize = 64;
+
+    void unmap();
+    void closeFile();
+    void resetIndex();
+    void extendIndex();
+    // 已索引部分的末尾是否仍与索引时相同（调用前需确认文件不短于 indexedBytes_）
+    bool indexedTailMatches() const;
+
+    // 从 offset 开始的一行（不含换行符）
+    std::string_view lineAt(uint64_t offset) const;
+
+    // 去掉 Windows 文本模式写入的 '\r'
+    static std::string_view trimLineEnding(std::string_view line) {
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+        return line;
+    }
+
+    std::string path_;
+    const char* data_ = nullptr;
+    uint64_t size_ = 0;
+    uint64_t mappedSize_ = 0;   // 映射的长度，POSIX 上可能超过文件大小
+
+    // fromBuffer 创建的读取器持有内容，不映射文件
+    bool inMemory_ = false;
+    std::string buffer_;
+
+#if defined(CP_PLATFORM_WINDOWS)
+    void* fileHandle_ = nullptr;
+    void* mappingHandle_ = nullptr;
+#else
+    int fd_ = -1;
+#endif
+    uint64_t device_ = 0;
+    uint64_t inode_ = 0;
+
+    // checkpoints_[k] 为第 k * kIndexStride 行的起始偏移
+    std::vector<uint64_t> checkpoints_;
+    // 已索引的完整行数，以及最后一个已索引换行符之后的偏移
+    size_t completeLines_ = 0;
+    uint64_t indexedBytes_ = 0;
+    std::string indexedTail_;
+};
+
+template<typename Visitor>
+bool LogFileReader::forEachLine(size_t first, size_t last, Visitor&& visit) {
+    last = std::min(last, lineCount());
+    if (first >= last) {
+        return true;
+    }
+
+    uint64_t offset = lineOffset(first);
+    for (size_t index = first; index < last; ++index) {
+        std::string_view line = lineAt(offset);
+        offset += line.size() + 1;
+        if (!visit(index, trimLineEnding(line))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace Internal
+} // namespace CorePlatform
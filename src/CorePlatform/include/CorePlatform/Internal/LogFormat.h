@@ -0,0 +1,144 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <charconv>
+#include <concepts>
+#include <type_traits>
+#include <cstdint>
+
+namespace CorePlatform {
+namespace Internal {
+
+/**
+ * @brief 统计格式串中的占位符个数
+ *
+ * 占位符为 "{}"，"{{" 和 "}}" 分别转义为 "{" 和 "}"。
+ * @return 占位符个数；格式串非法（如未闭合的 "{"）时返回 -1
+ */
+constexpr int countLogPlaceholders(std::string_view fmt) {
+    int count = 0;
+    for (size_t i = 0; i < fmt.size(); ++i) {
+        if (fmt[i] == '{') {
+            if (i + 1 < fmt.size() && (fmt[i + 1] == '{' || fmt[i + 1] == '}')) {
+                count += fmt[i + 1] == '}' ? 1 : 0;
+                ++i;
+                continue;
+            }
+            return -1;
+        }
+        if (fmt[i] == '}') {
+            if (i + 1 < fmt.size() && fmt[i + 1] == '}') {
+                ++i;
+                continue;
+            }
+            return -1;
+        }
+    }
+    return count;
+}
+
+// 可作为日志参数的类型：算术类型、枚举、字符串、指针
+template<typename T>
+concept LogFormattable =
+    std::is_arithmetic_v<std::remove_cvref_t<T>> ||
+    std::is_enum_v<std::remove_cvref_t<T>> ||
+    std::is_convertible_v<const T&, std::string_view> ||
+    std::is_pointer_v<std::decay_t<T>> ||
+    std::is_null_pointer_v<std::remove_cvref_t<T>>;
+
+// 仅用于在常量求值中报错：该函数没有定义，也不会在运行期被调用
+void logFormatArgumentCountMismatch();
+
+/**
+ * @brief 编译期校验的日志格式串
+ *
+ * 只能由常量表达式构造，占位符个数与参数个数不一致时编译失败。
+ * 通过 LogFormat<Args...> 使用，避免参与模板参数推导。
+ */
+template<typename... Args>
+class BasicLogFormat {
+public:
+    template<typename S>
+        requires std::convertible_to<const S&, std::string_view>
+    consteval BasicLogFormat(const S& fmt) : fmt_(fmt) {
+        if (countLogPlaceholders(fmt_) != static_cast<int>(sizeof...(Args))) {
+            logFormatArgumentCountMismatch();
+        }
+    }
+
+    constexpr std::string_view get() const { return fmt_; }
+
+private:
+    std::string_view fmt_;
+};
+
+// 将单个参数追加到 out，不经过 iostream，也不产生临时字符串
+template<LogFormattable T>
+void appendLogArg(std::string& out, const T& value) {
+    using U = std::remove_cvref_t<T>;
+
+    if constexpr (std::is_same_v<U, bool>) {
+        out += value ? "true" : "false";
+    } else if constexpr (std::is_same_v<U, char>) {
+        out += value;
+    } else if constexpr (std::is_arithmetic_v<U>) {
+        char buffer[64];
+        auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        out.append(buffer, result.ptr);
+    } else if constexpr (std::is_enum_v<U>) {
+        appendLogArg(out, static_cast<std::underlying_type_t<U>>(value));
+    } else if constexpr (std::is_null_pointer_v<U>) {
+        // nullptr_t 可隐式转换为 string_view，必须先于字符串分支判断
+        out += "0x0";
+    } else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+        if constexpr (std::is_pointer_v<std::remove_cvref_t<T>>) {
+            if (value == nullptr) {
+                out += "(null)";
+                return;
+            }
+        }
+        out += std::string_view(value);
+    } else {
+        char buffer[2 + sizeof(uintptr_t) * 2];
+        auto result = std::to_chars(buffer, buffer + sizeof(buffer),
+                                    reinterpret_cast<uintptr_t>(value), 16);
+        out += "0x";
+        out.append(buffer, result.ptr);
+    }
+}
+
+// 追加 fmt[pos...] 中下一个占位符之前的字面文本（处理转义），返回占位符之后的位置
+inline size_t appendLogLiteral(std::string& out, std::string_view fmt, size_t pos) {
+    while (pos < fmt.size()) {
+        const size_t brace = fmt.find_first_of("{}", pos);
+        if (brace == std::string_view::npos) {
+            out.append(fmt.data() + pos, fmt.size() - pos);
+            return fmt.size();
+        }
+        out.append(fmt.data() + pos, brace - pos);
+        if (fmt[brace] == '{' && brace + 1 < fmt.size() && fmt[brace + 1] == '}') {
+            return brace + 2;
+        }
+        // "{{" 或 "}}"
+        out += fmt[brace];
+        pos = brace + 2;
+    }
+    return pos;
+}
+
+// 按格式串把参数依次填入占位符，结果追加到 out
+template<typename... Args>
+void formatLogMessage(std::string& out, std::string_view fmt, const Args&... args) {
+    size_t pos = 0;
+    ((pos = appendLogLiteral(out, fmt, pos), appendLogArg(out, args)), ...);
+    appendLogLiteral(out, fmt, pos);
+}
+
+} // namespace Internal
+
+// 日志格式串类型：LogFormat<int, std::string> 要求格式串恰好含两个 "{}"
+template<typename... Args>
+using LogFormat = Internal::BasicLogFormat<std::type_identity_t<Args>...>;
+
+} // namespace CorePlatform
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <cstdint>
+#include <condition_variable>
+#include "CorePlatform/Internal/PlatformDetection.h"
+
+namespace CorePlatform {
+namespace Internal {
+
+class LogFileReader;
+class LogTimeBound;
+
+/**
+ * @brief 一个已轮转的日志分段
+ *
+ * 分段文件名为 "<日志路径>.<序号>"，压缩后追加 ".gz"。序号单调递增，越大越新。
+ */
+struct LogSegment {
+    std::string path;
+    uint64_t sequence = 0;
+    bool compressed = false;
+};
+
+// 序号为 sequence 的分段路径（未压缩）
+std::string logSegmentPath(const std::string& logPath, uint64_t sequence);
+
+// 列出 logPath 的所有轮转分段，按从旧到新排列
+// 压缩过程中同一序号可能同时存在两个文件，此时取未压缩的那个（压缩完成前它一定完整）
+std::vector<LogSegment> listLogSegments(const std::string& logPath);
+
+// 当前构建是否支持压缩分段（依赖 zlib）
+bool logCompressionAvailable();
+
+// 读取并解压一个 .gz 分段的全部内容，失败时返回 false
+bool readCompressedLogSegment(const std::string& path, std::string& out);
+
+// 只解压 .gz 分段开头最多 maxBytes 字节，失败时返回 false
+bool readCompressedLogSegmentHead(const std::string& path, size_t maxBytes, std::string& out);
+
+// 进程内 readCompressedLogSegment 完整解压分段的次数（诊断和测试用）
+uint64_t compressedLogSegmentReads();
+
+// 流式解压一个 .gz 分段，只统计解压后的行数（末尾不完整的行也算一行）和字节数，不保留内容
+bool measureCompressedLogSegment(const std::string& path, size_t& lineCount, uint64_t& size);
+
+class LogSegmentCache;
+
+/**
+ * @brief 读取端的一个日志分段
+ *
+ * 活动文件和未压缩的分段直接映射读取。压缩分段只在访问其中的行时才解压，
+ * 解压出的内容登记到 LogSegmentCache，可能随时被释放；行数和解压后的大小
+ * 由一次流式解压统计并缓存，定位行号时不需要保留内容。
+ */
+class LogSegmentReader {
+public:
+    // 读取已映射的文件，file 由调用者持有
+    explicit LogSegmentReader(LogFileReader& file);
+    // 读取已轮转的分段：未压缩的立即映射，失败时抛出 std::runtime_error；压缩的此时不读取
+    LogSegmentReader(const LogSegment& segment, LogSegmentCache& cache);
+    ~LogSegmentReader();
+
+    CP_DISABLE_COPY_MOVE(LogSegmentReader);
+
+    const std::string& path() const { return path_; }
+
+    // 是否与 file 为同一个文件，压缩分段总是返回 false
+    bool isSameFile(const LogFileReader& file) const;
+
+    // 行数和字节数，压缩分段未解压时按需统计；统计失败时为 0
+    size_t lineCount();
+    uint64_t size();
+
+    // 分段的修改时间（压缩时保留原分段的时间）早于 time，即分段内所有行都早于 time；无法判断时返回 false
+    bool endsBefore(std::chrono::system_clock::time_point time) const;
+
+    // 分段中第一条带时间戳的行不早于 bound；只读取（解压）开头的少量内容，无法判断时返回 false
+    bool startsNotBefore(const LogTimeBound& bound);
+
+    // 分段内容，压缩分段在此解压，失败时返回 nullptr
+    // 返回的读取器在下一次 load() 之前有效
+    LogFileReader* load();
+
+private:
+    friend class LogSegmentCache;
+
+    // 释放解压出的内容，返回释放的字节数
+    uint64_t unload();
+
+    std::string path_;
+    LogFileReader* file_ = nullptr;
+    std::unique_ptr<LogFileReader> owned_;
+    // 仅压缩分段非空
+    LogSegmentCache* cache_ = nullptr;
+    bool measured_ = false;
+    size_t lineCount_ = 0;
+    uint64_t size_ = 0;
+};
+
+/**
+ * @brief 压缩分段解压内容的缓存
+ *
+ * 按访问先后记录已解压的分段，总字节数超过上限时释放最久未访问的分段，
+ * 刚访问的分段总是保留（单个分段可以超过上限）。
+ */
+class LogSegmentCache {
+public:
+    explicit LogSegmentCache(uint64_t capacity) : capacity_(capacity) {}
+
+    CP_DISABLE_COPY_MOVE(LogSegmentCache);
+
+    // segment 刚被解压或访问
+    void touch(LogSegmentReader& segment);
+    // segment 即将销毁
+    void remove(LogSegmentReader& segment);
+
+    // 当前缓存的解压内容总字节数
+    uint64_t usedBytes() const { return used_; }
+
+private:
+    uint64_t capacity_;
+    uint64_t used_ = 0;
+    // 最近访问的在前
+    std::list<LogSegmentReader*> recent_;
+};
+
+// now 之后的下一个本地 hour 点整（0-23，超出范围时截断），hour 为 0 即下一个本地零点
+std::chrono::system_clock::time_point nextDailyRotation(std::chrono::system_clock::time_point now, int hour);
+
+/**
+ * @brief 日志分段的后台维护线程
+ *
+ * 在低优先级线程上压缩刚轮转出的分段，并按保留个数删除最旧的分段，
+ * 写日志的线程只负责重命名和重新打开文件。析构时处理完剩余任务再退出。
+ */
+class LogMaintenanceWorker {
+public:
+    LogMaintenanceWorker();
+    ~LogMaintenanceWorker();
+
+    CP_DISABLE_COPY_MOVE(LogMaintenanceWorker);
+
+    /**
+     * @brief 提交一次轮转之后的维护任务
+     * @param logPath 活动日志路径
+     * @param segmentPath 刚轮转出的分段
+     * @param compress 是否压缩该分段
+     * @param maxFiles 保留的分段个数，0 表示不限制
+     */
+    void schedule(std::string logPath, std::string segmentPath, bool compress, size_t maxFiles);
+
+    // 等待已提交的任务全部完成
+    void waitIdle();
+
+private:
+    struct Task {
+        std::string logPath;
+        std::string segmentPath;
+        bool compress;
+        size_t maxFiles;
+    };
+
+    void run();
+
+    std::mutex mutex_;
+    std::condition_variable taskCv_;
+    std::condition_variable idleCv_;
+    std::deque<Task> tasks_;
+    bool busy_ = false;
+    bool stopping_ = false;
+    std::thread thread_;
+};
+
+} // namespace Internal
+} // namespace CorePlatform
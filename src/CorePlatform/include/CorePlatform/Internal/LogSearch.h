@@ -0,0 +1,46 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <cstddef>
+
+namespace CorePlatform {
+namespace Internal {
+
+/**
+ * @brief ASCII 大小写不敏感的子串匹配器
+ *
+ * 构造时将模式串转换为小写，查找时直接在原始数据上做向量化的大小写折叠比较，
+ * 不需要为被搜索的数据生成小写副本。
+ *
+ * 先用模式串首尾两个字符在整块数据上筛选候选位置（SSE2/AVX2/NEON，
+ * 运行时按 CPU 能力选择，不支持时回退到标量实现），再逐个校验中间部分。
+ * 只折叠 'A'-'Z'，非 ASCII 字节按原值比较。
+ */
+class CaseInsensitiveMatcher {
+public:
+    static constexpr size_t npos = std::string_view::npos;
+
+    explicit CaseInsensitiveMatcher(std::string_view pattern);
+
+    // 模式串长度
+    size_t size() const { return pattern_.size(); }
+
+    // 在 text[from...] 中查找第一处匹配的位置，未找到时返回 npos
+    // 空模式串匹配 from（from 不超过 text.size() 时）
+    size_t find(std::string_view text, size_t from = 0) const;
+
+    // 当前进程使用的实现名称（"avx2"、"sse2"、"neon" 或 "scalar"），用于诊断和测试
+    static const char* implementationName();
+
+private:
+    std::string pattern_;
+};
+
+// ASCII 小写转换，非 'A'-'Z' 的字节保持不变
+constexpr char foldAsciiCase(char ch) {
+    return (ch >= 'A' && ch <= 'Z') ? static_cast<char>(ch + ('a' - 'A')) : ch;
+}
+
+} // namespace Internal
+} // namespace CorePlatform
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <chrono>
+#include <cstddef>
+#include "CorePlatform/TimeUtils.h"
+
+namespace CorePlatform {
+namespace Internal {
+
+// 从 "[时间戳] [LEVEL] ..." 形式的行首取出时间戳，行首不是可识别的时间戳时返回空视图
+std::string_view logLineTimestamp(std::string_view line);
+
+/**
+ * @brief 按时间查找日志行时使用的比较界限
+ *
+ * 构造时把时间点按四种 TimestampFormat 各格式化一次。日志时间戳是定长、按字段从大到小排列的文本，
+ * 同一格式下字典序与时间先后一致，因此比较时只需按行内时间戳的格式选出对应文本做一次 memcmp，
+ * 不需要解析日期或调用 mktime。精度以日志文件中的时间戳为准。
+ */
+class LogTimeBound {
+public:
+    explicit LogTimeBound(std::chrono::system_clock::time_point time);
+
+    std::chrono::system_clock::time_point time() const { return time_; }
+
+    /**
+     * @brief 判断日志行的时间是否早于界限
+     * @param early 行时间早于界限时置为 true
+     * @return 行首没有可识别的时间戳时返回 false
+     */
+    bool isBefore(std::string_view line, bool& early) const;
+
+private:
+    std::chrono::system_clock::time_point time_;
+    char formatted_[4][TimeUtils::kMaxTimestampLength];
+    size_t lengths_[4];
+};
+
+/**
+ * @brief 在按时间排列的日志内容中二分查找第一条时间不早于 bound 的行
+ *
+ * 在字节偏移上二分：每次从中点对齐到下一行行首，取其后第一条带时间戳的行比较，
+ * 区间缩小到 kLinearScanBytes 以内后顺序扫描。没有时间戳的行（多行消息的续行等）不参与比较，
+ * 归属于它前面的日志行。时间戳不单调（例如系统时钟回拨）时结果只在局部有序的范围内准确。
+ * @return 行首偏移，没有这样的行时返回 contents.size()
+ */
+size_t lowerBoundByTime(std::string_view contents, const LogTimeBound& bound);
+
+// 时间在 [from, to) 内的日志行所在的连续区域（包括其中的续行），没有时返回空视图
+std::string_view sliceByTime(std::string_view contents, const LogTimeBound& from, const LogTimeBound& to);
+
+/**
+ * @brief 解析查询时输入的时间
+ *
+ * 支持 "YYYY-MM-DD HH:MM[:SS[.fraction]]"（日期和时间之间也可以用 'T'）以及只有时间的
+ * "HH:MM[:SS[.fraction]]"（取 now 所在的日期）。默认按本地时间解释，末尾带 'Z' 时按 UTC 解释。
+ * @return 格式无效时返回 false
+ */
+bool parseLogTime(std::string_view text,
+                  std::chrono::system_clock::time_point& out,
+                  std::chrono::system_clock::time_point now = std::chrono::system_clock::now());
+
+} // namespace Internal
+} // namespace CorePlatform
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <condition_variable>
+#include "CorePlatform/SharedLogRing.h"
+#include "CorePlatform/Internal/PlatformDetection.h"
+
+namespace CorePlatform {
+namespace Internal {
+
+/**
+ * @brief 共享日志环的收集线程
+ *
+ * 读取所有日志环，把记录放入按时间排序的待写列表，时间早于 (当前时间 - mergeWindow) 的记录交给 deliver。
+ * 不同进程的日志到达先后不一定与时间一致，延后写出使窗口内的日志能按时间合并。
+ * deliver 只在收集线程（或 flush() 的调用线程）上串行调用。
+ */
+class SharedLogCollector {
+public:
+    using Deliver = std::function<void(const SharedLogRecord& record)>;
+
+    SharedLogCollector(Deliver deliver, std::chrono::milliseconds mergeWindow);
+    // 停止线程并写出所有剩余的日志
+    ~SharedLogCollector();
+
+    CP_DISABLE_COPY_MOVE(SharedLogCollector);
+
+    void addRing(std::shared_ptr<SharedLogRing> ring);
+
+    // 移除前写出该日志环中剩余的日志，返回是否找到
+    bool removeRing(const std::shared_ptr<SharedLogRing>& ring);
+
+    size_t ringCount() const;
+
+    // 立即写出所有已写入日志环的日志，不等待合并窗口
+    void flush();
+
+    // 当前线程是否正在某个收集器中写出记录（deliver 内部）
+    static bool isDelivering();
+
+private:
+    void run();
+
+    // 读取所有日志环并写出到期的记录，all 为 true 时全部写出，返回本次读取的条数；调用者必须持有 mutex_
+    size_t collectUnlocked(bool all);
+
+    const Deliver deliver_;
+    const std::chrono::milliseconds mergeWindow_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable ringsCv_;
+    std::vector<std::shared_ptr<SharedLogRing>> rings_;
+    std::vector<SharedLogRecord> pending_;  // 按时间排序
+    std::vector<SharedLogRecord> incoming_;
+    std::atomic<bool> running_{true};
+    std::thread thread_;
+};
+
+} // namespace Internal
+} // namespace CorePlatform
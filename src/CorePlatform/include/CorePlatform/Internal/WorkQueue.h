@@ -0,0 +1,240 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace CorePlatform {
+namespace Internal {
+
+// 递归目录操作使用的任务队列
+// 调用线程在 run() 中参与执行；任务多于空闲线程时按需创建工作线程，最多 maxThreads 个线程（含调用线程）。
+// 任务按后进先出的顺序执行：目录树按深度优先展开，排队的任务数与树的深度和宽度成正比，而不是与总项数成正比。
+class WorkQueue {
+public:
+    using Task = std::function<void()>;
+
+    // maxThreads 为 0 时按 CPU 核数
+    explicit WorkQueue(unsigned maxThreads) {
+        if (maxThreads == 0) {
+            maxThreads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        maxThreads_ = maxThreads;
+    }
+
+    ~WorkQueue() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            finished_ = true;
+        }
+        cv_.notify_all();
+        joinThreads();
+    }
+
+    WorkQueue(const WorkQueue&) = delete;
+    WorkQueue& operator=(const WorkQueue&) = delete;
+
+    // 加入任务，可以在任务中调用
+    void push(Task task) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_.push_back(std::move(task));
+        if (idle_ > 0) {
+            cv_.notify_one();
+        } else if (running_) {
+            startThread();
+        }
+    }
+
+    // 在调用线程中执行任务，直到所有任务（包括执行期间加入的任务）完成
+    void run() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            running_ = true;
+            for (size_t i = 1; i < tasks_.size(); ++i) {
+                startThread();
+            }
+        }
+        workerLoop();
+        joinThreads();
+    }
+
+private:
+    // 调用时持有 mutex_；创建线程失败时由现有线程继续执行
+    void startThread() {
+        if (threads_.size() + 1 >= maxThreads_) {
+            return;
+        }
+        try {
+            threads_.emplace_back([this] { workerLoop(); });
+        } catch (const std::system_error&) {
+            maxThreads_ = static_cast<unsigned>(threads_.size() + 1);
+        }
+    }
+
+    void workerLoop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            if (!tasks_.empty()) {
+                Task task = std::move(tasks_.back());
+                tasks_.pop_back();
+                ++active_;
+                lock.unlock();
+                task();
+                task = nullptr;
+                lock.lock();
+                --active_;
+                continue;
+            }
+            if (finished_ || active_ == 0) {
+                // 没有排队的任务，也没有正在执行、可能加入新任务的线程
+                finished_ = true;
+                cv_.notify_all();
+                return;
+            }
+            ++idle_;
+            cv_.wait(lock);
+            --idle_;
+        }
+    }
+
+    void joinThreads() {
+        std::vector<std::thread> threads;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            threads.swap(threads_);
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+    }
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::vector<Task> tasks_;
+    std::vector<std::thread> threads_;
+    unsigned maxThreads_ = 1;
+    unsigned active_ = 0;
+    unsigned idle_ = 0;
+    bool running_ = false;
+    bool finished_ = false;
+};
+
+// 工作窃取任务池
+// 每个线程有自己的双端队列：自己加入的任务从尾部后进先出地取（深度优先，目录项还在缓存中），
+// 空闲时从其他线程队列的头部窃取最早加入的任务（通常是靠近根、最大的子树），线程之间很少竞争同一把锁。
+// 所有队列为空且没有正在执行的任务（执行中的任务可能产生新任务）时 run() 返回。
+template<typename Task>
+class WorkStealingPool {
+public:
+    // threads 为 0 时按 CPU 核数
+    explicit WorkStealingPool(unsigned threads) {
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        for (unsigned i = 0; i < threads; ++i) {
+            queues_.push_back(std::make_unique<Queue>());
+        }
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    unsigned threadCount() const { return static_cast<unsigned>(queues_.size()); }
+
+    // 加入任务；worker 为当前线程的编号（传给 handler 的编号，run() 之前用 0）
+    void push(unsigned worker, Task task) {
+        pending_.fetch_add(1, std::memory_order_relaxed);
+        Queue& queue = *queues_[worker];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+    }
+
+    // 不再开始新的任务，正在执行的任务不受影响
+    void stop() { stopped_.store(true, std::memory_order_relaxed); }
+    bool stopped() const { return stopped_.load(std::memory_order_relaxed); }
+
+    // 在调用线程（编号 0）和 threadCount() - 1 个新线程中执行任务：handler(worker, task)
+    template<typename Handler>
+    void run(Handler&& handler) {
+        auto loop = [this, &handler](unsigned worker) {
+            unsigned idleRounds = 0;
+            Task task;
+            while (!stopped()) {
+                if (popLocal(worker, task) || steal(worker, task)) {
+                    idleRounds = 0;
+                    handler(worker, task);
+                    pending_.fetch_sub(1, std::memory_order_acq_rel);
+                    continue;
+                }
+                if (pending_.load(std::memory_order_acquire) == 0) {
+                    break;
+                }
+                // 其他线程正在执行的任务可能产生新任务：先让出 CPU，仍然没有再短暂休眠
+                if (++idleRounds < 64) {
+                    std::this_thread::yield();
+                } else {
+                    std::this_thread::sleep_for(std::chrono::microseconds(100));
+                }
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (unsigned i = 1; i < threadCount(); ++i) {
+            try {
+                threads.emplace_back(loop, i);
+            } catch (const std::system_error&) {
+                break;    // 创建线程失败时由已有线程窃取全部任务
+            }
+        }
+        loop(0);
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+    }
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    bool popLocal(unsigned worker, Task& task) {
+        Queue& queue = *queues_[worker];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) {
+            return false;
+        }
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+        return true;
+    }
+
+    bool steal(unsigned worker, Task& task) {
+        const size_t count = queues_.size();
+        for (size_t i = 1; i < count; ++i) {
+            Queue& queue = *queues_[(worker + i) % count];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (!queue.tasks.empty()) {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::atomic<size_t> pending_{0};    // 已加入但尚未执行完的任务数
+    std::atomic<bool> stopped_{false};
+};
+
+} // namespace Internal
+} // namespace CorePlatform
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <span>
+#include <concepts>
+#include <type_traits>
+#include <cstdint>
+
+namespace CorePlatform {
+
+// 结构化日志字段的值类型
+enum class LogFieldType : uint8_t {
+    Bool,
+    Int,
+    UInt,
+    Double,
+    String
+};
+
+// 可作为字段值的类型：bool、整数（char 除外）、浮点数、枚举、字符串
+template<typename T>
+concept LogFieldValue =
+    (std::is_arithmetic_v<std::remove_cvref_t<T>> && !std::is_same_v<std::remove_cvref_t<T>, char>) ||
+    std::is_enum_v<std::remove_cvref_t<T>> ||
+    (std::is_convertible_v<const T&, std::string_view> && !std::is_null_pointer_v<std::remove_cvref_t<T>>);
+
+/**
+ * @brief 结构化日志的一个字段
+ *
+ * 只引用调用者的键和字符串值，不复制数据，因此只能在记录日志的表达式中临时构造：
+ *   logger.logFields(LogLevel::INFO, "request done", {{"status", 200}, {"path", path}, {"ms", 12.5}});
+ * 枚举按底层整数记录，空的 C 字符串指针记录为 "(null)"。
+ */
+struct LogField {
+    std::string_view key;
+    LogFieldType type = LogFieldType::String;
+    union {
+        bool boolValue;
+        int64_t intValue;
+        uint64_t uintValue;
+        double doubleValue;
+    };
+    std::string_view stringValue;
+
+    template<typename T>
+        requires LogFieldValue<T>
+    LogField(std::string_view fieldKey, const T& value) : key(fieldKey), uintValue(0) {
+        using U = std::remove_cvref_t<T>;
+        if constexpr (std::is_same_v<U, bool>) {
+            type = LogFieldType::Bool;
+            boolValue = value;
+        } else if constexpr (std::is_enum_v<U>) {
+            type = LogFieldType::Int;
+            intValue = static_cast<int64_t>(value);
+        } else if constexpr (std::is_floating_point_v<U>) {
+            type = LogFieldType::Double;
+            doubleValue = static_cast<double>(value);
+        } else if constexpr (std::is_integral_v<U> && std::is_signed_v<U>) {
+            type = LogFieldType::Int;
+            intValue = static_cast<int64_t>(value);
+        } else if constexpr (std::is_integral_v<U>) {
+            type = LogFieldType::UInt;
+            uintValue = static_cast<uint64_t>(value);
+        } else {
+            if constexpr (std::is_pointer_v<std::remove_cvref_t<T>>) {
+                if (value == nullptr) {
+                    stringValue = "(null)";
+                    return;
+                }
+            }
+            stringValue = std::string_view(value);
+        }
+    }
+};
+
+namespace Internal {
+
+// 以 " key=value" 的形式追加字段（logfmt 风格），含空白、'=' 或引号的字符串值加引号并转义
+void appendLogFieldsText(std::string& out, std::span<const LogField> fields);
+
+// 追加带引号的 JSON 字符串：转义引号、反斜杠和控制字符，非法的 UTF-8 字节替换为 U+FFFD
+void appendJsonString(std::string& out, std::string_view text);
+
+// 追加字段值的 JSON 形式，NaN 和无穷大写为 null
+void appendJsonFieldValue(std::string& out, const LogField& field);
+
+/**
+ * @brief 持有一组字段的副本（异步输出排队时使用）
+ *
+ * 所有键和字符串值依次存放在同一块缓冲区中；对象移动后缓冲区地址可能变化（短字符串优化），
+ * 因此 view() 每次按长度重新指向缓冲区。
+ */
+class LogFieldStorage {
+public:
+    void assign(std::span<const LogField> fields);
+    bool empty() const { return fields_.empty(); }
+    std::span<const LogField> view();
+
+private:
+    std::vector<LogField> fields_;
+    std::string text_;
+};
+
+} // namespace Internal
+
+} // namespace CorePlatform
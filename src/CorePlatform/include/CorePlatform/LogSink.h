@@ -0,0 +1,308 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <condition_variable>
+#include "CorePlatform/Export.h"
+#include "CorePlatform/TimeUtils.h"
+#include "CorePlatform/LogFields.h"
+#include "CorePlatform/Internal/PlatformDetection.h"
+
+namespace CorePlatform {
+
+enum class LogLevel {
+    TRACE,
+    DEBUG,
+    INFO,
+    WARN,
+    ERR,
+    FATAL
+};
+
+// 异步模式下队列已满时的处理策略
+enum class LogOverflowPolicy {
+    Block,      // 阻塞调用线程，直到队列出现空位
+    Drop,       // 丢弃新到达的日志
+    DropOldest  // 丢弃队列中最旧的日志，为新日志腾出空间
+};
+
+// 日志级别名称（"TRACE" ... "FATAL"）
+CORE_PLATFORM_API const char* logLevelName(LogLevel level);
+
+// 解析级别名称（大小写不敏感，另接受 WARNING 和 ERR），无法识别时返回 false
+CORE_PLATFORM_API bool parseLogLevel(std::string_view text, LogLevel& level);
+
+// 交给输出格式化的一条日志，message 和 fields 只在格式化期间有效
+struct LogEntry {
+    LogLevel level = LogLevel::INFO;
+    std::chrono::system_clock::time_point time;
+    std::string_view message;
+    std::span<const LogField> fields;  // 结构化日志的字段，普通日志为空
+};
+
+// 日志格式化函数：将 entry 追加到 out（不含换行）
+using LogFormatter = std::function<void(std::string& out, const LogEntry& entry)>;
+
+// 单个日志输出的配置
+struct LogSinkOptions {
+    LogLevel level = LogLevel::TRACE;          // 输出自身的级别过滤，在 Logger 的全局级别之后生效
+    bool asynchronous = false;                 // 使用独立的队列和后台线程写出，慢速输出不拖慢调用线程和其他输出
+    size_t queueCapacity = 8192;               // 异步队列容量，向上取整为 2 的幂
+    LogOverflowPolicy overflowPolicy = LogOverflowPolicy::Block;
+    size_t bufferSize = 64 * 1024;             // 输出缓冲区字节数，超过后立即写出（文件和控制台输出使用）
+    std::chrono::milliseconds flushInterval{0};  // 刷新间隔，0 表示每次写入（异步时为每批）后立即刷新；同步输出只在写入时检查间隔
+    LogLevel flushLevel = LogLevel::ERR;       // 达到此级别的日志总是立即刷新
+    TimestampFormat timestampFormat = TimestampFormat::LocalMillis;  // 默认格式化使用的时间戳格式
+};
+
+/**
+ * @brief 日志输出的基类
+ *
+ * 负责级别过滤、格式化、异步排队和按节奏刷新，派生类只需实现 write()（以及需要时的 flushOutput()）；
+ * 需要未格式化的原始日志的输出改为覆盖 writeEntry()。
+ * writeEntry()、write() 和 flushOutput() 总是在持有内部写锁的情况下被调用，派生类无需自行同步。
+ *
+ * 异步输出的后台线程会调用虚函数，派生类必须在析构函数中先调用 stop()。
+ */
+class CORE_PLATFORM_API LogSink {
+public:
+    explicit LogSink(const LogSinkOptions& options = LogSinkOptions());
+    virtual ~LogSink();
+
+    CP_DISABLE_COPY_MOVE(LogSink);
+
+    // 输出自身的级别过滤
+    void setLevel(LogLevel level);
+    LogLevel getLevel() const;
+    bool shouldLog(LogLevel level) const {
+        return level >= level_.load(std::memory_order_relaxed);
+    }
+
+    // 设置格式化函数，传入空函数恢复默认格式
+    void setFormatter(LogFormatter formatter);
+
+    const LogSinkOptions& options() const { return options_; }
+
+    // 提交一条日志（由 Logger 调用，也可直接使用）；级别被过滤时直接返回
+    // 异步输出排队时复制消息和字段
+    void log(LogLevel level, std::chrono::system_clock::time_point time, std::string_view message,
+             std::span<const LogField> fields = {});
+
+    // 写出已提交的日志并刷新输出
+    void flush();
+
+    // 异步队列已满或输出端无法接收而被丢弃的日志条数
+    uint64_t getDroppedCount() const;
+
+protected:
+    // 写出一条日志，默认按格式化函数格式化后交给 write()
+    virtual void writeEntry(const LogEntry& entry);
+    
+    // 写出一条格式化后的日志（不含换行）
+    virtual void write(LogLevel, std::string_view) {}
+
+    // 将缓冲的内容真正写出
+    virtual void flushOutput() {}
+
+    // 记录一条在 write() 中无法送达而被丢弃的日志，计入 getDroppedCount()
+    void countDropped() { writeDropped_.fetch_add(1, std::memory_order_relaxed); }
+
+    // 未设置格式化函数时使用的格式，默认为 "[时间] [级别] 消息 key=value ..."
+    virtual void formatDefault(std::string& out, const LogEntry& entry) const;
+
+    // 写完队列中剩余的日志并停止后台线程，之后提交的日志同步写出
+    void stop();
+
+private:
+    struct Record {
+        LogLevel level = LogLevel::INFO;
+        std::chrono::system_clock::time_point time;
+        std::string message;
+        Internal::LogFieldStorage fields;
+    };
+    class Queue;
+
+    // 格式化并写出一条日志，调用者必须持有 writeMutex_
+    void writeUnlocked(LogLevel level, std::chrono::system_clock::time_point time, std::string_view message,
+                       std::span<const LogField> fields);
+    // 按刷新节奏决定是否刷新，调用者必须持有 writeMutex_
+    void maybeFlushUnlocked(LogLevel maxLevel, std::chrono::steady_clock::time_point now);
+    // 写出异步队列取出的一批日志
+    void writeBatch(std::vector<Record>& batch);
+    // 异步队列空闲时按刷新间隔写出缓冲的内容，返回距下次到期的时间
+    std::chrono::steady_clock::duration flushIfDue();
+
+    const LogSinkOptions options_;
+    std::atomic<LogLevel> level_;
+
+    std::mutex writeMutex_;
+    LogFormatter formatter_;
+    std::string formatBuffer_;
+    bool pendingFlush_ = false;
+    std::chrono::steady_clock::time_point lastFlush_;
+    std::atomic<uint64_t> writeDropped_{0};
+
+    // 异步队列和后台线程，同步输出为空
+    std::unique_ptr<Queue> queue_;
+};
+
+/**
+ * @brief 控制台输出
+ *
+ * 日志先追加到自身的缓冲区，刷新时一次写入 stdout/stderr，终端较慢时建议配合 asynchronous 使用。
+ */
+class CORE_PLATFORM_API ConsoleSink : public LogSink {
+public:
+    enum class Stream { Stdout, Stderr };
+
+    explicit ConsoleSink(const LogSinkOptions& options = LogSinkOptions(),
+                         Stream stream = Stream::Stdout,
+                         bool colored = true);
+    ~ConsoleSink() override;
+
+protected:
+    void write(LogLevel level, std::string_view formatted) override;
+    void flushOutput() override;
+
+private:
+    const Stream stream_;
+    const bool colored_;
+    std::string buffer_;
+};
+
+/**
+ * @brief 文件输出（追加写入，不参与轮转）
+ *
+ * 需要轮转和读取/搜索时使用 Logger::setLogFile。
+ */
+class CORE_PLATFORM_API FileSink : public LogSink {
+public:
+    explicit FileSink(const std::string& path, const LogSinkOptions& options = LogSinkOptions());
+    ~FileSink() override;
+
+    bool isOpen() const { return open_; }
+    const std::string& path() const { return path_; }
+
+protected:
+    void write(LogLevel level, std::string_view formatted) override;
+    void flushOutput() override;
+
+private:
+    const std::string path_;
+    std::ofstream file_;
+    bool open_ = false;
+    std::string buffer_;
+};
+
+/**
+ * @brief JSON Lines 文件输出：每条日志写成一行 JSON 对象，供日志采集程序直接解析
+ *
+ * 格式为 {"time":"...","level":"INFO","msg":"...",字段...}，字段按调用时的顺序写在后面，
+ * 不检查与固定键是否重名。时间总是 ISO 8601 UTC（微秒），不使用 timestampFormat。
+ * 直接拼接到输出缓冲区，不构造 JSON 对象；字符串按 JSON 规则转义，非法 UTF-8 字节替换为 U+FFFD。
+ */
+class CORE_PLATFORM_API JsonLinesSink : public FileSink {
+public:
+    explicit JsonLinesSink(const std::string& path, const LogSinkOptions& options = LogSinkOptions());
+    ~JsonLinesSink() override;
+
+protected:
+    void formatDefault(std::string& out, const LogEntry& entry) const override;
+};
+
+// 把一条日志格式化为 JsonLinesSink 使用的单行 JSON，可作为其他输出的格式化函数（例如输出到 stdout）
+CORE_PLATFORM_API void formatLogEntryJson(std::string& out, const LogEntry& entry);
+
+/**
+ * @brief 内存环形输出，保留最近的 capacity 条格式化日志
+ *
+ * 适合在界面或诊断接口中展示最近的日志，超过容量时覆盖最旧的条目。
+ */
+class CORE_PLATFORM_API MemoryRingSink : public LogSink {
+public:
+    explicit MemoryRingSink(size_t capacity, const LogSinkOptions& options = LogSinkOptions());
+    ~MemoryRingSink() override;
+
+    // 按从旧到新的顺序返回当前保留的日志
+    std::vector<std::string> snapshot() const;
+
+    // 清空已保留的日志
+    void clear();
+
+    size_t capacity() const { return capacity_; }
+
+protected:
+    void write(LogLevel level, std::string_view formatted) override;
+
+private:
+    const size_t capacity_;
+    mutable std::mutex ringMutex_;
+    std::vector<std::string> entries_;
+    size_t next_ = 0;  // 容量已满时下一条覆盖的位置
+};
+
+/**
+ * @brief 本机 syslog / journald 输出，通过 Unix 数据报套接字发送
+ *
+ * Syslog 协议发送 "<优先级>标识[进程号]: 消息"，时间由 syslog 守护进程补充；
+ * Journald 协议使用 journald 原生格式，包含 PRIORITY、SYSLOG_IDENTIFIER 和 MESSAGE 字段。
+ * 默认格式只包含消息本身。Windows 上不可用（isOpen() 返回 false，日志被忽略）。
+ *
+ * 发送不阻塞：守护进程来不及接收（接收缓冲区已满）时日志被丢弃并计入 getDroppedCount()。
+ * Journald 数据报超过套接字大小上限时，在 Linux 上改为写入密封的 memfd 并通过 SCM_RIGHTS 传递，
+ * 与 sd_journal_send 的做法一致；仍然失败的日志同样计入丢弃数。
+ */
+class CORE_PLATFORM_API SyslogSink : public LogSink {
+public:
+    enum class Protocol { Syslog, Journald };
+
+    struct Config {
+        std::string ident;                 // 程序标识，为空时使用进程名
+        Protocol protocol = Protocol::Syslog;
+        int facility = 1;                  // syslog facility，默认 LOG_USER
+        std::string socketPath;            // 为空时 Syslog 使用 /dev/log，Journald 使用 /run/systemd/journal/socket
+    };
+
+    explicit SyslogSink(const Config& config, const LogSinkOptions& options = LogSinkOptions());
+    ~SyslogSink() override;
+
+    bool isOpen() const;
+
+protected:
+    void write(LogLevel level, std::string_view formatted) override;
+    void formatDefault(std::string& out, const LogEntry& entry) const override;
+
+private:
+    // 连接套接字，调用者必须持有写锁（构造期间除外）
+    bool connectSocket();
+    // 连接断开时重新连接，失败后按指数退避推迟下次尝试；调用者必须持有写锁
+    bool reconnect();
+    void closeSocket();
+    // 数据报过长时通过 memfd 传递 journald 日志，成功返回 true
+    bool sendJournaldMemfd(int fd);
+
+    const Config config_;
+    std::string socketPath_;
+    std::string ident_;  // 已解析的程序标识
+    long pid_ = 0;
+    std::atomic<int> socket_{-1};
+    std::string datagram_;
+    std::chrono::steady_clock::time_point nextReconnect_;  // 此前不再尝试连接，退避期间的日志被丢弃
+    std::chrono::steady_clock::duration reconnectDelay_{};  // 下次连接失败后的退避时间，连接成功时清零
+};
+
+namespace Internal {
+// 日志级别对应的 ANSI 颜色码
+const char* consoleColorCode(LogLevel level);
+}
+
+} // namespace CorePlatform
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "CorePlatform/Export.h"
+#include "CorePlatform/LogSink.h"
+
+namespace CorePlatform {
+
+/**
+ * @brief 限流日志调用点的公共部分：记录被抑制的条数
+ *
+ * 调用点对象由 CP_LOG_RATE_LIMITED / CP_LOG_EVERY_N 宏以静态变量形式创建，状态全部为原子变量。
+ * 第一次发生抑制时调用点登记到进程级链表，Logger::flush() 借此补报尚未报告的抑制条数。
+ * 析构时从链表摘除，插件卸载后不会留下悬空的调用点。
+ */
+class CORE_PLATFORM_API LogThrottleSite {
+public:
+    // 已登记调用点尚未报告的抑制条数快照，文件名已拷贝
+    struct Suppressed {
+        std::string file;
+        int line;
+        LogLevel level;
+        uint64_t count;
+    };
+
+
+    const char* file() const { return file_; }
+    int line() const { return line_; }
+    LogLevel level() const { return level_; }
+
+    // 取出并清零尚未报告的抑制条数
+    uint64_t takeSuppressed() {
+        if (suppressed_.load(std::memory_order_relaxed) == 0) return 0;
+        return suppressed_.exchange(0, std::memory_order_relaxed);
+    }
+
+    // 累计被抑制的条数
+    uint64_t getTotalSuppressed() const { return total_.load(std::memory_order_relaxed); }
+
+    // 取出并清零所有已登记调用点尚未报告的抑制条数，与析构摘除持同一把锁
+    static std::vector<Suppressed> takeAllSuppressed();
+
+    LogThrottleSite(const LogThrottleSite&) = delete;
+    LogThrottleSite& operator=(const LogThrottleSite&) = delete;
+
+protected:
+    LogThrottleSite(const char* file, int line, LogLevel level);
+    ~LogThrottleSite();
+
+    void recordSuppressed() {
+        suppressed_.fetch_add(1, std::memory_order_relaxed);
+        total_.fetch_add(1, std::memory_order_relaxed);
+        if (!registered_.load(std::memory_order_relaxed) &&
+            !registered_.exchange(true, std::memory_order_relaxed)) {
+            registerSite();
+        }
+    }
+
+private:
+    struct Registry;
+    static Registry& registry();
+    void registerSite();
+
+    const char* const file_;
+    const int line_;
+    const LogLevel level_;
+    std::atomic<uint64_t> suppressed_{0};
+    std::atomic<uint64_t> total_{0};
+    std::atomic<bool> registered_{false};
+    // 侵入式双向链表，由 Registry::mutex 保护
+    LogThrottleSite* prev_ = nullptr;
+    LogThrottleSite* next_ = nullptr;
+};
+
+/**
+ * @brief 令牌桶限流（GCRA 实现）
+ *
+ * 平均每秒放行 ratePerSecond 条，最多连续放行 burst 条。
+ * 桶状态只有一个原子时间戳，放行判断为一次 CAS。
+ */
+class CORE_PLATFORM_API LogRateLimiter : public LogThrottleSite {
+public:
+    LogRateLimiter(const char* file, int line, LogLevel level, double ratePerSecond, uint32_t burst);
+
+    // 按当前时间判断是否放行，不放行时计入抑制条数
+    bool tryAcquire() {
+        return tryAcquire(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    // 以指定的单调时间（纳秒）判断是否放行
+    bool tryAcquire(int64_t nowNs) {
+        int64_t tat = theoreticalArrival_.load(std::memory_order_relaxed);
+        for (;;) {
+            const int64_t next = (tat > nowNs ? tat : nowNs) + intervalNs_;
+            if (next - nowNs > toleranceNs_) {
+                recordSuppressed();
+                return false;
+            }
+            if (theoreticalArrival_.compare_exchange_weak(tat, next, std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+    }
+
+private:
+    const int64_t intervalNs_;
+    const int64_t toleranceNs_;
+    std::atomic<int64_t> theoreticalArrival_{INT64_MIN / 2};
+};
+
+/**
+ * @brief 1/N 采样：每 N 条放行第一条
+ */
+class CORE_PLATFORM_API LogSampler : public LogThrottleSite {
+public:
+    LogSampler(const char* file, int line, LogLevel level, uint32_t everyN)
+        : LogThrottleSite(file, line, level), everyN_(everyN > 0 ? everyN : 1) {}
+
+    bool tryAcquire() {
+        if (count_.fetch_add(1, std::memory_order_relaxed) % everyN_ == 0) {
+            return true;
+        }
+        recordSuppressed();
+        return false;
+    }
+
+private:
+    const uint64_t everyN_;
+    std::atomic<uint64_t> count_{0};
+};
+
+} // namespace CorePlatform
@@ -5,42 +5,218 @@
 #include <mutex>
 #include <vector>
 #include <memory>
+#include <map>
 #include <atomic>
+#include <cstdint>
 #include <chrono>
 #include <iomanip>
 #include <sstream>
 #include <algorithm>
 #include <filesystem>
+#include <string_view>
+#include <span>
+#include <initializer_list>
+#include <shared_mutex>
 #include "CorePlatform/Export.h"
+#include "CorePlatform/LogSink.h"
+#include "CorePlatform/LogThrottle.h"
+#include "CorePlatform/FlightRecorder.h"
+#include "CorePlatform/SharedLogRing.h"
+#include "CorePlatform/TimeUtils.h"
+#include "CorePlatform/Internal/LogFormat.h"
+#include "CorePlatform/Internal/BinaryLog.h"
 
 namespace CorePlatform {
 
-enum class LogLevel {
-    TRACE,
-    DEBUG,
-    INFO,
-    WARN,
-    ERR,
-    FATAL
+namespace Internal {
+class LogFileReader;
+class LogSegmentReader;
+class LogSegmentCache;
+class LogMaintenanceWorker;
+class SharedLogCollector;
+}
+
+// 日志文件格式
+enum class LogFileFormat {
+    Text,   // "[时间] [级别] 消息" 文本行
+    Binary  // 延迟格式化的二进制记录，需用解码工具（cplogdecode）还原为文本
+};
+
+/**
+ * @brief 日志文件轮转策略
+ *
+ * 满足任一条件时，当前文件被重命名为 "<路径>.<序号>"（序号递增，越大越新），
+ * 随后在原路径上重新创建文件。压缩和清理旧分段在低优先级的后台线程中进行。
+ */
+struct LogRotationPolicy {
+    uint64_t maxFileSize = 0;  // 单个文件的最大字节数，0 表示不按大小轮转
+    bool daily = false;        // 每天本地 dailyHour 点后第一次写入时轮转
+    int dailyHour = 0;         // 按天轮转的本地时刻（0-23），默认零点
+    size_t maxFiles = 0;       // 保留的轮转分段个数，0 表示全部保留
+    bool compress = false;     // 将轮转分段压缩为 .gz（构建不支持 zlib 时忽略）
 };
 
+// 日志搜索结果中的一处匹配
+struct LogMatch {
+    size_t lineNumber = 0;  // 匹配所在行号（1-based）
+    uint64_t offset = 0;    // 匹配在日志内容中的字节偏移（轮转分段在前，当前文件在后，视为连续内容）
+    size_t length = 0;      // 匹配的字节数
+    size_t termIndex = 0;   // 多关键词搜索时命中的关键词下标，其余情况为 0
+};
+
+class NamedLogger;
+
 class CORE_PLATFORM_API Logger {
 public:
     // 获取单例实例
     static Logger& getInstance();
     
-    // 设置日志级别
+    // 设置日志级别（根级别，未单独配置的模块日志器继承此级别）
     void setLevel(LogLevel level);
     
+    // 获取根日志级别
+    LogLevel getLevel() const;
+    
+    /**
+     * @brief 获取指定名称的模块日志器（不存在时创建）
+     *
+     * 名称以 '.' 分隔层级，例如 "plugin.ExamplePlugin" 的父级为 "plugin"。
+     * 返回的引用在进程生命周期内有效，可缓存在静态变量中反复使用。
+     */
+    NamedLogger& getLogger(const std::string& name);
+    
+    /**
+     * @brief 从配置文件加载日志级别，可在运行时重复调用
+     *
+     * 只识别以下键，其余内容（包括 '#'、';' 注释和 [节] 标题）被忽略：
+     *   log.level = INFO                       根级别
+     *   log.level.<模块名> = DEBUG              模块级别，子模块未配置时继承
+     *   log.flight_recorder = TRACE            以该级别启用飞行记录器（默认选项），OFF 为停用；
+     *                                          未出现时不改变飞行记录器，级别未变时保留其中的记录
+     * 加载时先清除所有模块上已有的级别设置，再应用文件中的配置；
+     * 任何一行无效时不做任何修改并返回 false。
+     * @param error 失败时的错误描述
+     */
+    bool loadLevelConfig(const std::string& path, std::string* error = nullptr);
+    
     // 启用/禁用控制台输出
     void setConsoleOutput(bool enable);
     
-    // 设置日志文件路径
-    bool setLogFile(const std::string& path);
+    // 设置日志时间戳格式（默认本地时间，精确到毫秒）
+    void setTimestampFormat(TimestampFormat format);
+    
+    /**
+     * @brief 设置日志文件路径
+     * @param format 文件格式。Binary 格式下调用线程只记录格式串 ID 和参数原始字节，
+     *               由后台线程写入文件；该格式不参与轮转，读取和搜索接口也不覆盖它
+     */
+    bool setLogFile(const std::string& path, LogFileFormat format = LogFileFormat::Text);
+    
+    // 设置日志轮转策略，对当前及之后设置的日志文件生效
+    void setRotationPolicy(const LogRotationPolicy& policy);
+    
+    // 获取当前的日志轮转策略
+    LogRotationPolicy getRotationPolicy() const;
+    
+    // 当前日志文件已轮转出的分段路径，按从旧到新排列
+    std::vector<std::string> getRotatedLogFiles() const;
+    
+    // 启用/禁用异步模式：调用线程只负责入队，由后台线程批量写入控制台和文件
+    // queueCapacity 会向上取整为 2 的幂；禁用时会先写完队列中剩余的日志
+    void setAsyncMode(bool enable,
+                      size_t queueCapacity = 8192,
+                      LogOverflowPolicy policy = LogOverflowPolicy::Block);
+    
+    // 是否处于异步模式
+    bool isAsyncMode() const;
+    
+    // 异步模式下因队列已满而被丢弃的日志条数
+    uint64_t getDroppedCount() const;
+    
+    // 判断指定级别是否会被记录（一次 relaxed 原子读），包括只进入飞行记录器的级别
+    bool isEnabled(LogLevel level) const {
+        return level >= enabledLevel_.load(std::memory_order_relaxed);
+    }
+    
+    /**
+     * @brief 添加一个日志输出，与控制台和日志文件同时生效
+     *
+     * 每个输出有独立的级别过滤、格式、缓冲和刷新节奏；异步输出各自排队写出，
+     * 慢速输出不会拖慢其他输出。Logger 的全局级别（setLevel）先于输出自身的级别生效。
+     */
+    void addSink(std::shared_ptr<LogSink> sink);
+    
+    // 移除一个日志输出，返回是否找到；移除前会刷新该输出
+    bool removeSink(const std::shared_ptr<LogSink>& sink);
+    
+    // 移除所有通过 addSink 添加的输出
+    void clearSinks();
+    
+    // 当前添加的所有输出
+    std::vector<std::shared_ptr<LogSink>> getSinks() const;
+    
+    /**
+     * @brief 启用飞行记录器：每个线程在内存中保留最近的日志，崩溃或 FATAL 时导出
+     *
+     * 记录级别可以低于 setLevel 的级别，例如磁盘只写 INFO 而内存中保留 TRACE；
+     * 低于 setLevel 级别的日志只进入飞行记录器，不写入其他输出。
+     * 重复调用时以新的配置替换原有的记录器（原有记录不保留）；每线程条数相同时复用其缓冲区。
+     */
+    void enableFlightRecorder(const FlightRecorderOptions& options = FlightRecorderOptions());
+    
+    // 停用飞行记录器，崩溃时不再导出
+    void disableFlightRecorder();
+    
+    // 是否已启用飞行记录器
+    bool isFlightRecorderEnabled() const;
+    
+    // 导出飞行记录器中的日志，时间戳格式与 setTimestampFormat 一致
+    // path 为空时使用配置的导出路径；未启用或写入失败时返回 false
+    bool dumpFlightRecorder(const std::string& path = "") const;
+    
+    /**
+     * @brief 收集共享日志环中其他进程写入的日志
+     *
+     * 后台线程读取所有已添加的日志环，按时间戳合并后以原始时间写入本进程的输出，
+     * 消息以 "[pid 进程号] " 开头。为等待稍晚到达的其他进程的日志，写出会延后 kSharedLogMergeWindow；
+     * flush() 会立即写出所有已读到的日志。
+     */
+    void attachSharedLogRing(std::shared_ptr<SharedLogRing> ring);
+    
+    // 停止收集一个日志环，返回是否找到；移除前写出其中剩余的日志
+    bool detachSharedLogRing(const std::shared_ptr<SharedLogRing>& ring);
+    
+    // 合并多个日志环时等待迟到日志的时间
+    static constexpr std::chrono::milliseconds kSharedLogMergeWindow{20};
+    
+    /**
+     * @brief 以指定的时间记录一条日志（例如从其他进程收集的日志）
+     *
+     * 按根级别过滤后写入控制台、日志文件和添加的输出，不进入飞行记录器；
+     * 二进制日志文件记录的是写入时的时间。
+     */
+    void logAt(LogLevel level, std::chrono::system_clock::time_point time, const std::string& message);
     
     // 日志记录接口
     void log(LogLevel level, const std::string& message);
     
+    // 格式化日志接口："{}" 为占位符，占位符个数在编译期校验
+    // 消息在线程局部缓冲区中拼接，级别被过滤时不做任何格式化
+    template<typename... Args>
+    void log(LogLevel level, LogFormat<Args...> fmt, const Args&... args);
+    
+    /**
+     * @brief 结构化日志：消息加若干类型化字段
+     *
+     * 通过 addSink 添加的输出收到原始消息和字段（JsonLinesSink 写成一行 JSON）；
+     * 控制台、日志文件、飞行记录器等文本输出写入 "消息 key=value ..."。
+     * 字段只在调用期间被引用，级别被过滤时不做任何格式化。
+     */
+    void logFields(LogLevel level, std::string_view message, std::span<const LogField> fields);
+    void logFields(LogLevel level, std::string_view message, std::initializer_list<LogField> fields) {
+        logFields(level, message, std::span<const LogField>(fields.begin(), fields.size()));
+    }
+    
     // 便捷方法
     void trace(const std::string& message);
     void debug(const std::string& message);
@@ -49,18 +225,77 @@ public:
     void error(const std::string& message);
     void fatal(const std::string& message);
     
-    // 日志读取功能增强
+    // 格式化便捷方法
+    template<typename... Args>
+    void trace(LogFormat<Args...> fmt, const Args&... args) { log<>(LogLevel::TRACE, fmt, args...); }
+    template<typename... Args>
+    void debug(LogFormat<Args...> fmt, const Args&... args) { log<>(LogLevel::DEBUG, fmt, args...); }
+    template<typename... Args>
+    void info(LogFormat<Args...> fmt, const Args&... args)  { log<>(LogLevel::INFO, fmt, args...);  }
+    template<typename... Args>
+    void warn(LogFormat<Args...> fmt, const Args&... args)  { log<>(LogLevel::WARN, fmt, args...);  }
+    template<typename... Args>
+    void error(LogFormat<Args...> fmt, const Args&... args) { log<>(LogLevel::ERR, fmt, args...);   }
+    template<typename... Args>
+    void fatal(LogFormat<Args...> fmt, const Args&... args) { log<>(LogLevel::FATAL, fmt, args...); }
+    
+    // 日志读取功能增强：读取范围覆盖所有轮转分段和当前文件，行号连续编号
+    // 未设置文本日志文件时返回空；日志文件不存在或已被删除时抛出 std::runtime_error
     std::vector<std::string> readAllLogs() const;
     std::vector<std::string> readLogsFromBeginning(int maxLines) const;
     std::vector<std::string> readLogsFromEnd(int maxLines) const;
     std::vector<std::string> readLogsInRange(int startLine, int endLine) const;
     
-    // 日志内容搜索
+    /**
+     * @brief 读取时间在 [from, to) 内的日志行，覆盖所有轮转分段和当前文件
+     *
+     * 在内存映射的文件内容上按行首时间戳二分查找起止位置，不逐行扫描整个文件。
+     * 没有时间戳的续行随其前面的日志行一起返回。日志应按时间顺序写入。
+     * @param maxLines 最多返回的行数，0 表示不限制
+     */
+    std::vector<std::string> readLogsInTimeRange(std::chrono::system_clock::time_point from,
+                                                 std::chrono::system_clock::time_point to,
+                                                 size_t maxLines = 0) const;
+    
+    // 日志内容搜索（ASCII 大小写不敏感）
     bool containsInLogs(const std::string& searchText, 
                        int startLine = 0, 
                        int endLine = -1) const;
+    
+    /**
+     * @brief 大小写不敏感地搜索关键词的所有出现位置
+     *
+     * 直接在内存映射的文件内容上流式查找，不逐行复制或转换大小写。
+     * 行号范围的含义与 readLogsInRange 相同；同一关键词的匹配互不重叠。
+     * @param maxMatches 最多返回的匹配数，0 表示不限制
+     * @return 按文件偏移排序的匹配列表
+     */
+    std::vector<LogMatch> searchLogs(const std::string& searchText,
+                                     int startLine = 0,
+                                     int endLine = -1,
+                                     size_t maxMatches = 0) const;
+    
+    // 同时搜索多个关键词，结果按文件偏移合并排序，termIndex 为命中的关键词下标
+    std::vector<LogMatch> searchLogsAny(const std::vector<std::string>& terms,
+                                        int startLine = 0,
+                                        int endLine = -1,
+                                        size_t maxMatches = 0) const;
+    
+    // 按 ECMAScript 正则表达式（大小写不敏感）逐行搜索
+    // 正则表达式非法时抛出 std::regex_error
+    std::vector<LogMatch> searchLogsRegex(const std::string& pattern,
+                                          int startLine = 0,
+                                          int endLine = -1,
+                                          size_t maxMatches = 0) const;
 
-    // 刷新缓冲区
+    // 输出限流调用点尚未报告的抑制条数："suppressed N messages from 文件:行号"
+    // 限流宏在放行一条日志之前自动调用
+    void reportSuppressed(LogThrottleSite& site);
+    
+    // 补报所有限流调用点尚未报告的抑制条数（flush() 时自动调用）
+    void reportSuppressed();
+    
+    // 刷新缓冲区（异步模式下会等待队列中已提交的日志全部写出）
     void flush();
 
     // 获取当前日志路径
@@ -71,9 +306,14 @@ public:
     Logger& operator=(const Logger&) = delete;
 
 private:
+    friend class NamedLogger;
+    
     Logger();
     ~Logger();
     
+    // 异步写入后端（实现见 Logger.cpp）
+    class AsyncWriter;
+    
     // 获取当前时间字符串
     std::string getCurrentTime() const;
     
@@ -86,18 +326,355 @@ private:
     // 重置控制台颜色
     void resetConsoleColor() const;
     
+    // 输出一条 "suppressed N messages from 文件:行号" 摘要
+    void reportSuppressed(std::string_view file, int line, LogLevel level, uint64_t count);
+    
+    // 结构化日志交给添加的输出的部分：原始消息（文本消息的前缀）和字段
+    struct StructuredParts {
+        std::string_view message;
+        std::span<const LogField> fields;
+    };
+    
+    // 分发一条已通过级别过滤的日志：二进制文件输出在前，文本输出交给 dispatchText
+    // outputs 为 false 时日志只进入飞行记录器；structured 非空时 message 是附加了字段的文本
+    void dispatch(LogLevel level, const std::string& message, bool outputs,
+                  const StructuredParts* structured = nullptr);
+    
+    // 输出文本日志：先写入飞行记录器，再交给 writeText
+    void dispatchText(LogLevel level, const std::string& message, bool outputs,
+                      const StructuredParts* structured = nullptr);
+    
+    // 以指定时间写出文本日志：先交给添加的输出，再按当前模式（同步/异步）写入控制台和日志文件
+    void writeText(LogLevel level, std::chrono::system_clock::time_point time, const std::string& message,
+                   const StructuredParts* structured = nullptr);
+    
+    // 将日志交给所有添加的输出，结构化日志交出原始消息和字段
+    void dispatchSinks(LogLevel level, std::chrono::system_clock::time_point time, const std::string& message,
+                       const StructuredParts* structured);
+    
+    // 二进制模式下是否仍需要文本消息（控制台或添加的输出）
+    bool needsText() const {
+        return consoleOutput_.load(std::memory_order_relaxed) ||
+               hasSinks_.load(std::memory_order_relaxed) ||
+               flightRecorder_.load(std::memory_order_relaxed) != nullptr;
+    }
+    
+    // 控制台或文本日志文件是否需要文本消息
+    bool needsBuiltinText() const {
+        return consoleOutput_.load(std::memory_order_relaxed) ||
+               textFileOpen_.load(std::memory_order_relaxed);
+    }
+    
+    // 根级别是否允许写入飞行记录器以外的输出
+    bool outputsEnabled(LogLevel level) const {
+        return level >= currentLevel_.load(std::memory_order_relaxed);
+    }
+    
+    // 按根级别和飞行记录器级别重新计算 enabledLevel_，调用者必须持有 namedMutex_
+    void refreshEnabledLevelUnlocked();
+    
     // 内部日志实现
-    void logInternal(LogLevel level, const std::string& message);
+    void logInternal(LogLevel level, std::chrono::system_clock::time_point time, const std::string& message);
+    
+    // 当前线程复用的消息格式化缓冲区
+    static std::string& formatBuffer();
     
-    // 内部读取日志文件
-    std::vector<std::string> readLogFileUnlocked() const;
+    // 写出格式化缓冲区中的消息，并在缓冲区过大时释放内存
+    // includeBinary 为 false 时调用者已自行写入二进制输出
+    void logFormatted(LogLevel level, std::string& buffer, bool outputs, bool includeBinary = false,
+                      const StructuredParts* structured = nullptr);
+    
+    // 按根级别和各模块的设置重新计算模块日志器的生效级别，调用者必须持有 namedMutex_
+    void refreshNamedLevelsUnlocked();
+    
+    // 将一条日志格式化为 "[时间] [级别] 消息"，追加到 out
+    void formatEntry(std::string& out,
+                     LogLevel level,
+                     std::chrono::system_clock::time_point time,
+                     const std::string& message) const;
+    
+    // 以追加方式打开日志文件，调用者必须持有 logMutex_
+    bool openLogStreamUnlocked(const std::string& path);
+    
+    // 写入日志文件，按轮转策略在行边界处切分并轮转，调用者必须持有 logMutex_
+    void writeFileUnlocked(std::string_view data, std::chrono::system_clock::time_point time);
+    
+    // 将当前文件重命名为新的分段并重新打开，调用者必须持有 logMutex_
+    void rotateFileUnlocked();
+    
+    // 当前文件下一次按天轮转的时刻，调用者必须持有 logMutex_
+    std::chrono::system_clock::time_point nextDailyRotationUnlocked() const;
+    
+    // 获取按时间顺序排列的所有分段读取器（轮转分段在前，当前文件在后）
+    // 压缩分段此时不解压，未设置日志文件时返回空列表，调用者必须持有 readerMutex_
+    std::vector<Internal::LogSegmentReader*> acquireSegmentsUnlocked() const;
     
     // 成员变量
     std::atomic<LogLevel> currentLevel_;
+    // 调用点的级别门槛：根级别与飞行记录器级别中较低者
+    std::atomic<LogLevel> enabledLevel_;
     std::atomic<bool> consoleOutput_;
+    std::atomic<TimestampFormat> timestampFormat_;
     std::unique_ptr<std::ofstream> fileStream_;
+    // fileStream_ 是否已打开，供不持锁的快速判断（由 logMutex_ 保护写入）
+    std::atomic<bool> textFileOpen_{false};
     mutable std::mutex logMutex_;
+    // 内置控制台输出独立加锁，不与文件写入串行
+    std::mutex consoleMutex_;
     std::string logFilePath_;
+    
+    // 轮转状态（由 logMutex_ 保护）
+    LogRotationPolicy rotationPolicy_;
+    uint64_t currentFileSize_ = 0;
+    uint64_t nextSegmentSequence_ = 1;
+    std::chrono::system_clock::time_point nextDailyRotation_;
+    std::unique_ptr<Internal::LogMaintenanceWorker> maintenance_;
+    
+    // 读取端独立加锁，读取大文件时不阻塞日志写入
+    mutable std::mutex readerMutex_;
+    std::unique_ptr<Internal::LogFileReader> reader_;
+    std::unique_ptr<Internal::LogSegmentReader> activeSegment_;
+    // 压缩分段解压出的内容按最近访问淘汰，须在 segmentReaders_ 之后销毁
+    std::unique_ptr<Internal::LogSegmentCache> segmentCache_;
+    // 轮转分段内容不再变化，读取器按路径缓存
+    mutable std::vector<std::unique_ptr<Internal::LogSegmentReader>> segmentReaders_;
+    
+    // 异步模式状态：asyncWriter_ 非空即处于异步模式
+    std::atomic<AsyncWriter*> asyncWriter_;
+    // 已停用的写入器只停止线程不释放，避免与仍持有旧指针的生产者竞争
+    std::vector<std::unique_ptr<AsyncWriter>> asyncWriters_;
+    mutable std::mutex asyncConfigMutex_;
+    
+    // 二进制文件输出：binarySink_ 非空即处于二进制模式
+    std::atomic<Internal::BinaryLogSink*> binarySink_{nullptr};
+    // 与异步写入器相同，停用的输出只停止不释放，再次启用时重新打开复用（由 logMutex_ 保护）
+    std::unique_ptr<Internal::BinaryLogSink> binarySinkStorage_;
+    
+    // 通过 addSink 添加的输出；hasSinks_ 使未添加输出时的分发只需一次原子读
+    mutable std::shared_mutex sinksMutex_;
+    std::vector<std::shared_ptr<LogSink>> sinks_;
+    std::atomic<bool> hasSinks_{false};
+    
+    // 飞行记录器：flightRecorder_ 非空即已启用；与异步写入器相同，停用的记录器不释放，按每线程条数复用
+    std::atomic<FlightRecorder*> flightRecorder_{nullptr};
+    std::atomic<bool> flightDumpOnFatal_{false};
+    mutable std::mutex flightMutex_;
+    std::string flightDumpPath_;
+    std::vector<std::unique_ptr<FlightRecorder>> flightRecorders_;
+    
+    // 共享日志环的收集线程，添加第一个日志环时创建；flush() 持有副本，不在锁内等待收集线程
+    mutable std::mutex sharedLogMutex_;
+    std::shared_ptr<Internal::SharedLogCollector> sharedLogCollector_;
+    
+    // 模块日志器：创建后不再释放，按名称排序保证父级先于子级
+    mutable std::mutex namedMutex_;
+    std::map<std::string, std::unique_ptr<NamedLogger>> namedLoggers_;
+};
+
+/**
+ * @brief 模块日志器
+ *
+ * 通过 Logger::getLogger 获取。消息以 "[模块名] " 开头，与其他日志写入相同的输出。
+ * 未单独设置级别时继承父模块（最终为 Logger 的根级别），级别判断只需一次 relaxed 原子读，
+ * 因此可以只为某个模块打开 DEBUG 而不影响其他模块。
+ */
+class CORE_PLATFORM_API NamedLogger {
+public:
+    const std::string& name() const { return name_; }
+    
+    // 父模块，顶层模块返回 nullptr
+    NamedLogger* parent() const { return parent_; }
+    
+    // 判断指定级别是否会被记录（一次 relaxed 原子读），包括只进入飞行记录器的级别
+    bool isEnabled(LogLevel level) const {
+        return level >= enabledLevel_.load(std::memory_order_relaxed);
+    }
+    
+    // 为本模块设置级别，未单独设置的子模块随之改变
+    void setLevel(LogLevel level);
+    
+    // 清除本模块的级别设置，恢复继承父模块
+    void resetLevel();
+    
+    // 本模块单独设置的级别，未设置时返回 false
+    bool getExplicitLevel(LogLevel& level) const;
+    
+    // 当前生效的级别
+    LogLevel getEffectiveLevel() const {
+        return effectiveLevel_.load(std::memory_order_relaxed);
+    }
+    
+    void log(LogLevel level, const std::string& message);
+    
+    template<typename... Args>
+    void log(LogLevel level, LogFormat<Args...> fmt, const Args&... args);
+    
+    // 结构化日志，消息同样以 "[模块名] " 开头
+    void logFields(LogLevel level, std::string_view message, std::span<const LogField> fields);
+    void logFields(LogLevel level, std::string_view message, std::initializer_list<LogField> fields) {
+        logFields(level, message, std::span<const LogField>(fields.begin(), fields.size()));
+    }
+    
+    template<typename... Args>
+    void trace(LogFormat<Args...> fmt, const Args&... args) { log<>(LogLevel::TRACE, fmt, args...); }
+    template<typename... Args>
+    void debug(LogFormat<Args...> fmt, const Args&... args) { log<>(LogLevel::DEBUG, fmt, args...); }
+    template<typename... Args>
+    void info(LogFormat<Args...> fmt, const Args&... args)  { log<>(LogLevel::INFO, fmt, args...);  }
+    template<typename... Args>
+    void warn(LogFormat<Args...> fmt, const Args&... args)  { log<>(LogLevel::WARN, fmt, args...);  }
+    template<typename... Args>
+    void error(LogFormat<Args...> fmt, const Args&... args) { log<>(LogLevel::ERR, fmt, args...);   }
+    template<typename... Args>
+    void fatal(LogFormat<Args...> fmt, const Args&... args) { log<>(LogLevel::FATAL, fmt, args...); }
+    
+    NamedLogger(const NamedLogger&) = delete;
+    NamedLogger& operator=(const NamedLogger&) = delete;
+
+private:
+    friend class Logger;
+    
+    NamedLogger(Logger& owner, std::string name, NamedLogger* parent, LogLevel level);
+    
+    // 在缓冲区开头写入 "[模块名] "
+    void appendPrefix(std::string& buffer) const;
+    
+    Logger& owner_;
+    const std::string name_;
+    NamedLogger* const parent_;
+    std::atomic<LogLevel> effectiveLevel_;
+    // 调用点的级别门槛：生效级别与飞行记录器级别中较低者
+    std::atomic<LogLevel> enabledLevel_;
+    // 单独设置的级别（由 Logger::namedMutex_ 保护）
+    bool hasExplicitLevel_ = false;
+    LogLevel explicitLevel_ = LogLevel::INFO;
 };
 
-}
\ No newline at end of file
+// ====================== 模板函数实现 ======================
+
+template<typename... Args>
+void Logger::log(LogLevel level, LogFormat<Args...> fmt, const Args&... args) {
+    if (!isEnabled(level)) return;
+    const bool outputs = outputsEnabled(level);
+    
+    // 二进制输出不做格式化；只有同时输出到控制台、添加的输出或飞行记录器时才需要文本
+    if (Internal::BinaryLogSink* sink = binarySink_.load(std::memory_order_acquire); sink && outputs) {
+        sink->write(static_cast<uint8_t>(level), fmt.get(), args...);
+        if (level == LogLevel::FATAL) flush();
+        if (!needsText()) return;
+    }
+    
+    std::string& buffer = formatBuffer();
+    buffer.clear();
+    Internal::formatLogMessage(buffer, fmt.get(), args...);
+    logFormatted(level, buffer, outputs);
+}
+
+template<typename... Args>
+void NamedLogger::log(LogLevel level, LogFormat<Args...> fmt, const Args&... args) {
+    if (!isEnabled(level)) return;
+    
+    // 模块日志需要带上模块名，二进制输出同样记录格式化后的文本
+    std::string& buffer = Logger::formatBuffer();
+    buffer.clear();
+    appendPrefix(buffer);
+    Internal::formatLogMessage(buffer, fmt.get(), args...);
+    owner_.logFormatted(level, buffer, level >= getEffectiveLevel(), true);
+}
+
+} // namespace CorePlatform
+
+/**
+ * 日志宏：级别被过滤时不会对参数求值，关闭的 TRACE/DEBUG 只需一次原子读
+ *
+ * 示例:
+ *   CP_LOG_DEBUG("cache hit {} / {}", hits, total);
+ *
+ * 使用 log<>() 强制选择格式化重载，使无参数的格式串同样经过编译期校验
+ */
+#define CP_LOG(level, ...)                                                  \
+    do {                                                                    \
+        static ::CorePlatform::Logger& cpLogger_ =                          \
+            ::CorePlatform::Logger::getInstance();                          \
+        if (cpLogger_.isEnabled(level)) {                                   \
+            cpLogger_.log<>(level, __VA_ARGS__);                            \
+        }                                                                   \
+    } while (0)
+
+/**
+ * 结构化日志宏：级别被过滤时不会对字段求值
+ *
+ * 示例:
+ *   CP_LOG_FIELDS(LogLevel::INFO, "request done", {"status", status}, {"path", path});
+ */
+#define CP_LOG_FIELDS(level, message, ...)                                  \
+    do {                                                                    \
+        static ::CorePlatform::Logger& cpLogger_ =                          \
+            ::CorePlatform::Logger::getInstance();                          \
+        if (cpLogger_.isEnabled(level)) {                                   \
+            cpLogger_.logFields(level, message, {__VA_ARGS__});             \
+        }                                                                   \
+    } while (0)
+
+#define CP_LOG_TRACE(...) CP_LOG(::CorePlatform::LogLevel::TRACE, __VA_ARGS__)
+#define CP_LOG_DEBUG(...) CP_LOG(::CorePlatform::LogLevel::DEBUG, __VA_ARGS__)
+#define CP_LOG_INFO(...)  CP_LOG(::CorePlatform::LogLevel::INFO,  __VA_ARGS__)
+#define CP_LOG_WARN(...)  CP_LOG(::CorePlatform::LogLevel::WARN,  __VA_ARGS__)
+#define CP_LOG_ERROR(...) CP_LOG(::CorePlatform::LogLevel::ERR,   __VA_ARGS__)
+#define CP_LOG_FATAL(...) CP_LOG(::CorePlatform::LogLevel::FATAL, __VA_ARGS__)
+
+/**
+ * 限流日志宏：每个调用点独立限流，状态为调用点上的静态原子变量
+ * 被抑制的日志不做格式化；下一条被放行的日志之前（以及 flush() 时）输出一条
+ * "suppressed N messages from 文件:行号" 摘要
+ *
+ * 示例:
+ *   CP_LOG_RATE_LIMITED(LogLevel::ERR, 10, 20, "read failed: {}", err);  // 每秒 10 条，突发 20 条
+ *   CP_LOG_EVERY_N(LogLevel::WARN, 1000, "queue full, size {}", size);    // 每 1000 条记录 1 条
+ */
+#define CP_LOG_THROTTLED_(site, level, ...)                                 \
+    do {                                                                    \
+        static ::CorePlatform::Logger& cpLogger_ =                          \
+            ::CorePlatform::Logger::getInstance();                          \
+        if (cpLogger_.isEnabled(level) && site.tryAcquire()) {              \
+            cpLogger_.reportSuppressed(site);                               \
+            cpLogger_.log<>(level, __VA_ARGS__);                            \
+        }                                                                   \
+    } while (0)
+
+#define CP_LOG_RATE_LIMITED(level, ratePerSecond, burst, ...)               \
+    do {                                                                    \
+        static ::CorePlatform::LogRateLimiter cpRateLimiter_(               \
+            __FILE__, __LINE__, level, ratePerSecond, burst);               \
+        CP_LOG_THROTTLED_(cpRateLimiter_, level, __VA_ARGS__);              \
+    } while (0)
+
+#define CP_LOG_EVERY_N(level, n, ...)                                       \
+    do {                                                                    \
+        static ::CorePlatform::LogSampler cpSampler_(                       \
+            __FILE__, __LINE__, level, n);                                  \
+        CP_LOG_THROTTLED_(cpSampler_, level, __VA_ARGS__);                  \
+    } while (0)
+
+/**
+ * 模块日志宏：模块日志器在第一次执行时查找并缓存，之后的级别判断只需一次原子读
+ * module 必须是常量（每个调用点只查找一次）
+ *
+ * 示例:
+ *   CP_MODULE_LOG_DEBUG("plugin.ExamplePlugin", "loaded {} symbols", count);
+ */
+#define CP_MODULE_LOG(module, level, ...)                                   \
+    do {                                                                    \
+        static ::CorePlatform::NamedLogger& cpModuleLogger_ =               \
+            ::CorePlatform::Logger::getInstance().getLogger(module);        \
+        if (cpModuleLogger_.isEnabled(level)) {                             \
+            cpModuleLogger_.log<>(level, __VA_ARGS__);                      \
+        }                                                                   \
+    } while (0)
+
+#define CP_MODULE_LOG_TRACE(module, ...) CP_MODULE_LOG(module, ::CorePlatform::LogLevel::TRACE, __VA_ARGS__)
+#define CP_MODULE_LOG_DEBUG(module, ...) CP_MODULE_LOG(module, ::CorePlatform::LogLevel::DEBUG, __VA_ARGS__)
+#define CP_MODULE_LOG_INFO(module, ...)  CP_MODULE_LOG(module, ::CorePlatform::LogLevel::INFO,  __VA_ARGS__)
+#define CP_MODULE_LOG_WARN(module, ...)  CP_MODULE_LOG(module, ::CorePlatform::LogLevel::WARN,  __VA_ARGS__)
+#define CP_MODULE_LOG_ERROR(module, ...) CP_MODULE_LOG(module, ::CorePlatform::LogLevel::ERR,   __VA_ARGS__)
+#define CP_MODULE_LOG_FATAL(module, ...) CP_MODULE_LOG(module, ::CorePlatform::LogLevel::FATAL, __VA_ARGS__)
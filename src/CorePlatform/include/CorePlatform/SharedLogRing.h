@@ -0,0 +1,151 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <cstdint>
+#include <utility>
+#include "CorePlatform/Export.h"
+#include "CorePlatform/LogSink.h"
+#include "CorePlatform/Internal/PlatformDetection.h"
+
+namespace CorePlatform {
+
+// 从共享日志环读出的一条记录
+struct SharedLogRecord {
+    LogLevel level = LogLevel::INFO;
+    std::chrono::system_clock::time_point time;
+    int64_t processId = 0;
+    uint32_t threadId = 0;
+    std::string message;
+};
+
+/**
+ * @brief 跨进程的共享内存日志环
+ *
+ * 父进程创建日志环，通过环境变量把句柄交给子进程或进程外插件；各进程直接把日志写入共享内存，
+ * 不经过管道复制。日志环是固定槽位的多生产者队列（每个槽位带序号），写入只需一次 CAS，
+ * 队列已满时丢弃新日志而不阻塞写入进程。读取端空闲时在 futex 上等待，写入后按需唤醒。
+ *
+ * Linux 上匿名日志环使用 memfd（句柄 "fd:<进程号>:<描述符>"，子进程经 /proc 重新打开），
+ * 命名日志环使用 POSIX 共享内存（句柄 "shm:<名称>"）；没有 futex 的平台以短间隔轮询代替等待。
+ *
+ * 写入进程在写入中途退出（或长时间停滞）时，读取端在 kStalledSlotTimeout 后跳过该槽位，下一圈写入该槽位的
+ * 记录作废一次；停滞的写入者在这一圈内恢复不会覆盖其他记录，冲突的记录计入丢弃条数。
+ * 超过 kMaxMessageSize 的消息被截断。
+ */
+class CORE_PLATFORM_API SharedLogRing {
+public:
+    static constexpr size_t kMaxMessageSize = 456;
+    static constexpr std::chrono::milliseconds kStalledSlotTimeout{1000};
+    // 子进程查找日志环句柄使用的环境变量
+    static constexpr const char* kEnvironmentVariable = "CP_SHARED_LOG_RING";
+
+    /**
+     * @brief 创建日志环
+     * @param capacity 槽位个数，向上取整为 2 的幂
+     * @param name 为空时创建匿名日志环，否则创建同名的命名日志环（已存在时失败）
+     * @param error 失败时的错误描述
+     * @return 失败时返回 nullptr
+     */
+    static std::unique_ptr<SharedLogRing> create(size_t capacity,
+                                                 const std::string& name = "",
+                                                 std::string* error = nullptr);
+
+    // 按句柄打开其他进程创建的日志环，失败时返回 nullptr
+    static std::unique_ptr<SharedLogRing> attach(const std::string& handle, std::string* error = nullptr);
+
+    // 按 kEnvironmentVariable 中的句柄打开日志环，未设置或失败时返回 nullptr
+    static std::unique_ptr<SharedLogRing> attachFromEnvironment(std::string* error = nullptr);
+
+    ~SharedLogRing();
+
+    CP_DISABLE_COPY_MOVE(SharedLogRing);
+
+    // 供其他进程打开的句柄
+    const std::string& handle() const { return handle_; }
+
+    // 传给 Process::Start / Process::Execute 的环境变量
+    std::pair<std::string, std::string> environmentEntry() const {
+        return {kEnvironmentVariable, handle_};
+    }
+
+    size_t capacity() const { return capacity_; }
+
+    // 写入一条日志，队列已满时丢弃并返回 false
+    bool write(LogLevel level, std::chrono::system_clock::time_point time, std::string_view message);
+
+    // 按写入顺序取出最多 maxRecords 条日志追加到 out，返回取出的条数（只允许一个读取者）
+    size_t drain(std::vector<SharedLogRecord>& out, size_t maxRecords = SIZE_MAX);
+
+    // 等待新日志，已有未读日志时立即返回 true，超时返回 false
+    bool waitForData(std::chrono::milliseconds timeout);
+
+    // 等待任一日志环出现新日志，Linux 上在所有日志环的 futex 上同时等待（futex_waitv），
+    // 已有未读日志时立即返回 true，超时返回 false
+    static bool waitForAny(const std::vector<std::shared_ptr<SharedLogRing>>& rings,
+                           std::chrono::milliseconds timeout);
+
+    // 唤醒正在 waitForData / waitForAny 中等待的读取者
+    void wakeReader();
+
+    // 因队列已满（以及写入进程中途退出）而丢弃的日志条数，所有写入进程共同累计
+    uint64_t getDroppedCount() const;
+
+private:
+    struct Header;
+    struct Slot;
+
+    SharedLogRing() = default;
+
+    // 初始化或校验已映射的共享内存，失败时返回 false
+    bool initialize(bool creator, std::string* error);
+    Slot& slotAt(uint64_t position) const;
+    // 是否有已占用但尚未读出的槽位
+    bool hasUnread() const;
+
+    Header* header_ = nullptr;
+    unsigned char* slots_ = nullptr;
+    size_t capacity_ = 0;
+    size_t mappedSize_ = 0;
+    std::string handle_;
+    std::string shmName_;          // 创建者负责删除的命名共享内存
+#if defined(CP_PLATFORM_WINDOWS)
+    void* mapping_ = nullptr;
+#else
+    int fd_ = -1;
+#endif
+    // 读取端状态：等待写入进程发布的槽位及开始等待的时间
+    uint64_t stalledPosition_ = UINT64_MAX;
+    std::chrono::steady_clock::time_point stalledSince_;
+};
+
+/**
+ * @brief 把日志写入共享日志环的输出，在子进程或进程外插件中使用
+ *
+ * 示例（子进程）:
+ *   if (auto ring = SharedLogRing::attachFromEnvironment()) {
+ *       Logger::getInstance().addSink(std::make_shared<SharedLogRingSink>(std::move(ring)));
+ *   }
+ *
+ * 写入的是未格式化的消息和原始时间，由父进程按自身的格式输出。
+ */
+class CORE_PLATFORM_API SharedLogRingSink : public LogSink {
+public:
+    explicit SharedLogRingSink(std::shared_ptr<SharedLogRing> ring,
+                               const LogSinkOptions& options = LogSinkOptions());
+    ~SharedLogRingSink() override;
+
+    const std::shared_ptr<SharedLogRing>& ring() const { return ring_; }
+
+protected:
+    void writeEntry(const LogEntry& entry) override;
+
+private:
+    const std::shared_ptr<SharedLogRing> ring_;
+    std::string buffer_;
+};
+
+} // namespace CorePlatform
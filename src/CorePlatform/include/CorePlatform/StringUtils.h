@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <cstdint>
 #include <optional>
@@ -89,6 +90,15 @@ public:
      */
     static bool endsWith(const std::string& str, const std::string& suffix);
     
+    /**
+     * 按 glob 模式匹配整个字符串（大小写敏感）
+     * 支持 *（任意个字符）、?（单个字符）、[abc]、[a-z]、[!a-z]（或 [^a-z]）和 \ 转义
+     * @param pattern glob 模式，例如 "*.log"、"core.[0-9]*"
+     * @param text 要匹配的字符串
+     * @return 整个字符串匹配时返回 true
+     */
+    static bool matchGlob(std::string_view pattern, std::string_view text);
+    
     /**
      * 分割字符串
      * @param str 源字符串
@@ -8,8 +8,19 @@
 
 namespace CorePlatform {
 
+// 时间戳格式
+enum class TimestampFormat {
+    LocalMillis,        // "YYYY-MM-DD HH:MM:SS.mmm"（本地时间）
+    LocalMicros,        // "YYYY-MM-DD HH:MM:SS.uuuuuu"（本地时间）
+    UtcIso8601Millis,   // "YYYY-MM-DDTHH:MM:SS.mmmZ"（UTC）
+    UtcIso8601Micros    // "YYYY-MM-DDTHH:MM:SS.uuuuuuZ"（UTC）
+};
+
 class CORE_PLATFORM_API TimeUtils {
 public:
+    // formatTimestamp 输出缓冲区所需的最小长度（含结尾 '\0'）
+    static constexpr size_t kMaxTimestampLength = 32;
+
     /**
      * 精确休眠等待指定毫秒数
      * @param milliseconds 要等待的毫秒数
@@ -72,6 +83,29 @@ public:
      */
     static std::string currentDateTimeMillis();
     
+    /**
+     * 将时间点格式化到调用者提供的缓冲区
+     * 
+     * 每个线程按秒缓存 "YYYY-MM-DD HH:MM:SS" 前缀，同一秒内只改写小数部分，
+     * 不调用 localtime/strftime，也不分配内存。
+     * @param buffer 输出缓冲区，长度至少为 kMaxTimestampLength
+     * @param time 要格式化的时间点
+     * @param format 时间戳格式
+     * @return 写入的字符数（不含结尾 '\0'）
+     */
+    static size_t formatTimestamp(char* buffer,
+                                  std::chrono::system_clock::time_point time,
+                                  TimestampFormat format = TimestampFormat::LocalMillis);
+    
+    /**
+     * 将时间点格式化为字符串
+     * @param time 要格式化的时间点
+     * @param format 时间戳格式
+     * @return 格式化后的时间戳
+     */
+    static std::string formatTimestamp(std::chrono::system_clock::time_point time,
+                                       TimestampFormat format = TimestampFormat::LocalMillis);
+    
     /**
      * 测量代码块的执行时间
      * @tparam Func 可调用对象类型
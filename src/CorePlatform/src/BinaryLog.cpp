@@ -0,0 +1,633 @@
+#include "CorePlatform/Internal/BinaryLog.h"
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <tuple>
+#include <unordered_map>
+
+namespace CorePlatform {
+namespace Internal {
+
+namespace {
+
+constexpr uint8_t kDictionaryFrame = 1;
+constexpr uint8_t kDataFrame = 2;
+
+// 超过暂存缓冲区容量的记录直接写成独立的数据帧
+constexpr uint32_t kOversizedStreamId = 0xFFFFFFFFu;
+
+std::atomic<uint64_t> nextSinkId{1};
+
+// 后台线程空闲时的最长睡眠，用于兜底错过的唤醒
+constexpr auto kIdleWait = std::chrono::milliseconds(100);
+
+struct FormatEntry {
+    std::string format;
+    std::vector<BinaryArgType> types;
+};
+
+/**
+ * 进程级格式串字典：同一格式串（按地址、长度和参数类型区分）只登记一次，
+ * ID 即在字典中的下标，所有输出共享，因此切换文件后新文件会从头写出字典
+ */
+class FormatRegistry {
+public:
+    static FormatRegistry& instance() {
+        static FormatRegistry registry;
+        return registry;
+    }
+
+    uint32_t idFor(std::string_view fmt, const BinaryArgType* types, size_t count) {
+        const Key key{fmt.data(), fmt.size(), types};
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = ids_.find(key);
+        if (it != ids_.end()) {
+            return it->second;
+        }
+        const uint32_t id = static_cast<uint32_t>(entries_.size());
+        entries_.push_back(FormatEntry{std::string(fmt), std::vector<BinaryArgType>(types, types + count)});
+        ids_.emplace(key, id);
+        return id;
+    }
+
+    size_t size() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return entries_.size();
+    }
+
+    FormatEntry entry(size_t id) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return entries_[id];
+    }
+
+private:
+    using Key = std::tuple<const char*, size_t, const BinaryArgType*>;
+
+    std::mutex mutex_;
+    std::deque<FormatEntry> entries_;
+    std::map<Key, uint32_t> ids_;
+};
+
+struct LocalFormatKey {
+    const char* data;
+    size_t size;
+    const BinaryArgType* types;
+
+    bool operator==(const LocalFormatKey& other) const {
+        return data == other.data && size == other.size && types == other.types;
+    }
+};
+
+struct LocalFormatKeyHash {
+    size_t operator()(const LocalFormatKey& key) const {
+        const size_t a = std::hash<const void*>()(key.data);
+        const size_t b = std::hash<const void*>()(key.types);
+        return a ^ (b + 0x9e3779b97f4a7c15ULL + (a << 6) + (a >> 2)) ^ key.size;
+    }
+};
+
+// 与 Logger::getLevelString 保持一致
+const char* levelName(uint8_t level) {
+    static const char* const names[] = {"TRACE", "DEBUG", "INFO", "WARN", "ERROR", "FATAL"};
+    return level < sizeof(names) / sizeof(names[0]) ? names[level] : "UNKNOWN";
+}
+
+template<typename T>
+void appendRaw(std::string& out, const T& value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+// 顺序读取内存中的二进制数据，越界时置 ok 为 false
+class ByteReader {
+public:
+    ByteReader(const char* data, size_t size) : data_(data), size_(size) {}
+
+    template<typename T>
+    T read() {
+        T value{};
+        if (size_ - pos_ < sizeof(T)) {
+            ok_ = false;
+            pos_ = size_;
+            return value;
+        }
+        std::memcpy(&value, data_ + pos_, sizeof(T));
+        pos_ += sizeof(T);
+        return value;
+    }
+
+    std::string_view readBytes(size_t count) {
+        if (size_ - pos_ < count) {
+            ok_ = false;
+            pos_ = size_;
+            return std::string_view();
+        }
+        std::string_view bytes(data_ + pos_, count);
+        pos_ += count;
+        return bytes;
+    }
+
+    bool ok() const { return ok_; }
+    bool atEnd() const { return pos_ >= size_; }
+
+private:
+    const char* data_;
+    size_t size_;
+    size_t pos_ = 0;
+    bool ok_ = true;
+};
+
+// 按参数类型解码一个参数，并用与 appendLogArg 相同的规则追加到 out
+void decodeArg(ByteReader& reader, BinaryArgType type, std::string& out) {
+    switch (type) {
+        case BinaryArgType::Bool:       appendLogArg(out, reader.read<bool>()); break;
+        case BinaryArgType::Char:       appendLogArg(out, reader.read<char>()); break;
+        case BinaryArgType::Int8:       appendLogArg(out, reader.read<int8_t>()); break;
+        case BinaryArgType::UInt8:      appendLogArg(out, reader.read<uint8_t>()); break;
+        case BinaryArgType::Int16:      appendLogArg(out, reader.read<int16_t>()); break;
+        case BinaryArgType::UInt16:     appendLogArg(out, reader.read<uint16_t>()); break;
+        case BinaryArgType::Int32:      appendLogArg(out, reader.read<int32_t>()); break;
+        case BinaryArgType::UInt32:     appendLogArg(out, reader.read<uint32_t>()); break;
+        case BinaryArgType::Int64:      appendLogArg(out, reader.read<int64_t>()); break;
+        case BinaryArgType::UInt64:     appendLogArg(out, reader.read<uint64_t>()); break;
+        case BinaryArgType::Float:      appendLogArg(out, reader.read<float>()); break;
+        case BinaryArgType::Double:     appendLogArg(out, reader.read<double>()); break;
+        case BinaryArgType::LongDouble: appendLogArg(out, reader.read<long double>()); break;
+        case BinaryArgType::Null:       appendLogArg(out, nullptr); break;
+        case BinaryArgType::Pointer:
+            appendLogArg(out, reinterpret_cast<const void*>(reader.read<uintptr_t>()));
+            break;
+        case BinaryArgType::String: {
+            const uint32_t length = reader.read<uint32_t>();
+            if (length == kBinaryNullString) {
+                appendLogArg(out, static_cast<const char*>(nullptr));
+            } else {
+                appendLogArg(out, reader.readBytes(length));
+            }
+            break;
+        }
+        default:
+            reader.readBytes(SIZE_MAX);
+            break;
+    }
+}
+
+} // 匿名命名空间
+
+// ================ StagingBuffer ================
+
+// 单生产者（所属线程）单消费者（后台写线程）的字节环形缓冲区
+class BinaryLogSink::StagingBuffer {
+public:
+    explicit StagingBuffer(uint32_t streamId)
+        : streamId_(streamId), data_(new char[kStagingCapacity]) {}
+
+    uint32_t streamId() const { return streamId_; }
+
+    // 生产者：预留连续空间
+    char* tryReserve(size_t size) {
+        const uint64_t head = head_.load(std::memory_order_relaxed);
+        if (!hasRoom(head, size)) {
+            return nullptr;
+        }
+        const size_t pos = static_cast<size_t>(head & kMask);
+        if (pos + size > kStagingCapacity) {
+            return nullptr;
+        }
+        return data_.get() + pos;
+    }
+
+    void commit(size_t size) {
+        head_.store(head_.load(std::memory_order_relaxed) + size, std::memory_order_release);
+    }
+
+    // 生产者：写入可能跨越缓冲区末尾的记录，空间不足时返回 false
+    bool tryWrite(const char* data, size_t size) {
+        const uint64_t head = head_.load(std::memory_order_relaxed);
+        if (!hasRoom(head, size)) {
+            return false;
+        }
+        const size_t pos = static_cast<size_t>(head & kMask);
+        const size_t first = std::min(size, kStagingCapacity - pos);
+        std::memcpy(data_.get() + pos, data, first);
+        std::memcpy(data_.get(), data + first, size - first);
+        head_.store(head + size, std::memory_order_release);
+        return true;
+    }
+
+    // 消费者：当前已提交的位置
+    uint64_t committed() const { return head_.load(std::memory_order_acquire); }
+
+    // 消费者：把 [tail, head) 交给 write(first, firstSize, second, secondSize)
+    template<typename Writer>
+    bool consume(uint64_t head, Writer&& write) {
+        const uint64_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail == head) {
+            return false;
+        }
+        const size_t pos = static_cast<size_t>(tail & kMask);
+        const size_t length = static_cast<size_t>(head - tail);
+        const size_t first = std::min(length, kStagingCapacity - pos);
+        write(data_.get() + pos, first, data_.get(), length - first);
+        tail_.store(head, std::memory_order_release);
+        return true;
+    }
+
+    bool empty() const {
+        return tail_.load(std::memory_order_acquire) == head_.load(std::memory_order_acquire);
+    }
+
+    std::atomic<bool> retired{false};
+
+private:
+    static constexpr uint64_t kMask = kStagingCapacity - 1;
+
+    bool hasRoom(uint64_t head, size_t size) {
+        if (size <= kStagingCapacity - static_cast<size_t>(head - cachedTail_)) {
+            return true;
+        }
+        cachedTail_ = tail_.load(std::memory_order_acquire);
+        return size <= kStagingCapacity - static_cast<size_t>(head - cachedTail_);
+    }
+
+    const uint32_t streamId_;
+    std::unique_ptr<char[]> data_;
+    alignas(64) std::atomic<uint64_t> head_{0};
+    uint64_t cachedTail_ = 0;  // 生产者缓存的消费位置，减少跨核读取
+    alignas(64) std::atomic<uint64_t> tail_{0};
+};
+
+// ================ BinaryLogSink ================
+
+BinaryLogSink::BinaryLogSink(const std::string& path) {
+    open(path);
+}
+
+bool BinaryLogSink::open(const std::string& path) {
+    {
+        std::lock_guard<std::mutex> lock(fileMutex_);
+        path_ = path;
+        file_.clear();
+        file_.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+        open_ = file_.is_open();
+        if (!open_) {
+            return false;
+        }
+        file_.write(kBinaryLogMagic, sizeof(kBinaryLogMagic));
+        file_.flush();
+        // 新文件需要完整的字典
+        dictionaryWritten_ = 0;
+    }
+    {
+        std::lock_guard<std::mutex> lock(buffersMutex_);
+        nextStreamId_ = 0;
+        sinkId_.store(nextSinkId.fetch_add(1, std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+    running_.store(true, std::memory_order_release);
+    thread_ = std::thread([this]() { run(); });
+    return true;
+}
+
+BinaryLogSink::~BinaryLogSink() {
+    stop();
+}
+
+uint32_t BinaryLogSink::formatId(std::string_view fmt, const BinaryArgType* types, size_t count) {
+    // 调用点的格式串和参数类型数组都具有静态存储期，按地址缓存在线程内，命中时无需加锁
+    thread_local std::unordered_map<LocalFormatKey, uint32_t, LocalFormatKeyHash> cache;
+    const LocalFormatKey key{fmt.data(), fmt.size(), types};
+    auto it = cache.find(key);
+    if (it != cache.end()) {
+        return it->second;
+    }
+    const uint32_t id = FormatRegistry::instance().idFor(fmt, types, count);
+    cache.emplace(key, id);
+    return id;
+}
+
+BinaryLogSink::StagingBuffer* BinaryLogSink::localBuffer() {
+    struct LocalBuffer {
+        uint64_t sinkId = 0;
+        std::shared_ptr<StagingBuffer> buffer;
+
+        ~LocalBuffer() {
+            if (buffer) {
+                buffer->retired = true;
+            }
+        }
+    };
+    thread_local LocalBuffer local;
+
+    const uint64_t sinkId = sinkId_.load(std::memory_order_relaxed);
+    if (!running_.load(std::memory_order_relaxed)) {
+        // 已停止：归还本线程的缓冲区，不必等到线程退出
+        if (local.sinkId == sinkId) {
+            local.buffer.reset();
+            local.sinkId = 0;
+        }
+        return nullptr;
+    }
+    if (local.sinkId != sinkId) {
+        if (local.buffer) {
+            local.buffer->retired = true;
+        }
+        std::lock_guard<std::mutex> lock(buffersMutex_);
+        local.buffer = std::make_shared<StagingBuffer>(nextStreamId_++);
+        local.sinkId = sinkId;
+        buffers_.push_back(local.buffer);
+    }
+    return local.buffer.get();
+}
+
+char* BinaryLogSink::tryReserve(size_t size, StagingBuffer*& buffer) {
+    buffer = localBuffer();
+    return buffer ? buffer->tryReserve(size) : nullptr;
+}
+
+void BinaryLogSink::commit(StagingBuffer* buffer, size_t size) {
+    buffer->commit(size);
+    wakeWriter();
+}
+
+void BinaryLogSink::wakeWriter() {
+    if (writerIdle_.load(std::memory_order_seq_cst)) {
+        std::lock_guard<std::mutex> lock(waitMutex_);
+        wakeCv_.notify_one();
+    }
+}
+
+void BinaryLogSink::writeSlow(const char* data, size_t size) {
+    if (!running_.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    if (size > kStagingCapacity) {
+        std::lock_guard<std::mutex> lock(fileMutex_);
+        // 字典必须先于引用它的记录写出
+        writeDictionaryUnlocked();
+        writeFrame(kDataFrame, kOversizedStreamId, data, size, nullptr, 0);
+        file_.flush();
+        return;
+    }
+
+    // 缓冲区已满：等待后台线程腾出空间；期间被重新打开时旧缓冲区不再被读取，放弃这条记录
+    const uint64_t sinkId = sinkId_.load(std::memory_order_relaxed);
+    StagingBuffer* buffer = localBuffer();
+    if (!buffer) {
+        return;
+    }
+    while (!buffer->tryWrite(data, size)) {
+        if (!running_.load(std::memory_order_acquire) ||
+            sinkId_.load(std::memory_order_relaxed) != sinkId) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(waitMutex_);
+            wakeCv_.notify_one();
+        }
+        std::this_thread::yield();
+    }
+    wakeWriter();
+}
+
+void BinaryLogSink::writeFrame(uint8_t kind, uint32_t id, const char* first, size_t firstSize,
+                               const char* second, size_t secondSize) {
+    char header[sizeof(uint8_t) + 2 * sizeof(uint32_t)];
+    const uint32_t length = static_cast<uint32_t>(firstSize + secondSize);
+    header[0] = static_cast<char>(kind);
+    std::memcpy(header + 1, &id, sizeof(id));
+    std::memcpy(header + 1 + sizeof(id), &length, sizeof(length));
+    file_.write(header, sizeof(header));
+    file_.write(first, static_cast<std::streamsize>(firstSize));
+    if (secondSize > 0) {
+        file_.write(second, static_cast<std::streamsize>(secondSize));
+    }
+}
+
+bool BinaryLogSink::writeDictionaryUnlocked() {
+    const size_t registered = FormatRegistry::instance().size();
+    if (dictionaryWritten_ == registered) {
+        return false;
+    }
+
+    std::string frame;
+    for (; dictionaryWritten_ < registered; ++dictionaryWritten_) {
+        const FormatEntry entry = FormatRegistry::instance().entry(dictionaryWritten_);
+        appendRaw(frame, kDictionaryFrame);
+        appendRaw(frame, static_cast<uint32_t>(dictionaryWritten_));
+        appendRaw(frame, static_cast<uint8_t>(entry.types.size()));
+        for (BinaryArgType type : entry.types) {
+            appendRaw(frame, type);
+        }
+        appendRaw(frame, static_cast<uint32_t>(entry.format.size()));
+        frame += entry.format;
+    }
+    file_.write(frame.data(), static_cast<std::streamsize>(frame.size()));
+    return true;
+}
+
+bool BinaryLogSink::drainOnce() {
+    std::vector<std::shared_ptr<StagingBuffer>> snapshot;
+    {
+        std::lock_guard<std::mutex> lock(buffersMutex_);
+        snapshot = buffers_;
+    }
+
+    // 先确定本轮要写出的范围，再写字典：这些记录的格式串一定已经登记
+    std::vector<uint64_t> heads(snapshot.size());
+    for (size_t i = 0; i < snapshot.size(); ++i) {
+        heads[i] = snapshot[i]->committed();
+    }
+
+    bool wrote = false;
+    {
+        std::lock_guard<std::mutex> lock(fileMutex_);
+        wrote = writeDictionaryUnlocked();
+
+        for (size_t i = 0; i < snapshot.size(); ++i) {
+            StagingBuffer& buffer = *snapshot[i];
+            wrote |= buffer.consume(heads[i], [&](const char* first, size_t firstSize,
+                                                  const char* second, size_t secondSize) {
+                writeFrame(kDataFrame, buffer.streamId(), first, firstSize, second, secondSize);
+            });
+        }
+        if (wrote) {
+            file_.flush();
+        }
+    }
+
+    // 线程已退出且数据已写完的缓冲区不再需要
+    std::lock_guard<std::mutex> lock(buffersMutex_);
+    buffers_.erase(std::remove_if(buffers_.begin(), buffers_.end(),
+                                  [](const std::shared_ptr<StagingBuffer>& buffer) {
+                                      return buffer->retired.load(std::memory_order_acquire) && buffer->empty();
+                                  }),
+                   buffers_.end());
+    return wrote;
+}
+
+bool BinaryLogSink::hasPending() {
+    std::lock_guard<std::mutex> lock(buffersMutex_);
+    return std::any_of(buffers_.begin(), buffers_.end(),
+                       [](const std::shared_ptr<StagingBuffer>& buffer) { return !buffer->empty(); });
+}
+
+void BinaryLogSink::run() {
+    while (running_.load(std::memory_order_acquire)) {
+        const bool wrote = drainOnce();
+
+        std::unique_lock<std::mutex> lock(waitMutex_);
+        ++passCount_;
+        passCv_.notify_all();
+        if (wrote) {
+            continue;
+        }
+        // 先声明空闲再检查：提交记录的线程看到标志后会来唤醒，不会错过
+        writerIdle_.store(true, std::memory_order_seq_cst);
+        if (!hasPending() && running_.load(std::memory_order_acquire)) {
+            wakeCv_.wait_for(lock, kIdleWait);
+        }
+        writerIdle_.store(false, std::memory_order_relaxed);
+    }
+}
+
+void BinaryLogSink::flush() {
+    if (!running_.load(std::memory_order_acquire)) {
+        return;
+    }
+    // 请求之后完整地经过两轮，保证请求前提交的记录都已写出
+    std::unique_lock<std::mutex> lock(waitMutex_);
+    const uint64_t target = passCount_ + 2;
+    wakeCv_.notify_one();
+    passCv_.wait(lock, [&]() {
+        return passCount_ >= target || !running_.load(std::memory_order_acquire);
+    });
+}
+
+void BinaryLogSink::stop() {
+    {
+        std::lock_guard<std::mutex> lock(waitMutex_);
+        if (!running_.exchange(false)) {
+            return;
+        }
+    }
+    wakeCv_.notify_one();
+    passCv_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    drainOnce();
+    {
+        std::lock_guard<std::mutex> lock(fileMutex_);
+        file_.close();
+    }
+    // 各线程仍持有自己的缓冲区，下次写入时归还或换成新的
+    std::lock_guard<std::mutex> lock(buffersMutex_);
+    buffers_.clear();
+}
+
+// ================ 解码 ================
+
+bool decodeBinaryLog(const std::string& path,
+                     std::vector<std::string>& lines,
+                     TimestampFormat format,
+                     std::string* error) {
+    auto fail = [error](const char* message) {
+        if (error) {
+            *error = message;
+        }
+        return false;
+    };
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return fail("unable to open file");
+    }
+    const std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (contents.size() < sizeof(kBinaryLogMagic) ||
+        std::memcmp(contents.data(), kBinaryLogMagic, sizeof(kBinaryLogMagic)) != 0) {
+        return fail("not a binary log file");
+    }
+
+    struct Record {
+        int64_t timestamp;
+        std::string text;
+    };
+    std::vector<Record> records;
+    std::unordered_map<uint32_t, FormatEntry> dictionary;
+    bool ok = true;
+
+    ByteReader reader(contents.data() + sizeof(kBinaryLogMagic), contents.size() - sizeof(kBinaryLogMagic));
+    while (ok && !reader.atEnd()) {
+        const uint8_t kind = reader.read<uint8_t>();
+        if (kind == kDictionaryFrame) {
+            const uint32_t id = reader.read<uint32_t>();
+            const uint8_t argCount = reader.read<uint8_t>();
+            FormatEntry entry;
+            for (uint8_t i = 0; i < argCount; ++i) {
+                entry.types.push_back(reader.read<BinaryArgType>());
+            }
+            entry.format = std::string(reader.readBytes(reader.read<uint32_t>()));
+            dictionary[id] = std::move(entry);
+        } else if (kind == kDataFrame) {
+            reader.read<uint32_t>();  // streamId：只用于写入端区分线程
+            const std::string_view payload = reader.readBytes(reader.read<uint32_t>());
+            ByteReader recordReader(payload.data(), payload.size());
+            while (recordReader.ok() && !recordReader.atEnd()) {
+                const uint32_t id = recordReader.read<uint32_t>();
+                const uint8_t level = recordReader.read<uint8_t>();
+                const int64_t timestamp = recordReader.read<int64_t>();
+                auto it = dictionary.find(id);
+                if (!recordReader.ok() || it == dictionary.end()) {
+                    ok = false;
+                    break;
+                }
+
+                // 与 formatLogMessage 相同：字面文本和参数交替追加
+                std::string message;
+                size_t pos = 0;
+                for (BinaryArgType type : it->second.types) {
+                    pos = appendLogLiteral(message, it->second.format, pos);
+                    decodeArg(recordReader, type, message);
+                }
+                appendLogLiteral(message, it->second.format, pos);
+                if (!recordReader.ok()) {
+                    ok = false;
+                    break;
+                }
+
+                char timeStr[TimeUtils::kMaxTimestampLength];
+                const auto time = std::chrono::system_clock::time_point(
+                    std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                        std::chrono::nanoseconds(timestamp)));
+                const size_t timeLen = TimeUtils::formatTimestamp(timeStr, time, format);
+
+                std::string text;
+                text.reserve(timeLen + message.size() + 16);
+                text += '[';
+                text.append(timeStr, timeLen);
+                text += "] [";
+                text += levelName(level);
+                text += "] ";
+                text += message;
+                records.push_back(Record{timestamp, std::move(text)});
+            }
+        } else {
+            ok = false;
+        }
+        ok = ok && reader.ok();
+    }
+
+    // 各线程的记录分帧交错写入，按时间戳稳定排序后即为全局顺序
+    std::stable_sort(records.begin(), records.end(), [](const Record& a, const Record& b) {
+        return a.timestamp < b.timestamp;
+    });
+    lines.reserve(lines.size() + records.size());
+    for (auto& record : records) {
+        lines.push_back(std::move(record.text));
+    }
+    return ok ? true : fail("corrupted binary log");
+}
+
+} // namespace Internal
+} // namespace CorePlatform
@@ -0,0 +1,376 @@
+#include "CorePlatform/CircularLogFile.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+
+#if defined(CP_PLATFORM_WINDOWS)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace CorePlatform {
+
+/**
+ * 文件开头的控制块。数据区的内容按时间顺序为
+ *   [oldestOffset, dataEnd) + [0, writeOffset)    已回绕且 writeOffset <= oldestOffset < dataEnd
+ *   [0, writeOffset)                              其他情况
+ * 偏移量通过 atomic_ref 读写，写入顺序保证任意时刻崩溃留下的组合都满足上式。
+ */
+struct CircularLogFile::Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t headerSize;
+    uint64_t capacity;
+    uint64_t writeOffset;   // 下一条日志的写入位置
+    uint64_t oldestOffset;  // 回绕后最旧一条完整日志的起始位置
+    uint64_t dataEnd;       // 上一圈数据的末尾
+    uint64_t wrapCount;
+    uint64_t reserved;
+};
+
+namespace {
+
+constexpr char kFileMagic[8] = {'C', 'P', 'L', 'O', 'G', 'R', 'N', 'G'};
+constexpr uint32_t kFileVersion = 1;
+
+void setError(std::string* error, const std::string& message) {
+    if (error) {
+        *error = message;
+    }
+}
+
+std::string systemError(const std::string& what) {
+#if defined(CP_PLATFORM_WINDOWS)
+    return what + " failed (error " + std::to_string(GetLastError()) + ")";
+#else
+    return what + " failed: " + std::strerror(errno);
+#endif
+}
+
+uint64_t loadOffset(const uint64_t& field) {
+    return std::atomic_ref<uint64_t>(const_cast<uint64_t&>(field)).load(std::memory_order_acquire);
+}
+
+void storeOffset(uint64_t& field, uint64_t value) {
+    std::atomic_ref<uint64_t>(field).store(value, std::memory_order_release);
+}
+
+// 文件头是否属于容量为 capacity 的环形日志文件
+template<typename HeaderT>
+bool isValidHeader(const HeaderT& header, size_t capacity) {
+    return memcmp(header.magic, kFileMagic, sizeof(kFileMagic)) == 0 &&
+           header.version == kFileVersion &&
+           header.headerSize == CircularLogFile::kHeaderSize &&
+           header.capacity == capacity &&
+           loadOffset(header.writeOffset) <= capacity &&
+           loadOffset(header.dataEnd) <= capacity;
+}
+
+// 按时间顺序追加数据区的内容
+template<typename HeaderT>
+void appendChronological(std::string& out, const HeaderT& header, const char* data) {
+    const uint64_t writeOffset = loadOffset(header.writeOffset);
+    const uint64_t oldest = loadOffset(header.oldestOffset);
+    const uint64_t dataEnd = loadOffset(header.dataEnd);
+    if (loadOffset(header.wrapCount) > 0 && oldest >= writeOffset && oldest < dataEnd) {
+        out.append(data + oldest, static_cast<size_t>(dataEnd - oldest));
+    }
+    out.append(data, static_cast<size_t>(writeOffset));
+}
+
+std::vector<std::string> splitLines(std::string_view contents, size_t maxLines) {
+    std::vector<std::string> lines;
+    if (contents.empty()) {
+        return lines;
+    }
+    if (contents.back() == '\n') {
+        contents.remove_suffix(1);
+    }
+    size_t begin = 0;
+    if (maxLines > 0) {
+        // 从末尾反向找到倒数第 maxLines 行的行首
+        size_t end = contents.size();
+        for (size_t count = 0; count < maxLines; ++count) {
+            const size_t newline = end == 0 ? std::string_view::npos : contents.rfind('\n', end - 1);
+            if (newline == std::string_view::npos) {
+                begin = 0;
+                break;
+            }
+            begin = newline + 1;
+            end = newline;
+        }
+    }
+    while (true) {
+        const size_t newline = contents.find('\n', begin);
+        lines.emplace_back(contents.substr(begin, newline == std::string_view::npos ? std::string_view::npos
+                                                                                    : newline - begin));
+        if (newline == std::string_view::npos) break;
+        begin = newline + 1;
+    }
+    return lines;
+}
+
+} // 匿名命名空间
+
+// ================ CircularLogFile ================
+
+std::unique_ptr<CircularLogFile> CircularLogFile::open(const std::string& path, size_t capacity, std::string* error) {
+    static_assert(sizeof(Header) == kHeaderSize, "header size is part of the file format");
+
+    std::unique_ptr<CircularLogFile> file(new CircularLogFile());
+    file->path_ = path;
+    file->capacity_ = std::max(capacity, kMinCapacity);
+    file->mappedSize_ = kHeaderSize + file->capacity_;
+
+#if defined(CP_PLATFORM_WINDOWS)
+    HANDLE handle = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ,
+                                nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) {
+        setError(error, systemError("CreateFile " + path));
+        return nullptr;
+    }
+    file->file_ = handle;
+    // 映射时按指定大小扩展或截断文件
+    LARGE_INTEGER size;
+    size.QuadPart = static_cast<LONGLONG>(file->mappedSize_);
+    if (!SetFilePointerEx(handle, size, nullptr, FILE_BEGIN) || !SetEndOfFile(handle)) {
+        setError(error, systemError("SetEndOfFile " + path));
+        return nullptr;
+    }
+    HANDLE mapping = CreateFileMappingA(handle, nullptr, PAGE_READWRITE, 0, 0, nullptr);
+    if (!mapping) {
+        setError(error, systemError("CreateFileMapping " + path));
+        return nullptr;
+    }
+    file->mapping_ = mapping;
+    void* view = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, file->mappedSize_);
+    if (!view) {
+        setError(error, systemError("MapViewOfFile"));
+        return nullptr;
+    }
+#else
+    const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        setError(error, systemError("open " + path));
+        return nullptr;
+    }
+    file->fd_ = fd;
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        setError(error, systemError("fstat " + path));
+        return nullptr;
+    }
+    if (static_cast<size_t>(st.st_size) != file->mappedSize_ &&
+        ftruncate(fd, static_cast<off_t>(file->mappedSize_)) != 0) {
+        setError(error, systemError("ftruncate " + path));
+        return nullptr;
+    }
+#if defined(CP_PLATFORM_LINUX)
+    // 预先分配磁盘块：稀疏文件在磁盘写满时写入映射会触发 SIGBUS
+    if (const int rc = posix_fallocate(fd, 0, static_cast<off_t>(file->mappedSize_)); rc != 0) {
+        errno = rc;
+        setError(error, systemError("posix_fallocate " + path));
+        return nullptr;
+    }
+#endif
+    void* view = mmap(nullptr, file->mappedSize_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (view == MAP_FAILED) {
+        setError(error, systemError("mmap " + path));
+        return nullptr;
+    }
+#endif
+
+    file->header_ = static_cast<Header*>(view);
+    file->data_ = static_cast<char*>(view) + kHeaderSize;
+    file->initialize();
+    return file;
+}
+
+bool CircularLogFile::readFile(const std::string& path, std::string& contents, std::string* error) {
+    std::ifstream stream(path, std::ios::binary);
+    if (!stream) {
+        setError(error, "unable to open " + path);
+        return false;
+    }
+    // 先只读文件头，普通日志文件不会被整个读入
+    stream.seekg(0, std::ios::end);
+    const std::streamoff fileSize = stream.tellg();
+    stream.seekg(0, std::ios::beg);
+    Header header;
+    if (fileSize < static_cast<std::streamoff>(kHeaderSize) ||
+        !stream.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        !isValidHeader(header, static_cast<size_t>(fileSize) - kHeaderSize)) {
+        setError(error, "not a circular log file: " + path);
+        return false;
+    }
+    std::string data(static_cast<size_t>(header.capacity), '\0');
+    if (!stream.read(data.data(), static_cast<std::streamsize>(data.size()))) {
+        setError(error, "unable to read " + path);
+        return false;
+    }
+    contents.clear();
+    appendChronological(contents, header, data.data());
+    return true;
+}
+
+CircularLogFile::~CircularLogFile() {
+    if (header_) {
+        sync();
+    }
+#if defined(CP_PLATFORM_WINDOWS)
+    if (header_) UnmapViewOfFile(header_);
+    if (mapping_) CloseHandle(static_cast<HANDLE>(mapping_));
+    if (file_) CloseHandle(static_cast<HANDLE>(file_));
+#else
+    if (header_) munmap(header_, mappedSize_);
+    if (fd_ >= 0) close(fd_);
+#endif
+}
+
+void CircularLogFile::initialize() {
+    if (isValidHeader(*header_, capacity_)) {
+        return;
+    }
+    // 新文件或格式不符：magic 最后写入，中途崩溃时下次打开仍会重新初始化
+    memset(header_, 0, kHeaderSize);
+    header_->version = kFileVersion;
+    header_->headerSize = kHeaderSize;
+    header_->capacity = capacity_;
+    std::atomic_thread_fence(std::memory_order_release);
+    memcpy(header_->magic, kFileMagic, sizeof(kFileMagic));
+    markDirty(0, 0);
+}
+
+uint64_t CircularLogFile::wrapCount() const {
+    return loadOffset(header_->wrapCount);
+}
+
+void CircularLogFile::append(std::string_view text) {
+    // 换行符是记录的分隔符，回绕时按它确定最旧一条日志的起点，日志本身的换行必须转义
+    std::string escaped;
+    if (text.find('\n') != std::string_view::npos) {
+        escaped.reserve(text.size() + 16);
+        for (const char ch : text) {
+            if (ch == '\n') {
+                escaped += "\\n";
+            } else {
+                escaped += ch;
+            }
+        }
+        text = escaped;
+    }
+
+    // 一条日志最多占满整个数据区（含换行符）
+    const size_t length = std::min(text.size() + 1, capacity_);
+    text = text.substr(0, length - 1);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint64_t writeOffset = header_->writeOffset;
+    if (writeOffset + length > capacity_) {
+        // 回绕：依次让上一圈的残留失效、记录本圈末尾、回到开头，每一步之后文件头都描述同一份内容
+        storeOffset(header_->oldestOffset, 0);
+        storeOffset(header_->dataEnd, writeOffset);
+        storeOffset(header_->wrapCount, header_->wrapCount + 1);
+        storeOffset(header_->writeOffset, 0);
+        writeOffset = 0;
+    }
+
+    const uint64_t end = writeOffset + length;
+    if (header_->wrapCount > 0 && header_->oldestOffset < end && header_->oldestOffset < header_->dataEnd) {
+        // 即将覆盖的最旧日志失效：找到 end 之后的第一个行首，必须在覆盖之前检查 end - 1 处的旧字节
+        uint64_t oldest = header_->dataEnd;
+        if (end < header_->dataEnd) {
+            if (data_[end - 1] == '\n') {
+                oldest = end;
+            } else if (const void* newline = memchr(data_ + end, '\n', static_cast<size_t>(header_->dataEnd - end))) {
+                oldest = static_cast<uint64_t>(static_cast<const char*>(newline) - data_) + 1;
+            }
+        }
+        storeOffset(header_->oldestOffset, oldest);
+    }
+
+    memcpy(data_ + writeOffset, text.data(), text.size());
+    data_[end - 1] = '\n';
+    storeOffset(header_->writeOffset, end);
+    markDirty(static_cast<size_t>(writeOffset), static_cast<size_t>(end));
+}
+
+void CircularLogFile::markDirty(size_t begin, size_t end) {
+    dirtyBegin_ = std::min(dirtyBegin_, begin);
+    dirtyEnd_ = std::max(dirtyEnd_, end);
+}
+
+bool CircularLogFile::sync() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (dirtyBegin_ == SIZE_MAX) {
+        return true;
+    }
+    // 文件头和数据区的修改范围一起写回（地址需要按页对齐）
+    const size_t end = kHeaderSize + dirtyEnd_;
+    bool ok = true;
+#if defined(CP_PLATFORM_WINDOWS)
+    ok = FlushViewOfFile(header_, end) && FlushFileBuffers(static_cast<HANDLE>(file_));
+#else
+    const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    const size_t begin = (kHeaderSize + dirtyBegin_) / pageSize * pageSize;
+    char* base = reinterpret_cast<char*>(header_);
+    if (begin >= pageSize) {
+        ok = msync(base, kHeaderSize, MS_SYNC) == 0;
+    }
+    ok = msync(base + begin, end - begin, MS_SYNC) == 0 && ok;
+#endif
+    dirtyBegin_ = SIZE_MAX;
+    dirtyEnd_ = 0;
+    return ok;
+}
+
+std::string CircularLogFile::readContents() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::string contents;
+    appendChronological(contents, *header_, data_);
+    return contents;
+}
+
+std::vector<std::string> CircularLogFile::readAllLines() const {
+    return splitLines(readContents(), 0);
+}
+
+std::vector<std::string> CircularLogFile::readLastLines(size_t maxLines) const {
+    if (maxLines == 0) {
+        return {};
+    }
+    return splitLines(readContents(), maxLines);
+}
+
+// ================ CircularFileSink ================
+
+CircularFileSink::CircularFileSink(std::shared_ptr<CircularLogFile> file, const LogSinkOptions& options)
+    : LogSink(options), file_(std::move(file)) {
+}
+
+CircularFileSink::~CircularFileSink() {
+    stop();
+    if (file_) {
+        file_->sync();
+    }
+}
+
+void CircularFileSink::write(LogLevel, std::string_view formatted) {
+    if (file_) {
+        file_->append(formatted);
+    }
+}
+
+void CircularFileSink::flushOutput() {
+    if (file_) {
+        file_->sync();
+    }
+}
+
+} // namespace CorePlatform
@@ -0,0 +1,99 @@
+#include "CorePlatform/FileSystem.h"
+
+namespace CorePlatform {
+
+// ================ DirectoryEntry ================
+
+void FileSystem::DirectoryEntry::Assign(const WalkEntry& entry) {
+    // 复用已有的容量，遍历时通常不分配内存
+    path.assign(entry.path.data(), entry.path.size());
+    nameOffset = path.size() - entry.name.size();
+    type = entry.type;
+    depth = entry.depth;
+    statusLoaded = false;
+}
+
+uint64_t FileSystem::DirectoryEntry::Size() const {
+    LoadStatus();
+    return size;
+}
+
+std::chrono::system_clock::time_point FileSystem::DirectoryEntry::ModificationTime() const {
+    LoadStatus();
+    return modificationTime;
+}
+
+// ================ RecursiveDirectoryIterator ================
+
+struct FileSystem::RecursiveDirectoryIterator::State {
+    State(const std::string& path, const WalkOptions& options) : walker(path, options) {}
+
+    Walker walker;
+    DirectoryEntry entry;
+    bool atEnd = false;     // 到达结尾后保留状态，以便读取 Errors()
+};
+
+FileSystem::RecursiveDirectoryIterator::RecursiveDirectoryIterator(const std::string& path)
+    : RecursiveDirectoryIterator(path, WalkOptions()) {}
+
+FileSystem::RecursiveDirectoryIterator::RecursiveDirectoryIterator(const std::string& path,
+                                                                   const WalkOptions& options)
+    : state(std::make_shared<State>(path, options)) {
+    ++*this;
+}
+
+const FileSystem::DirectoryEntry& FileSystem::RecursiveDirectoryIterator::operator*() const {
+    return state->entry;
+}
+
+FileSystem::RecursiveDirectoryIterator& FileSystem::RecursiveDirectoryIterator::operator++() {
+    if (state && !state->atEnd) {
+        WalkEntry entry;
+        if (state->walker.Next(entry)) {
+            state->entry.Assign(entry);
+        } else {
+            state->atEnd = true;
+        }
+    }
+    return *this;
+}
+
+bool FileSystem::RecursiveDirectoryIterator::operator==(const RecursiveDirectoryIterator& other) const {
+    const bool end = !state || state->atEnd;
+    const bool otherEnd = !other.state || other.state->atEnd;
+    return end == otherEnd && (end || state == other.state);
+}
+
+void FileSystem::RecursiveDirectoryIterator::SkipSubtree() {
+    if (state) {
+        state->walker.SkipSubtree();
+    }
+}
+
+int FileSystem::RecursiveDirectoryIterator::Depth() const {
+    return state ? state->entry.Depth() : 0;
+}
+
+const std::vector<FileSystem::TreeError>& FileSystem::RecursiveDirectoryIterator::Errors() const {
+    static const std::vector<TreeError> kNoErrors;
+    return state ? state->walker.Errors() : kNoErrors;
+}
+
+// ================ DirectoryIterator ================
+
+namespace {
+
+FileSystem::WalkOptions SingleLevel(FileSystem::WalkOptions options) {
+    options.maxDepth = 1;
+    return options;
+}
+
+} // 匿名命名空间
+
+FileSystem::DirectoryIterator::DirectoryIterator(const std::string& path)
+    : DirectoryIterator(path, WalkOptions()) {}
+
+FileSystem::DirectoryIterator::DirectoryIterator(const std::string& path, const WalkOptions& options)
+    : iterator(path, SingleLevel(options)) {}
+
+} // namespace CorePlatform
@@ -0,0 +1,489 @@
+#include "CorePlatform/FlightRecorder.h"
+#include "CorePlatform/TimeUtils.h"
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+#if defined(CP_PLATFORM_WINDOWS)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#if defined(CP_PLATFORM_LINUX)
+#include <sys/syscall.h>
+#endif
+#endif
+
+namespace CorePlatform {
+
+struct FlightRecorder::Slot {
+    // 0 表示空槽位；奇数表示正在写入；偶数 2*(n+1) 表示已写入该线程的第 n 条记录
+    std::atomic<uint64_t> sequence{0};
+    int64_t timeNs = 0;
+    uint32_t threadId = 0;
+    uint8_t level = 0;
+    uint8_t length = 0;
+    char text[kMaxMessageSize];
+};
+
+struct FlightRecorder::ThreadRing {
+    explicit ThreadRing(size_t capacity) : slots(new Slot[capacity]) {}
+
+    std::unique_ptr<Slot[]> slots;
+    std::atomic<uint64_t> next{0};      // 下一条记录的编号，只由持有线程写入
+    std::atomic<uint64_t> first{0};     // 编号小于此值的记录已被 reset() 丢弃
+    // 占用标记由线程局部句柄共同持有，记录器先于线程销毁时线程退出仍可安全归还
+    std::shared_ptr<std::atomic<bool>> inUse = std::make_shared<std::atomic<bool>>(true);
+    ThreadRing* nextRing = nullptr;     // 登记到链表之前写入，之后不再修改
+};
+
+namespace {
+
+static_assert(FlightRecorder::kMaxMessageSize <= 255, "length is stored in a single byte");
+
+std::atomic<uint64_t> g_nextRecorderId{1};
+
+// 当前线程的系统线程号
+uint32_t currentThreadId() {
+#if defined(CP_PLATFORM_WINDOWS)
+    return static_cast<uint32_t>(GetCurrentThreadId());
+#elif defined(CP_PLATFORM_LINUX)
+    return static_cast<uint32_t>(syscall(SYS_gettid));
+#elif defined(CP_PLATFORM_MACOS)
+    uint64_t tid = 0;
+    pthread_threadid_np(nullptr, &tid);
+    return static_cast<uint32_t>(tid);
+#else
+    return static_cast<uint32_t>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+#endif
+}
+
+// 线程退出时归还缓冲区，供之后的新线程复用
+struct LocalRingHandle {
+    uint64_t recorderId = 0;
+    void* ring = nullptr;
+    std::shared_ptr<std::atomic<bool>> inUse;
+    uint32_t threadId = 0;
+
+    ~LocalRingHandle() {
+        if (inUse) {
+            inUse->store(false, std::memory_order_release);
+        }
+    }
+};
+
+thread_local LocalRingHandle t_ringHandle;
+
+// ---------------- 信号安全的文本输出 ----------------
+
+// 固定缓冲区上的追加写入，不分配内存
+struct LineWriter {
+    char data[FlightRecorder::kMaxMessageSize + 96];
+    size_t size = 0;
+
+    void append(const char* text, size_t length) {
+        length = std::min(length, sizeof(data) - size);
+        std::memcpy(data + size, text, length);
+        size += length;
+    }
+    void append(const char* text) { append(text, std::strlen(text)); }
+    void appendChar(char ch) { append(&ch, 1); }
+    void appendDigits(uint64_t value, int width) {
+        char digits[20];
+        int count = 0;
+        do {
+            digits[count++] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        } while (value > 0 && count < 20);
+        for (int i = count; i < width; ++i) appendChar('0');
+        while (count > 0) appendChar(digits[--count]);
+    }
+};
+
+// 由 1970-01-01 起的天数计算公历日期（Howard Hinnant 算法）
+void civilFromDays(int64_t days, int64_t& year, unsigned& month, unsigned& day) {
+    days += 719468;
+    const int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    const unsigned doe = static_cast<unsigned>(days - era * 146097);
+    const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const unsigned mp = (5 * doy + 2) / 153;
+    day = doy - (153 * mp + 2) / 5 + 1;
+    month = mp < 10 ? mp + 3 : mp - 9;
+    year = static_cast<int64_t>(yoe) + era * 400 + (month <= 2 ? 1 : 0);
+}
+
+// 追加 "YYYY-MM-DDTHH:MM:SS.mmmZ"，不依赖 localtime 等非信号安全函数
+void appendUtcTimestamp(LineWriter& out, int64_t timeNs) {
+    const int64_t millis = (timeNs >= 0 ? timeNs : timeNs - 999999) / 1000000;
+    const int64_t seconds = (millis >= 0 ? millis : millis - 999) / 1000;
+    const int64_t days = (seconds >= 0 ? seconds : seconds - 86399) / 86400;
+    const unsigned secOfDay = static_cast<unsigned>(seconds - days * 86400);
+    int64_t year = 0;
+    unsigned month = 0;
+    unsigned day = 0;
+    civilFromDays(days, year, month, day);
+
+    out.appendDigits(static_cast<uint64_t>(std::max<int64_t>(year, 0)), 4);
+    out.appendChar('-');
+    out.appendDigits(month, 2);
+    out.appendChar('-');
+    out.appendDigits(day, 2);
+    out.appendChar('T');
+    out.appendDigits(secOfDay / 3600, 2);
+    out.appendChar(':');
+    out.appendDigits(secOfDay / 60 % 60, 2);
+    out.appendChar(':');
+    out.appendDigits(secOfDay % 60, 2);
+    out.appendChar('.');
+    out.appendDigits(static_cast<uint64_t>(millis - seconds * 1000), 3);
+    out.appendChar('Z');
+}
+
+#if defined(CP_PLATFORM_WINDOWS)
+using NativeFile = HANDLE;
+const NativeFile kInvalidFile = INVALID_HANDLE_VALUE;
+
+NativeFile openForDump(const char* path) {
+    return CreateFileA(path, GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+}
+bool writeAll(NativeFile file, const char* data, size_t size) {
+    DWORD written = 0;
+    return WriteFile(file, data, static_cast<DWORD>(size), &written, nullptr) && written == size;
+}
+void closeDump(NativeFile file) {
+    CloseHandle(file);
+}
+#else
+using NativeFile = int;
+const NativeFile kInvalidFile = -1;
+
+NativeFile openForDump(const char* path) {
+    return open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+}
+bool writeAll(NativeFile file, const char* data, size_t size) {
+    while (size > 0) {
+        const ssize_t n = write(file, data, size);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+void closeDump(NativeFile file) {
+    close(file);
+}
+#endif
+
+// ---------------- 崩溃信号处理 ----------------
+
+constexpr int kCrashSignals[] = {
+    SIGSEGV, SIGABRT, SIGFPE, SIGILL,
+#if !defined(CP_PLATFORM_WINDOWS)
+    SIGBUS,
+#endif
+};
+constexpr size_t kCrashSignalCount = sizeof(kCrashSignals) / sizeof(kCrashSignals[0]);
+
+std::atomic<const FlightRecorder*> g_crashRecorder{nullptr};
+std::atomic<bool> g_crashDumped{false};
+char g_crashPath[1024];
+std::atomic<bool> g_handlerInstalled{false};
+
+#if !defined(CP_PLATFORM_WINDOWS)
+// 崩溃处理函数使用的备用信号栈：栈溢出引起 SIGSEGV 时原有的栈已经不可用
+constexpr size_t kAltStackSize = 64 * 1024;
+
+struct AltSignalStack {
+    bool attempted = false;
+    std::unique_ptr<char[]> memory;
+
+    ~AltSignalStack() {
+        if (!memory) return;
+        stack_t current{};
+        if (sigaltstack(nullptr, &current) == 0 && current.ss_sp == memory.get()) {
+            stack_t disable{};
+            disable.ss_flags = SS_DISABLE;
+            sigaltstack(&disable, nullptr);
+        }
+    }
+};
+
+thread_local AltSignalStack t_altStack;
+
+// 为当前线程安装备用信号栈，线程已有备用栈（例如由其他库安装）时保持不变
+void ensureAltSignalStack() {
+    if (t_altStack.attempted) return;
+    t_altStack.attempted = true;
+
+    stack_t current{};
+    if (sigaltstack(nullptr, &current) != 0 || !(current.ss_flags & SS_DISABLE)) {
+        return;
+    }
+    auto memory = std::make_unique<char[]>(kAltStackSize);
+    stack_t stack{};
+    stack.ss_sp = memory.get();
+    stack.ss_size = kAltStackSize;
+    if (sigaltstack(&stack, nullptr) == 0) {
+        t_altStack.memory = std::move(memory);
+    }
+}
+#endif
+
+#if defined(CP_PLATFORM_WINDOWS)
+using PreviousHandler = void (*)(int);
+PreviousHandler g_previousHandlers[kCrashSignalCount];
+#else
+struct sigaction g_previousActions[kCrashSignalCount];
+#endif
+
+void crashSignalHandler(int signal) {
+    // 多个线程同时崩溃时只导出一次
+    const FlightRecorder* recorder = g_crashRecorder.load(std::memory_order_acquire);
+    if (recorder && !g_crashDumped.exchange(true, std::memory_order_acq_rel)) {
+        recorder->dumpSignalSafe(g_crashPath);
+    }
+
+    // 恢复原有处理方式并重新发送信号
+    for (size_t i = 0; i < kCrashSignalCount; ++i) {
+        if (kCrashSignals[i] != signal) continue;
+#if defined(CP_PLATFORM_WINDOWS)
+        std::signal(signal, g_previousHandlers[i] ? g_previousHandlers[i] : SIG_DFL);
+#else
+        sigaction(signal, &g_previousActions[i], nullptr);
+#endif
+    }
+    std::raise(signal);
+}
+
+} // 匿名命名空间
+
+// ================ FlightRecorder ================
+
+FlightRecorder::FlightRecorder(size_t recordsPerThread, LogLevel level)
+    : capacity_(std::max<size_t>(recordsPerThread, 1)),
+      level_(level),
+      id_(g_nextRecorderId.fetch_add(1, std::memory_order_relaxed)) {}
+
+FlightRecorder::~FlightRecorder() {
+    const FlightRecorder* self = this;
+    g_crashRecorder.compare_exchange_strong(self, nullptr, std::memory_order_acq_rel);
+
+    ThreadRing* ring = rings_.load(std::memory_order_acquire);
+    while (ring) {
+        ThreadRing* next = ring->nextRing;
+        delete ring;
+        ring = next;
+    }
+}
+
+FlightRecorder::ThreadRing* FlightRecorder::localRing() {
+#if !defined(CP_PLATFORM_WINDOWS)
+    if (!t_altStack.attempted && g_handlerInstalled.load(std::memory_order_relaxed)) {
+        ensureAltSignalStack();
+    }
+#endif
+
+    LocalRingHandle& handle = t_ringHandle;
+    if (handle.recorderId == id_) {
+        return static_cast<ThreadRing*>(handle.ring);
+    }
+
+    // 切换到另一个记录器：归还之前的缓冲区
+    if (handle.inUse) {
+        handle.inUse->store(false, std::memory_order_release);
+        handle.inUse.reset();
+    }
+    if (handle.threadId == 0) {
+        handle.threadId = currentThreadId();
+    }
+
+    // 优先复用已退出线程留下的缓冲区
+    ThreadRing* ring = nullptr;
+    for (ThreadRing* candidate = rings_.load(std::memory_order_acquire); candidate; candidate = candidate->nextRing) {
+        bool expected = false;
+        if (candidate->inUse->compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+            ring = candidate;
+            break;
+        }
+    }
+    if (!ring) {
+        ring = new ThreadRing(capacity_);
+        ThreadRing* head = rings_.load(std::memory_order_relaxed);
+        do {
+            ring->nextRing = head;
+        } while (!rings_.compare_exchange_weak(head, ring, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    handle.recorderId = id_;
+    handle.ring = ring;
+    handle.inUse = ring->inUse;
+    return ring;
+}
+
+void FlightRecorder::record(LogLevel level, std::chrono::system_clock::time_point time, std::string_view message) {
+    if (!shouldRecord(level)) return;
+
+    ThreadRing* ring = localRing();
+    const uint64_t index = ring->next.load(std::memory_order_relaxed);
+    Slot& slot = ring->slots[index % capacity_];
+
+    slot.sequence.store(index * 2 + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    const size_t length = std::min(message.size(), kMaxMessageSize);
+    slot.timeNs = std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+    slot.threadId = t_ringHandle.threadId;
+    slot.level = static_cast<uint8_t>(level);
+    slot.length = static_cast<uint8_t>(length);
+    std::memcpy(slot.text, message.data(), length);
+
+    slot.sequence.store(index * 2 + 2, std::memory_order_release);
+    ring->next.store(index + 1, std::memory_order_release);
+}
+
+void FlightRecorder::reset(LogLevel level) {
+    level_.store(level, std::memory_order_relaxed);
+    for (ThreadRing* ring = rings_.load(std::memory_order_acquire); ring; ring = ring->nextRing) {
+        ring->first.store(ring->next.load(std::memory_order_acquire), std::memory_order_release);
+    }
+}
+
+bool FlightRecorder::dump(const std::string& path, TimestampFormat format) const {
+    struct Entry {
+        int64_t timeNs;
+        uint32_t threadId;
+        uint64_t index;
+        LogLevel level;
+        std::string text;
+    };
+    std::vector<Entry> entries;
+
+    for (ThreadRing* ring = rings_.load(std::memory_order_acquire); ring; ring = ring->nextRing) {
+        const uint64_t next = ring->next.load(std::memory_order_acquire);
+        const uint64_t first = std::max(next > capacity_ ? next - capacity_ : 0,
+                                        ring->first.load(std::memory_order_acquire));
+        for (uint64_t index = first; index < next; ++index) {
+            const Slot& slot = ring->slots[index % capacity_];
+            if (slot.sequence.load(std::memory_order_acquire) != index * 2 + 2) {
+                continue;
+            }
+            Entry entry{slot.timeNs, slot.threadId, index, static_cast<LogLevel>(slot.level),
+                        std::string(slot.text, slot.length)};
+            // 复制期间被覆盖的记录丢弃
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) != index * 2 + 2) {
+                continue;
+            }
+            entries.push_back(std::move(entry));
+        }
+    }
+
+    std::stable_sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+        return a.timeNs < b.timeNs;
+    });
+
+    std::ofstream out(path, std::ios::out | std::ios::trunc | std::ios::binary);
+    if (!out) {
+        return false;
+    }
+    std::string line;
+    for (const auto& entry : entries) {
+        char timeStr[TimeUtils::kMaxTimestampLength];
+        const size_t timeLen = TimeUtils::formatTimestamp(
+            timeStr, std::chrono::system_clock::time_point(
+                std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                    std::chrono::nanoseconds(entry.timeNs))), format);
+        line.clear();
+        line += '[';
+        line.append(timeStr, timeLen);
+        line += "] [";
+        line += logLevelName(entry.level);
+        line += "] [";
+        line += std::to_string(entry.threadId);
+        line += "] ";
+        line += entry.text;
+        line += '\n';
+        out.write(line.data(), static_cast<std::streamsize>(line.size()));
+    }
+    out.flush();
+    return static_cast<bool>(out);
+}
+
+bool FlightRecorder::dumpSignalSafe(const char* path) const noexcept {
+    const NativeFile file = openForDump(path);
+    if (file == kInvalidFile) {
+        return false;
+    }
+
+    bool ok = true;
+    for (ThreadRing* ring = rings_.load(std::memory_order_acquire); ring && ok; ring = ring->nextRing) {
+        const uint64_t next = ring->next.load(std::memory_order_acquire);
+        const uint64_t first = std::max(next > capacity_ ? next - capacity_ : 0,
+                                        ring->first.load(std::memory_order_acquire));
+        for (uint64_t index = first; index < next && ok; ++index) {
+            const Slot& slot = ring->slots[index % capacity_];
+            // 崩溃时可能有线程正在写入，跳过未完成的槽位
+            if (slot.sequence.load(std::memory_order_acquire) != index * 2 + 2) {
+                continue;
+            }
+            LineWriter line;
+            line.appendChar('[');
+            appendUtcTimestamp(line, slot.timeNs);
+            line.append("] [");
+            line.append(logLevelName(static_cast<LogLevel>(slot.level)));
+            line.append("] [");
+            line.appendDigits(slot.threadId, 1);
+            line.append("] ");
+            line.append(slot.text, std::min<size_t>(slot.length, kMaxMessageSize));
+            line.appendChar('\n');
+            ok = writeAll(file, line.data, line.size);
+        }
+    }
+    closeDump(file);
+    return ok;
+}
+
+void FlightRecorder::installCrashHandler(const FlightRecorder* recorder, const std::string& path) {
+    // 先撤下旧目标再更新路径，处理函数不会读到写了一半的路径
+    g_crashRecorder.store(nullptr, std::memory_order_release);
+    if (!recorder) {
+        return;
+    }
+    const size_t length = std::min(path.size(), sizeof(g_crashPath) - 1);
+    std::memcpy(g_crashPath, path.data(), length);
+    g_crashPath[length] = '\0';
+    g_crashDumped.store(false, std::memory_order_relaxed);
+    g_crashRecorder.store(recorder, std::memory_order_release);
+#if !defined(CP_PLATFORM_WINDOWS)
+    ensureAltSignalStack();
+#endif
+
+    if (g_handlerInstalled.exchange(true, std::memory_order_acq_rel)) {
+        return;
+    }
+    for (size_t i = 0; i < kCrashSignalCount; ++i) {
+#if defined(CP_PLATFORM_WINDOWS)
+        g_previousHandlers[i] = std::signal(kCrashSignals[i], crashSignalHandler);
+        if (g_previousHandlers[i] == SIG_ERR) {
+            g_previousHandlers[i] = nullptr;
+        }
+#else
+        struct sigaction action {};
+        action.sa_handler = crashSignalHandler;
+        sigemptyset(&action.sa_mask);
+        action.sa_flags = SA_ONSTACK;
+        sigaction(kCrashSignals[i], &action, &g_previousActions[i]);
+#endif
+    }
+}
+
+} // namespace CorePlatform
@@ -0,0 +1,236 @@
+#include "CorePlatform/LogFields.h"
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+
+namespace CorePlatform {
+namespace Internal {
+
+namespace {
+
+// JSON 字符串中每个字节的处理方式
+enum : uint8_t {
+    kJsonPlain = 0,    // 原样复制
+    kJsonEscape = 1,   // 需要转义（引号、反斜杠、控制字符）
+    kJsonUtf8 = 2      // 多字节 UTF-8 序列的首字节，需要校验
+};
+
+constexpr std::array<uint8_t, 256> makeJsonByteClass() {
+    std::array<uint8_t, 256> table{};
+    for (int ch = 0; ch < 256; ++ch) {
+        if (ch < 0x20 || ch == '"' || ch == '\\') {
+            table[ch] = kJsonEscape;
+        } else if (ch >= 0x80) {
+            table[ch] = kJsonUtf8;
+        }
+    }
+    return table;
+}
+
+constexpr std::array<uint8_t, 256> kJsonByteClass = makeJsonByteClass();
+
+// 一次检查 8 个字节（SWAR）：普通文本中绝大多数字节不需要处理，可以整块跳过
+constexpr uint64_t kByteOnes = 0x0101010101010101ull;
+constexpr uint64_t kByteHighs = 0x8080808080808080ull;
+
+// 存在小于 n 的字节时结果非零（n 不超过 128）
+constexpr uint64_t hasByteLess(uint64_t word, uint8_t n) {
+    return (word - kByteOnes * n) & ~word & kByteHighs;
+}
+
+// 存在等于 value 的字节时结果非零
+constexpr uint64_t hasByte(uint64_t word, uint8_t value) {
+    return hasByteLess(word ^ (kByteOnes * value), 1);
+}
+
+inline uint64_t loadWord(const unsigned char* p) {
+    uint64_t word;
+    memcpy(&word, p, sizeof(word));
+    return word;
+}
+
+constexpr bool isContinuation(unsigned char ch) {
+    return (ch & 0xC0) == 0x80;
+}
+
+// p 开头的合法 UTF-8 序列的长度，非法（截断、过长编码、代理区、超出 U+10FFFF）时返回 0
+size_t utf8SequenceLength(const unsigned char* p, size_t available) {
+    const unsigned char lead = p[0];
+    if (lead >= 0xC2 && lead <= 0xDF) {
+        return available >= 2 && isContinuation(p[1]) ? 2 : 0;
+    }
+    if (lead >= 0xE0 && lead <= 0xEF) {
+        if (available < 3 || !isContinuation(p[2])) return 0;
+        const unsigned char second = p[1];
+        if (lead == 0xE0) return second >= 0xA0 && second <= 0xBF ? 3 : 0;
+        if (lead == 0xED) return second >= 0x80 && second <= 0x9F ? 3 : 0;
+        return isContinuation(second) ? 3 : 0;
+    }
+    if (lead >= 0xF0 && lead <= 0xF4) {
+        if (available < 4 || !isContinuation(p[2]) || !isContinuation(p[3])) return 0;
+        const unsigned char second = p[1];
+        if (lead == 0xF0) return second >= 0x90 && second <= 0xBF ? 4 : 0;
+        if (lead == 0xF4) return second >= 0x80 && second <= 0x8F ? 4 : 0;
+        return isContinuation(second) ? 4 : 0;
+    }
+    return 0;
+}
+
+void appendEscapedByte(std::string& out, unsigned char ch) {
+    switch (ch) {
+        case '"':  out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\n': out += "\\n"; break;
+        case '\r': out += "\\r"; break;
+        case '\t': out += "\\t"; break;
+        case '\b': out += "\\b"; break;
+        case '\f': out += "\\f"; break;
+        default: {
+            static constexpr char kHex[] = "0123456789abcdef";
+            const char escaped[6] = {'\\', 'u', '0', '0', kHex[ch >> 4], kHex[ch & 0xF]};
+            out.append(escaped, sizeof(escaped));
+            break;
+        }
+    }
+}
+
+template<typename T>
+void appendNumber(std::string& out, T value) {
+    char buffer[32];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr);
+}
+
+// logfmt 中需要加引号的字符串：空串或含空白、控制字符、'='、引号
+bool needsQuotes(std::string_view text) {
+    if (text.empty()) return true;
+    const auto* data = reinterpret_cast<const unsigned char*>(text.data());
+    size_t i = 0;
+    for (; i + 8 <= text.size(); i += 8) {
+        const uint64_t word = loadWord(data + i);
+        if (hasByteLess(word, 0x21) | hasByte(word, '=') | hasByte(word, '"') | hasByte(word, 0x7F)) {
+            return true;
+        }
+    }
+    for (; i < text.size(); ++i) {
+        if (data[i] <= ' ' || data[i] == '=' || data[i] == '"' || data[i] == 0x7F) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // 匿名命名空间
+
+void appendJsonString(std::string& out, std::string_view text) {
+    const auto* data = reinterpret_cast<const unsigned char*>(text.data());
+    const size_t size = text.size();
+
+    out += '"';
+    size_t runStart = 0;
+    size_t i = 0;
+    while (i < size) {
+        // 整块跳过不含引号、反斜杠、控制字符和非 ASCII 字节的 8 字节
+        while (i + 8 <= size) {
+            const uint64_t word = loadWord(data + i);
+            if (hasByteLess(word, 0x20) | hasByte(word, '"') | hasByte(word, '\\') | (word & kByteHighs)) {
+                break;
+            }
+            i += 8;
+        }
+        if (i >= size) {
+            break;
+        }
+        const uint8_t kind = kJsonByteClass[data[i]];
+        if (kind == kJsonPlain) {
+            ++i;
+            continue;
+        }
+        if (kind == kJsonUtf8) {
+            if (const size_t length = utf8SequenceLength(data + i, size - i)) {
+                i += length;
+                continue;
+            }
+        }
+
+        // 先整段复制之前不需要处理的字节
+        out.append(text.data() + runStart, i - runStart);
+        if (kind == kJsonUtf8) {
+            out += "\\ufffd";
+        } else {
+            appendEscapedByte(out, data[i]);
+        }
+        runStart = ++i;
+    }
+    out.append(text.data() + runStart, size - runStart);
+    out += '"';
+}
+
+void appendJsonFieldValue(std::string& out, const LogField& field) {
+    switch (field.type) {
+        case LogFieldType::Bool:
+            out += field.boolValue ? "true" : "false";
+            break;
+        case LogFieldType::Int:
+            appendNumber(out, field.intValue);
+            break;
+        case LogFieldType::UInt:
+            appendNumber(out, field.uintValue);
+            break;
+        case LogFieldType::Double:
+            if (std::isfinite(field.doubleValue)) {
+                appendNumber(out, field.doubleValue);
+            } else {
+                out += "null";
+            }
+            break;
+        case LogFieldType::String:
+            appendJsonString(out, field.stringValue);
+            break;
+    }
+}
+
+void appendLogFieldsText(std::string& out, std::span<const LogField> fields) {
+    for (const LogField& field : fields) {
+        out += ' ';
+        out += field.key;
+        out += '=';
+        if (field.type != LogFieldType::String) {
+            appendJsonFieldValue(out, field);
+        } else if (needsQuotes(field.stringValue)) {
+            appendJsonString(out, field.stringValue);
+        } else {
+            out += field.stringValue;
+        }
+    }
+}
+
+// ================ LogFieldStorage ================
+
+void LogFieldStorage::assign(std::span<const LogField> fields) {
+    fields_.assign(fields.begin(), fields.end());
+    text_.clear();
+    for (const LogField& field : fields) {
+        text_ += field.key;
+        if (field.type == LogFieldType::String) {
+            text_ += field.stringValue;
+        }
+    }
+}
+
+std::span<const LogField> LogFieldStorage::view() {
+    const char* cursor = text_.data();
+    for (LogField& field : fields_) {
+        field.key = std::string_view(cursor, field.key.size());
+        cursor += field.key.size();
+        if (field.type == LogFieldType::String) {
+            field.stringValue = std::string_view(cursor, field.stringValue.size());
+            cursor += field.stringValue.size();
+        }
+    }
+    return fields_;
+}
+
+} // namespace Internal
+} // namespace CorePlatform
@@ -0,0 +1,356 @@
+#include "CorePlatform/Internal/LogFileReader.h"
+#include <stdexcept>
+#include <utility>
+
+#if defined(CP_PLATFORM_WINDOWS)
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace CorePlatform {
+namespace Internal {
+
+namespace {
+
+#if !defined(CP_PLATFORM_WINDOWS)
+// 映射超出文件末尾的预留长度（按当前大小取值，限制在这个范围内）
+constexpr uint64_t kMinMappingHeadroom = 1 << 20;
+constexpr uint64_t kMaxMappingHeadroom = 256 << 20;
+#endif
+
+// 在 [begin, end) 中反向查找字符
+const char* findLast(const char* begin, const char* end, char ch) {
+    while (end > begin) {
+        --end;
+        if (*end == ch) {
+            return end;
+        }
+    }
+    return nullptr;
+}
+
+} // 匿名命名空间
+
+LogFileReader::LogFileReader(std::string path) : path_(std::move(path)) {
+    resetIndex();
+}
+
+LogFileReader::~LogFileReader() {
+    unmap();
+    closeFile();
+}
+
+std::unique_ptr<LogFileReader> LogFileReader::fromBuffer(std::string path, std::string contents) {
+    auto reader = std::make_unique<LogFileReader>(std::move(path));
+    reader->inMemory_ = true;
+    reader->buffer_ = std::move(contents);
+    reader->data_ = reader->buffer_.data();
+    reader->size_ = reader->buffer_.size();
+    return reader;
+}
+
+bool LogFileReader::isSameFile(const LogFileReader& other) const {
+    if (inMemory_ || other.inMemory_) {
+        return false;
+    }
+    return device_ == other.device_ && inode_ == other.inode_;
+}
+
+void LogFileReader::unmap() {
+    if (inMemory_) {
+        return;
+    }
+    if (data_) {
+#if defined(CP_PLATFORM_WINDOWS)
+        UnmapViewOfFile(data_);
+#else
+        munmap(const_cast<char*>(data_), static_cast<size_t>(mappedSize_));
+#endif
+    }
+#if defined(CP_PLATFORM_WINDOWS)
+    if (mappingHandle_) {
+        CloseHandle(mappingHandle_);
+        mappingHandle_ = nullptr;
+    }
+#endif
+    data_ = nullptr;
+    size_ = 0;
+    mappedSize_ = 0;
+}
+
+void LogFileReader::closeFile() {
+#if defined(CP_PLATFORM_WINDOWS)
+    if (fileHandle_) {
+        CloseHandle(fileHandle_);
+        fileHandle_ = nullptr;
+    }
+#else
+    if (fd_ != -1) {
+        close(fd_);
+        fd_ = -1;
+    }
+#endif
+}
+
+void LogFileReader::resetIndex() {
+    checkpoints_.assign(1, 0);
+    completeLines_ = 0;
+    indexedBytes_ = 0;
+    indexedTail_.clear();
+}
+
+bool LogFileReader::indexedTailMatches() const {
+    if (indexedTail_.empty()) {
+        return true;
+    }
+    const char* tail = data_ + indexedBytes_ - indexedTail_.size();
+    return std::memcmp(tail, indexedTail_.data(), indexedTail_.size()) == 0;
+}
+
+void LogFileReader::refresh() {
+    if (inMemory_) {
+        return;
+    }
+
+#if defined(CP_PLATFORM_WINDOWS)
+    std::wstring widePath(path_.begin(), path_.end());
+    // 路径指向的文件被替换（例如轮转）时重新打开
+    if (fileHandle_) {
+        HANDLE probe = CreateFileW(widePath.c_str(), 0, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                   nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (probe != INVALID_HANDLE_VALUE) {
+            BY_HANDLE_FILE_INFORMATION info;
+            const bool replaced = GetFileInformationByHandle(probe, &info) &&
+                (info.dwVolumeSerialNumber != device_ ||
+                 ((static_cast<uint64_t>(info.nFileIndexHigh) << 32) | info.nFileIndexLow) != inode_);
+            CloseHandle(probe);
+            if (replaced) {
+                unmap();
+                closeFile();
+                resetIndex();
+            }
+        }
+    }
+
+    if (!fileHandle_) {
+        HANDLE handle = CreateFileW(widePath.c_str(), GENERIC_READ,
+                                    FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                    nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (handle == INVALID_HANDLE_VALUE) {
+            throw std::runtime_error("Unable to open log file: " + path_);
+        }
+        fileHandle_ = handle;
+
+        BY_HANDLE_FILE_INFORMATION info;
+        if (GetFileInformationByHandle(handle, &info)) {
+            device_ = info.dwVolumeSerialNumber;
+            inode_ = (static_cast<uint64_t>(info.nFileIndexHigh) << 32) | info.nFileIndexLow;
+        }
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(fileHandle_, &fileSize)) {
+        throw std::runtime_error("Unable to stat log file: " + path_);
+    }
+    const uint64_t newSize = static_cast<uint64_t>(fileSize.QuadPart);
+#else
+    // 路径指向的文件被替换（例如轮转）时重新打开
+    struct stat pathStat;
+    const bool pathExists = stat(path_.c_str(), &pathStat) == 0;
+    if (fd_ != -1 && pathExists &&
+        (static_cast<uint64_t>(pathStat.st_dev) != device_ ||
+         static_cast<uint64_t>(pathStat.st_ino) != inode_)) {
+        unmap();
+        closeFile();
+        resetIndex();
+    } else if (fd_ != -1 && !pathExists) {
+        // 路径不存在：轮转时文件只是被重命名，继续读取；文件已被删除时与从未存在一样报错
+        struct stat openedStat;
+        if (fstat(fd_, &openedStat) == 0 && openedStat.st_nlink == 0) {
+            unmap();
+            closeFile();
+            resetIndex();
+        }
+    }
+
+    if (fd_ == -1) {
+        fd_ = open(path_.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd_ == -1) {
+            throw std::runtime_error("Unable to open log file: " + path_);
+        }
+    }
+
+    struct stat st;
+    if (fstat(fd_, &st) != 0) {
+        throw std::runtime_error("Unable to stat log file: " + path_);
+    }
+    device_ = static_cast<uint64_t>(st.st_dev);
+    inode_ = static_cast<uint64_t>(st.st_ino);
+    const uint64_t newSize = static_cast<uint64_t>(st.st_size);
+#endif
+
+    // 文件被截断，或截断后又写入了至少同样多的内容：之前的索引全部失效。
+    // 文件不短于 indexedBytes_，比较已映射的部分不会越过文件末尾
+    if (newSize < indexedBytes_ || !indexedTailMatches()) {
+        resetIndex();
+    }
+
+#if defined(CP_PLATFORM_WINDOWS)
+    // 只读的映射对象不能超过文件大小，大小变化时重新映射
+    if (newSize == size_ && (data_ || newSize == 0)) {
+        return;
+    }
+    unmap();
+    if (newSize == 0) {
+        return;
+    }
+    mappingHandle_ = CreateFileMappingW(fileHandle_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mappingHandle_) {
+        throw std::runtime_error("Unable to map log file: " + path_);
+    }
+    void* view = MapViewOfFile(mappingHandle_, FILE_MAP_READ, 0, 0, static_cast<SIZE_T>(newSize));
+    if (!view) {
+        CloseHandle(mappingHandle_);
+        mappingHandle_ = nullptr;
+        throw std::runtime_error("Unable to map log file: " + path_);
+    }
+    data_ = static_cast<const char*>(view);
+    mappedSize_ = newSize;
+#else
+    // 映射足够长时只更新可见的大小：已访问的页保持映射，追加写入不必重新映射整个文件
+    if (newSize > mappedSize_) {
+        const uint64_t headroom = std::clamp(newSize, kMinMappingHeadroom, kMaxMappingHeadroom);
+        const uint64_t length = newSize + headroom;
+        void* view = mmap(nullptr, static_cast<size_t>(length), PROT_READ, MAP_SHARED, fd_, 0);
+        if (view == MAP_FAILED) {
+            throw std::runtime_error("Unable to map log file: " + path_);
+        }
+        unmap();
+        data_ = static_cast<const char*>(view);
+        mappedSize_ = length;
+    }
+#endif
+
+    size_ = newSize;
+}
+
+void LogFileReader::extendIndex() {
+    const char* const end = data_ + size_;
+    const char* cursor = data_ + indexedBytes_;
+
+    while (cursor < end) {
+        const void* hit = memchr(cursor, '\n', static_cast<size_t>(end - cursor));
+        if (!hit) {
+            break;
+        }
+        cursor = static_cast<const char*>(hit) + 1;
+        ++completeLines_;
+        if (completeLines_ % kIndexStride == 0) {
+            checkpoints_.push_back(static_cast<uint64_t>(cursor - data_));
+        }
+    }
+
+    const uint64_t indexed = static_cast<uint64_t>(cursor - data_);
+    if (indexed != indexedBytes_) {
+        const size_t tailSize = static_cast<size_t>(std::min<uint64_t>(indexed, kTailFingerprintSize));
+        indexedTail_.assign(cursor - tailSize, tailSize);
+        indexedBytes_ = indexed;
+    }
+}
+
+size_t LogFileReader::lineCount() {
+    extendIndex();
+    return completeLines_ + (indexedBytes_ < size_ ? 1 : 0);
+}
+
+uint64_t LogFileReader::lineOffset(size_t index) {
+    if (index > completeLines_) {
+        extendIndex();
+    }
+
+    uint64_t offset = checkpoints_[index / kIndexStride];
+    for (size_t skip = index % kIndexStride; skip > 0; --skip) {
+        const void* hit = memchr(data_ + offset, '\n', static_cast<size_t>(size_ - offset));
+        offset = static_cast<uint64_t>(static_cast<const char*>(hit) - data_) + 1;
+    }
+    return offset;
+}
+
+std::string_view LogFileReader::linesView(size_t first, size_t last) {
+    const size_t total = lineCount();
+    last = std::min(last, total);
+    if (first >= last) {
+        return std::string_view();
+    }
+
+    const uint64_t begin = lineOffset(first);
+    const uint64_t end = last < total ? lineOffset(last) : size_;
+    return std::string_view(data_ + begin, static_cast<size_t>(end - begin));
+}
+
+std::string_view LogFileReader::lineAt(uint64_t offset) const {
+    const char* begin = data_ + offset;
+    const void* hit = memchr(begin, '\n', static_cast<size_t>(size_ - offset));
+    const char* end = hit ? static_cast<const char*>(hit) : data_ + size_;
+    return std::string_view(begin, static_cast<size_t>(end - begin));
+}
+
+std::vector<std::string> LogFileReader::readLines(size_t first, size_t last) {
+    std::vector<std::string> result;
+    const size_t total = lineCount();
+    if (first < last && first < total) {
+        result.reserve(std::min(last, total) - first);
+    }
+    forEachLine(first, last, [&result](size_t, std::string_view line) {
+        result.emplace_back(line);
+        return true;
+    });
+    return result;
+}
+
+std::vector<std::string> LogFileReader::readHead(size_t maxLines) {
+    std::vector<std::string> result;
+    const char* cursor = data_;
+    const char* const end = data_ + size_;
+
+    while (cursor < end && result.size() < maxLines) {
+        const void* hit = memchr(cursor, '\n', static_cast<size_t>(end - cursor));
+        const char* lineEnd = hit ? static_cast<const char*>(hit) : end;
+        result.emplace_back(trimLineEnding(std::string_view(cursor, static_cast<size_t>(lineEnd - cursor))));
+        cursor = lineEnd + 1;
+    }
+    return result;
+}
+
+std::vector<std::string> LogFileReader::readTail(size_t maxLines) {
+    std::vector<std::string> result;
+    if (size_ == 0 || maxLines == 0) {
+        return result;
+    }
+
+    // 末尾换行符属于最后一行，不产生空行
+    const char* lineEnd = data_ + size_;
+    if (lineEnd[-1] == '\n') {
+        --lineEnd;
+    }
+
+    while (result.size() < maxLines) {
+        const char* newline = findLast(data_, lineEnd, '\n');
+        const char* lineBegin = newline ? newline + 1 : data_;
+        result.emplace_back(trimLineEnding(std::string_view(lineBegin, static_cast<size_t>(lineEnd - lineBegin))));
+        if (!newline) {
+            break;
+        }
+        lineEnd = newline;
+    }
+
+    std::reverse(result.begin(), result.end());
+    return result;
+}
+
+} // namespace Internal
+} // namespace CorePlatform
@@ -0,0 +1,500 @@
+#include "CorePlatform/Internal/LogRotation.h"
+#include "CorePlatform/Internal/LogFileReader.h"
+#include "CorePlatform/Internal/LogTimeSearch.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <string_view>
+#include <system_error>
+
+#if defined(CP_HAVE_ZLIB)
+#include <zlib.h>
+#endif
+
+#if defined(CP_PLATFORM_WINDOWS)
+#include <windows.h>
+#elif defined(CP_PLATFORM_LINUX)
+#include <sys/resource.h>
+#elif defined(CP_PLATFORM_MACOS)
+#include <pthread.h>
+#endif
+
+namespace CorePlatform {
+namespace Internal {
+
+namespace {
+
+constexpr const char* kCompressedSuffix = ".gz";
+
+// 按时间跳过分段时读取的开头字节数，足以容纳第一条日志行的时间戳
+constexpr size_t kSegmentHeadBytes = 4096;
+
+// 文件修改时间与行内时间戳比较时的余量：时间戳可能只精确到秒，文件系统时间戳按时钟节拍取值
+constexpr std::chrono::seconds kModifiedTimeSlack{2};
+
+// 进程内完整解压 .gz 分段的次数
+std::atomic<uint64_t> g_compressedReads{0};
+
+// 解析 "<日志文件名>.<序号>[.gz]"，不匹配时返回 false
+bool parseSegmentName(const std::string& name, const std::string& baseName, LogSegment& segment) {
+    if (name.size() <= baseName.size() + 1 ||
+        name.compare(0, baseName.size(), baseName) != 0 ||
+        name[baseName.size()] != '.') {
+        return false;
+    }
+
+    std::string_view rest(name);
+    rest.remove_prefix(baseName.size() + 1);
+    segment.compressed = rest.size() > 3 && rest.substr(rest.size() - 3) == kCompressedSuffix;
+    if (segment.compressed) {
+        rest.remove_suffix(3);
+    }
+    if (rest.empty() || rest.size() > 19) {
+        return false;
+    }
+
+    uint64_t sequence = 0;
+    for (char ch : rest) {
+        if (ch < '0' || ch > '9') {
+            return false;
+        }
+        sequence = sequence * 10 + static_cast<uint64_t>(ch - '0');
+    }
+    segment.sequence = sequence;
+    return true;
+}
+
+// 压缩为 "<分段>.gz"：先写临时文件再重命名，最后删除原分段
+bool compressSegment(const std::string& path) {
+#if defined(CP_HAVE_ZLIB)
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return false;
+    }
+
+    const std::string compressedPath = path + kCompressedSuffix;
+    const std::string tempPath = compressedPath + ".tmp";
+    gzFile out = gzopen(tempPath.c_str(), "wb6");
+    if (!out) {
+        return false;
+    }
+
+    bool ok = true;
+    char buffer[64 * 1024];
+    while (ok && in) {
+        in.read(buffer, sizeof(buffer));
+        const int count = static_cast<int>(in.gcount());
+        if (count > 0 && gzwrite(out, buffer, static_cast<unsigned>(count)) != count) {
+            ok = false;
+        }
+    }
+    if (gzclose(out) != Z_OK) {
+        ok = false;
+    }
+    in.close();
+
+    std::error_code ec;
+    if (ok) {
+        // 保留原分段的修改时间，按时间查询时据此跳过整个分段
+        const auto modified = std::filesystem::last_write_time(path, ec);
+        if (!ec) {
+            std::filesystem::last_write_time(tempPath, modified, ec);
+        }
+        std::filesystem::rename(tempPath, compressedPath, ec);
+        ok = !ec;
+    }
+    if (!ok) {
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+    std::filesystem::remove(path, ec);
+    return true;
+#else
+    (void)path;
+    return false;
+#endif
+}
+
+// 删除超出保留个数的最旧分段
+void pruneSegments(const std::string& logPath, size_t maxFiles) {
+    std::vector<LogSegment> segments = listLogSegments(logPath);
+    if (segments.size() <= maxFiles) {
+        return;
+    }
+
+    const size_t excess = segments.size() - maxFiles;
+    for (size_t i = 0; i < excess; ++i) {
+        std::error_code ec;
+        const std::string plainPath = logSegmentPath(logPath, segments[i].sequence);
+        std::filesystem::remove(plainPath, ec);
+        std::filesystem::remove(plainPath + kCompressedSuffix, ec);
+    }
+}
+
+// 维护线程只做后台工作，降低其调度优先级
+void lowerCurrentThreadPriority() {
+#if defined(CP_PLATFORM_WINDOWS)
+    SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_LOWEST);
+#elif defined(CP_PLATFORM_LINUX)
+    // Linux 上 nice 值按线程生效，who 为 0 时只影响调用线程
+    setpriority(PRIO_PROCESS, 0, 19);
+#elif defined(CP_PLATFORM_MACOS)
+    pthread_set_qos_class_self_np(QOS_CLASS_BACKGROUND, 0);
+#endif
+}
+
+} // 匿名命名空间
+
+std::string logSegmentPath(const std::string& logPath, uint64_t sequence) {
+    char suffix[32];
+    std::snprintf(suffix, sizeof(suffix), ".%06llu", static_cast<unsigned long long>(sequence));
+    return logPath + suffix;
+}
+
+std::vector<LogSegment> listLogSegments(const std::string& logPath) {
+    std::vector<LogSegment> segments;
+    const std::filesystem::path path(logPath);
+    const std::string baseName = path.filename().string();
+    std::filesystem::path dir = path.parent_path();
+    if (dir.empty()) {
+        dir = ".";
+    }
+
+    std::error_code ec;
+    for (std::filesystem::directory_iterator it(dir, ec), end; !ec && it != end; it.increment(ec)) {
+        LogSegment segment;
+        if (parseSegmentName(it->path().filename().string(), baseName, segment)) {
+            segment.path = (dir / it->path().filename()).string();
+            segments.push_back(std::move(segment));
+        }
+    }
+
+    // 同一序号时未压缩的排在前面，随后去重
+    std::sort(segments.begin(), segments.end(), [](const LogSegment& a, const LogSegment& b) {
+        return a.sequence != b.sequence ? a.sequence < b.sequence : a.compressed < b.compressed;
+    });
+    segments.erase(std::unique(segments.begin(), segments.end(),
+                               [](const LogSegment& a, const LogSegment& b) {
+                                   return a.sequence == b.sequence;
+                               }),
+                   segments.end());
+    return segments;
+}
+
+bool logCompressionAvailable() {
+#if defined(CP_HAVE_ZLIB)
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool readCompressedLogSegment(const std::string& path, std::string& out) {
+#if defined(CP_HAVE_ZLIB)
+    gzFile in = gzopen(path.c_str(), "rb");
+    if (!in) {
+        return false;
+    }
+    gzbuffer(in, 128 * 1024);
+    g_compressedReads.fetch_add(1, std::memory_order_relaxed);
+
+    out.clear();
+    char buffer[64 * 1024];
+    int count = 0;
+    while ((count = gzread(in, buffer, sizeof(buffer))) > 0) {
+        out.append(buffer, static_cast<size_t>(count));
+    }
+    const bool ok = count == 0;
+    gzclose(in);
+    return ok;
+#else
+    (void)path;
+    (void)out;
+    return false;
+#endif
+}
+
+bool readCompressedLogSegmentHead(const std::string& path, size_t maxBytes, std::string& out) {
+#if defined(CP_HAVE_ZLIB)
+    gzFile in = gzopen(path.c_str(), "rb");
+    if (!in) {
+        return false;
+    }
+
+    out.assign(maxBytes, '\0');
+    size_t total = 0;
+    int count = 0;
+    while (total < maxBytes &&
+           (count = gzread(in, out.data() + total, static_cast<unsigned>(maxBytes - total))) > 0) {
+        total += static_cast<size_t>(count);
+    }
+    gzclose(in);
+    out.resize(total);
+    return count >= 0;
+#else
+    (void)path;
+    (void)maxBytes;
+    (void)out;
+    return false;
+#endif
+}
+
+uint64_t compressedLogSegmentReads() {
+    return g_compressedReads.load(std::memory_order_relaxed);
+}
+
+bool measureCompressedLogSegment(const std::string& path, size_t& lineCount, uint64_t& size) {
+#if defined(CP_HAVE_ZLIB)
+    gzFile in = gzopen(path.c_str(), "rb");
+    if (!in) {
+        return false;
+    }
+    gzbuffer(in, 128 * 1024);
+
+    size_t newlines = 0;
+    uint64_t total = 0;
+    char last = '\n';
+    char buffer[64 * 1024];
+    int count = 0;
+    while ((count = gzread(in, buffer, sizeof(buffer))) > 0) {
+        newlines += static_cast<size_t>(std::count(buffer, buffer + count, '\n'));
+        total += static_cast<uint64_t>(count);
+        last = buffer[count - 1];
+    }
+    const bool ok = count == 0;
+    gzclose(in);
+    if (!ok) {
+        return false;
+    }
+
+    lineCount = newlines + (last != '\n' ? 1 : 0);
+    size = total;
+    return true;
+#else
+    (void)path;
+    (void)lineCount;
+    (void)size;
+    return false;
+#endif
+}
+
+std::chrono::system_clock::time_point nextDailyRotation(std::chrono::system_clock::time_point now, int hour) {
+    std::time_t t = std::chrono::system_clock::to_time_t(now);
+    std::tm bt{};
+#ifdef _WIN32
+    localtime_s(&bt, &t);
+#else
+    localtime_r(&t, &bt);
+#endif
+    bt.tm_hour = std::clamp(hour, 0, 23);
+    bt.tm_min = 0;
+    bt.tm_sec = 0;
+    bt.tm_isdst = -1;
+    std::tm sameDay = bt;
+    auto next = std::chrono::system_clock::from_time_t(std::mktime(&sameDay));
+    if (next <= now) {
+        // 今天的轮转时刻已过；按日期加一再换算，夏令时切换当天也落在本地 hour 点
+        bt.tm_mday += 1;
+        next = std::chrono::system_clock::from_time_t(std::mktime(&bt));
+    }
+    return next;
+}
+
+// ================ LogSegmentReader ================
+
+LogSegmentReader::LogSegmentReader(LogFileReader& file)
+    : path_(file.path()), file_(&file) {
+}
+
+LogSegmentReader::LogSegmentReader(const LogSegment& segment, LogSegmentCache& cache)
+    : path_(segment.path) {
+    if (segment.compressed) {
+        cache_ = &cache;
+        return;
+    }
+    owned_ = std::make_unique<LogFileReader>(segment.path);
+    owned_->refresh();
+    file_ = owned_.get();
+}
+
+LogSegmentReader::~LogSegmentReader() {
+    if (cache_) {
+        cache_->remove(*this);
+    }
+}
+
+bool LogSegmentReader::isSameFile(const LogFileReader& file) const {
+    return !cache_ && file_->isSameFile(file);
+}
+
+size_t LogSegmentReader::lineCount() {
+    if (file_) {
+        return file_->lineCount();
+    }
+    if (!measured_) {
+        measured_ = measureCompressedLogSegment(path_, lineCount_, size_);
+    }
+    return lineCount_;
+}
+
+uint64_t LogSegmentReader::size() {
+    if (file_) {
+        return file_->contents().size();
+    }
+    lineCount();
+    return size_;
+}
+
+LogFileReader* LogSegmentReader::load() {
+    if (cache_ && !file_) {
+        std::string contents;
+        if (!readCompressedLogSegment(path_, contents)) {
+            return nullptr;
+        }
+        owned_ = LogFileReader::fromBuffer(path_, std::move(contents));
+        file_ = owned_.get();
+    }
+    if (cache_) {
+        cache_->touch(*this);
+    }
+    return file_;
+}
+
+bool LogSegmentReader::endsBefore(std::chrono::system_clock::time_point time) const {
+    // 分段中的每一行都在写入文件之前取得时间戳，修改时间不早于最后一行的时间
+    std::error_code ec;
+    const auto modified = std::filesystem::last_write_time(path_, ec);
+    if (ec) {
+        return false;
+    }
+    return std::chrono::file_clock::to_sys(modified) + kModifiedTimeSlack < time;
+}
+
+bool LogSegmentReader::startsNotBefore(const LogTimeBound& bound) {
+    std::string head;
+    std::string_view view;
+    if (file_) {
+        view = file_->contents().substr(0, kSegmentHeadBytes);
+    } else if (readCompressedLogSegmentHead(path_, kSegmentHeadBytes, head)) {
+        view = head;
+    }
+    // 只比较完整的行，开头的续行没有时间戳，跳过
+    while (!view.empty()) {
+        const size_t newline = view.find('\n');
+        if (newline == std::string_view::npos) {
+            break;
+        }
+        bool early = false;
+        if (bound.isBefore(view.substr(0, newline), early)) {
+            return !early;
+        }
+        view.remove_prefix(newline + 1);
+    }
+    return false;
+}
+
+uint64_t LogSegmentReader::unload() {
+    if (!cache_ || !file_) {
+        return 0;
+    }
+    // 行数已由索引得出，释放内容后仍可定位行号
+    lineCount_ = file_->lineCount();
+    size_ = file_->contents().size();
+    measured_ = true;
+    file_ = nullptr;
+    owned_.reset();
+    return size_;
+}
+
+// ================ LogSegmentCache ================
+
+void LogSegmentCache::touch(LogSegmentReader& segment) {
+    auto it = std::find(recent_.begin(), recent_.end(), &segment);
+    if (it == recent_.end()) {
+        used_ += segment.size();
+        recent_.push_front(&segment);
+    } else {
+        recent_.splice(recent_.begin(), recent_, it);
+    }
+
+    while (used_ > capacity_ && recent_.size() > 1) {
+        used_ -= recent_.back()->unload();
+        recent_.pop_back();
+    }
+}
+
+void LogSegmentCache::remove(LogSegmentReader& segment) {
+    auto it = std::find(recent_.begin(), recent_.end(), &segment);
+    if (it != recent_.end()) {
+        used_ -= segment.size();
+        recent_.erase(it);
+    }
+}
+
+// ================ LogMaintenanceWorker ================
+
+LogMaintenanceWorker::LogMaintenanceWorker() {
+    thread_ = std::thread([this]() { run(); });
+}
+
+LogMaintenanceWorker::~LogMaintenanceWorker() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    taskCv_.notify_one();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void LogMaintenanceWorker::schedule(std::string logPath, std::string segmentPath,
+                                    bool compress, size_t maxFiles) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_.push_back(Task{std::move(logPath), std::move(segmentPath), compress, maxFiles});
+    }
+    taskCv_.notify_one();
+}
+
+void LogMaintenanceWorker::waitIdle() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idleCv_.wait(lock, [this]() { return tasks_.empty() && !busy_; });
+}
+
+void LogMaintenanceWorker::run() {
+    lowerCurrentThreadPriority();
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        taskCv_.wait(lock, [this]() { return stopping_ || !tasks_.empty(); });
+        if (tasks_.empty()) {
+            return;
+        }
+
+        Task task = std::move(tasks_.front());
+        tasks_.pop_front();
+        busy_ = true;
+        lock.unlock();
+
+        // 先删除再压缩，避免压缩即将被删除的分段
+        if (task.maxFiles > 0) {
+            pruneSegments(task.logPath, task.maxFiles);
+        }
+        if (task.compress) {
+            compressSegment(task.segmentPath);
+        }
+
+        lock.lock();
+        busy_ = false;
+        if (tasks_.empty()) {
+            idleCv_.notify_all();
+        }
+    }
+}
+
+} // namespace Internal
+} // namespace CorePlatform
@@ -0,0 +1,199 @@
+#include "CorePlatform/Internal/LogSearch.h"
+#include "CorePlatform/Internal/PlatformDetection.h"
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define CP_LOG_SEARCH_SSE2 1
+    #include <emmintrin.h>
+    #if defined(CP_COMPILER_GCC) || defined(CP_COMPILER_CLANG)
+        // AVX2 版本通过 target 属性单独编译，运行时检测 CPU 后启用
+        #define CP_LOG_SEARCH_AVX2 1
+        #include <immintrin.h>
+    #endif
+#elif defined(__aarch64__) || defined(_M_ARM64) || defined(__ARM_NEON)
+    #define CP_LOG_SEARCH_NEON 1
+    #include <arm_neon.h>
+#endif
+
+namespace CorePlatform {
+namespace Internal {
+
+namespace {
+
+constexpr char upperAsciiCase(char ch) {
+    return (ch >= 'a' && ch <= 'z') ? static_cast<char>(ch - ('a' - 'A')) : ch;
+}
+
+// 校验 text 开头是否与（已转小写的）模式串匹配
+CP_FORCE_INLINE bool matchesAt(const char* text, const std::string& pattern) {
+    for (size_t i = 0; i < pattern.size(); ++i) {
+        if (foldAsciiCase(text[i]) != pattern[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 标量实现：也用于处理向量化版本剩余的尾部
+size_t findScalar(const char* text, size_t size, size_t from, const std::string& pattern) {
+    const size_t m = pattern.size();
+    const char lower = pattern[0];
+    const char upper = upperAsciiCase(lower);
+
+    for (size_t i = from; i + m <= size; ++i) {
+        if ((text[i] == lower || text[i] == upper) && matchesAt(text + i, pattern)) {
+            return i;
+        }
+    }
+    return CaseInsensitiveMatcher::npos;
+}
+
+#if defined(CP_LOG_SEARCH_SSE2)
+
+// 用模式串首尾字符（两种大小写）筛选候选位置，每次处理 16 字节
+size_t findSse2(const char* text, size_t size, size_t from, const std::string& pattern) {
+    const size_t m = pattern.size();
+    const __m128i firstLower = _mm_set1_epi8(pattern.front());
+    const __m128i firstUpper = _mm_set1_epi8(upperAsciiCase(pattern.front()));
+    const __m128i lastLower = _mm_set1_epi8(pattern.back());
+    const __m128i lastUpper = _mm_set1_epi8(upperAsciiCase(pattern.back()));
+
+    size_t i = from;
+    for (; i + m - 1 + 16 <= size; i += 16) {
+        const __m128i head = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i));
+        const __m128i tail = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i + m - 1));
+        const __m128i headHit = _mm_or_si128(_mm_cmpeq_epi8(head, firstLower), _mm_cmpeq_epi8(head, firstUpper));
+        const __m128i tailHit = _mm_or_si128(_mm_cmpeq_epi8(tail, lastLower), _mm_cmpeq_epi8(tail, lastUpper));
+
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(headHit, tailHit)));
+        while (mask != 0) {
+            const size_t candidate = i + static_cast<size_t>(std::countr_zero(mask));
+            if (matchesAt(text + candidate, pattern)) {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+    }
+    return findScalar(text, size, i, pattern);
+}
+
+#endif
+
+#if defined(CP_LOG_SEARCH_AVX2)
+
+// 与 SSE2 版本相同的筛选方式，每次处理 32 字节
+__attribute__((target("avx2")))
+size_t findAvx2(const char* text, size_t size, size_t from, const std::string& pattern) {
+    const size_t m = pattern.size();
+    const __m256i firstLower = _mm256_set1_epi8(pattern.front());
+    const __m256i firstUpper = _mm256_set1_epi8(upperAsciiCase(pattern.front()));
+    const __m256i lastLower = _mm256_set1_epi8(pattern.back());
+    const __m256i lastUpper = _mm256_set1_epi8(upperAsciiCase(pattern.back()));
+
+    size_t i = from;
+    for (; i + m - 1 + 32 <= size; i += 32) {
+        const __m256i head = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + i));
+        const __m256i tail = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + i + m - 1));
+        const __m256i headHit = _mm256_or_si256(_mm256_cmpeq_epi8(head, firstLower), _mm256_cmpeq_epi8(head, firstUpper));
+        const __m256i tailHit = _mm256_or_si256(_mm256_cmpeq_epi8(tail, lastLower), _mm256_cmpeq_epi8(tail, lastUpper));
+
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(headHit, tailHit)));
+        while (mask != 0) {
+            const size_t candidate = i + static_cast<size_t>(std::countr_zero(mask));
+            if (matchesAt(text + candidate, pattern)) {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+    }
+    return findSse2(text, size, i, pattern);
+}
+
+#endif
+
+#if defined(CP_LOG_SEARCH_NEON)
+
+// NEON 没有 movemask：把比较结果窄化为每字节 4 位的 64 位掩码
+size_t findNeon(const char* text, size_t size, size_t from, const std::string& pattern) {
+    const size_t m = pattern.size();
+    const uint8x16_t firstLower = vdupq_n_u8(static_cast<uint8_t>(pattern.front()));
+    const uint8x16_t firstUpper = vdupq_n_u8(static_cast<uint8_t>(upperAsciiCase(pattern.front())));
+    const uint8x16_t lastLower = vdupq_n_u8(static_cast<uint8_t>(pattern.back()));
+    const uint8x16_t lastUpper = vdupq_n_u8(static_cast<uint8_t>(upperAsciiCase(pattern.back())));
+
+    size_t i = from;
+    for (; i + m - 1 + 16 <= size; i += 16) {
+        const uint8x16_t head = vld1q_u8(reinterpret_cast<const uint8_t*>(text + i));
+        const uint8x16_t tail = vld1q_u8(reinterpret_cast<const uint8_t*>(text + i + m - 1));
+        const uint8x16_t headHit = vorrq_u8(vceqq_u8(head, firstLower), vceqq_u8(head, firstUpper));
+        const uint8x16_t tailHit = vorrq_u8(vceqq_u8(tail, lastLower), vceqq_u8(tail, lastUpper));
+        const uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(vandq_u8(headHit, tailHit)), 4);
+
+        uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(narrowed), 0) & 0x8888888888888888ULL;
+        while (mask != 0) {
+            const size_t candidate = i + static_cast<size_t>(std::countr_zero(mask) >> 2);
+            if (matchesAt(text + candidate, pattern)) {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+    }
+    return findScalar(text, size, i, pattern);
+}
+
+#endif
+
+using FindFunction = size_t (*)(const char*, size_t, size_t, const std::string&);
+
+struct Implementation {
+    FindFunction find;
+    const char* name;
+};
+
+Implementation selectImplementation() {
+#if defined(CP_LOG_SEARCH_AVX2)
+    if (__builtin_cpu_supports("avx2")) {
+        return {findAvx2, "avx2"};
+    }
+#endif
+#if defined(CP_LOG_SEARCH_SSE2)
+    return {findSse2, "sse2"};
+#elif defined(CP_LOG_SEARCH_NEON)
+    return {findNeon, "neon"};
+#else
+    return {findScalar, "scalar"};
+#endif
+}
+
+const Implementation& activeImplementation() {
+    static const Implementation implementation = selectImplementation();
+    return implementation;
+}
+
+} // 匿名命名空间
+
+CaseInsensitiveMatcher::CaseInsensitiveMatcher(std::string_view pattern) {
+    pattern_.reserve(pattern.size());
+    for (char ch : pattern) {
+        pattern_ += foldAsciiCase(ch);
+    }
+}
+
+size_t CaseInsensitiveMatcher::find(std::string_view text, size_t from) const {
+    if (pattern_.empty()) {
+        return from <= text.size() ? from : npos;
+    }
+    if (from >= text.size() || text.size() - from < pattern_.size()) {
+        return npos;
+    }
+    return activeImplementation().find(text.data(), text.size(), from, pattern_);
+}
+
+const char* CaseInsensitiveMatcher::implementationName() {
+    return activeImplementation().name;
+}
+
+} // namespace Internal
+} // namespace CorePlatform
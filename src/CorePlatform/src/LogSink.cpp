@@ -0,0 +1,608 @@
+#include "CorePlatform/LogSink.h"
+#include "CorePlatform/Internal/AsyncLogQueue.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+
+#if !defined(CP_PLATFORM_WINDOWS)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#endif
+
+#if defined(CP_PLATFORM_LINUX)
+#include <sys/mman.h>
+#endif
+
+#if defined(CP_PLATFORM_MACOS)
+#include <stdlib.h>
+#endif
+
+namespace CorePlatform {
+
+namespace {
+
+// 连接 syslog 守护进程失败后的退避时间，每次失败翻倍
+constexpr auto kMinReconnectDelay = std::chrono::milliseconds(100);
+constexpr auto kMaxReconnectDelay = std::chrono::seconds(30);
+
+// 偶发的超长日志不应让输出长期占用大块内存
+constexpr size_t kMaxRetainedCapacity = 64 * 1024;
+
+#if !defined(CP_PLATFORM_WINDOWS)
+// 日志级别对应的 syslog 严重程度
+int syslogSeverity(LogLevel level) {
+    switch (level) {
+        case LogLevel::FATAL: return 2;  // LOG_CRIT
+        case LogLevel::ERR:   return 3;  // LOG_ERR
+        case LogLevel::WARN:  return 4;  // LOG_WARNING
+        case LogLevel::INFO:  return 6;  // LOG_INFO
+        default:              return 7;  // LOG_DEBUG
+    }
+}
+
+// 当前进程名，用作默认的 syslog 标识
+std::string processName() {
+#if defined(CP_PLATFORM_LINUX)
+    return program_invocation_short_name;
+#elif defined(CP_PLATFORM_MACOS)
+    return getprogname();
+#else
+    return "CorePlatform";
+#endif
+}
+#endif
+
+} // 匿名命名空间
+
+const char* logLevelName(LogLevel level) {
+    switch (level) {
+        case LogLevel::TRACE: return "TRACE";
+        case LogLevel::DEBUG: return "DEBUG";
+        case LogLevel::INFO:  return "INFO";
+        case LogLevel::WARN:  return "WARN";
+        case LogLevel::ERR:   return "ERROR";
+        case LogLevel::FATAL: return "FATAL";
+        default: return "UNKNOWN";
+    }
+}
+
+bool parseLogLevel(std::string_view text, LogLevel& level) {
+    std::string upper(text);
+    for (char& ch : upper) {
+        if (ch >= 'a' && ch <= 'z') ch = static_cast<char>(ch - 'a' + 'A');
+    }
+    if (upper == "TRACE") level = LogLevel::TRACE;
+    else if (upper == "DEBUG") level = LogLevel::DEBUG;
+    else if (upper == "INFO") level = LogLevel::INFO;
+    else if (upper == "WARN" || upper == "WARNING") level = LogLevel::WARN;
+    else if (upper == "ERROR" || upper == "ERR") level = LogLevel::ERR;
+    else if (upper == "FATAL") level = LogLevel::FATAL;
+    else return false;
+    return true;
+}
+
+namespace Internal {
+
+const char* consoleColorCode(LogLevel level) {
+    switch (level) {
+        case LogLevel::FATAL: return "\033[41;37m"; // 红底白字
+        case LogLevel::ERR:   return "\033[31;1m";  // 红色加粗
+        case LogLevel::WARN:  return "\033[33;1m";  // 黄色加粗
+        case LogLevel::INFO:  return "\033[32;1m";  // 绿色加粗
+        case LogLevel::DEBUG: return "\033[34;1m";  // 蓝色加粗
+        case LogLevel::TRACE: return "\033[36m";    // 青色
+        default: return "\033[0m";
+    }
+}
+
+} // namespace Internal
+
+// ================ LogSink ================
+
+class LogSink::Queue : public Internal::AsyncLogQueue<LogSink::Record> {
+public:
+    using AsyncLogQueue::AsyncLogQueue;
+};
+
+LogSink::LogSink(const LogSinkOptions& options)
+    : options_(options),
+      level_(options.level),
+      lastFlush_(std::chrono::steady_clock::now()) {
+    if (options_.asynchronous) {
+        // 队列在构造完成之前一定为空，后台线程不会提前调用派生类的虚函数
+        queue_ = std::make_unique<Queue>(
+            options_.queueCapacity, options_.overflowPolicy,
+            [this](std::vector<Record>& batch) { writeBatch(batch); },
+            [this] { return flushIfDue(); });
+        queue_->start();
+    }
+}
+
+LogSink::~LogSink() {
+    stop();
+}
+
+void LogSink::setLevel(LogLevel level) {
+    level_.store(level, std::memory_order_relaxed);
+}
+
+LogLevel LogSink::getLevel() const {
+    return level_.load(std::memory_order_relaxed);
+}
+
+void LogSink::setFormatter(LogFormatter formatter) {
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    formatter_ = std::move(formatter);
+}
+
+uint64_t LogSink::getDroppedCount() const {
+    const uint64_t writeDropped = writeDropped_.load(std::memory_order_relaxed);
+    return queue_ ? queue_->droppedCount() + writeDropped : writeDropped;
+}
+
+void LogSink::log(LogLevel level, std::chrono::system_clock::time_point time, std::string_view message,
+                  std::span<const LogField> fields) {
+    if (!shouldLog(level)) return;
+
+    if (queue_ && queue_->running()) {
+        Record record{level, time, std::string(message), {}};
+        if (!fields.empty()) {
+            record.fields.assign(fields);
+        }
+        if (queue_->submit(std::move(record), level >= options_.flushLevel)) {
+            return;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    writeUnlocked(level, time, message, fields);
+    maybeFlushUnlocked(level, std::chrono::steady_clock::now());
+}
+
+void LogSink::flush() {
+    if (queue_) {
+        queue_->waitUntilDrained();
+    }
+
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    flushOutput();
+    pendingFlush_ = false;
+    lastFlush_ = std::chrono::steady_clock::now();
+}
+
+void LogSink::stop() {
+    if (queue_) {
+        queue_->stop();
+    }
+
+    // 派生类与基类析构都会调用，第二次调用时已无待刷新内容，不会再调用虚函数
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    if (pendingFlush_) {
+        flushOutput();
+        pendingFlush_ = false;
+    }
+}
+
+void LogSink::formatDefault(std::string& out, const LogEntry& entry) const {
+    char timeStr[TimeUtils::kMaxTimestampLength];
+    const size_t timeLen = TimeUtils::formatTimestamp(timeStr, entry.time, options_.timestampFormat);
+
+    out += '[';
+    out.append(timeStr, timeLen);
+    out += "] [";
+    out += logLevelName(entry.level);
+    out += "] ";
+    out += entry.message;
+    Internal::appendLogFieldsText(out, entry.fields);
+}
+
+void LogSink::writeUnlocked(LogLevel level, std::chrono::system_clock::time_point time, std::string_view message,
+                            std::span<const LogField> fields) {
+    writeEntry(LogEntry{level, time, message, fields});
+}
+
+void LogSink::writeEntry(const LogEntry& entry) {
+    formatBuffer_.clear();
+    if (formatter_) {
+        formatter_(formatBuffer_, entry);
+    } else {
+        formatDefault(formatBuffer_, entry);
+    }
+    write(entry.level, formatBuffer_);
+
+    if (formatBuffer_.capacity() > kMaxRetainedCapacity) {
+        std::string().swap(formatBuffer_);
+    }
+}
+
+void LogSink::maybeFlushUnlocked(LogLevel maxLevel, std::chrono::steady_clock::time_point now) {
+    pendingFlush_ = true;
+    if (options_.flushInterval.count() == 0 ||
+        maxLevel >= options_.flushLevel ||
+        now - lastFlush_ >= options_.flushInterval) {
+        flushOutput();
+        pendingFlush_ = false;
+        lastFlush_ = now;
+    }
+}
+
+void LogSink::writeBatch(std::vector<Record>& batch) {
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    LogLevel maxLevel = LogLevel::TRACE;
+    for (Record& record : batch) {
+        writeUnlocked(record.level, record.time, record.message, record.fields.view());
+        maxLevel = std::max(maxLevel, record.level);
+    }
+    maybeFlushUnlocked(maxLevel, std::chrono::steady_clock::now());
+}
+
+std::chrono::steady_clock::duration LogSink::flushIfDue() {
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    if (!pendingFlush_) {
+        return std::chrono::steady_clock::duration::max();
+    }
+    const auto now = std::chrono::steady_clock::now();
+    const auto due = lastFlush_ + options_.flushInterval;
+    if (now < due) {
+        return due - now;
+    }
+    flushOutput();
+    pendingFlush_ = false;
+    lastFlush_ = now;
+    return std::chrono::steady_clock::duration::max();
+}
+
+// ================ ConsoleSink ================
+
+ConsoleSink::ConsoleSink(const LogSinkOptions& options, Stream stream, bool colored)
+    : LogSink(options), stream_(stream), colored_(colored) {}
+
+ConsoleSink::~ConsoleSink() {
+    stop();
+}
+
+void ConsoleSink::write(LogLevel level, std::string_view formatted) {
+    if (colored_) {
+        buffer_ += Internal::consoleColorCode(level);
+    }
+    buffer_ += formatted;
+    if (colored_) {
+        buffer_ += "\033[0m";
+    }
+    buffer_ += '\n';
+
+    if (buffer_.size() >= options().bufferSize) {
+        std::FILE* out = stream_ == Stream::Stdout ? stdout : stderr;
+        std::fwrite(buffer_.data(), 1, buffer_.size(), out);
+        buffer_.clear();
+    }
+}
+
+void ConsoleSink::flushOutput() {
+    std::FILE* out = stream_ == Stream::Stdout ? stdout : stderr;
+    if (!buffer_.empty()) {
+        std::fwrite(buffer_.data(), 1, buffer_.size(), out);
+        buffer_.clear();
+    }
+    std::fflush(out);
+    if (buffer_.capacity() > std::max(options().bufferSize, kMaxRetainedCapacity)) {
+        std::string().swap(buffer_);
+    }
+}
+
+// ================ FileSink ================
+
+FileSink::FileSink(const std::string& path, const LogSinkOptions& options)
+    : LogSink(options), path_(path) {
+    std::error_code ec;
+    const std::filesystem::path dir = std::filesystem::path(path).parent_path();
+    if (!dir.empty()) {
+        std::filesystem::create_directories(dir, ec);
+    }
+    file_.open(path, std::ios::out | std::ios::app | std::ios::binary);
+    open_ = file_.is_open();
+}
+
+FileSink::~FileSink() {
+    stop();
+}
+
+void FileSink::write(LogLevel level, std::string_view formatted) {
+    (void)level;
+    if (!open_) return;
+
+    buffer_ += formatted;
+    buffer_ += '\n';
+    if (buffer_.size() >= options().bufferSize) {
+        file_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+        buffer_.clear();
+    }
+}
+
+void FileSink::flushOutput() {
+    if (!open_) return;
+
+    if (!buffer_.empty()) {
+        file_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+        buffer_.clear();
+    }
+    file_.flush();
+    if (buffer_.capacity() > std::max(options().bufferSize, kMaxRetainedCapacity)) {
+        std::string().swap(buffer_);
+    }
+}
+
+// ================ JsonLinesSink ================
+
+void formatLogEntryJson(std::string& out, const LogEntry& entry) {
+    char timeStr[TimeUtils::kMaxTimestampLength];
+    const size_t timeLen = TimeUtils::formatTimestamp(timeStr, entry.time, TimestampFormat::UtcIso8601Micros);
+
+    // 时间戳和级别名称不含需要转义的字符
+    out += "{\"time\":\"";
+    out.append(timeStr, timeLen);
+    out += "\",\"level\":\"";
+    out += logLevelName(entry.level);
+    out += "\",\"msg\":";
+    Internal::appendJsonString(out, entry.message);
+    for (const LogField& field : entry.fields) {
+        out += ',';
+        Internal::appendJsonString(out, field.key);
+        out += ':';
+        Internal::appendJsonFieldValue(out, field);
+    }
+    out += '}';
+}
+
+JsonLinesSink::JsonLinesSink(const std::string& path, const LogSinkOptions& options)
+    : FileSink(path, options) {}
+
+JsonLinesSink::~JsonLinesSink() {
+    stop();
+}
+
+void JsonLinesSink::formatDefault(std::string& out, const LogEntry& entry) const {
+    formatLogEntryJson(out, entry);
+}
+
+// ================ MemoryRingSink ================
+
+MemoryRingSink::MemoryRingSink(size_t capacity, const LogSinkOptions& options)
+    : LogSink(options), capacity_(std::max<size_t>(capacity, 1)) {}
+
+MemoryRingSink::~MemoryRingSink() {
+    stop();
+}
+
+void MemoryRingSink::write(LogLevel level, std::string_view formatted) {
+    (void)level;
+    std::lock_guard<std::mutex> lock(ringMutex_);
+    if (entries_.size() < capacity_) {
+        entries_.emplace_back(formatted);
+        return;
+    }
+    // 覆盖最旧的条目，复用其已分配的内存
+    entries_[next_].assign(formatted);
+    next_ = (next_ + 1) % capacity_;
+}
+
+std::vector<std::string> MemoryRingSink::snapshot() const {
+    std::lock_guard<std::mutex> lock(ringMutex_);
+    std::vector<std::string> result;
+    result.reserve(entries_.size());
+    for (size_t i = 0; i < entries_.size(); ++i) {
+        result.push_back(entries_[(next_ + i) % entries_.size()]);
+    }
+    return result;
+}
+
+void MemoryRingSink::clear() {
+    std::lock_guard<std::mutex> lock(ringMutex_);
+    entries_.clear();
+    next_ = 0;
+}
+
+// ================ SyslogSink ================
+
+SyslogSink::SyslogSink(const Config& config, const LogSinkOptions& options)
+    : LogSink(options), config_(config) {
+#if !defined(CP_PLATFORM_WINDOWS)
+    socketPath_ = config_.socketPath;
+    if (socketPath_.empty()) {
+        socketPath_ = config_.protocol == Protocol::Journald ? "/run/systemd/journal/socket" : "/dev/log";
+    }
+    ident_ = config_.ident.empty() ? processName() : config_.ident;
+    pid_ = static_cast<long>(getpid());
+    reconnect();
+#endif
+}
+
+SyslogSink::~SyslogSink() {
+    stop();
+    closeSocket();
+}
+
+bool SyslogSink::isOpen() const {
+    return socket_.load(std::memory_order_relaxed) >= 0;
+}
+
+void SyslogSink::formatDefault(std::string& out, const LogEntry& entry) const {
+    // 时间和级别由 syslog / journald 记录
+    out += entry.message;
+    Internal::appendLogFieldsText(out, entry.fields);
+}
+
+bool SyslogSink::connectSocket() {
+#if defined(CP_PLATFORM_WINDOWS)
+    return false;
+#else
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (socketPath_.size() >= sizeof(addr.sun_path)) {
+        return false;
+    }
+    std::memcpy(addr.sun_path, socketPath_.c_str(), socketPath_.size() + 1);
+
+    const int fd = socket(AF_UNIX, SOCK_DGRAM, 0);
+    if (fd < 0) {
+        return false;
+    }
+    fcntl(fd, F_SETFD, FD_CLOEXEC);
+    if (connect(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0) {
+        close(fd);
+        return false;
+    }
+    socket_.store(fd, std::memory_order_relaxed);
+    return true;
+#endif
+}
+
+bool SyslogSink::reconnect() {
+    const auto now = std::chrono::steady_clock::now();
+    if (now < nextReconnect_) {
+        return false;
+    }
+    if (connectSocket()) {
+        reconnectDelay_ = {};
+        return true;
+    }
+    // 守护进程未运行时不在每条日志上重复创建套接字和连接
+    reconnectDelay_ = reconnectDelay_ == std::chrono::steady_clock::duration{}
+        ? std::chrono::duration_cast<std::chrono::steady_clock::duration>(kMinReconnectDelay)
+        : std::min<std::chrono::steady_clock::duration>(reconnectDelay_ * 2, kMaxReconnectDelay);
+    nextReconnect_ = now + reconnectDelay_;
+    return false;
+}
+
+void SyslogSink::closeSocket() {
+#if !defined(CP_PLATFORM_WINDOWS)
+    const int fd = socket_.exchange(-1, std::memory_order_relaxed);
+    if (fd >= 0) {
+        close(fd);
+    }
+#endif
+}
+
+bool SyslogSink::sendJournaldMemfd(int fd) {
+#if defined(CP_PLATFORM_LINUX)
+    // journald 只接受已密封的 memfd，确保发送后内容不会再被修改
+    const int memfd = memfd_create("journal-message", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (memfd < 0) {
+        return false;
+    }
+    size_t written = 0;
+    while (written < datagram_.size()) {
+        const ssize_t n = ::write(memfd, datagram_.data() + written, datagram_.size() - written);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            close(memfd);
+            errno = EMSGSIZE;
+            return false;
+        }
+        written += static_cast<size_t>(n);
+    }
+    if (fcntl(memfd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL) != 0) {
+        close(memfd);
+        errno = EMSGSIZE;
+        return false;
+    }
+
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))] = {};
+    msghdr message{};
+    message.msg_control = control;
+    message.msg_controllen = sizeof(control);
+    cmsghdr* header = CMSG_FIRSTHDR(&message);
+    header->cmsg_level = SOL_SOCKET;
+    header->cmsg_type = SCM_RIGHTS;
+    header->cmsg_len = CMSG_LEN(sizeof(int));
+    std::memcpy(CMSG_DATA(header), &memfd, sizeof(int));
+
+    const bool sent = sendmsg(fd, &message, MSG_DONTWAIT) >= 0;
+    const int error = errno;
+    close(memfd);
+    errno = error;
+    return sent;
+#else
+    (void)fd;
+    return false;
+#endif
+}
+
+void SyslogSink::write(LogLevel level, std::string_view formatted) {
+#if defined(CP_PLATFORM_WINDOWS)
+    (void)level;
+    (void)formatted;
+#else
+    // 守护进程启动前或重启期间连接会失败，退避期满后的写入重新尝试
+    if (socket_.load(std::memory_order_relaxed) < 0 && !reconnect()) {
+        countDropped();
+        return;
+    }
+
+    const int severity = syslogSeverity(level);
+    datagram_.clear();
+    if (config_.protocol == Protocol::Journald) {
+        datagram_ += "PRIORITY=";
+        datagram_ += std::to_string(severity);
+        datagram_ += "\nSYSLOG_FACILITY=";
+        datagram_ += std::to_string(config_.facility);
+        datagram_ += "\nSYSLOG_IDENTIFIER=";
+        datagram_ += ident_;
+        datagram_ += "\nSYSLOG_PID=";
+        datagram_ += std::to_string(pid_);
+        if (formatted.find('\n') == std::string_view::npos) {
+            datagram_ += "\nMESSAGE=";
+            datagram_ += formatted;
+        } else {
+            // 多行消息使用二进制字段格式：字段名、换行、64 位小端长度、内容
+            datagram_ += "\nMESSAGE\n";
+            uint64_t size = formatted.size();
+            for (int i = 0; i < 8; ++i) {
+                datagram_ += static_cast<char>(size & 0xFF);
+                size >>= 8;
+            }
+            datagram_ += formatted;
+        }
+        datagram_ += '\n';
+    } else {
+        datagram_ += '<';
+        datagram_ += std::to_string(config_.facility * 8 + severity);
+        datagram_ += '>';
+        datagram_ += ident_;
+        datagram_ += '[';
+        datagram_ += std::to_string(pid_);
+        datagram_ += "]: ";
+        datagram_ += formatted;
+    }
+
+    // 不阻塞调用线程：守护进程积压时宁可丢弃日志，也不让业务线程（或异步队列）卡在 send() 上
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        const int fd = socket_.load(std::memory_order_relaxed);
+        if (fd >= 0 && send(fd, datagram_.data(), datagram_.size(), MSG_DONTWAIT) >= 0) {
+            return;
+        }
+        if (fd >= 0 && errno == EMSGSIZE && config_.protocol == Protocol::Journald && sendJournaldMemfd(fd)) {
+            return;
+        }
+        // 守护进程重启后旧连接失效，重新连接一次；其他错误（接收缓冲区已满、消息过长）丢弃这条日志
+        if (errno != ECONNREFUSED && errno != ENOTCONN && errno != ECONNRESET) {
+            countDropped();
+            return;
+        }
+        closeSocket();
+        if (!reconnect()) {
+            countDropped();
+            return;
+        }
+    }
+    countDropped();
+#endif
+}
+
+} // namespace CorePlatform
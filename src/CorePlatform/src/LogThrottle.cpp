@@ -0,0 +1,83 @@
+#include "CorePlatform/LogThrottle.h"
+#include <algorithm>
+#include <limits>
+#include <mutex>
+
+namespace CorePlatform {
+
+struct LogThrottleSite::Registry {
+    std::mutex mutex;
+    LogThrottleSite* head = nullptr;
+};
+
+LogThrottleSite::Registry& LogThrottleSite::registry() {
+    static Registry instance;
+    return instance;
+}
+
+LogThrottleSite::LogThrottleSite(const char* file, int line, LogLevel level)
+    : file_(file), line_(line), level_(level) {
+    // 先于调用点构造完成，静态析构时链表晚于所有调用点销毁
+    registry();
+}
+
+LogThrottleSite::~LogThrottleSite() {
+    if (!registered_.load(std::memory_order_acquire)) return;
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    if (prev_) {
+        prev_->next_ = next_;
+    } else if (reg.head == this) {
+        reg.head = next_;
+    }
+    if (next_) {
+        next_->prev_ = prev_;
+    }
+}
+
+void LogThrottleSite::registerSite() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    prev_ = nullptr;
+    next_ = reg.head;
+    if (next_) {
+        next_->prev_ = this;
+    }
+    reg.head = this;
+}
+
+std::vector<LogThrottleSite::Suppressed> LogThrottleSite::takeAllSuppressed() {
+    // 在锁内拷贝文件名：卸载的插件中 __FILE__ 指向的内存会随模块一起失效
+    std::vector<Suppressed> result;
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (LogThrottleSite* site = reg.head; site; site = site->next_) {
+        const uint64_t count = site->takeSuppressed();
+        if (count > 0) {
+            result.push_back({site->file_, site->line_, site->level_, count});
+        }
+    }
+    return result;
+}
+
+namespace {
+
+int64_t rateInterval(double ratePerSecond) {
+    // 速率非正时等同于只放行 burst 条
+    if (!(ratePerSecond > 0)) {
+        return std::numeric_limits<int64_t>::max() / 4;
+    }
+    const double interval = 1e9 / ratePerSecond;
+    return static_cast<int64_t>(std::clamp(interval, 1.0, static_cast<double>(std::numeric_limits<int64_t>::max() / 4)));
+}
+
+} // 匿名命名空间
+
+LogRateLimiter::LogRateLimiter(const char* file, int line, LogLevel level, double ratePerSecond, uint32_t burst)
+    : LogThrottleSite(file, line, level),
+      intervalNs_(rateInterval(ratePerSecond)),
+      toleranceNs_(intervalNs_ > std::numeric_limits<int64_t>::max() / 4 / std::max<uint32_t>(burst, 1)
+                       ? std::numeric_limits<int64_t>::max() / 4
+                       : intervalNs_ * std::max<uint32_t>(burst, 1)) {}
+
+} // namespace CorePlatform
@@ -0,0 +1,244 @@
+#include "CorePlatform/Internal/LogTimeSearch.h"
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+
+namespace CorePlatform {
+namespace Internal {
+
+namespace {
+
+// 二分区间小于该字节数时改为顺序扫描
+constexpr size_t kLinearScanBytes = 4096;
+
+constexpr TimestampFormat kFormats[4] = {
+    TimestampFormat::LocalMillis,
+    TimestampFormat::LocalMicros,
+    TimestampFormat::UtcIso8601Millis,
+    TimestampFormat::UtcIso8601Micros,
+};
+
+constexpr bool isDigit(char ch) {
+    return ch >= '0' && ch <= '9';
+}
+
+// 按时间戳长度确定格式下标，不是已知长度时返回 -1
+int formatIndex(size_t length) {
+    switch (length) {
+        case 23: return 0;  // YYYY-MM-DD HH:MM:SS.mmm
+        case 26: return 1;  // YYYY-MM-DD HH:MM:SS.uuuuuu
+        case 24: return 2;  // YYYY-MM-DDTHH:MM:SS.mmmZ
+        case 27: return 3;  // YYYY-MM-DDTHH:MM:SS.uuuuuuZ
+        default: return -1;
+    }
+}
+
+// 从 offset 开始的一行（不含换行符）
+std::string_view lineAt(std::string_view contents, size_t offset) {
+    const size_t newline = contents.find('\n', offset);
+    return contents.substr(offset, newline == std::string_view::npos ? std::string_view::npos : newline - offset);
+}
+
+// 不小于 offset 的第一个行首
+size_t nextLineStart(std::string_view contents, size_t offset) {
+    if (offset == 0 || contents[offset - 1] == '\n') {
+        return offset;
+    }
+    const size_t newline = contents.find('\n', offset);
+    return newline == std::string_view::npos ? contents.size() : newline + 1;
+}
+
+// 解析 text 开头的固定宽度十进制数
+bool parseNumber(std::string_view text, size_t pos, size_t width, int& value) {
+    if (pos + width > text.size()) return false;
+    value = 0;
+    for (size_t i = pos; i < pos + width; ++i) {
+        if (!isDigit(text[i])) return false;
+        value = value * 10 + (text[i] - '0');
+    }
+    return true;
+}
+
+} // 匿名命名空间
+
+std::string_view logLineTimestamp(std::string_view line) {
+    // 最长的时间戳是 27 个字符
+    if (line.size() < 25 || line[0] != '[') {
+        return std::string_view();
+    }
+    const size_t close = line.find(']', 1);
+    if (close == std::string_view::npos || formatIndex(close - 1) < 0) {
+        return std::string_view();
+    }
+    const std::string_view stamp = line.substr(1, close - 1);
+    if (!isDigit(stamp[0]) || stamp[4] != '-' || stamp[7] != '-' ||
+        (stamp[10] != ' ' && stamp[10] != 'T') ||
+        stamp[13] != ':' || stamp[16] != ':' || stamp[19] != '.') {
+        return std::string_view();
+    }
+    return stamp;
+}
+
+// ================ LogTimeBound ================
+
+LogTimeBound::LogTimeBound(std::chrono::system_clock::time_point time) : time_(time) {
+    for (int i = 0; i < 4; ++i) {
+        lengths_[i] = TimeUtils::formatTimestamp(formatted_[i], time, kFormats[i]);
+    }
+}
+
+bool LogTimeBound::isBefore(std::string_view line, bool& early) const {
+    const std::string_view stamp = logLineTimestamp(line);
+    if (stamp.empty()) {
+        return false;
+    }
+    const int index = formatIndex(stamp.size());
+    early = memcmp(stamp.data(), formatted_[index], lengths_[index]) < 0;
+    return true;
+}
+
+// ================ 按时间查找 ================
+
+size_t lowerBoundByTime(std::string_view contents, const LogTimeBound& bound) {
+    // 不变式：lo 是行首，lo 之前带时间戳的行都早于 bound
+    size_t lo = 0;
+    size_t hi = contents.size();
+    while (hi - lo > kLinearScanBytes) {
+        const size_t mid = lo + (hi - lo) / 2;
+
+        // 找 [mid, hi) 中第一条带时间戳的行
+        bool found = false;
+        bool early = false;
+        size_t offset = nextLineStart(contents, mid);
+        size_t lineEnd = offset;
+        while (offset < hi) {
+            const std::string_view line = lineAt(contents, offset);
+            lineEnd = offset + line.size() + 1;
+            if (bound.isBefore(line, early)) {
+                found = true;
+                break;
+            }
+            offset = lineEnd;
+        }
+
+        if (found && early) {
+            lo = std::min(lineEnd, contents.size());
+        } else {
+            // 结果在该行之前，或者 [mid, hi) 中没有可比较的行
+            hi = mid;
+        }
+    }
+
+    for (size_t offset = lo; offset < contents.size();) {
+        const std::string_view line = lineAt(contents, offset);
+        bool early = false;
+        if (bound.isBefore(line, early) && !early) {
+            return offset;
+        }
+        offset += line.size() + 1;
+    }
+    return contents.size();
+}
+
+std::string_view sliceByTime(std::string_view contents, const LogTimeBound& from, const LogTimeBound& to) {
+    if (to.time() <= from.time()) {
+        return std::string_view();
+    }
+    const size_t begin = lowerBoundByTime(contents, from);
+    if (begin >= contents.size()) {
+        return std::string_view();
+    }
+    const size_t end = begin + lowerBoundByTime(contents.substr(begin), to);
+    return contents.substr(begin, end - begin);
+}
+
+bool parseLogTime(std::string_view text,
+                  std::chrono::system_clock::time_point& out,
+                  std::chrono::system_clock::time_point now) {
+    while (!text.empty() && text.front() == ' ') text.remove_prefix(1);
+    while (!text.empty() && text.back() == ' ') text.remove_suffix(1);
+    const bool utc = !text.empty() && text.back() == 'Z';
+    if (utc) {
+        text.remove_suffix(1);
+    }
+
+    int year = 0;
+    int month = 0;
+    int day = 0;
+    if (text.size() >= 10 && text[4] == '-') {
+        if (!parseNumber(text, 0, 4, year) || text[7] != '-' ||
+            !parseNumber(text, 5, 2, month) || !parseNumber(text, 8, 2, day) ||
+            text.size() < 11 || (text[10] != ' ' && text[10] != 'T')) {
+            return false;
+        }
+        text.remove_prefix(11);
+    } else if (utc) {
+        const std::chrono::year_month_day date{std::chrono::floor<std::chrono::days>(now)};
+        year = static_cast<int>(date.year());
+        month = static_cast<int>(static_cast<unsigned>(date.month()));
+        day = static_cast<int>(static_cast<unsigned>(date.day()));
+    } else {
+        const std::time_t t = std::chrono::system_clock::to_time_t(now);
+        std::tm bt{};
+#ifdef _WIN32
+        localtime_s(&bt, &t);
+#else
+        localtime_r(&t, &bt);
+#endif
+        year = bt.tm_year + 1900;
+        month = bt.tm_mon + 1;
+        day = bt.tm_mday;
+    }
+
+    // HH:MM[:SS[.fraction]]
+    int hour = 0;
+    int minute = 0;
+    int second = 0;
+    if (!parseNumber(text, 0, 2, hour) || text.size() < 5 || text[2] != ':' || !parseNumber(text, 3, 2, minute)) {
+        return false;
+    }
+    size_t pos = 5;
+    if (pos < text.size()) {
+        if (text[pos] != ':' || !parseNumber(text, pos + 1, 2, second)) return false;
+        pos += 3;
+    }
+    int64_t nanos = 0;
+    if (pos < text.size()) {
+        if (text[pos] != '.' || pos + 1 == text.size() || text.size() - pos - 1 > 9) return false;
+        int64_t scale = 100000000;
+        for (++pos; pos < text.size(); ++pos, scale /= 10) {
+            if (!isDigit(text[pos])) return false;
+            nanos += (text[pos] - '0') * scale;
+        }
+    }
+    if (month < 1 || month > 12 || day < 1 || day > 31 || hour > 23 || minute > 59 || second > 60) {
+        return false;
+    }
+
+    std::chrono::system_clock::time_point base;
+    if (utc) {
+        const std::chrono::year_month_day date{std::chrono::year{year},
+                                               std::chrono::month{static_cast<unsigned>(month)},
+                                               std::chrono::day{static_cast<unsigned>(day)}};
+        if (!date.ok()) return false;
+        base = std::chrono::sys_days(date) + std::chrono::hours(hour) +
+               std::chrono::minutes(minute) + std::chrono::seconds(second);
+    } else {
+        std::tm bt{};
+        bt.tm_year = year - 1900;
+        bt.tm_mon = month - 1;
+        bt.tm_mday = day;
+        bt.tm_hour = hour;
+        bt.tm_min = minute;
+        bt.tm_sec = second;
+        bt.tm_isdst = -1;
+        const std::time_t t = std::mktime(&bt);
+        if (t == static_cast<std::time_t>(-1)) return false;
+        base = std::chrono::system_clock::from_time_t(t);
+    }
+    out = base + std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(nanos));
+    return true;
+}
+
+} // namespace Internal
+} // namespace CorePlatform
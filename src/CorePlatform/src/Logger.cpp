@@ -1,9 +1,19 @@
 #include "CorePlatform/Logger.h"
+#include "CorePlatform/TimeUtils.h"
+#include "CorePlatform/StringUtils.h"
+#include "CorePlatform/Internal/LogFileReader.h"
+#include "CorePlatform/Internal/LogSearch.h"
+#include "CorePlatform/Internal/LogTimeSearch.h"
+#include "CorePlatform/Internal/LogRotation.h"
+#include "CorePlatform/Internal/AsyncLogQueue.h"
+#include "CorePlatform/Internal/SharedLogCollector.h"
 #include <iostream>
 #include <fstream>
 #include <memory>
 #include <stdexcept>
 #include <cctype>
+#include <regex>
+#include <cstring>
 
 // 平台相关头文件
 #ifdef _WIN32
@@ -15,10 +25,117 @@
 
 namespace CorePlatform {
 
+namespace {
+
+// 异步模式下在队列中传递的日志记录，时间戳在调用线程上采集
+struct LogRecord {
+    LogLevel level = LogLevel::INFO;
+    std::chrono::system_clock::time_point time;
+    std::string message;
+};
+
+// 读取时保留的压缩分段解压内容上限
+constexpr uint64_t kSegmentCacheBytes = 64ull * 1024 * 1024;
+
+} // 匿名命名空间
+
+// ================ 异步写入后端 ================
+
+class Logger::AsyncWriter {
+public:
+    AsyncWriter(Logger& owner, size_t capacity, LogOverflowPolicy policy)
+        : owner_(owner),
+          queue_(capacity, policy, [this](std::vector<LogRecord>& batch) { writeBatch(batch); }) {}
+
+    size_t capacity() const { return queue_.capacity(); }
+    LogOverflowPolicy policy() const { return queue_.policy(); }
+    uint64_t droppedCount() const { return queue_.droppedCount(); }
+
+    void start() { queue_.start(); }
+
+    // 停止写线程，并在当前线程写完剩余日志
+    void stop() { queue_.stop(); }
+
+    // 提交一条日志；写入器已停止时返回 false，由调用者改走同步路径
+    bool submit(LogLevel level, std::chrono::system_clock::time_point time, const std::string& message) {
+        if (!queue_.running()) {
+            return false;
+        }
+        return queue_.submit(LogRecord{level, time, message}, false);
+    }
+
+    // 等待调用前已提交的日志全部写出
+    void waitUntilDrained() { queue_.waitUntilDrained(); }
+
+private:
+    // 一批日志在锁外格式化，控制台和文件各自加锁，各做一次写入和一次刷新
+    void writeBatch(std::vector<LogRecord>& batch) {
+        // 停止后可能由多个线程同时写出，缓冲区按线程分开并反复复用
+        thread_local std::string fileBuffer;
+        thread_local std::string consoleBuffer;
+        fileBuffer.clear();
+        consoleBuffer.clear();
+#ifdef _WIN32
+        thread_local std::vector<size_t> recordEnds;
+        recordEnds.clear();
+#endif
+
+        const bool console = owner_.consoleOutput_.load(std::memory_order_relaxed);
+        for (const auto& rec : batch) {
+            const size_t begin = fileBuffer.size();
+            owner_.formatEntry(fileBuffer, rec.level, rec.time, rec.message);
+#ifdef _WIN32
+            (void)begin;
+            recordEnds.push_back(fileBuffer.size());
+#else
+            if (console) {
+                consoleBuffer += Internal::consoleColorCode(rec.level);
+                consoleBuffer.append(fileBuffer, begin, std::string::npos);
+                consoleBuffer += "\033[0m\n";
+            }
+#endif
+            fileBuffer += '\n';
+        }
+
+        if (console) {
+            std::lock_guard<std::mutex> lock(owner_.consoleMutex_);
+#ifdef _WIN32
+            // Windows 控制台颜色需要逐条设置属性
+            size_t begin = 0;
+            for (size_t i = 0; i < batch.size(); ++i) {
+                owner_.setConsoleColor(batch[i].level);
+                std::cout.write(fileBuffer.data() + begin, recordEnds[i] - begin);
+                owner_.resetConsoleColor();
+                std::cout << '\n';
+                begin = recordEnds[i] + 1;
+            }
+#else
+            std::cout.write(consoleBuffer.data(), consoleBuffer.size());
+#endif
+            std::cout.flush();
+        }
+        if (owner_.textFileOpen_.load(std::memory_order_relaxed)) {
+            std::lock_guard<std::mutex> lock(owner_.logMutex_);
+            if (owner_.fileStream_ && owner_.fileStream_->is_open()) {
+                owner_.writeFileUnlocked(fileBuffer, batch.back().time);
+            }
+        }
+    }
+
+    Logger& owner_;
+    Internal::AsyncLogQueue<LogRecord> queue_;
+};
+
+// ================ Logger ================
+
 Logger::Logger() : 
     currentLevel_(LogLevel::INFO), 
+    enabledLevel_(LogLevel::INFO),
     consoleOutput_(true),
-    logFilePath_("") 
+    timestampFormat_(TimestampFormat::LocalMillis),
+    logFilePath_(""),
+    segmentCache_(std::make_unique<Internal::LogSegmentCache>(kSegmentCacheBytes)),
+    asyncWriter_(nullptr)
 {
     // 确保日志文件目录存在
     if (!logFilePath_.empty()) {
@@ -45,6 +162,15 @@ Logger::Logger() :
 }
 
 Logger::~Logger() {
+    // 收集线程会写日志，先于其他输出停止
+    {
+        std::lock_guard<std::mutex> lock(sharedLogMutex_);
+        sharedLogCollector_.reset();
+    }
+    disableFlightRecorder();
+    setAsyncMode(false);
+    // 等待后台压缩和清理完成
+    maintenance_.reset();
     if (fileStream_ && fileStream_->is_open()) {
         fileStream_->close();
     }
@@ -56,19 +182,190 @@ Logger& Logger::getInstance() {
 }
 
 void Logger::setLevel(LogLevel level) {
+    std::lock_guard<std::mutex> lock(namedMutex_);
     currentLevel_ = level;
+    refreshEnabledLevelUnlocked();
+}
+
+LogLevel Logger::getLevel() const {
+    return currentLevel_.load(std::memory_order_relaxed);
+}
+
+NamedLogger& Logger::getLogger(const std::string& name) {
+    std::lock_guard<std::mutex> lock(namedMutex_);
+    
+    // 从顶层开始逐级查找，缺少的父模块一并创建
+    NamedLogger* parent = nullptr;
+    size_t pos = 0;
+    while (true) {
+        const size_t dot = name.find('.', pos);
+        const std::string prefix = name.substr(0, dot);
+        auto it = namedLoggers_.find(prefix);
+        if (it == namedLoggers_.end()) {
+            const LogLevel level = parent ? parent->getEffectiveLevel()
+                                          : currentLevel_.load(std::memory_order_relaxed);
+            it = namedLoggers_.emplace(prefix, std::unique_ptr<NamedLogger>(
+                new NamedLogger(*this, prefix, parent, level))).first;
+            if (const FlightRecorder* recorder = flightRecorder_.load(std::memory_order_acquire)) {
+                it->second->enabledLevel_.store(std::min(level, recorder->level()), std::memory_order_relaxed);
+            }
+        }
+        parent = it->second.get();
+        if (dot == std::string::npos) {
+            return *parent;
+        }
+        pos = dot + 1;
+    }
+}
+
+void Logger::refreshNamedLevelsUnlocked() {
+    // 飞行记录器需要低于生效级别的日志时，调用点门槛随之降低
+    const FlightRecorder* recorder = flightRecorder_.load(std::memory_order_acquire);
+    
+    // 父模块名是子模块名的前缀，按名称顺序遍历时父级总是先于子级
+    const LogLevel root = currentLevel_.load(std::memory_order_relaxed);
+    for (auto& [name, logger] : namedLoggers_) {
+        LogLevel level = root;
+        if (logger->hasExplicitLevel_) {
+            level = logger->explicitLevel_;
+        } else if (logger->parent_) {
+            level = logger->parent_->effectiveLevel_.load(std::memory_order_relaxed);
+        }
+        logger->effectiveLevel_.store(level, std::memory_order_relaxed);
+        logger->enabledLevel_.store(recorder ? std::min(level, recorder->level()) : level,
+                                    std::memory_order_relaxed);
+    }
+}
+
+void Logger::refreshEnabledLevelUnlocked() {
+    const LogLevel root = currentLevel_.load(std::memory_order_relaxed);
+    const FlightRecorder* recorder = flightRecorder_.load(std::memory_order_acquire);
+    enabledLevel_.store(recorder ? std::min(root, recorder->level()) : root, std::memory_order_relaxed);
+    refreshNamedLevelsUnlocked();
+}
+
+bool Logger::loadLevelConfig(const std::string& path, std::string* error) {
+    std::ifstream in(path);
+    if (!in) {
+        if (error) *error = "cannot open " + path;
+        return false;
+    }
+    
+    constexpr std::string_view kRootKey = "log.level";
+    constexpr std::string_view kFlightRecorderKey = "log.flight_recorder";
+    bool hasRoot = false;
+    LogLevel rootLevel = LogLevel::INFO;
+    std::vector<std::pair<std::string, LogLevel>> moduleLevels;
+    // 未出现时保持飞行记录器现状；OFF 为停用
+    bool hasFlightRecorder = false;
+    bool flightRecorderOn = false;
+    LogLevel flightRecorderLevel = LogLevel::TRACE;
+    
+    std::string line;
+    for (size_t lineNumber = 1; std::getline(in, line); ++lineNumber) {
+        const size_t comment = line.find_first_of("#;");
+        if (comment != std::string::npos) {
+            line.erase(comment);
+        }
+        line = StringUtils::trim(line);
+        if (line.empty() || line.front() == '[') {
+            continue;
+        }
+        
+        const size_t eq = line.find('=');
+        if (eq == std::string::npos) {
+            continue;
+        }
+        const std::string key = StringUtils::trim(line.substr(0, eq));
+        const std::string value = StringUtils::trim(line.substr(eq + 1));
+        if (key == kFlightRecorderKey) {
+            hasFlightRecorder = true;
+            flightRecorderOn = StringUtils::toUpper(value) != "OFF";
+            if (flightRecorderOn && !parseLogLevel(value, flightRecorderLevel)) {
+                if (error) *error = path + ":" + std::to_string(lineNumber) + ": invalid flight recorder level '" + value + "'";
+                return false;
+            }
+            continue;
+        }
+        if (key.compare(0, kRootKey.size(), kRootKey) != 0) {
+            continue;
+        }
+        
+        LogLevel level;
+        if (!parseLogLevel(value, level)) {
+            if (error) *error = path + ":" + std::to_string(lineNumber) + ": invalid log level '" + value + "'";
+            return false;
+        }
+        if (key.size() == kRootKey.size()) {
+            hasRoot = true;
+            rootLevel = level;
+        } else if (key[kRootKey.size()] == '.' && key.size() > kRootKey.size() + 1) {
+            moduleLevels.emplace_back(key.substr(kRootKey.size() + 1), level);
+        } else {
+            if (error) *error = path + ":" + std::to_string(lineNumber) + ": invalid key '" + key + "'";
+            return false;
+        }
+    }
+    
+    // 先创建模块日志器（getLogger 自行加锁），再一次性应用所有级别
+    std::vector<NamedLogger*> targets;
+    for (const auto& [name, level] : moduleLevels) {
+        targets.push_back(&getLogger(name));
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(namedMutex_);
+        if (hasRoot) {
+            currentLevel_ = rootLevel;
+        }
+        for (auto& [name, logger] : namedLoggers_) {
+            logger->hasExplicitLevel_ = false;
+        }
+        for (size_t i = 0; i < targets.size(); ++i) {
+            targets[i]->hasExplicitLevel_ = true;
+            targets[i]->explicitLevel_ = moduleLevels[i].second;
+        }
+        refreshEnabledLevelUnlocked();
+    }
+    
+    // 级别未变时保留已启用的记录器及其中的记录
+    if (hasFlightRecorder && !flightRecorderOn) {
+        disableFlightRecorder();
+    } else if (hasFlightRecorder) {
+        const FlightRecorder* recorder = flightRecorder_.load(std::memory_order_acquire);
+        if (!recorder || recorder->level() != flightRecorderLevel) {
+            FlightRecorderOptions options;
+            options.level = flightRecorderLevel;
+            enableFlightRecorder(options);
+        }
+    }
+    return true;
 }
 
 void Logger::setConsoleOutput(bool enable) {
     consoleOutput_ = enable;
 }
 
-bool Logger::setLogFile(const std::string& path) {
+void Logger::setTimestampFormat(TimestampFormat format) {
+    timestampFormat_ = format;
+}
+
+bool Logger::setLogFile(const std::string& path, LogFileFormat format) {
+    // 已入队的日志属于旧文件，切换前先写完
+    if (AsyncWriter* writer = asyncWriter_.load(std::memory_order_acquire)) {
+        writer->waitUntilDrained();
+    }
+
     std::lock_guard<std::mutex> lock(logMutex_);
     
     if (fileStream_ && fileStream_->is_open()) {
         fileStream_->close();
     }
+    fileStream_.reset();
+    textFileOpen_.store(false, std::memory_order_relaxed);
+    if (Internal::BinaryLogSink* sink = binarySink_.exchange(nullptr, std::memory_order_acq_rel)) {
+        sink->stop();
+    }
     
     // 确保目录存在
     std::filesystem::path dir = std::filesystem::path(path).parent_path();
@@ -76,7 +373,43 @@ bool Logger::setLogFile(const std::string& path) {
         std::filesystem::create_directories(dir);
     }
     logFilePath_ = path;
+    
+    if (format == LogFileFormat::Binary) {
+        if (!binarySinkStorage_) {
+            binarySinkStorage_ = std::make_unique<Internal::BinaryLogSink>(path);
+        } else if (!binarySinkStorage_->open(path)) {
+            return false;
+        }
+        if (!binarySinkStorage_->isOpen()) {
+            return false;
+        }
+        binarySink_.store(binarySinkStorage_.get(), std::memory_order_release);
+        
+        // 读取接口只支持文本文件
+        std::lock_guard<std::mutex> readerLock(readerMutex_);
+        activeSegment_.reset();
+        reader_.reset();
+        segmentReaders_.clear();
+        return true;
+    }
 
+    if (!openLogStreamUnlocked(path)) {
+        return false;
+    }
+    
+    // 从已有分段之后继续编号
+    std::vector<Internal::LogSegment> segments = Internal::listLogSegments(path);
+    nextSegmentSequence_ = segments.empty() ? 1 : segments.back().sequence + 1;
+    nextDailyRotation_ = nextDailyRotationUnlocked();
+    
+    std::lock_guard<std::mutex> readerLock(readerMutex_);
+    reader_ = std::make_unique<Internal::LogFileReader>(path);
+    activeSegment_ = std::make_unique<Internal::LogSegmentReader>(*reader_);
+    segmentReaders_.clear();
+    return true;
+}
+
+bool Logger::openLogStreamUnlocked(const std::string& path) {
 #ifdef _WIN32
     // 使用安全的 _wsopen_s 替代 _wsopen
     std::wstring widePath(path.begin(), path.end());
@@ -126,14 +459,402 @@ bool Logger::setLogFile(const std::string& path) {
     
     if (!fileStream_->is_open()) {
         fileStream_.reset();
+        textFileOpen_.store(false, std::memory_order_relaxed);
         return false;
     }
+    textFileOpen_.store(true, std::memory_order_relaxed);
+    
+    std::error_code ec;
+    const auto size = std::filesystem::file_size(path, ec);
+    currentFileSize_ = ec ? 0 : static_cast<uint64_t>(size);
     return true;
 }
 
+void Logger::setRotationPolicy(const LogRotationPolicy& policy) {
+    std::lock_guard<std::mutex> lock(logMutex_);
+    rotationPolicy_ = policy;
+    nextDailyRotation_ = nextDailyRotationUnlocked();
+}
+
+LogRotationPolicy Logger::getRotationPolicy() const {
+    std::lock_guard<std::mutex> lock(logMutex_);
+    return rotationPolicy_;
+}
+
+std::vector<std::string> Logger::getRotatedLogFiles() const {
+    const std::string path = getCurrentLogPath();
+    std::vector<std::string> files;
+    if (path.empty()) return files;
+    
+    for (const auto& segment : Internal::listLogSegments(path)) {
+        files.push_back(segment.path);
+    }
+    return files;
+}
+
+void Logger::writeFileUnlocked(std::string_view data, std::chrono::system_clock::time_point time) {
+    if (!fileStream_ || !fileStream_->is_open()) return;
+    
+    if (rotationPolicy_.daily && time >= nextDailyRotation_) {
+        nextDailyRotation_ = Internal::nextDailyRotation(time, rotationPolicy_.dailyHour);
+        if (currentFileSize_ > 0) {
+            rotateFileUnlocked();
+        }
+    }
+    
+    const uint64_t maxSize = rotationPolicy_.maxFileSize;
+    while (!data.empty()) {
+        size_t chunk = data.size();
+        if (maxSize > 0 && currentFileSize_ + data.size() > maxSize) {
+            // 在行边界处切分，保证单行不会被拆到两个文件中
+            const uint64_t room = maxSize > currentFileSize_ ? maxSize - currentFileSize_ : 0;
+            const size_t lineEnd = room > 0 ? data.rfind('\n', static_cast<size_t>(room - 1)) : std::string_view::npos;
+            if (lineEnd != std::string_view::npos) {
+                chunk = lineEnd + 1;
+            } else if (currentFileSize_ > 0) {
+                rotateFileUnlocked();
+                if (!fileStream_ || !fileStream_->is_open()) return;
+                continue;
+            } else {
+                // 单行超过上限：独占一个文件
+                const size_t firstLineEnd = data.find('\n');
+                chunk = firstLineEnd == std::string_view::npos ? data.size() : firstLineEnd + 1;
+            }
+        }
+        
+        fileStream_->write(data.data(), static_cast<std::streamsize>(chunk));
+        currentFileSize_ += chunk;
+        data.remove_prefix(chunk);
+    }
+    fileStream_->flush();
+}
+
+void Logger::rotateFileUnlocked() {
+    fileStream_->close();
+    
+    const std::string segmentPath = Internal::logSegmentPath(logFilePath_, nextSegmentSequence_++);
+    std::error_code ec;
+    std::filesystem::rename(logFilePath_, segmentPath, ec);
+    
+    // 重命名失败时继续追加到原文件，不丢日志
+    if (!openLogStreamUnlocked(logFilePath_)) {
+        fileStream_.reset();
+        textFileOpen_.store(false, std::memory_order_relaxed);
+        return;
+    }
+    if (ec) return;
+    
+    const bool compress = rotationPolicy_.compress && Internal::logCompressionAvailable();
+    if (compress || rotationPolicy_.maxFiles > 0) {
+        if (!maintenance_) {
+            maintenance_ = std::make_unique<Internal::LogMaintenanceWorker>();
+        }
+        maintenance_->schedule(logFilePath_, segmentPath, compress, rotationPolicy_.maxFiles);
+    }
+}
+
+std::chrono::system_clock::time_point Logger::nextDailyRotationUnlocked() const {
+    // 从文件最后写入的时间算起：重新打开昨天写过的文件后，今天的第一次写入就轮转，
+    // 而不是等到打开之后的下一个轮转时刻
+    auto from = std::chrono::system_clock::now();
+    if (currentFileSize_ > 0) {
+        std::error_code ec;
+        const auto modified = std::filesystem::last_write_time(logFilePath_, ec);
+        if (!ec) {
+            from = std::min(from, std::chrono::time_point_cast<std::chrono::system_clock::duration>(
+                                      std::chrono::file_clock::to_sys(modified)));
+        }
+    }
+    return Internal::nextDailyRotation(from, rotationPolicy_.dailyHour);
+}
+
+void Logger::setAsyncMode(bool enable, size_t queueCapacity, LogOverflowPolicy policy) {
+    std::lock_guard<std::mutex> lock(asyncConfigMutex_);
+
+    if (AsyncWriter* current = asyncWriter_.load(std::memory_order_acquire)) {
+        asyncWriter_.store(nullptr, std::memory_order_release);
+        current->stop();
+    }
+    if (!enable) {
+        return;
+    }
+
+    // 复用配置相同的已停用写入器，避免反复切换时不断累积队列内存
+    AsyncWriter* writer = nullptr;
+    for (auto& candidate : asyncWriters_) {
+        if (candidate->policy() == policy &&
+            candidate->capacity() == Internal::roundUpCapacity(queueCapacity)) {
+            writer = candidate.get();
+            break;
+        }
+    }
+    if (!writer) {
+        asyncWriters_.push_back(std::make_unique<AsyncWriter>(*this, queueCapacity, policy));
+        writer = asyncWriters_.back().get();
+    }
+
+    writer->start();
+    asyncWriter_.store(writer, std::memory_order_release);
+}
+
+bool Logger::isAsyncMode() const {
+    return asyncWriter_.load(std::memory_order_acquire) != nullptr;
+}
+
+uint64_t Logger::getDroppedCount() const {
+    std::lock_guard<std::mutex> lock(asyncConfigMutex_);
+    uint64_t total = 0;
+    for (const auto& writer : asyncWriters_) {
+        total += writer->droppedCount();
+    }
+    return total;
+}
+
 void Logger::log(LogLevel level, const std::string& message) {
-    if (level < currentLevel_) return;
-    logInternal(level, message);
+    if (!isEnabled(level)) return;
+    dispatch(level, message, outputsEnabled(level));
+}
+
+std::string& Logger::formatBuffer() {
+    thread_local std::string buffer;
+    return buffer;
+}
+
+void Logger::logFields(LogLevel level, std::string_view message, std::span<const LogField> fields) {
+    if (!isEnabled(level)) return;
+    
+    // 文本输出使用 "消息 key=value ..."，添加的输出取其前缀作为原始消息；
+    // 只有添加的输出时不需要字段的文本形式
+    std::string& buffer = formatBuffer();
+    buffer.clear();
+    buffer += message;
+    if (needsBuiltinText() || binarySink_.load(std::memory_order_relaxed) ||
+        flightRecorder_.load(std::memory_order_relaxed)) {
+        Internal::appendLogFieldsText(buffer, fields);
+    }
+    const StructuredParts structured{std::string_view(buffer).substr(0, message.size()), fields};
+    logFormatted(level, buffer, outputsEnabled(level), true, &structured);
+}
+
+void Logger::logFormatted(LogLevel level, std::string& buffer, bool outputs, bool includeBinary,
+                          const StructuredParts* structured) {
+    if (includeBinary) {
+        dispatch(level, buffer, outputs, structured);
+    } else {
+        dispatchText(level, buffer, outputs, structured);
+    }
+
+    // 偶发的超长消息不应让每个线程长期占用大块内存
+    constexpr size_t kMaxRetainedCapacity = 64 * 1024;
+    if (buffer.capacity() > kMaxRetainedCapacity) {
+        std::string().swap(buffer);
+    }
+}
+
+void Logger::dispatch(LogLevel level, const std::string& message, bool outputs,
+                      const StructuredParts* structured) {
+    Internal::BinaryLogSink* sink = binarySink_.load(std::memory_order_acquire);
+    if (sink && outputs) {
+        sink->write(static_cast<uint8_t>(level), "{}", std::string_view(message));
+        if (level == LogLevel::FATAL) sink->flush();
+        if (!needsText()) return;
+    }
+    dispatchText(level, message, outputs, structured);
+}
+
+void Logger::dispatchText(LogLevel level, const std::string& message, bool outputs,
+                          const StructuredParts* structured) {
+    const auto now = std::chrono::system_clock::now();
+    if (FlightRecorder* recorder = flightRecorder_.load(std::memory_order_acquire)) {
+        if (recorder->shouldRecord(level)) {
+            recorder->record(level, now, message);
+        }
+        if (level == LogLevel::FATAL && flightDumpOnFatal_.load(std::memory_order_relaxed)) {
+            dumpFlightRecorder();
+        }
+    }
+    if (outputs) {
+        writeText(level, now, message, structured);
+    }
+}
+
+void Logger::writeText(LogLevel level, std::chrono::system_clock::time_point time, const std::string& message,
+                       const StructuredParts* structured) {
+    if (hasSinks_.load(std::memory_order_acquire)) {
+        dispatchSinks(level, time, message, structured);
+    }
+    // 二进制模式下文本只写控制台，未开启控制台时到此为止
+    if (binarySink_.load(std::memory_order_acquire) && !consoleOutput_) {
+        return;
+    }
+    if (!needsBuiltinText()) {
+        return;
+    }
+    
+    if (AsyncWriter* writer = asyncWriter_.load(std::memory_order_acquire)) {
+        if (writer->submit(level, time, message)) {
+            // FATAL 之后进程可能立即退出，必须保证已落盘
+            if (level == LogLevel::FATAL) {
+                flush();
+            }
+            return;
+        }
+    }
+    logInternal(level, time, message);
+}
+
+void Logger::dispatchSinks(LogLevel level, std::chrono::system_clock::time_point time, const std::string& message,
+                           const StructuredParts* structured) {
+    std::shared_lock<std::shared_mutex> lock(sinksMutex_);
+    for (const auto& sink : sinks_) {
+        if (structured) {
+            sink->log(level, time, structured->message, structured->fields);
+        } else {
+            sink->log(level, time, message);
+        }
+    }
+    if (level == LogLevel::FATAL) {
+        for (const auto& sink : sinks_) {
+            sink->flush();
+        }
+    }
+}
+
+void Logger::addSink(std::shared_ptr<LogSink> sink) {
+    if (!sink) return;
+    std::unique_lock<std::shared_mutex> lock(sinksMutex_);
+    if (std::find(sinks_.begin(), sinks_.end(), sink) != sinks_.end()) {
+        return;
+    }
+    sinks_.push_back(std::move(sink));
+    hasSinks_.store(true, std::memory_order_release);
+}
+
+bool Logger::removeSink(const std::shared_ptr<LogSink>& sink) {
+    std::unique_lock<std::shared_mutex> lock(sinksMutex_);
+    auto it = std::find(sinks_.begin(), sinks_.end(), sink);
+    if (it == sinks_.end()) {
+        return false;
+    }
+    sinks_.erase(it);
+    hasSinks_.store(!sinks_.empty(), std::memory_order_release);
+    lock.unlock();
+    
+    sink->flush();
+    return true;
+}
+
+void Logger::clearSinks() {
+    std::vector<std::shared_ptr<LogSink>> removed;
+    {
+        std::unique_lock<std::shared_mutex> lock(sinksMutex_);
+        removed.swap(sinks_);
+        hasSinks_.store(false, std::memory_order_release);
+    }
+    for (const auto& sink : removed) {
+        sink->flush();
+    }
+}
+
+std::vector<std::shared_ptr<LogSink>> Logger::getSinks() const {
+    std::shared_lock<std::shared_mutex> lock(sinksMutex_);
+    return sinks_;
+}
+
+void Logger::enableFlightRecorder(const FlightRecorderOptions& options) {
+    std::string dumpPath = options.dumpPath;
+    if (dumpPath.empty()) {
+        const std::string logPath = getCurrentLogPath();
+        dumpPath = logPath.empty() ? "flight-recorder.log" : logPath + ".flight";
+    }
+    
+    std::lock_guard<std::mutex> lock(flightMutex_);
+    
+    // 复用每线程条数相同的记录器，避免反复启用时不断累积线程缓冲区
+    FlightRecorder* recorder = nullptr;
+    for (auto& candidate : flightRecorders_) {
+        if (candidate->recordsPerThread() == std::max<size_t>(options.recordsPerThread, 1)) {
+            recorder = candidate.get();
+            recorder->reset(options.level);
+            break;
+        }
+    }
+    if (!recorder) {
+        flightRecorders_.push_back(std::make_unique<FlightRecorder>(options.recordsPerThread, options.level));
+        recorder = flightRecorders_.back().get();
+    }
+    
+    flightDumpPath_ = dumpPath;
+    flightDumpOnFatal_.store(options.dumpOnFatal, std::memory_order_relaxed);
+    flightRecorder_.store(recorder, std::memory_order_release);
+    FlightRecorder::installCrashHandler(options.installCrashHandler ? recorder : nullptr, dumpPath);
+    
+    std::lock_guard<std::mutex> levelLock(namedMutex_);
+    refreshEnabledLevelUnlocked();
+}
+
+void Logger::disableFlightRecorder() {
+    std::lock_guard<std::mutex> lock(flightMutex_);
+    if (!flightRecorder_.exchange(nullptr, std::memory_order_acq_rel)) {
+        return;
+    }
+    FlightRecorder::installCrashHandler(nullptr, std::string());
+    
+    std::lock_guard<std::mutex> levelLock(namedMutex_);
+    refreshEnabledLevelUnlocked();
+}
+
+bool Logger::isFlightRecorderEnabled() const {
+    return flightRecorder_.load(std::memory_order_acquire) != nullptr;
+}
+
+bool Logger::dumpFlightRecorder(const std::string& path) const {
+    std::lock_guard<std::mutex> lock(flightMutex_);
+    const FlightRecorder* recorder = flightRecorder_.load(std::memory_order_acquire);
+    if (!recorder) {
+        return false;
+    }
+    return recorder->dump(path.empty() ? flightDumpPath_ : path, timestampFormat_.load(std::memory_order_relaxed));
+}
+
+void Logger::attachSharedLogRing(std::shared_ptr<SharedLogRing> ring) {
+    if (!ring) return;
+    std::lock_guard<std::mutex> lock(sharedLogMutex_);
+    if (!sharedLogCollector_) {
+        sharedLogCollector_ = std::make_shared<Internal::SharedLogCollector>(
+            [this](const SharedLogRecord& record) {
+                std::string& buffer = formatBuffer();
+                buffer.clear();
+                buffer += "[pid ";
+                buffer += std::to_string(record.processId);
+                buffer += "] ";
+                buffer += record.message;
+                logAt(record.level, record.time, buffer);
+            },
+            kSharedLogMergeWindow);
+    }
+    sharedLogCollector_->addRing(std::move(ring));
+}
+
+bool Logger::detachSharedLogRing(const std::shared_ptr<SharedLogRing>& ring) {
+    std::lock_guard<std::mutex> lock(sharedLogMutex_);
+    if (!sharedLogCollector_ || !sharedLogCollector_->removeRing(ring)) {
+        return false;
+    }
+    if (sharedLogCollector_->ringCount() == 0) {
+        sharedLogCollector_.reset();
+    }
+    return true;
+}
+
+void Logger::logAt(LogLevel level, std::chrono::system_clock::time_point time, const std::string& message) {
+    if (!outputsEnabled(level)) return;
+    if (Internal::BinaryLogSink* sink = binarySink_.load(std::memory_order_acquire)) {
+        sink->write(static_cast<uint8_t>(level), "{}", std::string_view(message));
+        if (level == LogLevel::FATAL) sink->flush();
+        if (!consoleOutput_.load(std::memory_order_relaxed) && !hasSinks_.load(std::memory_order_relaxed)) return;
+    }
+    writeText(level, time, message);
 }
 
 void Logger::trace(const std::string& message) { log(LogLevel::TRACE, message); }
@@ -144,40 +865,28 @@ void Logger::error(const std::string& message) { log(LogLevel::ERR, message); }
 void Logger::fatal(const std::string& message) { log(LogLevel::FATAL, message); }
 
 std::string Logger::getCurrentTime() const {
-    auto now = std::chrono::system_clock::now();
-    auto in_time_t = std::chrono::system_clock::to_time_t(now);
-    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-                now.time_since_epoch()) % 1000;
-    
-    std::stringstream ss;
-    
-    // 跨平台安全的本地时间获取
-    struct tm time_info;
-#if defined(_WIN32)
-    if (localtime_s(&time_info, &in_time_t)) {
-        memset(&time_info, 0, sizeof(time_info));  // 出错时使用默认值
-    }
-#else
-    if (!localtime_r(&in_time_t, &time_info)) {
-        memset(&time_info, 0, sizeof(time_info));  // 出错时使用默认值
-    }
-#endif
+    return TimeUtils::formatTimestamp(std::chrono::system_clock::now(),
+                                      timestampFormat_.load(std::memory_order_relaxed));
+}
 
-    ss << std::put_time(&time_info, "%Y-%m-%d %H:%M:%S");
-    ss << '.' << std::setfill('0') << std::setw(3) << ms.count();
-    return ss.str();
+void Logger::formatEntry(std::string& out,
+                         LogLevel level,
+                         std::chrono::system_clock::time_point time,
+                         const std::string& message) const {
+    char timeStr[TimeUtils::kMaxTimestampLength];
+    const size_t timeLen = TimeUtils::formatTimestamp(
+        timeStr, time, timestampFormat_.load(std::memory_order_relaxed));
+    
+    out += '[';
+    out.append(timeStr, timeLen);
+    out += "] [";
+    out += getLevelString(level);
+    out += "] ";
+    out += message;
 }
 
 std::string Logger::getLevelString(LogLevel level) const {
-    switch(level) {
-        case LogLevel::TRACE: return "TRACE";
-        case LogLevel::DEBUG: return "DEBUG";
-        case LogLevel::INFO:  return "INFO";
-        case LogLevel::WARN:  return "WARN";
-        case LogLevel::ERR: return "ERROR";
-        case LogLevel::FATAL: return "FATAL";
-        default: return "UNKNOWN";
-    }
+    return logLevelName(level);
 }
 
 void Logger::setConsoleColor(LogLevel level) const {
@@ -197,19 +906,7 @@ void Logger::setConsoleColor(LogLevel level) const {
     
     SetConsoleTextAttribute(hConsole, color);
 #else
-    const char* colorCode = "";
-    
-    switch(level) {
-        case LogLevel::FATAL: colorCode = "\033[41;37m"; break; // 红底白字
-        case LogLevel::ERR: colorCode = "\033[31;1m";  break; // 红色加粗
-        case LogLevel::WARN:  colorCode = "\033[33;1m";  break; // 黄色加粗
-        case LogLevel::INFO:  colorCode = "\033[32;1m";  break; // 绿色加粗
-        case LogLevel::DEBUG: colorCode = "\033[34;1m";  break; // 蓝色加粗
-        case LogLevel::TRACE: colorCode = "\033[36m";    break; // 青色
-        default: colorCode = "\033[0m";
-    }
-    
-    std::cout << colorCode;
+    std::cout << Internal::consoleColorCode(level);
 #endif
 }
 
@@ -223,170 +920,550 @@ void Logger::resetConsoleColor() const {
 #endif
 }
 
-void Logger::logInternal(LogLevel level, const std::string& message) {
-    std::lock_guard<std::mutex> lock(logMutex_);
-    
-    std::string timeStr = getCurrentTime();
-    std::string levelStr = getLevelString(level);
-    std::string logEntry = "[" + timeStr + "] [" + levelStr + "] " + message;
+void Logger::logInternal(LogLevel level, std::chrono::system_clock::time_point time, const std::string& message) {
+    // 复用线程局部缓冲区，避免每条日志分配新字符串；格式化不持锁
+    thread_local std::string logEntry;
+    logEntry.clear();
+    formatEntry(logEntry, level, time, message);
     
-    // 控制台输出
-    if (consoleOutput_) {
+    // 控制台输出，与文件分别加锁，终端较慢时不阻塞文件写入
+    if (consoleOutput_.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(consoleMutex_);
         setConsoleColor(level);
         std::cout << logEntry;
         resetConsoleColor();
-        std::cout << std::endl;
+        std::cout << '\n';
         std::cout.flush();
     }
     
     // 文件输出
-    if (fileStream_ && fileStream_->is_open()) {
-        *fileStream_ << logEntry << std::endl;
-        fileStream_->flush();
+    if (textFileOpen_.load(std::memory_order_relaxed)) {
+        logEntry += '\n';
+        std::lock_guard<std::mutex> lock(logMutex_);
+        if (fileStream_ && fileStream_->is_open()) {
+            writeFileUnlocked(logEntry, time);
+        }
     }
 }
 
-std::vector<std::string> Logger::readLogFileUnlocked() const {
-    std::vector<std::string> lines;
-    
-    if (logFilePath_.empty()) {
-        return lines;
+std::vector<Internal::LogSegmentReader*> Logger::acquireSegmentsUnlocked() const {
+    std::vector<Internal::LogSegmentReader*> segments;
+    if (!reader_) {
+        return segments;
     }
     
-    std::ifstream file(logFilePath_);
-    if (!file.is_open()) {
-        throw std::runtime_error("Unable to open log file: " + logFilePath_);
-    }
+    // 先同步当前文件再列出分段：若两步之间发生轮转，当前读取器仍映射着刚被重命名的文件，
+    // 该分段按文件身份去重，不会重复读取
+    reader_->refresh();
     
-    std::string line;
-    while (std::getline(file, line)) {
-        lines.push_back(line);
+    // 列出的分段可能恰好被后台压缩替换，打开失败时重新列出
+    // 压缩分段只记录路径，访问其中的行时才解压
+    for (int attempt = 0; attempt < 3; ++attempt) {
+        bool complete = true;
+        std::vector<std::unique_ptr<Internal::LogSegmentReader>> readers;
+        
+        for (const auto& segment : Internal::listLogSegments(reader_->path())) {
+            auto cached = std::find_if(segmentReaders_.begin(), segmentReaders_.end(),
+                                       [&segment](const auto& reader) {
+                                           return reader && reader->path() == segment.path;
+                                       });
+            if (cached != segmentReaders_.end()) {
+                readers.push_back(std::move(*cached));
+                continue;
+            }
+            
+            std::unique_ptr<Internal::LogSegmentReader> reader;
+            try {
+                reader = std::make_unique<Internal::LogSegmentReader>(segment, *segmentCache_);
+            } catch (const std::runtime_error&) {
+                complete = false;
+                continue;
+            }
+            if (!reader->isSameFile(*reader_)) {
+                readers.push_back(std::move(reader));
+            }
+        }
+        
+        segmentReaders_ = std::move(readers);
+        if (complete) break;
     }
     
-    return lines;
+    for (const auto& reader : segmentReaders_) {
+        segments.push_back(reader.get());
+    }
+    segments.push_back(activeSegment_.get());
+    return segments;
+}
+
+namespace {
+
+size_t totalLineCount(const std::vector<Internal::LogSegmentReader*>& segments) {
+    size_t total = 0;
+    for (auto* segment : segments) {
+        total += segment->lineCount();
+    }
+    return total;
 }
 
+/**
+ * 把连续编号的第 [first, last) 行拆分到各分段上，依次回调
+ * visit(reader, localFirst, localLast, lineBase, byteBase)，返回 false 时停止
+ * lineBase/byteBase 为该分段之前所有分段的行数和字节数
+ * 只加载与范围相交的分段，last 可以超出总行数
+ */
+template<typename Visitor>
+void forEachSegmentRange(const std::vector<Internal::LogSegmentReader*>& segments,
+                         size_t first, size_t last, Visitor&& visit) {
+    size_t lineBase = 0;
+    uint64_t byteBase = 0;
+    for (auto* segment : segments) {
+        if (lineBase >= last) return;
+        
+        const size_t count = segment->lineCount();
+        if (first < lineBase + count) {
+            // 分段在列出后被删除时跳过，行号仍按统计的行数连续编排
+            Internal::LogFileReader* reader = segment->load();
+            if (reader) {
+                const size_t localFirst = first > lineBase ? first - lineBase : 0;
+                const size_t localLast = std::min(last - lineBase, count);
+                if (!visit(*reader, localFirst, localLast, lineBase, byteBase)) return;
+            }
+        }
+        lineBase += count;
+        byteBase += segment->size();
+    }
+}
+
+} // 匿名命名空间
+
 std::vector<std::string> Logger::readAllLogs() const {
-    std::lock_guard<std::mutex> lock(logMutex_);
-    return readLogFileUnlocked();
+    std::lock_guard<std::mutex> lock(readerMutex_);
+    std::vector<std::string> result;
+    for (auto* segment : acquireSegmentsUnlocked()) {
+        Internal::LogFileReader* reader = segment->load();
+        if (!reader) continue;
+        auto lines = reader->readLines(0, reader->lineCount());
+        result.insert(result.end(), std::make_move_iterator(lines.begin()), std::make_move_iterator(lines.end()));
+    }
+    return result;
 }
 
 std::vector<std::string> Logger::readLogsFromBeginning(int maxLines) const {
-    std::lock_guard<std::mutex> lock(logMutex_);
-    auto lines = readLogFileUnlocked();
+    if (maxLines <= 0) return readAllLogs();
     
-    if (maxLines > 0 && static_cast<int>(lines.size()) > maxLines) {
-        lines.resize(maxLines);
+    std::lock_guard<std::mutex> lock(readerMutex_);
+    std::vector<std::string> result;
+    for (auto* segment : acquireSegmentsUnlocked()) {
+        const size_t remaining = static_cast<size_t>(maxLines) - result.size();
+        if (remaining == 0) break;
+        Internal::LogFileReader* reader = segment->load();
+        if (!reader) continue;
+        auto lines = reader->readHead(remaining);
+        result.insert(result.end(), std::make_move_iterator(lines.begin()), std::make_move_iterator(lines.end()));
     }
-    
-    return lines;
+    return result;
 }
 
 std::vector<std::string> Logger::readLogsFromEnd(int maxLines) const {
-    std::lock_guard<std::mutex> lock(logMutex_);
-    auto lines = readLogFileUnlocked();
+    if (maxLines <= 0) return readAllLogs();
+    
+    std::lock_guard<std::mutex> lock(readerMutex_);
+    const auto segments = acquireSegmentsUnlocked();
     
-    if (maxLines > 0 && static_cast<int>(lines.size()) > maxLines) {
-        lines.erase(lines.begin(), lines.end() - maxLines);
+    // 从最新的分段尾部反向扫描，不需要读取或索引整个文件
+    std::vector<std::vector<std::string>> chunks;
+    size_t collected = 0;
+    for (auto it = segments.rbegin(); it != segments.rend() && collected < static_cast<size_t>(maxLines); ++it) {
+        Internal::LogFileReader* reader = (*it)->load();
+        if (!reader) continue;
+        chunks.push_back(reader->readTail(static_cast<size_t>(maxLines) - collected));
+        collected += chunks.back().size();
     }
     
-    return lines;
+    std::vector<std::string> result;
+    result.reserve(collected);
+    for (auto it = chunks.rbegin(); it != chunks.rend(); ++it) {
+        result.insert(result.end(), std::make_move_iterator(it->begin()), std::make_move_iterator(it->end()));
+    }
+    return result;
 }
 
-std::vector<std::string> Logger::readLogsInRange(int startLine, int endLine) const {
-    std::lock_guard<std::mutex> lock(logMutex_);
-    auto lines = readLogFileUnlocked();
-    
-    if (lines.empty()) return {};
-    
-    const int totalLines = static_cast<int>(lines.size());
+std::vector<std::string> Logger::readLogsInTimeRange(std::chrono::system_clock::time_point from,
+                                                     std::chrono::system_clock::time_point to,
+                                                     size_t maxLines) const {
+    const Internal::LogTimeBound fromBound(from);
+    const Internal::LogTimeBound toBound(to);
     
+    std::lock_guard<std::mutex> lock(readerMutex_);
+    std::vector<std::string> result;
+    if (!(from < to)) {
+        return result;
+    }
+    for (auto* segment : acquireSegmentsUnlocked()) {
+        // 先按修改时间和开头的时间戳跳过范围之外的分段，压缩分段不必整体解压；
+        // 分段按时间排列，开始于 to 之后的分段之后都不会再有匹配的行
+        if (segment->endsBefore(from)) continue;
+        if (segment->startsNotBefore(toBound)) break;
+        Internal::LogFileReader* reader = segment->load();
+        if (!reader) continue;
+        std::string_view view = Internal::sliceByTime(reader->contents(), fromBound, toBound);
+        while (!view.empty()) {
+            if (maxLines != 0 && result.size() >= maxLines) {
+                return result;
+            }
+            const size_t newline = view.find('\n');
+            std::string_view line = view.substr(0, newline);
+            if (!line.empty() && line.back() == '\r') {
+                line.remove_suffix(1);
+            }
+            result.emplace_back(line);
+            view.remove_prefix(newline == std::string_view::npos ? view.size() : newline + 1);
+        }
+    }
+    return result;
+}
+
+namespace {
+
+// 将 1-based（负数表示倒数）的行号范围转换为 0-based 的 [first, last)
+// 范围为空时返回 false。只有出现倒数行号时才统计总行数，否则 last 可能超出总行数，
+// 由 forEachSegmentRange 截断，范围之后的分段不会被读取
+bool resolveLineRange(int startLine, int endLine,
+                      const std::vector<Internal::LogSegmentReader*>& segments,
+                      size_t& first, size_t& last) {
     // 处理非法值0：视为第1行
     if (startLine == 0) startLine = 1;
     if (endLine == 0) endLine = 1;
     
+    if (startLine > 0 && endLine > 0) {
+        if (segments.empty() || startLine > endLine) return false;
+        first = static_cast<size_t>(startLine) - 1;
+        last = static_cast<size_t>(endLine);
+        return true;
+    }
+    
+    const size_t totalLines = totalLineCount(segments);
+    if (totalLines == 0) return false;
+    
+    const int total = static_cast<int>(totalLines);
+    
     // 转换1-based为0-based索引（正数-1，负数直接加总行数）
-    auto toZeroBased = [totalLines](int line) {
-        return line > 0 ? line - 1 : totalLines + line;
+    auto toZeroBased = [total](int line) {
+        return line > 0 ? line - 1 : total + line;
     };
     
-    int startIndex = toZeroBased(startLine);
-    int endIndex = toZeroBased(endLine);
+    int startIndex = std::max(0, toZeroBased(startLine));
+    int endIndex = std::min(total - 1, toZeroBased(endLine));
     
-    // 边界检查
-    startIndex = std::max(0, startIndex);
-    endIndex = std::min(totalLines - 1, endIndex);
+    if (startIndex > endIndex) return false;
     
-    if (startIndex > endIndex) return {};
+    first = static_cast<size_t>(startIndex);
+    last = static_cast<size_t>(endIndex) + 1;
+    return true;
+}
+
+} // 匿名命名空间
+
+std::vector<std::string> Logger::readLogsInRange(int startLine, int endLine) const {
+    std::lock_guard<std::mutex> lock(readerMutex_);
+    const auto segments = acquireSegmentsUnlocked();
     
-    std::vector<std::string> result;
-    result.reserve(endIndex - startIndex + 1); // 预分配内存
-    for (int i = startIndex; i <= endIndex; ++i) {
-        result.push_back(lines[i]);
+    size_t first = 0;
+    size_t last = 0;
+    if (!resolveLineRange(startLine, endLine, segments, first, last)) {
+        return {};
     }
     
+    std::vector<std::string> result;
+    forEachSegmentRange(segments, first, last,
+                        [&result](Internal::LogFileReader& reader, size_t localFirst, size_t localLast,
+                                  size_t, uint64_t) {
+        auto lines = reader.readLines(localFirst, localLast);
+        result.insert(result.end(), std::make_move_iterator(lines.begin()), std::make_move_iterator(lines.end()));
+        return true;
+    });
     return result;
 }
 
+namespace {
+
+// 关键词不能跨行：含换行符的关键词在按行语义下永远不会命中
+bool isSearchableTerm(const std::string& term) {
+    return !term.empty() && term.find('\n') == std::string::npos;
+}
+
+/**
+ * 在连续的多行区域中流式查找所有关键词，按偏移顺序回调 onMatch(termIndex, position, length)
+ * 关键词不含换行符，因此每处匹配都完整地落在某一行内
+ */
+template<typename OnMatch>
+bool scanTerms(std::string_view region,
+               const std::vector<Internal::CaseInsensitiveMatcher>& matchers,
+               const std::vector<size_t>& termIndices,
+               OnMatch&& onMatch) {
+    constexpr size_t npos = Internal::CaseInsensitiveMatcher::npos;
+    
+    std::vector<size_t> next(matchers.size());
+    for (size_t i = 0; i < matchers.size(); ++i) {
+        next[i] = matchers[i].find(region, 0);
+    }
+    
+    while (true) {
+        size_t best = npos;
+        size_t bestMatcher = 0;
+        for (size_t i = 0; i < matchers.size(); ++i) {
+            if (next[i] < best) {
+                best = next[i];
+                bestMatcher = i;
+            }
+        }
+        if (best == npos) {
+            return true;
+        }
+        if (!onMatch(termIndices[bestMatcher], best, matchers[bestMatcher].size())) {
+            return false;
+        }
+        next[bestMatcher] = matchers[bestMatcher].find(region, best + matchers[bestMatcher].size());
+    }
+}
+
+} // 匿名命名空间
+
 bool Logger::containsInLogs(const std::string& searchText, 
                           int startLine, 
                           int endLine) const {
-    std::lock_guard<std::mutex> lock(logMutex_);
-    auto lines = readLogFileUnlocked();
+    std::lock_guard<std::mutex> lock(readerMutex_);
+    const auto segments = acquireSegmentsUnlocked();
     
-    if (lines.empty()) return false;
-    
-    const int totalLines = static_cast<int>(lines.size());
+    size_t first = 0;
+    size_t last = 0;
+    if (!resolveLineRange(startLine, endLine, segments, first, last)) {
+        return false;
+    }
     
-    // 处理非法值0：视为第1行
-    if (startLine == 0) startLine = 1;
-    if (endLine == 0) endLine = 1;
+    if (!searchText.empty() && !isSearchableTerm(searchText)) return false;
     
-    // 转换1-based为0-based索引
-    auto toZeroBased = [totalLines](int line) {
-        return line > 0 ? line - 1 : totalLines + line;
-    };
+    // 直接在映射区域上查找，不逐行复制；空串与范围内任意一行都匹配
+    Internal::CaseInsensitiveMatcher matcher(searchText);
+    bool found = false;
+    forEachSegmentRange(segments, first, last,
+                        [&](Internal::LogFileReader& reader, size_t localFirst, size_t localLast,
+                            size_t, uint64_t) {
+        found = searchText.empty() ||
+                matcher.find(reader.linesView(localFirst, localLast)) != Internal::CaseInsensitiveMatcher::npos;
+        return !found;
+    });
+    return found;
+}
+
+std::vector<LogMatch> Logger::searchLogs(const std::string& searchText,
+                                         int startLine,
+                                         int endLine,
+                                         size_t maxMatches) const {
+    return searchLogsAny({searchText}, startLine, endLine, maxMatches);
+}
+
+std::vector<LogMatch> Logger::searchLogsAny(const std::vector<std::string>& terms,
+                                            int startLine,
+                                            int endLine,
+                                            size_t maxMatches) const {
+    std::vector<Internal::CaseInsensitiveMatcher> matchers;
+    std::vector<size_t> termIndices;
+    for (size_t i = 0; i < terms.size(); ++i) {
+        if (isSearchableTerm(terms[i])) {
+            matchers.emplace_back(terms[i]);
+            termIndices.push_back(i);
+        }
+    }
     
-    int startIndex = toZeroBased(startLine);
-    int endIndex = toZeroBased(endLine);
+    std::vector<LogMatch> matches;
+    if (matchers.empty()) return matches;
     
-    // 边界检查
-    startIndex = std::max(0, startIndex);
-    endIndex = std::min(totalLines - 1, endIndex);
+    std::lock_guard<std::mutex> lock(readerMutex_);
+    const auto segments = acquireSegmentsUnlocked();
     
-    if (startIndex > endIndex) return false;
+    size_t first = 0;
+    size_t last = 0;
+    if (!resolveLineRange(startLine, endLine, segments, first, last)) {
+        return matches;
+    }
     
-    // 大小写不敏感搜索（优化：避免重复转换搜索文本）
-    std::string lowerSearch;
-    lowerSearch.reserve(searchText.size());
-    std::transform(searchText.begin(), searchText.end(), 
-                  std::back_inserter(lowerSearch),
-                  [](unsigned char c){ return std::tolower(c); });
-    
-    for (int i = startIndex; i <= endIndex; ++i) {
-        // 避免修改原字符串
-        std::string lowerLine;
-        lowerLine.reserve(lines[i].size());
-        std::transform(lines[i].begin(), lines[i].end(),
-                      std::back_inserter(lowerLine),
-                      [](unsigned char c){ return std::tolower(c); });
+    forEachSegmentRange(segments, first, last,
+                        [&](Internal::LogFileReader& reader, size_t localFirst, size_t localLast,
+                            size_t lineBase, uint64_t byteBase) {
+        const std::string_view region = reader.linesView(localFirst, localLast);
+        const uint64_t regionOffset = byteBase + static_cast<uint64_t>(region.data() - reader.contents().data());
         
-        if (lowerLine.find(lowerSearch) != std::string::npos) {
-            return true;
-        }
+        // 行号随匹配位置向前推进，只统计两次匹配之间的换行符
+        size_t lineIndex = lineBase + localFirst;
+        size_t countedUpTo = 0;
+        return scanTerms(region, matchers, termIndices, [&](size_t termIndex, size_t position, size_t length) {
+            lineIndex += static_cast<size_t>(std::count(region.begin() + countedUpTo, region.begin() + position, '\n'));
+            countedUpTo = position;
+            
+            LogMatch match;
+            match.lineNumber = lineIndex + 1;
+            match.offset = regionOffset + position;
+            match.length = length;
+            match.termIndex = termIndex;
+            matches.push_back(match);
+            return maxMatches == 0 || matches.size() < maxMatches;
+        });
+    });
+    
+    return matches;
+}
+
+std::vector<LogMatch> Logger::searchLogsRegex(const std::string& pattern,
+                                              int startLine,
+                                              int endLine,
+                                              size_t maxMatches) const {
+    // 在加锁之前编译正则表达式，非法时直接抛出
+    const std::regex regex(pattern, std::regex::ECMAScript | std::regex::icase);
+    
+    std::vector<LogMatch> matches;
+    std::lock_guard<std::mutex> lock(readerMutex_);
+    const auto segments = acquireSegmentsUnlocked();
+    
+    size_t first = 0;
+    size_t last = 0;
+    if (!resolveLineRange(startLine, endLine, segments, first, last)) {
+        return matches;
     }
     
-    return false;
+    forEachSegmentRange(segments, first, last,
+                        [&](Internal::LogFileReader& reader, size_t localFirst, size_t localLast,
+                            size_t lineBase, uint64_t byteBase) {
+        const char* const base = reader.contents().data();
+        return reader.forEachLine(localFirst, localLast, [&](size_t lineIndex, std::string_view line) {
+            const char* const lineEnd = line.data() + line.size();
+            for (std::cregex_iterator it(line.data(), lineEnd, regex), end; it != end; ++it) {
+                LogMatch match;
+                match.lineNumber = lineBase + lineIndex + 1;
+                match.offset = byteBase + static_cast<uint64_t>(line.data() - base) + static_cast<uint64_t>(it->position());
+                match.length = static_cast<size_t>(it->length());
+                matches.push_back(match);
+                if (maxMatches != 0 && matches.size() >= maxMatches) {
+                    return false;
+                }
+            }
+            return true;
+        });
+    });
+    
+    return matches;
+}
+
+void Logger::reportSuppressed(LogThrottleSite& site) {
+    const uint64_t count = site.takeSuppressed();
+    if (count == 0) return;
+    reportSuppressed(site.file(), site.line(), site.level(), count);
+}
+
+void Logger::reportSuppressed() {
+    // 先在登记锁内取出快照再输出，调用点可能随插件卸载而析构
+    for (const LogThrottleSite::Suppressed& entry : LogThrottleSite::takeAllSuppressed()) {
+        reportSuppressed(entry.file, entry.line, entry.level, entry.count);
+    }
+}
+
+void Logger::reportSuppressed(std::string_view file, int line, LogLevel level, uint64_t count) {
+    // 只保留文件名，避免摘要中出现构建机上的完整路径
+    const size_t slash = file.find_last_of("/\\");
+    if (slash != std::string_view::npos) {
+        file.remove_prefix(slash + 1);
+    }
+    log<>(level, "suppressed {} messages from {}:{}", count, file, line);
 }
 
 // 刷新缓冲区
 void Logger::flush() {
+    reportSuppressed();
+    // 收集线程写出的 FATAL 日志也会触发 flush()，此时它自己正持有收集器的锁
+    if (!Internal::SharedLogCollector::isDelivering()) {
+        std::shared_ptr<Internal::SharedLogCollector> collector;
+        {
+            std::lock_guard<std::mutex> lock(sharedLogMutex_);
+            collector = sharedLogCollector_;
+        }
+        if (collector) {
+            collector->flush();
+        }
+    }
+    if (AsyncWriter* writer = asyncWriter_.load(std::memory_order_acquire)) {
+        writer->waitUntilDrained();
+    }
+    if (Internal::BinaryLogSink* sink = binarySink_.load(std::memory_order_acquire)) {
+        sink->flush();
+    }
+    if (hasSinks_.load(std::memory_order_acquire)) {
+        std::shared_lock<std::shared_mutex> sinksLock(sinksMutex_);
+        for (const auto& sink : sinks_) {
+            sink->flush();
+        }
+    }
     std::lock_guard<std::mutex> lock(logMutex_);
     if (fileStream_ && fileStream_->is_open()) {
         fileStream_->flush();
     }
 }
 
+// ================ NamedLogger ================
+
+NamedLogger::NamedLogger(Logger& owner, std::string name, NamedLogger* parent, LogLevel level)
+    : owner_(owner), name_(std::move(name)), parent_(parent), effectiveLevel_(level), enabledLevel_(level) {}
+
+void NamedLogger::setLevel(LogLevel level) {
+    std::lock_guard<std::mutex> lock(owner_.namedMutex_);
+    hasExplicitLevel_ = true;
+    explicitLevel_ = level;
+    owner_.refreshNamedLevelsUnlocked();
+}
+
+void NamedLogger::resetLevel() {
+    std::lock_guard<std::mutex> lock(owner_.namedMutex_);
+    hasExplicitLevel_ = false;
+    owner_.refreshNamedLevelsUnlocked();
+}
+
+bool NamedLogger::getExplicitLevel(LogLevel& level) const {
+    std::lock_guard<std::mutex> lock(owner_.namedMutex_);
+    if (hasExplicitLevel_) {
+        level = explicitLevel_;
+    }
+    return hasExplicitLevel_;
+}
+
+void NamedLogger::log(LogLevel level, const std::string& message) {
+    if (!isEnabled(level)) return;
+    
+    std::string& buffer = Logger::formatBuffer();
+    buffer.clear();
+    appendPrefix(buffer);
+    buffer += message;
+    owner_.logFormatted(level, buffer, level >= getEffectiveLevel(), true);
+}
+
+void NamedLogger::logFields(LogLevel level, std::string_view message, std::span<const LogField> fields) {
+    if (!isEnabled(level)) return;
+    
+    std::string& buffer = Logger::formatBuffer();
+    buffer.clear();
+    appendPrefix(buffer);
+    buffer += message;
+    const size_t messageLength = buffer.size();
+    Internal::appendLogFieldsText(buffer, fields);
+    const Logger::StructuredParts structured{std::string_view(buffer).substr(0, messageLength), fields};
+    owner_.logFormatted(level, buffer, level >= getEffectiveLevel(), true, &structured);
+}
+
+void NamedLogger::appendPrefix(std::string& buffer) const {
+    if (name_.empty()) return;
+    buffer += '[';
+    buffer += name_;
+    buffer += "] ";
+}
+
 // 获取当前日志路径
 std::string Logger::getCurrentLogPath() const {
     std::lock_guard<std::mutex> lock(logMutex_);
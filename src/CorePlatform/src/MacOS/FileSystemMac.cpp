@@ -1,12 +1,18 @@
 #include "CorePlatform/FileSystem.h"
+#include "CorePlatform/Internal/WorkQueue.h"
+#include "CorePlatform/StringUtils.h"
 #include <unistd.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <dirent.h>
 #include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/clonefile.h>
+#include <copyfile.h>
 #include <cstring>
 #include <vector>
 #include <algorithm>
+#include <utility>
 #include <climits>
 #include <cstdlib>
 #include <cerrno>
@@ -15,6 +21,8 @@
 #include <pwd.h>
 #include <mach-o/dyld.h> // macOS 特有的可执行路径获取
 #include <stdexcept>
+#include <atomic>
+#include <mutex>
 
 namespace CorePlatform {
 
@@ -62,49 +70,659 @@ bool CreateDirectoryRecursive(const std::string& path, mode_t mode = 0755) {
     return mkdir(path.c_str(), mode) == 0;
 }
 
-// 递归删除目录
-bool DeleteDirectoryRecursive(const std::string& path) {
-    DIR* dir = opendir(path.c_str());
-    if (!dir) return false;
+int ToPosixAdvice(FileSystem::MapAdvice advice) {
+    switch (advice) {
+        case FileSystem::MapAdvice::Sequential: return POSIX_MADV_SEQUENTIAL;
+        case FileSystem::MapAdvice::Random: return POSIX_MADV_RANDOM;
+        case FileSystem::MapAdvice::WillNeed: return POSIX_MADV_WILLNEED;
+        default: return POSIX_MADV_NORMAL;
+    }
+}
+
+// 打开文件，被信号中断时重试
+int OpenRetrying(const char* path, int flags, mode_t mode = 0) {
+    int fd;
+    do {
+        fd = open(path, flags, mode);
+    } while (fd == -1 && errno == EINTR);
+    return fd;
+}
+
+// 相对于目录描述符打开文件，被信号中断时重试
+int OpenAtRetrying(int dirFd, const char* name, int flags, mode_t mode = 0) {
+    int fd;
+    do {
+        fd = openat(dirFd, name, flags, mode);
+    } while (fd == -1 && errno == EINTR);
+    return fd;
+}
+
+// 关闭文件描述符，保留之前操作设置的 errno
+void CloseKeepingErrno(int fd) {
+    int savedErrno = errno;
+    close(fd);
+    errno = savedErrno;
+}
+
+// 读满 size 字节或读到文件末尾，处理部分读取和 EINTR；返回读取的字节数，出错时返回 -1
+ssize_t ReadFully(int fd, void* buffer, size_t size) {
+    size_t total = 0;
+    while (total < size) {
+        ssize_t n = read(fd, static_cast<char*>(buffer) + total, size - total);
+        if (n > 0) {
+            total += static_cast<size_t>(n);
+        } else if (n == 0) {
+            break;
+        } else if (errno != EINTR) {
+            return -1;
+        }
+    }
+    return static_cast<ssize_t>(total);
+}
+
+// 写出全部 size 字节，处理部分写入和 EINTR
+bool WriteFully(int fd, const void* data, size_t size) {
+    size_t total = 0;
+    while (total < size) {
+        ssize_t n = write(fd, static_cast<const char*>(data) + total, size - total);
+        if (n > 0) {
+            total += static_cast<size_t>(n);
+        } else if (n == 0) {
+            errno = EIO;
+            return false;
+        } else if (errno != EINTR) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 读取整个文件到 buffer（std::vector<uint8_t> 或 std::string），容量足够时不分配内存
+template<typename Buffer>
+bool ReadWholeFile(const std::string& path, Buffer& buffer) {
+    int fd = OpenRetrying(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+        return false;
+    }
     
-    bool success = true;
-    struct dirent* entry;
+    // 多留一个字节：读满说明文件在 fstat 之后增长了，继续按块扩展；
+    // /proc 等文件的大小为 0，从缓冲区已有的容量开始
+    constexpr size_t kMinChunk = 4096;
+    struct stat st;
+    size_t expected = 0;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        expected = static_cast<size_t>(st.st_size) + 1;
+    } else {
+        expected = std::max(buffer.capacity(), kMinChunk);
+    }
+    buffer.resize(expected);
     
-    while ((entry = readdir(dir)) != nullptr) {
-        // 跳过 "." 和 ".."
-        if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
-            continue;
+    size_t total = 0;
+    while (true) {
+        ssize_t n = ReadFully(fd, buffer.data() + total, buffer.size() - total);
+        if (n < 0) {
+            CloseKeepingErrno(fd);
+            buffer.clear();
+            return false;
+        }
+        total += static_cast<size_t>(n);
+        if (total < buffer.size()) {
+            break;
+        }
+        buffer.resize(std::max(buffer.size() * 2, kMinChunk));
+    }
+    close(fd);
+    buffer.resize(total);
+    return true;
+}
+
+// 文件复制引擎：按 SEEK_DATA/SEEK_HOLE 跳过空洞，用缓冲区读写数据段
+class FileCopier {
+public:
+    FileCopier(int sourceFd, int destFd, uint64_t totalBytes, const FileSystem::CopyOptions& options)
+        : source(sourceFd), dest(destFd), total(totalBytes), options(options) {}
+
+    bool Run(FileSystem::CopyResult& result) {
+        result.totalBytes = total;
+        bool sparse = options.preserveSparse;
+        uint64_t offset = 0;
+        while (offset < total) {
+            // 找到下一段数据 [dataStart, dataEnd)，中间的空洞不读不写
+            uint64_t dataStart = offset;
+            uint64_t dataEnd = total;
+            if (sparse) {
+                off_t data = lseek(source, static_cast<off_t>(offset), SEEK_DATA);
+                if (data >= 0) {
+                    off_t hole = lseek(source, data, SEEK_HOLE);
+                    dataStart = static_cast<uint64_t>(data);
+                    dataEnd = hole >= 0 ? std::min<uint64_t>(static_cast<uint64_t>(hole), total) : total;
+                } else if (errno == ENXIO) {
+                    dataStart = total;    // 剩余部分都是空洞
+                } else {
+                    sparse = false;       // 文件系统不支持 SEEK_DATA，剩余部分按数据复制
+                }
+            }
+            
+            for (uint64_t position = dataStart; position < dataEnd;) {
+                ssize_t n = CopyChunk(position, dataEnd - position);
+                if (n < 0) {
+                    return false;
+                }
+                if (n == 0) {
+                    // 复制期间源文件被截断
+                    total = position;
+                    dataEnd = position;
+                    break;
+                }
+                position += static_cast<uint64_t>(n);
+                copied += static_cast<uint64_t>(n);
+                if (!ReportProgress(position)) {
+                    return false;
+                }
+            }
+            offset = dataEnd;
         }
         
-        std::string fullPath = path + "/" + entry->d_name;
-        struct stat statbuf;
+        // 末尾的空洞只需设置文件大小
+        if (ftruncate(dest, static_cast<off_t>(total)) != 0) {
+            return false;
+        }
+        result.method = copied > 0 ? FileSystem::CopyMethod::Buffered : FileSystem::CopyMethod::None;
+        result.bytesCopied = copied;
+        result.totalBytes = total;
+        return ReportProgress(total);
+    }
+
+private:
+    bool ReportProgress(uint64_t position) {
+        if (options.progress && !options.progress(position, total)) {
+            errno = ECANCELED;
+            return false;
+        }
+        return true;
+    }
+
+    // 从 offset 开始复制最多 length 字节，返回复制的字节数，源文件已到末尾时返回 0，出错时返回 -1
+    ssize_t CopyChunk(uint64_t offset, uint64_t length) {
+        if (buffer.empty()) {
+            buffer.resize(std::max<size_t>(options.bufferSize, 4096));
+        }
+        size_t chunk = static_cast<size_t>(std::min<uint64_t>(length, buffer.size()));
         
-        if (lstat(fullPath.c_str(), &statbuf) != 0) {
-            success = false;
-            continue;
+        ssize_t n;
+        do {
+            n = pread(source, buffer.data(), chunk, static_cast<off_t>(offset));
+        } while (n < 0 && errno == EINTR);
+        if (n <= 0) {
+            return n;
         }
         
-        if (S_ISDIR(statbuf.st_mode)) {
-            // 递归删除子目录
-            if (!DeleteDirectoryRecursive(fullPath)) {
-                success = false;
+        size_t written = 0;
+        while (written < static_cast<size_t>(n)) {
+            ssize_t w = pwrite(dest, buffer.data() + written, static_cast<size_t>(n) - written,
+                               static_cast<off_t>(offset + written));
+            if (w > 0) {
+                written += static_cast<size_t>(w);
+            } else if (w == 0) {
+                errno = EIO;
+                return -1;
+            } else if (errno != EINTR) {
+                return -1;
             }
-        } else {
-            // 删除文件
-            if (unlink(fullPath.c_str()) != 0) {
-                success = false;
+        }
+        return n;
+    }
+
+    const int source;
+    const int dest;
+    uint64_t total;
+    const FileSystem::CopyOptions& options;
+    uint64_t copied = 0;
+    std::vector<char> buffer;
+};
+
+// 目录树操作的共享状态：任务队列、计数和错误列表
+class TreeOperation {
+public:
+    explicit TreeOperation(const FileSystem::TreeOptions& options)
+        : options(options), queue(options.threads) {}
+
+    void AddError(const std::string& path, int error) {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        errors.push_back({path, std::error_code(error, std::generic_category())});
+        if (options.stopOnError) {
+            stopped.store(true, std::memory_order_relaxed);
+        }
+    }
+
+    // 汇总结果；有错误时返回 false，errno 为第一个错误
+    bool Finish(FileSystem::TreeResult* result) {
+        bool success = errors.empty();
+        if (!success) {
+            errno = errors.front().error.value();
+        }
+        if (result) {
+            result->files = files.load();
+            result->directories = directories.load();
+            result->bytes = bytes.load();
+            result->errors = std::move(errors);
+        }
+        return success;
+    }
+
+    const FileSystem::TreeOptions& options;
+    Internal::WorkQueue queue;
+    std::atomic<uint64_t> files{0};
+    std::atomic<uint64_t> directories{0};
+    std::atomic<uint64_t> bytes{0};
+    std::atomic<bool> stopped{false};
+    std::mutex errorMutex;
+    std::vector<FileSystem::TreeError> errors;
+};
+
+// 目录树中的一个目录：它的内容（包括所有子目录）处理完之后才能删除它或设置它的权限和时间。
+// 子目录相对于父节点保持打开的描述符访问（openat/mkdirat/unlinkat），遍历期间路径中的目录被替换为
+// 符号链接也不会被跟随到树外
+struct TreeNode {
+    std::string source;                 // 完整路径，用于错误信息
+    std::string dest;
+    std::string name;                   // 在父目录中的名称，根节点为空
+    TreeNode* parent = nullptr;
+    int sourceFd = -1;                  // 源目录，所有子目录完成之前保持打开
+    int destFd = -1;                    // 复制时：目标目录
+    std::atomic<size_t> pending{1};     // 自身的扫描 + 尚未完成的子目录
+    std::atomic<bool> failed{false};    // 删除时：有内容没有删除，保留该目录
+    bool created = false;               // 复制时：目标目录已创建，完成后设置权限和时间
+    struct stat st {};
+
+    // 相对于父目录描述符的位置；根节点没有父节点，使用调用者给出的路径
+    int SourceParentFd() const { return parent ? parent->sourceFd : AT_FDCWD; }
+    int DestParentFd() const { return parent ? parent->destFd : AT_FDCWD; }
+    const char* SourceName() const { return parent ? name.c_str() : source.c_str(); }
+    const char* DestName() const { return parent ? name.c_str() : dest.c_str(); }
+};
+
+bool IsDotOrDotDot(const char* name) {
+    return name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'));
+}
+
+// 打开源目录用于遍历，不跟随符号链接；另外保留一个描述符供子目录使用（DIR 在扫描完后即关闭）
+DIR* OpenSourceDirectory(TreeNode* node, int& fd) {
+    fd = OpenAtRetrying(node->SourceParentFd(), node->SourceName(), O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+    if (fd == -1) {
+        return nullptr;
+    }
+    node->sourceFd = fcntl(fd, F_DUPFD_CLOEXEC, 0);
+    DIR* dir = node->sourceFd == -1 ? nullptr : fdopendir(fd);
+    if (!dir) {
+        CloseKeepingErrno(fd);
+    }
+    return dir;
+}
+
+// 关闭节点保持打开的目录描述符
+void CloseNodeDirectories(TreeNode* node) {
+    if (node->sourceFd != -1) {
+        close(node->sourceFd);
+        node->sourceFd = -1;
+    }
+    if (node->destFd != -1) {
+        close(node->destFd);
+        node->destFd = -1;
+    }
+}
+
+// 完成目录的一项工作；最后一项完成时删除该目录，再向上通知父目录
+void FinishDeleteNode(TreeOperation& op, TreeNode* node) {
+    while (node && node->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        TreeNode* parent = node->parent;
+        CloseNodeDirectories(node);
+        bool failed = node->failed.load(std::memory_order_relaxed);
+        if (!failed) {
+            if (unlinkat(node->SourceParentFd(), node->SourceName(), AT_REMOVEDIR) == 0) {
+                op.directories.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                op.AddError(node->source, errno);
+                failed = true;
             }
         }
+        if (failed && parent) {
+            parent->failed.store(true, std::memory_order_relaxed);
+        }
+        delete node;
+        node = parent;
+    }
+}
+
+void DeleteTreeNode(TreeOperation& op, TreeNode* node) {
+    int fd = -1;
+    DIR* dir = op.stopped.load(std::memory_order_relaxed) ? nullptr : OpenSourceDirectory(node, fd);
+    if (!dir) {
+        if (!op.stopped.load(std::memory_order_relaxed)) {
+            op.AddError(node->source, errno);
+        }
+        node->failed.store(true, std::memory_order_relaxed);
+        FinishDeleteNode(op, node);
+        return;
     }
     
+    while (struct dirent* entry = readdir(dir)) {
+        const char* name = entry->d_name;
+        if (IsDotOrDotDot(name)) {
+            continue;
+        }
+        // 按 d_type 区分目录，只有类型未知时才需要 fstatat（macOS 上对目录 unlinkat 返回 EPERM，不能用来判断）
+        bool isDirectory = entry->d_type == DT_DIR;
+        if (entry->d_type == DT_UNKNOWN) {
+            struct stat st;
+            isDirectory = fstatat(fd, name, &st, AT_SYMLINK_NOFOLLOW) == 0 && S_ISDIR(st.st_mode);
+        }
+        if (!isDirectory) {
+            if (unlinkat(fd, name, 0) == 0) {
+                op.files.fetch_add(1, std::memory_order_relaxed);
+            } else if (errno != ENOENT) {
+                op.AddError(node->source + '/' + name, errno);
+                node->failed.store(true, std::memory_order_relaxed);
+            }
+            continue;
+        }
+        
+        auto* child = new TreeNode;
+        child->source = node->source + '/' + name;
+        child->name = name;
+        child->parent = node;
+        node->pending.fetch_add(1, std::memory_order_relaxed);
+        op.queue.push([&op, child] { DeleteTreeNode(op, child); });
+    }
     closedir(dir);
+    FinishDeleteNode(op, node);
+}
+
+// 在目录描述符之间复制一个普通文件，失败时返回 errno
+int CopyFileAt(TreeOperation& op, int sourceDir, int destDir, const char* name, const struct stat& st) {
+    int source = openat(sourceDir, name, O_RDONLY | O_NOFOLLOW | O_CLOEXEC);
+    if (source == -1) {
+        return errno;
+    }
+    int flags = O_WRONLY | O_CREAT | O_NOFOLLOW | O_CLOEXEC | (op.options.overwrite ? O_TRUNC : O_EXCL);
+    int dest = openat(destDir, name, flags, st.st_mode & 0777);
+    if (dest == -1) {
+        int error = errno;
+        close(source);
+        return error;
+    }
     
-    // 删除空目录
-    if (success) {
-        success = rmdir(path.c_str()) == 0;
+    FileSystem::CopyOptions copyOptions;
+    copyOptions.overwrite = op.options.overwrite;
+    FileSystem::CopyResult copyResult;
+    FileCopier copier(source, dest, static_cast<uint64_t>(st.st_size), copyOptions);
+    bool success = copier.Run(copyResult);
+    if (success && op.options.copyMetadata) {
+        const struct timespec times[2] = {st.st_atimespec, st.st_mtimespec};
+        success = fchmod(dest, st.st_mode & 07777) == 0 && futimens(dest, times) == 0;
     }
+    int error = success ? 0 : errno;
+    close(source);
+    if (close(dest) != 0 && success) {
+        error = errno;
+    }
+    if (error != 0) {
+        unlinkat(destDir, name, 0);
+    } else {
+        op.bytes.fetch_add(copyResult.bytesCopied, std::memory_order_relaxed);
+    }
+    return error;
+}
+
+// 复制符号链接本身，失败时返回 errno
+int CopySymlinkAt(TreeOperation& op, int sourceDir, int destDir, const char* name, const struct stat& st) {
+    std::string target(static_cast<size_t>(st.st_size > 0 ? st.st_size : PATH_MAX), '\0');
+    ssize_t length = readlinkat(sourceDir, name, target.data(), target.size());
+    if (length < 0) {
+        return errno;
+    }
+    target.resize(static_cast<size_t>(length));
     
-    return success;
+    int result = symlinkat(target.c_str(), destDir, name);
+    if (result != 0 && errno == EEXIST && op.options.overwrite && unlinkat(destDir, name, 0) == 0) {
+        result = symlinkat(target.c_str(), destDir, name);
+    }
+    if (result != 0) {
+        return errno;
+    }
+    if (op.options.copyMetadata) {
+        const struct timespec times[2] = {st.st_atimespec, st.st_mtimespec};
+        utimensat(destDir, name, times, AT_SYMLINK_NOFOLLOW);
+    }
+    return 0;
+}
+
+// 完成目录的一项工作；最后一项完成时设置目标目录的权限和时间（此后不再向其中写入），再向上通知父目录
+void FinishCopyNode(TreeOperation& op, TreeNode* node) {
+    while (node && node->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        if (node->created && op.options.copyMetadata) {
+            const struct timespec times[2] = {node->st.st_atimespec, node->st.st_mtimespec};
+            if (fchmod(node->destFd, node->st.st_mode & 07777) != 0 || futimens(node->destFd, times) != 0) {
+                op.AddError(node->dest, errno);
+            }
+        }
+        CloseNodeDirectories(node);
+        TreeNode* parent = node->parent;
+        delete node;
+        node = parent;
+    }
+}
+
+void CopyTreeNode(TreeOperation& op, TreeNode* node) {
+    if (op.stopped.load(std::memory_order_relaxed)) {
+        FinishCopyNode(op, node);
+        return;
+    }
+    
+    int sourceFd = -1;
+    DIR* dir = OpenSourceDirectory(node, sourceFd);
+    if (!dir || fstat(sourceFd, &node->st) != 0) {
+        op.AddError(node->source, errno);
+        if (dir) {
+            closedir(dir);
+        }
+        FinishCopyNode(op, node);
+        return;
+    }
+    
+    // 先以所有者可写的权限创建，内容复制完成后再设置源目录的权限。
+    // 已存在的目标目录可以合并，但只有根目录可以是指向目录的符号链接
+    const int destParentFd = node->DestParentFd();
+    const char* destName = node->DestName();
+    const int noFollow = node->parent ? O_NOFOLLOW : 0;
+    if (mkdirat(destParentFd, destName, (node->st.st_mode & 0777) | S_IRWXU) != 0) {
+        struct stat existing;
+        if (errno != EEXIST ||
+            fstatat(destParentFd, destName, &existing, node->parent ? AT_SYMLINK_NOFOLLOW : 0) != 0 ||
+            !S_ISDIR(existing.st_mode)) {
+            op.AddError(node->dest, errno == EEXIST ? ENOTDIR : errno);
+            closedir(dir);
+            FinishCopyNode(op, node);
+            return;
+        }
+    }
+    int destFd = OpenAtRetrying(destParentFd, destName, O_RDONLY | O_DIRECTORY | O_CLOEXEC | noFollow);
+    node->destFd = destFd;
+    if (destFd == -1) {
+        op.AddError(node->dest, errno);
+        closedir(dir);
+        FinishCopyNode(op, node);
+        return;
+    }
+    node->created = true;
+    op.directories.fetch_add(1, std::memory_order_relaxed);
+    
+    while (struct dirent* entry = readdir(dir)) {
+        const char* name = entry->d_name;
+        if (IsDotOrDotDot(name)) {
+            continue;
+        }
+        struct stat st;
+        bool isDirectory = entry->d_type == DT_DIR;
+        if (!isDirectory) {
+            if (fstatat(sourceFd, name, &st, AT_SYMLINK_NOFOLLOW) != 0) {
+                if (errno != ENOENT) {
+                    op.AddError(node->source + '/' + name, errno);
+                }
+                continue;
+            }
+            isDirectory = S_ISDIR(st.st_mode);
+        }
+        if (isDirectory) {
+            auto* child = new TreeNode;
+            child->source = node->source + '/' + name;
+            child->dest = node->dest + '/' + name;
+            child->name = name;
+            child->parent = node;
+            node->pending.fetch_add(1, std::memory_order_relaxed);
+            op.queue.push([&op, child] { CopyTreeNode(op, child); });
+            continue;
+        }
+        
+        int error = 0;
+        if (S_ISREG(st.st_mode)) {
+            error = CopyFileAt(op, sourceFd, destFd, name, st);
+        } else if (S_ISLNK(st.st_mode)) {
+            error = CopySymlinkAt(op, sourceFd, destFd, name, st);
+        } else if (S_ISFIFO(st.st_mode)) {
+            error = mkfifo((node->dest + '/' + name).c_str(), st.st_mode & 07777) == 0 ? 0 : errno;
+        } else {
+            error = ENOTSUP;    // 设备和套接字
+        }
+        if (error == 0) {
+            op.files.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            op.AddError(node->source + '/' + name, error);
+        }
+    }
+    closedir(dir);
+    FinishCopyNode(op, node);
+}
+
+// 目标路径（可以尚不存在）位于源目录之内或就是源目录
+bool IsInsideDirectory(const std::string& directory, const std::string& path) {
+    char resolved[PATH_MAX];
+    if (!realpath(directory.c_str(), resolved)) {
+        return false;
+    }
+    std::string root = resolved;
+    
+    std::string target = path;
+    while (target.size() > 1 && target.back() == '/') {
+        target.pop_back();
+    }
+    std::string suffix;
+    while (!realpath(target.c_str(), resolved)) {
+        size_t slash = target.find_last_of('/');
+        if (slash == std::string::npos) {
+            if (!realpath(".", resolved)) {
+                return false;
+            }
+            suffix = "/" + target + suffix;
+            break;
+        }
+        suffix = target.substr(slash) + suffix;
+        target = slash == 0 ? "/" : target.substr(0, slash);
+    }
+    std::string full = std::string(resolved) + suffix;
+    return full == root || (full.size() > root.size() && full.compare(0, root.size(), root) == 0 &&
+                            (root == "/" || full[root.size()] == '/'));
+}
+
+// 由目录项类型得到文件类型，类型未知（部分文件系统不提供）时 fstatat
+FileSystem::FileType DirentFileType(int dirFd, const char* name, unsigned char dType) {
+    switch (dType) {
+        case DT_REG: return FileSystem::FileType::Regular;
+        case DT_DIR: return FileSystem::FileType::Directory;
+        case DT_LNK: return FileSystem::FileType::Symlink;
+        case DT_UNKNOWN: {
+            struct stat st;
+            if (fstatat(dirFd, name, &st, AT_SYMLINK_NOFOLLOW) != 0) {
+                return FileSystem::FileType::Other;
+            }
+            if (S_ISREG(st.st_mode)) return FileSystem::FileType::Regular;
+            if (S_ISDIR(st.st_mode)) return FileSystem::FileType::Directory;
+            if (S_ISLNK(st.st_mode)) return FileSystem::FileType::Symlink;
+            return FileSystem::FileType::Other;
+        }
+        default:
+            return FileSystem::FileType::Other;
+    }
+}
+
+// 项是否通过 WalkOptions 中的类型和文件名过滤
+bool WalkFilterMatches(const FileSystem::WalkOptions& options, FileSystem::FileType type, std::string_view name) {
+    switch (type) {
+        case FileSystem::FileType::Regular: if (!options.files) return false; break;
+        case FileSystem::FileType::Directory: if (!options.directories) return false; break;
+        case FileSystem::FileType::Symlink: if (!options.symlinks) return false; break;
+        default: if (!options.others) return false; break;
+    }
+    return options.pattern.empty() || StringUtils::matchGlob(options.pattern, name);
+}
+
+// 去掉末尾多余的 '/'（根目录 "/" 除外）
+std::string TrimTrailingSlashes(const std::string& path) {
+    size_t end = path.find_last_not_of('/');
+    return end == std::string::npos ? path.substr(0, 1) : path.substr(0, end + 1);
+}
+
+// 多线程遍历中保持打开的目录，由它的所有子目录任务共享，最后一个子目录打开后关闭
+struct WalkDirectory {
+    explicit WalkDirectory(int descriptor) : fd(descriptor) {}
+    ~WalkDirectory() { close(fd); }
+    WalkDirectory(const WalkDirectory&) = delete;
+    WalkDirectory& operator=(const WalkDirectory&) = delete;
+
+    const int fd;
+};
+
+// 多线程遍历：每个任务是一个目录，子目录作为新任务加入当前线程的队列。
+// 子目录相对于父目录描述符打开（与 Walker 和 CopyTree/DeleteTree 相同），路径只用于结果和错误信息
+struct WalkTask {
+    std::shared_ptr<const WalkDirectory> parent;    // 根任务为空，按 path 打开
+    std::string name;
+    std::string path;
+    int depth = 0;
+};
+
+// ===== 文件元数据 =====
+
+// 批量获取元数据时每个任务处理的路径数
+constexpr size_t kStatBatchChunk = 64;
+
+// 失败时返回 false，原因见 errno；lstat 总是返回全部字段，包括创建时间
+bool StatFileInfo(const char* path, uint32_t fields, FileSystem::FileInfo& info) {
+    info = FileSystem::FileInfo();
+    struct stat st;
+    if (lstat(path, &st) != 0) {
+        return false;
+    }
+    if (S_ISREG(st.st_mode)) {
+        info.type = FileSystem::FileType::Regular;
+    } else if (S_ISDIR(st.st_mode)) {
+        info.type = FileSystem::FileType::Directory;
+    } else if (S_ISLNK(st.st_mode)) {
+        info.type = FileSystem::FileType::Symlink;
+    }
+    info.size = static_cast<uint64_t>(st.st_size);
+    info.permissions = static_cast<int>(st.st_mode & 07777);    // Permissions 的取值与 POSIX 权限位相同
+    info.links = static_cast<uint32_t>(st.st_nlink);
+    info.uid = st.st_uid;
+    info.gid = st.st_gid;
+    info.device = static_cast<uint64_t>(st.st_dev);
+    info.inode = static_cast<uint64_t>(st.st_ino);
+    info.accessTime = TimeSpecToTimePoint(st.st_atimespec);
+    info.modificationTime = TimeSpecToTimePoint(st.st_mtimespec);
+    info.changeTime = TimeSpecToTimePoint(st.st_ctimespec);
+    info.creationTime = TimeSpecToTimePoint(st.st_birthtimespec);
+    info.fields = fields;
+    return true;
 }
 
 } // 匿名命名空间
@@ -186,61 +804,103 @@ bool FileSystem::SetModificationTime(const std::string& path,
     return utimensat(AT_FDCWD, path.c_str(), times, 0) == 0;
 }
 
-std::vector<uint8_t> FileSystem::ReadFile(const std::string& path) {
-    int fd = open(path.c_str(), O_RDONLY);
-    if (fd == -1) {
-        return {};
+bool FileSystem::GetFileInfo(const std::string& path, FileInfo& info, uint32_t fields) {
+    return StatFileInfo(path.c_str(), fields, info);
+}
+
+bool FileSystem::GetFileInfos(std::span<const std::string> paths, std::vector<FileInfo>& infos,
+                              uint32_t fields, unsigned threads, std::vector<std::error_code>* errors) {
+    infos.assign(paths.size(), FileInfo());
+    if (errors) {
+        errors->assign(paths.size(), std::error_code());
     }
     
-    struct stat st;
-    if (fstat(fd, &st) != 0) {
-        close(fd);
-        return {};
-    }
+    // 每个任务写入不同的元素，不需要加锁
+    std::atomic<bool> success{true};
+    auto statRange = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            if (!StatFileInfo(paths[i].c_str(), fields, infos[i])) {
+                success.store(false, std::memory_order_relaxed);
+                if (errors) {
+                    (*errors)[i] = std::error_code(errno, std::generic_category());
+                }
+            }
+        }
+    };
     
-    std::vector<uint8_t> buffer(st.st_size);
-    ssize_t bytesRead = read(fd, buffer.data(), st.st_size);
-    close(fd);
+    if (threads == 1 || paths.size() <= kStatBatchChunk) {
+        statRange(0, paths.size());
+        return success.load(std::memory_order_relaxed);
+    }
     
-    if (bytesRead != st.st_size) {
+    Internal::WorkQueue queue(threads);
+    for (size_t begin = 0; begin < paths.size(); begin += kStatBatchChunk) {
+        size_t end = std::min(begin + kStatBatchChunk, paths.size());
+        queue.push([&statRange, begin, end] { statRange(begin, end); });
+    }
+    queue.run();
+    return success.load(std::memory_order_relaxed);
+}
+
+std::vector<uint8_t> FileSystem::ReadFile(const std::string& path) {
+    std::vector<uint8_t> buffer;
+    if (!ReadFile(path, buffer)) {
         return {};
     }
-    
     return buffer;
 }
 
-bool FileSystem::WriteFile(const std::string& path, const std::vector<uint8_t>& data) {
-    int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+bool FileSystem::ReadFile(const std::string& path, std::vector<uint8_t>& buffer) {
+    return ReadWholeFile(path, buffer);
+}
+
+int64_t FileSystem::ReadFile(const std::string& path, std::span<uint8_t> buffer) {
+    int fd = OpenRetrying(path.c_str(), O_RDONLY | O_CLOEXEC);
     if (fd == -1) {
-        return false;
+        return -1;
     }
     
-    ssize_t bytesWritten = write(fd, data.data(), data.size());
-    close(fd);
-    
-    return bytesWritten == static_cast<ssize_t>(data.size());
+    ssize_t bytesRead = ReadFully(fd, buffer.data(), buffer.size());
+    CloseKeepingErrno(fd);
+    return bytesRead;
 }
 
-bool FileSystem::AppendFile(const std::string& path, const std::vector<uint8_t>& data) {
-    int fd = open(path.c_str(), O_WRONLY | O_APPEND);
+bool FileSystem::WriteFile(const std::string& path, std::span<const uint8_t> data) {
+    int fd = OpenRetrying(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
     if (fd == -1) {
         return false;
     }
     
-    ssize_t bytesWritten = write(fd, data.data(), data.size());
-    close(fd);
+    bool success = WriteFully(fd, data.data(), data.size());
+    CloseKeepingErrno(fd);
+    return success;
+}
+
+bool FileSystem::AppendFile(const std::string& path, std::span<const uint8_t> data) {
+    int fd = OpenRetrying(path.c_str(), O_WRONLY | O_APPEND | O_CLOEXEC);
+    if (fd == -1) {
+        return false;
+    }
     
-    return bytesWritten == static_cast<ssize_t>(data.size());
+    bool success = WriteFully(fd, data.data(), data.size());
+    CloseKeepingErrno(fd);
+    return success;
 }
 
 std::string FileSystem::ReadTextFile(const std::string& path) {
-    auto data = ReadFile(path);
-    return std::string(data.begin(), data.end());
+    std::string content;
+    if (!ReadTextFile(path, content)) {
+        return "";
+    }
+    return content;
+}
+
+bool FileSystem::ReadTextFile(const std::string& path, std::string& content) {
+    return ReadWholeFile(path, content);
 }
 
-bool FileSystem::WriteTextFile(const std::string& path, const std::string& content) {
-    std::vector<uint8_t> data(content.begin(), content.end());
-    return WriteFile(path, data);
+bool FileSystem::WriteTextFile(const std::string& path, std::string_view content) {
+    return WriteFile(path, std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(content.data()), content.size()));
 }
 
 bool FileSystem::RemoveFile(const std::string& path) {
@@ -248,35 +908,100 @@ bool FileSystem::RemoveFile(const std::string& path) {
 }
 
 bool FileSystem::DuplicateFile(const std::string& from, const std::string& to, bool overwrite) {
-    if (!overwrite && access(to.c_str(), F_OK) == 0) {
-        errno = EEXIST;
+    CopyOptions options;
+    options.overwrite = overwrite;
+    options.copyMetadata = true;    // 与之前使用 fcopyfile(COPYFILE_ALL) 的行为一致
+    return DuplicateFile(from, to, options);
+}
+
+bool FileSystem::DuplicateFile(const std::string& from, const std::string& to,
+                               const CopyOptions& options, CopyResult* result) {
+    CopyResult localResult;
+    CopyResult& copyResult = result ? *result : localResult;
+    copyResult = CopyResult();
+    
+    int source = OpenRetrying(from.c_str(), O_RDONLY | O_CLOEXEC);
+    if (source == -1) {
         return false;
     }
-    
-    // 使用 macOS 特有的 fcopyfile 函数进行高效复制
-    int source_fd = open(from.c_str(), O_RDONLY);
-    if (source_fd == -1) {
+    struct stat sourceStat;
+    if (fstat(source, &sourceStat) != 0) {
+        CloseKeepingErrno(source);
         return false;
     }
+    const uint64_t total = static_cast<uint64_t>(sourceStat.st_size);
     
-    int flags = O_WRONLY | O_CREAT | O_TRUNC;
-    if (!overwrite) {
-        flags |= O_EXCL;
+    // 覆盖自身会先把源文件截断
+    struct stat destStat;
+    bool destExists = stat(to.c_str(), &destStat) == 0;
+    if (destExists) {
+        if (!options.overwrite) {
+            close(source);
+            errno = EEXIST;
+            return false;
+        }
+        if (destStat.st_dev == sourceStat.st_dev && destStat.st_ino == sourceStat.st_ino) {
+            close(source);
+            errno = EINVAL;
+            return false;
+        }
     }
     
-    int dest_fd = open(to.c_str(), flags, 0644);
-    if (dest_fd == -1) {
-        close(source_fd);
+    // APFS 上克隆数据块；clonefile 要求目标不存在，并且总是带上源文件的权限和时间
+    if (options.allowReflink && !destExists && total > 0 &&
+        fclonefileat(source, AT_FDCWD, to.c_str(), 0) == 0) {
+        close(source);
+        copyResult.method = CopyMethod::Reflink;
+        copyResult.bytesCopied = total;
+        copyResult.totalBytes = total;
+        if (options.progress && !options.progress(total, total)) {
+            unlink(to.c_str());
+            errno = ECANCELED;
+            return false;
+        }
+        return true;
+    }
+    
+    int flags = O_WRONLY | O_CREAT | O_CLOEXEC | (options.overwrite ? O_TRUNC : O_EXCL);
+    int dest = OpenRetrying(to.c_str(), flags, 0644);
+    if (dest == -1) {
+        CloseKeepingErrno(source);
         return false;
     }
     
-    // 使用 fcopyfile 进行复制（macOS 特有）
-    fcopyfile_state_t state = fcopyfile_state_alloc();
-    bool success = fcopyfile(source_fd, dest_fd, state, COPYFILE_ALL) == 0;
-    fcopyfile_state_free(state);
+    bool success;
+    if (options.allowKernelCopy && !options.progress) {
+        // 没有进度回调时由 fcopyfile 在内核中复制数据（保留空洞）
+        copyfile_flags_t copyFlags = COPYFILE_DATA | (options.preserveSparse ? COPYFILE_DATA_SPARSE : 0);
+        success = fcopyfile(source, dest, nullptr, copyFlags) == 0;
+        if (success) {
+            copyResult.method = total > 0 ? CopyMethod::System : CopyMethod::None;
+            copyResult.bytesCopied = total;
+            copyResult.totalBytes = total;
+        }
+    } else {
+        FileCopier copier(source, dest, total, options);
+        success = copier.Run(copyResult);
+    }
+    
+    if (success && options.copyMetadata) {
+        // 先改属主再改权限位：chown 会清除 setuid/setgid
+        if (fchown(dest, sourceStat.st_uid, sourceStat.st_gid) != 0) {
+            // 没有权限改属主时保留当前用户为属主
+        }
+        const struct timespec times[2] = {sourceStat.st_atimespec, sourceStat.st_mtimespec};
+        success = fchmod(dest, sourceStat.st_mode & 07777) == 0 && futimens(dest, times) == 0;
+    }
     
-    close(source_fd);
-    close(dest_fd);
+    CloseKeepingErrno(source);
+    if (close(dest) != 0 && success) {
+        success = false;
+    }
+    if (!success) {
+        int savedErrno = errno;
+        unlink(to.c_str());
+        errno = savedErrno;
+    }
     return success;
 }
 
@@ -299,36 +1024,340 @@ bool FileSystem::DeleteDirectory(const std::string& path) {
 }
 
 bool FileSystem::DeleteDirectoriesRecursive(const std::string& path) {
-    return DeleteDirectoryRecursive(path);
+    // DeleteTree 也会删除单个文件，这里只接受目录
+    struct stat st;
+    if (lstat(path.c_str(), &st) != 0) {
+        return false;
+    }
+    if (!S_ISDIR(st.st_mode)) {
+        errno = ENOTDIR;
+        return false;
+    }
+    TreeOptions options;
+    options.threads = 1;
+    return DeleteTree(path, options);
 }
 
-bool FileSystem::ListDirectory(const std::string& path, std::vector<std::string>& entries) {
-    DIR* dir = opendir(path.c_str());
-    if (!dir) {
+bool FileSystem::CopyTree(const std::string& from, const std::string& to,
+                          const TreeOptions& options, TreeResult* result) {
+    if (result) {
+        *result = TreeResult();
+    }
+    struct stat st;
+    if (lstat(from.c_str(), &st) != 0) {
+        return false;
+    }
+    if (!S_ISDIR(st.st_mode)) {
+        errno = ENOTDIR;
+        return false;
+    }
+    if (IsInsideDirectory(from, to)) {
+        errno = EINVAL;
         return false;
     }
     
-    entries.clear();
-    struct dirent* entry;
+    TreeOperation op(options);
+    auto* root = new TreeNode;
+    root->source = from;
+    root->dest = to;
+    op.queue.push([&op, root] { CopyTreeNode(op, root); });
+    op.queue.run();
+    return op.Finish(result);
+}
+
+bool FileSystem::CopyTree(const std::string& from, const std::string& to) {
+    return CopyTree(from, to, TreeOptions());
+}
+
+bool FileSystem::DeleteTree(const std::string& path, const TreeOptions& options, TreeResult* result) {
+    if (result) {
+        *result = TreeResult();
+    }
+    struct stat st;
+    if (lstat(path.c_str(), &st) != 0) {
+        return false;
+    }
+    if (!S_ISDIR(st.st_mode)) {
+        if (unlink(path.c_str()) != 0) {
+            return false;
+        }
+        if (result) {
+            result->files = 1;
+        }
+        return true;
+    }
     
-    while ((entry = readdir(dir)) != nullptr) {
-        // 跳过 "." 和 ".."
-        if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
-            continue;
+    TreeOperation op(options);
+    auto* root = new TreeNode;
+    root->source = path;
+    op.queue.push([&op, root] { DeleteTreeNode(op, root); });
+    op.queue.run();
+    return op.Finish(result);
+}
+
+// ===== 目录遍历 =====
+
+struct FileSystem::Walker::State {
+    // 一层正在读取的目录
+    struct Frame {
+        DIR* dir = nullptr;
+        int fd = -1;
+        size_t pathLength = 0;      // 该目录在 path 中的长度
+        int depth = 0;              // root 为 0
+    };
+
+    WalkOptions options;
+    std::string path;
+    std::vector<Frame> frames;
+    std::vector<TreeError> errors;
+    const char* pendingName = nullptr;              // 上一次返回的目录，下一次 Next 时进入
+    int pendingDepth = 0;
+
+    ~State() {
+        for (const Frame& frame : frames) {
+            closedir(frame.dir);
         }
-        entries.push_back(entry->d_name);
+    }
+
+    void AddError(const std::string& errorPath, int error) {
+        errors.push_back({errorPath, std::error_code(error, std::generic_category())});
+    }
+
+    // 进入 path 所指的目录；name 相对于当前最内层目录
+    void Enter(const char* name, int depth) {
+        int fd = frames.empty()
+            ? OpenRetrying(path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC)
+            : openat(frames.back().fd, name, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+        DIR* dir = fd == -1 ? nullptr : fdopendir(fd);
+        if (!dir) {
+            AddError(path, errno);
+            if (fd != -1) {
+                close(fd);
+            }
+            return;
+        }
+        Frame frame;
+        frame.dir = dir;
+        frame.fd = fd;
+        frame.pathLength = path.size();
+        frame.depth = depth;
+        frames.push_back(frame);
+    }
+
+    bool Next(WalkEntry& entry) {
+        if (pendingName) {
+            const char* name = pendingName;
+            pendingName = nullptr;
+            Enter(name, pendingDepth);
+        }
+        while (!frames.empty()) {
+            Frame& frame = frames.back();
+            errno = 0;
+            struct dirent* dirent = readdir(frame.dir);
+            if (!dirent) {
+                if (errno != 0) {
+                    AddError(path.substr(0, frame.pathLength), errno);
+                }
+                closedir(frame.dir);
+                frames.pop_back();
+                continue;
+            }
+            const char* name = dirent->d_name;
+            if (IsDotOrDotDot(name)) {
+                continue;
+            }
+            
+            const size_t nameLength = dirent->d_namlen;
+            path.resize(frame.pathLength);
+            if (path.back() != '/') {
+                path += '/';
+            }
+            path.append(name, nameLength);
+            const int depth = frame.depth + 1;
+            const FileType type = DirentFileType(frame.fd, name, dirent->d_type);
+            const bool descend = type == FileType::Directory && (options.maxDepth < 0 || depth < options.maxDepth);
+            
+            if (WalkFilterMatches(options, type, std::string_view(name, nameLength))) {
+                entry.path = path;
+                entry.name = std::string_view(path).substr(path.size() - nameLength);
+                entry.type = type;
+                entry.depth = depth;
+                if (descend) {
+                    // 下一次 readdir 之前目录项不会被覆盖
+                    pendingName = name;
+                    pendingDepth = depth;
+                }
+                return true;
+            }
+            if (descend) {
+                Enter(name, depth);
+            }
+        }
+        return false;
+    }
+};
+
+FileSystem::Walker::Walker(const std::string& root) : Walker(root, WalkOptions()) {}
+
+FileSystem::Walker::Walker(const std::string& root, const WalkOptions& options)
+    : state(std::make_unique<State>()) {
+    state->options = options;
+    state->path = TrimTrailingSlashes(root);
+    if (options.maxDepth != 0) {
+        state->Enter(nullptr, 0);
+    }
+}
+
+FileSystem::Walker::~Walker() = default;
+FileSystem::Walker::Walker(Walker&& other) noexcept = default;
+FileSystem::Walker& FileSystem::Walker::operator=(Walker&& other) noexcept = default;
+
+bool FileSystem::Walker::Next(WalkEntry& entry) {
+    return state && state->Next(entry);
+}
+
+void FileSystem::Walker::SkipSubtree() {
+    if (state) {
+        state->pendingName = nullptr;
+    }
+}
+
+const std::vector<FileSystem::TreeError>& FileSystem::Walker::Errors() const {
+    static const std::vector<TreeError> kNoErrors;
+    return state ? state->errors : kNoErrors;
+}
+
+bool FileSystem::Walk(const std::string& root, const WalkOptions& options, const WalkVisitor& visitor,
+                      std::vector<TreeError>* errors) {
+    if (options.threads == 1) {
+        Walker walker(root, options);
+        WalkEntry entry;
+        while (walker.Next(entry)) {
+            WalkAction action = visitor(entry);
+            if (action == WalkAction::Stop) {
+                break;
+            }
+            if (action == WalkAction::SkipSubtree) {
+                walker.SkipSubtree();
+            }
+        }
+        if (errors) {
+            *errors = walker.Errors();
+        }
+        return walker.Errors().empty();
     }
     
-    closedir(dir);
-    return true;
+    Internal::WorkStealingPool<WalkTask> pool(options.threads);
+    std::vector<std::string> paths(pool.threadCount());
+    std::mutex errorMutex;
+    std::vector<TreeError> walkErrors;
+    auto addError = [&](const std::string& path, int error) {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        walkErrors.push_back({path, std::error_code(error, std::generic_category())});
+    };
+    
+    pool.push(0, WalkTask{nullptr, std::string(), TrimTrailingSlashes(root), 0});
+    if (options.maxDepth == 0) {
+        pool.stop();
+    }
+    pool.run([&](unsigned worker, WalkTask& task) {
+        const int fd = task.parent
+            ? OpenAtRetrying(task.parent->fd, task.name.c_str(), O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC)
+            : OpenRetrying(task.path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        task.parent.reset();
+        DIR* dir = fd == -1 ? nullptr : fdopendir(fd);
+        if (!dir) {
+            addError(task.path, errno);
+            if (fd != -1) {
+                close(fd);
+            }
+            return;
+        }
+        std::string& path = paths[worker];
+        const int depth = task.depth + 1;
+        // 子目录任务共享的描述符（DIR 扫描完即关闭，另外复制一个），全部打开之后才关闭
+        std::shared_ptr<const WalkDirectory> directory;
+        
+        while (!pool.stopped()) {
+            errno = 0;
+            struct dirent* dirent = readdir(dir);
+            if (!dirent) {
+                if (errno != 0) {
+                    addError(task.path, errno);
+                }
+                break;
+            }
+            const char* name = dirent->d_name;
+            if (IsDotOrDotDot(name)) {
+                continue;
+            }
+            
+            const size_t nameLength = dirent->d_namlen;
+            path.assign(task.path);
+            if (path.back() != '/') {
+                path += '/';
+            }
+            path.append(name, nameLength);
+            const FileType type = DirentFileType(fd, name, dirent->d_type);
+            bool descend = type == FileType::Directory && (options.maxDepth < 0 || depth < options.maxDepth);
+            
+            if (WalkFilterMatches(options, type, std::string_view(name, nameLength))) {
+                WalkEntry entry;
+                entry.path = path;
+                entry.name = std::string_view(path).substr(path.size() - nameLength);
+                entry.type = type;
+                entry.depth = depth;
+                WalkAction action = visitor(entry);
+                if (action == WalkAction::Stop) {
+                    pool.stop();
+                    break;
+                }
+                if (action == WalkAction::SkipSubtree) {
+                    descend = false;
+                }
+            }
+            if (descend && !directory) {
+                const int childFd = fcntl(fd, F_DUPFD_CLOEXEC, 0);
+                if (childFd == -1) {
+                    addError(path, errno);
+                    descend = false;
+                } else {
+                    directory = std::make_shared<const WalkDirectory>(childFd);
+                }
+            }
+            if (descend) {
+                pool.push(worker, WalkTask{directory, std::string(name, nameLength), path, depth});
+            }
+        }
+        closedir(dir);
+    });
+    
+    bool success = walkErrors.empty();
+    if (errors) {
+        *errors = std::move(walkErrors);
+    }
+    return success;
 }
 
-bool FileSystem::ListDirectoryRecursive(const std::string& path, std::vector<std::string>& entries) {
+void FileSystem::DirectoryEntry::LoadStatus() const {
+    if (statusLoaded) {
+        return;
+    }
+    statusLoaded = true;
+    struct stat st;
+    if (lstat(path.c_str(), &st) == 0) {
+        size = static_cast<uint64_t>(st.st_size);
+        modificationTime = TimeSpecToTimePoint(st.st_mtimespec);
+    }
+}
+
+bool FileSystem::ListDirectory(const std::string& path, std::vector<std::string>& entries) {
     DIR* dir = opendir(path.c_str());
     if (!dir) {
         return false;
     }
     
+    entries.clear();
     struct dirent* entry;
     
     while ((entry = readdir(dir)) != nullptr) {
@@ -336,24 +1365,24 @@ bool FileSystem::ListDirectoryRecursive(const std::string& path, std::vector<std
         if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
             continue;
         }
-        
-        std::string fullPath = path + "/" + entry->d_name;
-        entries.push_back(fullPath);
-        
-        struct stat st;
-        if (lstat(fullPath.c_str(), &st) == 0 && S_ISDIR(st.st_mode)) {
-            // 递归处理子目录
-            std::vector<std::string> subEntries;
-            if (ListDirectoryRecursive(fullPath, subEntries)) {
-                entries.insert(entries.end(), subEntries.begin(), subEntries.end());
-            }
-        }
+        entries.push_back(entry->d_name);
     }
     
     closedir(dir);
     return true;
 }
 
+bool FileSystem::ListDirectoryRecursive(const std::string& path, std::vector<std::string>& entries) {
+    Walker walker(path);
+    WalkEntry entry;
+    while (walker.Next(entry)) {
+        entries.emplace_back(entry.path);
+    }
+    // 与之前一致：只有根目录无法打开时失败，跳过无法读取的子目录
+    const std::vector<TreeError>& errors = walker.Errors();
+    return errors.empty() || errors.front().path != TrimTrailingSlashes(path);
+}
+
 // ===== 符号链接操作 =====
 
 bool FileSystem::CreateSymlink(const std::string& target, const std::string& linkPath) {
@@ -610,4 +1639,141 @@ bool FileSystem::RemovePermissions(const std::string& path, int permissions) {
     return SetPermissions(path, current & ~permissions);
 }
 
+// ===== 内存映射文件 =====
+
+FileSystem::MappedFile::MappedFile(const std::string& path) {
+    Open(path, MapOptions());
+}
+
+FileSystem::MappedFile::MappedFile(const std::string& path, const MapOptions& options) {
+    Open(path, options);
+}
+
+FileSystem::MappedFile::~MappedFile() {
+    Close();
+}
+
+FileSystem::MappedFile::MappedFile(MappedFile&& other) noexcept {
+    *this = std::move(other);
+}
+
+FileSystem::MappedFile& FileSystem::MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        Close();
+        data = std::exchange(other.data, nullptr);
+        mappedSize = std::exchange(other.mappedSize, 0);
+        mappedLength = std::exchange(other.mappedLength, 0);
+        mapMode = other.mapMode;
+        isOpen = std::exchange(other.isOpen, false);
+        hugePages = std::exchange(other.hugePages, false);
+    }
+    return *this;
+}
+
+bool FileSystem::MappedFile::Open(const std::string& path) {
+    return Open(path, MapOptions());
+}
+
+bool FileSystem::MappedFile::Open(const std::string& path, const MapOptions& options) {
+    Close();
+
+    const bool writable = options.mode == MapMode::ReadWrite;
+    int fd = writable ? open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644)
+                      : open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        const int savedErrno = errno;
+        close(fd);
+        errno = savedErrno;
+        return false;
+    }
+    uint64_t fileSize = static_cast<uint64_t>(st.st_size);
+    if (writable && options.size > fileSize) {
+        if (ftruncate(fd, static_cast<off_t>(options.size)) != 0) {
+            const int savedErrno = errno;
+            close(fd);
+            errno = savedErrno;
+            return false;
+        }
+        fileSize = options.size;
+    }
+    if (fileSize > SIZE_MAX) {
+        close(fd);
+        errno = EFBIG;
+        return false;
+    }
+
+    mapMode = options.mode;
+    mappedSize = static_cast<size_t>(fileSize);
+    if (mappedSize == 0) {
+        // 长度为 0 的映射不合法，空文件直接视为已打开
+        close(fd);
+        isOpen = true;
+        return true;
+    }
+
+    // macOS 不支持文件的大页映射，hugePages 选项被忽略
+    mappedLength = mappedSize;
+
+    const int prot = options.mode == MapMode::ReadOnly ? PROT_READ : PROT_READ | PROT_WRITE;
+    const int flags = options.mode == MapMode::CopyOnWrite ? MAP_PRIVATE : MAP_SHARED;
+    void* view = mmap(nullptr, mappedLength, prot, flags, fd, 0);
+    const int savedErrno = errno;
+    // 映射建立后不再需要文件描述符
+    close(fd);
+    if (view == MAP_FAILED) {
+        mappedSize = 0;
+        mappedLength = 0;
+        hugePages = false;
+        errno = savedErrno;
+        return false;
+    }
+    data = static_cast<uint8_t*>(view);
+    isOpen = true;
+
+    if (options.advice != MapAdvice::Normal) {
+        Advise(options.advice);
+    }
+    return true;
+}
+
+void FileSystem::MappedFile::Close() {
+    if (data) {
+        munmap(data, mappedLength);
+    }
+    data = nullptr;
+    mappedSize = 0;
+    mappedLength = 0;
+    isOpen = false;
+    hugePages = false;
+}
+
+bool FileSystem::MappedFile::Advise(MapAdvice advice, size_t offset, size_t length) {
+    if (!data || offset >= mappedSize) {
+        return isOpen;
+    }
+    length = std::min(length, mappedSize - offset);
+
+    // 起始地址需要按页对齐
+    const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    const size_t alignedOffset = offset / pageSize * pageSize;
+    const int rc = posix_madvise(data + alignedOffset, length + (offset - alignedOffset), ToPosixAdvice(advice));
+    if (rc != 0) {
+        errno = rc;
+        return false;
+    }
+    return true;
+}
+
+bool FileSystem::MappedFile::Flush(bool wait) {
+    if (!data || mapMode != MapMode::ReadWrite) {
+        return isOpen;
+    }
+    return msync(data, mappedLength, wait ? MS_SYNC : MS_ASYNC) == 0;
+}
+
 } // namespace CorePlatform
\ No newline at end of file
@@ -0,0 +1,429 @@
+#include "CorePlatform/FileSystem.h"
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#if defined(CP_PLATFORM_WINDOWS)
+#include <windows.h>
+#elif defined(CP_PLATFORM_LINUX)
+#include <poll.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#endif
+
+namespace CorePlatform {
+
+namespace {
+
+int LastError() {
+#if defined(CP_PLATFORM_WINDOWS)
+    return static_cast<int>(GetLastError());
+#else
+    return errno;
+#endif
+}
+
+void RestoreError(int error) {
+#if defined(CP_PLATFORM_WINDOWS)
+    SetLastError(static_cast<DWORD>(error));
+#else
+    errno = error;
+#endif
+}
+
+// 路径所在目录的前缀（含结尾的 '/'），子项的键为 前缀 + 名称；没有 '/' 时为空，表示当前目录
+std::string ParentPrefix(const std::string& path) {
+    size_t end = path.find_last_not_of('/');
+    if (end == std::string::npos) {
+        return "/";
+    }
+    size_t slash = path.find_last_of('/', end);
+    return slash == std::string::npos ? std::string() : path.substr(0, slash + 1);
+}
+
+// 目录本身作为前缀
+std::string DirectoryPrefix(const std::string& path) {
+    size_t end = path.find_last_not_of('/');
+    return end == std::string::npos ? std::string("/") : path.substr(0, end + 1) + "/";
+}
+
+#if defined(CP_PLATFORM_LINUX)
+// 目录中的项或目录本身的元数据变化
+constexpr uint32_t kWatchMask = IN_ATTRIB | IN_MODIFY | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO |
+                                IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR | IN_EXCL_UNLINK;
+
+// 增删目录项会改变目录的修改时间
+constexpr uint32_t kEntryChangeMask = IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO;
+#endif
+
+} // 匿名命名空间
+
+struct FileSystem::MetadataCache::State {
+    struct Entry {
+        FileInfo info;
+        int error = 0;      // 查询失败时的错误码，0 表示成功
+        std::chrono::steady_clock::time_point expires;
+    };
+
+    // 查询开始时相关计数的快照：路径所在目录的变化会使 parent 改变，目录本身的内容变化会使 self 改变
+    struct Generations {
+        uint64_t global = 0;
+        uint64_t parent = 0;
+        uint64_t self = 0;
+
+        bool operator==(const Generations&) const = default;
+    };
+
+    explicit State(const MetadataCacheOptions& options) : options(options) {
+#if defined(CP_PLATFORM_LINUX)
+        if (options.watchChanges && options.ttl.count() > 0) {
+            StartWatching();
+        }
+#endif
+    }
+
+    ~State() {
+#if defined(CP_PLATFORM_LINUX)
+        if (thread.joinable()) {
+            uint64_t value = 1;
+            ssize_t written = write(wakeFd, &value, sizeof(value));
+            (void)written;
+            thread.join();
+        }
+        if (inotifyFd >= 0) {
+            close(inotifyFd);
+        }
+        if (wakeFd >= 0) {
+            close(wakeFd);
+        }
+#endif
+    }
+
+    // 查询元数据，未命中时获取并放入缓存
+    void Lookup(const std::string& path, FileInfo& info, int& error) {
+        const auto now = std::chrono::steady_clock::now();
+        // 命中时只持有共享锁查找哈希表，多个线程的查询互不阻塞
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex);
+            auto it = entries.find(path);
+            if (it != entries.end() && now < it->second.expires) {
+                hits.fetch_add(1, std::memory_order_relaxed);
+                info = it->second.info;
+                error = it->second.error;
+                return;
+            }
+        }
+
+        const std::string parentPrefix = ParentPrefix(path);
+        const std::string directoryPrefix = DirectoryPrefix(path);
+        Generations startGenerations;
+        {
+            std::unique_lock<std::shared_mutex> lock(mutex);
+            // 释放共享锁期间其他线程可能已经放入了新的结果
+            auto it = entries.find(path);
+            if (it != entries.end()) {
+                if (now < it->second.expires) {
+                    hits.fetch_add(1, std::memory_order_relaxed);
+                    info = it->second.info;
+                    error = it->second.error;
+                    return;
+                }
+                entries.erase(it);
+                ++stats.expirations;
+            }
+            ++stats.misses;
+            startGenerations = GenerationsLocked(parentPrefix, directoryPrefix);
+        }
+
+#if defined(CP_PLATFORM_LINUX)
+        // 先监视再获取：之后的变化一定会产生事件
+        if (inotifyFd >= 0) {
+            WatchDirectory(parentPrefix);
+        }
+#endif
+        error = FileSystem::GetFileInfo(path, info, InfoBasic) ? 0 : LastError();
+#if defined(CP_PLATFORM_LINUX)
+        // 目录本身也要监视，其中增删文件时修改时间才会失效；新加的监视之前的变化需要重新获取
+        if (error == 0 && info.type == FileType::Directory && inotifyFd >= 0 &&
+            WatchDirectory(directoryPrefix)) {
+            error = FileSystem::GetFileInfo(path, info, InfoBasic) ? 0 : LastError();
+        }
+#endif
+        if (options.ttl.count() <= 0) {
+            return;
+        }
+
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        // 获取期间该路径所在目录或目录本身有变化，结果可能已经过时；其他目录的变化不影响
+        if (GenerationsLocked(parentPrefix, directoryPrefix) != startGenerations) {
+            return;
+        }
+        if (entries.size() >= options.maxEntries && entries.find(path) == entries.end()) {
+            for (auto it = entries.begin(); it != entries.end();) {
+                if (it->second.expires <= now) {
+                    it = entries.erase(it);
+                    ++stats.expirations;
+                } else {
+                    ++it;
+                }
+            }
+            if (entries.size() >= options.maxEntries) {
+                stats.invalidations += entries.size();
+                entries.clear();
+            }
+        }
+        entries.insert_or_assign(path, Entry{info, error, now + options.ttl});
+    }
+
+    // 调用时持有 mutex
+    void EraseLocked(const std::string& key) {
+        if (entries.erase(key) > 0) {
+            ++stats.invalidations;
+        }
+    }
+
+    // 目录前缀对应的变化计数，按哈希分组，冲突只会多丢弃一些查询结果
+    uint64_t& PrefixGenerationLocked(const std::string& prefix) {
+        return prefixGenerations[std::hash<std::string>()(prefix) % prefixGenerations.size()];
+    }
+
+    Generations GenerationsLocked(const std::string& parentPrefix, const std::string& directoryPrefix) {
+        return {generation, PrefixGenerationLocked(parentPrefix), PrefixGenerationLocked(directoryPrefix)};
+    }
+
+    // 使路径相关的进行中的查询结果不放入缓存
+    void InvalidateLocked(const std::string& path) {
+        EraseLocked(path);
+        ++PrefixGenerationLocked(ParentPrefix(path));
+        ++PrefixGenerationLocked(DirectoryPrefix(path));
+    }
+
+    std::shared_mutex mutex;
+    const MetadataCacheOptions options;
+    std::unordered_map<std::string, Entry> entries;
+    uint64_t generation = 0;    // 清空或删除整个子树时加一，所有进行中的查询结果都不放入缓存
+    std::array<uint64_t, 256> prefixGenerations{};  // 目录有变化或其中的路径被手动失效时加一
+    MetadataCacheStats stats;   // 除 hits 外的计数，持有独占锁时修改
+    std::atomic<uint64_t> hits{0};  // 命中只持有共享锁，单独计数
+
+#if defined(CP_PLATFORM_LINUX)
+    void StartWatching() {
+        inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (inotifyFd >= 0 && wakeFd >= 0) {
+            try {
+                thread = std::thread([this] { EventLoop(); });
+                return;
+            } catch (const std::system_error&) {
+                // 无法创建线程时只按 ttl 失效
+            }
+        }
+        if (inotifyFd >= 0) {
+            close(inotifyFd);
+            inotifyFd = -1;
+        }
+        if (wakeFd >= 0) {
+            close(wakeFd);
+            wakeFd = -1;
+        }
+    }
+
+    // 监视 prefix 表示的目录，新加监视时返回 true；目录不存在或达到监视数上限时条目只按 ttl 失效
+    bool WatchDirectory(const std::string& prefix) {
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex);
+            if (prefixWatches.count(prefix) > 0) {
+                return false;
+            }
+        }
+        int wd = inotify_add_watch(inotifyFd, prefix.empty() ? "." : prefix.c_str(), kWatchMask);
+        if (wd < 0) {
+            return false;
+        }
+        // 同一目录的不同写法得到同一个 wd
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        if (!prefixWatches.emplace(prefix, wd).second) {
+            return false;
+        }
+        watchPrefixes[wd].push_back(prefix);
+        return true;
+    }
+
+    void EventLoop() {
+        alignas(struct inotify_event) char buffer[64 * 1024];
+        struct pollfd fds[2] = {{inotifyFd, POLLIN, 0}, {wakeFd, POLLIN, 0}};
+        while (true) {
+            if (poll(fds, 2, -1) < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return;
+            }
+            if (fds[1].revents != 0) {
+                return;
+            }
+            ssize_t n = read(inotifyFd, buffer, sizeof(buffer));
+            if (n <= 0) {
+                if (n < 0 && (errno == EINTR || errno == EAGAIN)) {
+                    continue;
+                }
+                return;
+            }
+
+            std::unique_lock<std::shared_mutex> lock(mutex);
+            for (ssize_t offset = 0; offset < n;) {
+                const auto* event = reinterpret_cast<const struct inotify_event*>(buffer + offset);
+                HandleEvent(*event);
+                offset += static_cast<ssize_t>(sizeof(struct inotify_event) + event->len);
+            }
+        }
+    }
+
+    // 调用时持有 mutex
+    void HandleEvent(const struct inotify_event& event) {
+        if (event.mask & IN_Q_OVERFLOW) {
+            stats.invalidations += entries.size();
+            entries.clear();
+            ++generation;
+            return;
+        }
+        auto it = watchPrefixes.find(event.wd);
+        if (it == watchPrefixes.end()) {
+            return;
+        }
+        for (const std::string& prefix : it->second) {
+            ++PrefixGenerationLocked(prefix);
+            if (event.len > 0) {
+                std::string key = prefix + event.name;
+                EraseLocked(key);
+                // 目录被移走、删除或替换，其中所有路径的结果都可能变化
+                if ((event.mask & IN_ISDIR) && (event.mask & kEntryChangeMask)) {
+                    EraseSubtreeLocked(key + "/");
+                }
+                if (event.mask & kEntryChangeMask) {
+                    EraseDirectoryLocked(prefix);
+                }
+            } else {
+                EraseDirectoryLocked(prefix);
+                if (event.mask & (IN_DELETE_SELF | IN_MOVE_SELF)) {
+                    EraseSubtreeLocked(prefix);
+                }
+            }
+        }
+        // 目录被移走后监视跟随目录，原路径需要重新监视
+        if (event.mask & IN_MOVE_SELF) {
+            inotify_rm_watch(inotifyFd, event.wd);
+        }
+        if (event.mask & (IN_IGNORED | IN_MOVE_SELF)) {
+            for (const std::string& prefix : it->second) {
+                prefixWatches.erase(prefix);
+            }
+            watchPrefixes.erase(it);
+        }
+    }
+
+    // 目录本身的条目（写作 "dir" 或 "dir/"）
+    void EraseDirectoryLocked(const std::string& prefix) {
+        if (prefix.empty()) {
+            EraseLocked(".");
+            return;
+        }
+        EraseLocked(prefix);
+        if (prefix.size() > 1) {
+            EraseLocked(prefix.substr(0, prefix.size() - 1));
+        }
+    }
+
+    void EraseSubtreeLocked(const std::string& prefix) {
+        if (prefix.empty()) {
+            return;
+        }
+        ++generation;
+        for (auto it = entries.begin(); it != entries.end();) {
+            if (it->first.compare(0, prefix.size(), prefix) == 0) {
+                it = entries.erase(it);
+                ++stats.invalidations;
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    int inotifyFd = -1;
+    int wakeFd = -1;            // 通知后台线程退出
+    std::unordered_map<std::string, int> prefixWatches;
+    std::unordered_map<int, std::vector<std::string>> watchPrefixes;
+    std::thread thread;
+#endif
+};
+
+FileSystem::MetadataCache::MetadataCache() : MetadataCache(MetadataCacheOptions()) {}
+
+FileSystem::MetadataCache::MetadataCache(const MetadataCacheOptions& options)
+    : state(std::make_unique<State>(options)) {}
+
+FileSystem::MetadataCache::~MetadataCache() = default;
+
+bool FileSystem::MetadataCache::Exists(const std::string& path) {
+    FileInfo info;
+    return GetFileInfo(path, info);
+}
+
+FileSystem::FileType FileSystem::MetadataCache::GetFileType(const std::string& path) {
+    FileInfo info;
+    return GetFileInfo(path, info) ? info.type : FileType::Other;
+}
+
+uint64_t FileSystem::MetadataCache::GetFileSize(const std::string& path) {
+    FileInfo info;
+    return GetFileInfo(path, info) ? info.size : 0;
+}
+
+std::chrono::system_clock::time_point FileSystem::MetadataCache::GetModificationTime(const std::string& path) {
+    FileInfo info;
+    return GetFileInfo(path, info) ? info.modificationTime : std::chrono::system_clock::time_point();
+}
+
+bool FileSystem::MetadataCache::GetFileInfo(const std::string& path, FileInfo& info) {
+    int error = 0;
+    state->Lookup(path, info, error);
+    if (error != 0) {
+        RestoreError(error);
+        return false;
+    }
+    return true;
+}
+
+void FileSystem::MetadataCache::Invalidate(const std::string& path) {
+    std::unique_lock<std::shared_mutex> lock(state->mutex);
+    state->InvalidateLocked(path);
+}
+
+void FileSystem::MetadataCache::Clear() {
+    std::unique_lock<std::shared_mutex> lock(state->mutex);
+    state->stats.invalidations += state->entries.size();
+    state->entries.clear();
+    ++state->generation;
+}
+
+FileSystem::MetadataCacheStats FileSystem::MetadataCache::Stats() const {
+    std::shared_lock<std::shared_mutex> lock(state->mutex);
+    MetadataCacheStats stats = state->stats;
+    stats.hits = state->hits.load(std::memory_order_relaxed);
+    stats.entries = state->entries.size();
+#if defined(CP_PLATFORM_LINUX)
+    stats.watches = state->watchPrefixes.size();
+#endif
+    return stats;
+}
+
+} // namespace CorePlatform
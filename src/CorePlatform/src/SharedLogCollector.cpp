@@ -0,0 +1,154 @@
+#include "CorePlatform/Internal/SharedLogCollector.h"
+#include <algorithm>
+
+namespace CorePlatform {
+namespace Internal {
+
+namespace {
+
+// 没有待写记录时等待新日志的最长时间
+constexpr std::chrono::milliseconds kIdleWait{200};
+// 待写记录过多时不再等待合并窗口
+constexpr size_t kMaxPending = 65536;
+// 每个日志环单次读取的最大条数
+constexpr size_t kDrainBatch = 4096;
+
+// 正在写出记录的收集器；deliver 内部触发的 flush() 不能再次加锁
+thread_local const SharedLogCollector* t_delivering = nullptr;
+
+} // 匿名命名空间
+
+SharedLogCollector::SharedLogCollector(Deliver deliver, std::chrono::milliseconds mergeWindow)
+    : deliver_(std::move(deliver)), mergeWindow_(mergeWindow) {
+    thread_ = std::thread([this] { run(); });
+}
+
+SharedLogCollector::~SharedLogCollector() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_.store(false, std::memory_order_release);
+        for (const auto& ring : rings_) {
+            ring->wakeReader();
+        }
+    }
+    ringsCv_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    collectUnlocked(true);
+}
+
+void SharedLogCollector::addRing(std::shared_ptr<SharedLogRing> ring) {
+    if (!ring) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (std::find(rings_.begin(), rings_.end(), ring) != rings_.end()) {
+            return;
+        }
+        // 收集线程可能正在等待已有的日志环，唤醒后把新的日志环加入等待
+        for (const auto& existing : rings_) {
+            existing->wakeReader();
+        }
+        rings_.push_back(std::move(ring));
+    }
+    ringsCv_.notify_all();
+}
+
+bool SharedLogCollector::removeRing(const std::shared_ptr<SharedLogRing>& ring) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = std::find(rings_.begin(), rings_.end(), ring);
+    if (it == rings_.end()) {
+        return false;
+    }
+    collectUnlocked(true);
+    rings_.erase(it);
+    ring->wakeReader();
+    return true;
+}
+
+bool SharedLogCollector::isDelivering() {
+    return t_delivering != nullptr;
+}
+
+size_t SharedLogCollector::ringCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return rings_.size();
+}
+
+void SharedLogCollector::flush() {
+    if (t_delivering == this) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    collectUnlocked(true);
+}
+
+void SharedLogCollector::run() {
+    std::vector<std::shared_ptr<SharedLogRing>> rings;
+    while (running_.load(std::memory_order_acquire)) {
+        bool hasPending = false;
+        size_t drained = 0;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            ringsCv_.wait(lock, [this] {
+                return !rings_.empty() || !running_.load(std::memory_order_acquire);
+            });
+            drained = collectUnlocked(false);
+            hasPending = !pending_.empty();
+            rings = rings_;
+        }
+        if (rings.empty()) {
+            continue;
+        }
+
+        // 有待写记录时最多等到最早的记录到期；在所有日志环的 futex 上等待
+        const std::chrono::milliseconds wait = hasPending ? std::min(mergeWindow_, kIdleWait) : kIdleWait;
+        // 未发布的槽位（写入进程中途退出）会让等待立即返回，此时稍作等待避免空转
+        if (SharedLogRing::waitForAny(rings, wait) && drained == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        rings.clear();
+    }
+}
+
+size_t SharedLogCollector::collectUnlocked(bool all) {
+    for (const auto& ring : rings_) {
+        while (ring->drain(incoming_, kDrainBatch) == kDrainBatch) {}
+    }
+    const size_t drained = incoming_.size();
+
+    if (!incoming_.empty()) {
+        // 同一个日志环内基本有序，排序后与已有的待写记录归并
+        auto byTime = [](const SharedLogRecord& a, const SharedLogRecord& b) { return a.time < b.time; };
+        std::stable_sort(incoming_.begin(), incoming_.end(), byTime);
+        const size_t middle = pending_.size();
+        pending_.insert(pending_.end(), std::make_move_iterator(incoming_.begin()),
+                        std::make_move_iterator(incoming_.end()));
+        incoming_.clear();
+        std::inplace_merge(pending_.begin(), pending_.begin() + static_cast<std::ptrdiff_t>(middle),
+                           pending_.end(), byTime);
+    }
+    if (pending_.empty()) {
+        return drained;
+    }
+
+    size_t ready = pending_.size();
+    if (!all && pending_.size() <= kMaxPending) {
+        const auto cutoff = std::chrono::system_clock::now() - mergeWindow_;
+        ready = static_cast<size_t>(std::upper_bound(pending_.begin(), pending_.end(), cutoff,
+            [](const std::chrono::system_clock::time_point& time, const SharedLogRecord& record) {
+                return time < record.time;
+            }) - pending_.begin());
+    }
+    t_delivering = this;
+    for (size_t i = 0; i < ready; ++i) {
+        deliver_(pending_[i]);
+    }
+    t_delivering = nullptr;
+    pending_.erase(pending_.begin(), pending_.begin() + static_cast<std::ptrdiff_t>(ready));
+    return drained;
+}
+
+} // namespace Internal
+} // namespace CorePlatform
@@ -0,0 +1,572 @@
+#include "CorePlatform/SharedLogRing.h"
+#include "CorePlatform/Internal/BoundedQueue.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#if defined(CP_PLATFORM_WINDOWS)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#if defined(CP_PLATFORM_LINUX)
+#include <climits>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+#endif
+
+namespace CorePlatform {
+
+// 共享内存开头的控制块；各进程独立映射，只能包含地址无关的无锁原子变量
+struct SharedLogRing::Header {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t capacity;
+    uint64_t slotSize;
+    alignas(64) std::atomic<uint64_t> enqueuePos;
+    alignas(64) std::atomic<uint64_t> dequeuePos;
+    alignas(64) std::atomic<uint32_t> futexWord;    // 读取者等待的 futex，写入者发布后递增
+    std::atomic<uint32_t> readerWaiting;
+    std::atomic<uint64_t> dropped;
+};
+
+// 槽位序号：等于位置时可写入，等于位置 + 1 时可读取，读取后加上 capacity 进入下一圈。
+// writers 高位为最近进入的写入者的位置，低位为正在写入该槽位的进程数：读取端跳过停滞的槽位后，
+// 停滞的写入者可能与下一圈的写入者同时写入，只有开始时没有其他写入者的一方写入内容，另一方发布作废的记录。
+// 上一圈遗留的计数只生效一圈：写入者进入时换成自己的位置，写入中途退出的进程不会让该槽位永久作废
+struct SharedLogRing::Slot {
+    std::atomic<uint64_t> sequence;
+    std::atomic<uint64_t> writers;
+    int64_t timeNs;
+    int64_t processId;
+    uint32_t threadId;
+    uint16_t length;
+    uint8_t level;
+    char text[kMaxMessageSize];
+};
+
+namespace {
+
+constexpr uint32_t kRingMagic = 0x43504c52;  // "CPLR"
+constexpr uint32_t kRingVersion = 3;
+
+// 发布时序号带有该标志表示记录作废（写入时与其他写入者冲突），读取端直接跳过
+constexpr uint64_t kDiscardedRecord = uint64_t{1} << 63;
+
+// 槽位 writers 的低 16 位为写入者个数，其余位为所属位置（截断）
+constexpr unsigned kWriterCountBits = 16;
+constexpr uint64_t kWriterCountMask = (uint64_t{1} << kWriterCountBits) - 1;
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free,
+              "shared memory atomics must be lock free");
+static_assert(SharedLogRing::kMaxMessageSize <= UINT16_MAX, "length is stored in 16 bits");
+
+// 控制块占用的字节数，槽位紧随其后
+constexpr size_t kHeaderSize = 256;
+
+int64_t currentProcessId() {
+#if defined(CP_PLATFORM_WINDOWS)
+    return static_cast<int64_t>(GetCurrentProcessId());
+#else
+    return static_cast<int64_t>(getpid());
+#endif
+}
+
+uint32_t currentThreadId() {
+#if defined(CP_PLATFORM_WINDOWS)
+    return static_cast<uint32_t>(GetCurrentThreadId());
+#elif defined(CP_PLATFORM_LINUX)
+    thread_local const uint32_t tid = static_cast<uint32_t>(syscall(SYS_gettid));
+    return tid;
+#else
+    return static_cast<uint32_t>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+#endif
+}
+
+void setError(std::string* error, const std::string& message) {
+    if (error) {
+        *error = message;
+    }
+}
+
+std::string systemError(const std::string& what) {
+#if defined(CP_PLATFORM_WINDOWS)
+    return what + " failed (error " + std::to_string(GetLastError()) + ")";
+#else
+    return what + " failed: " + std::strerror(errno);
+#endif
+}
+
+#if defined(CP_PLATFORM_LINUX)
+void futexWait(std::atomic<uint32_t>* word, uint32_t expected, std::chrono::milliseconds timeout) {
+    struct timespec ts;
+    ts.tv_sec = static_cast<time_t>(timeout.count() / 1000);
+    ts.tv_nsec = static_cast<long>(timeout.count() % 1000) * 1000000;
+    // 共享映射上的 futex 不能使用 FUTEX_PRIVATE_FLAG
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAIT, expected, &ts, nullptr, 0);
+}
+
+void futexWakeAll(std::atomic<uint32_t>* word) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+#endif
+
+// 无法在 futex 上同时等待多个日志环时的轮询间隔
+constexpr std::chrono::milliseconds kMultiRingPoll{5};
+
+} // 匿名命名空间
+
+// ================ SharedLogRing ================
+
+std::unique_ptr<SharedLogRing> SharedLogRing::create(size_t capacity, const std::string& name, std::string* error) {
+    std::unique_ptr<SharedLogRing> ring(new SharedLogRing());
+    ring->capacity_ = Internal::roundUpCapacity(std::max<size_t>(capacity, 2));
+    ring->mappedSize_ = kHeaderSize + ring->capacity_ * sizeof(Slot);
+
+#if defined(CP_PLATFORM_WINDOWS)
+    if (name.empty()) {
+        setError(error, "anonymous shared log rings are not supported on this platform");
+        return nullptr;
+    }
+    const std::string mappingName = "Local\\" + name;
+    HANDLE mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+                                        static_cast<DWORD>(static_cast<uint64_t>(ring->mappedSize_) >> 32),
+                                        static_cast<DWORD>(ring->mappedSize_), mappingName.c_str());
+    if (!mapping || GetLastError() == ERROR_ALREADY_EXISTS) {
+        if (mapping) CloseHandle(mapping);
+        setError(error, systemError("CreateFileMapping " + name));
+        return nullptr;
+    }
+    ring->mapping_ = mapping;
+    void* view = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, ring->mappedSize_);
+    if (!view) {
+        setError(error, systemError("MapViewOfFile"));
+        return nullptr;
+    }
+    ring->handle_ = "win:" + name;
+#else
+    int fd = -1;
+    if (name.empty()) {
+#if defined(CP_PLATFORM_LINUX)
+        fd = static_cast<int>(syscall(SYS_memfd_create, "cp-shared-log-ring", MFD_CLOEXEC));
+        if (fd < 0) {
+            setError(error, systemError("memfd_create"));
+            return nullptr;
+        }
+        ring->handle_ = "fd:" + std::to_string(currentProcessId()) + ":" + std::to_string(fd);
+#else
+        setError(error, "anonymous shared log rings are not supported on this platform");
+        return nullptr;
+#endif
+    } else {
+        ring->shmName_ = "/" + name;
+        fd = shm_open(ring->shmName_.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+        if (fd < 0) {
+            ring->shmName_.clear();
+            setError(error, systemError("shm_open " + name));
+            return nullptr;
+        }
+        ring->handle_ = "shm:" + name;
+    }
+    ring->fd_ = fd;
+    if (ftruncate(fd, static_cast<off_t>(ring->mappedSize_)) != 0) {
+        setError(error, systemError("ftruncate"));
+        return nullptr;
+    }
+    void* view = mmap(nullptr, ring->mappedSize_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (view == MAP_FAILED) {
+        setError(error, systemError("mmap"));
+        return nullptr;
+    }
+#endif
+
+    ring->header_ = static_cast<Header*>(view);
+    ring->slots_ = static_cast<unsigned char*>(view) + kHeaderSize;
+    if (!ring->initialize(true, error)) {
+        return nullptr;
+    }
+    return ring;
+}
+
+std::unique_ptr<SharedLogRing> SharedLogRing::attach(const std::string& handle, std::string* error) {
+    std::unique_ptr<SharedLogRing> ring(new SharedLogRing());
+    ring->handle_ = handle;
+
+#if defined(CP_PLATFORM_WINDOWS)
+    if (handle.compare(0, 4, "win:") != 0) {
+        setError(error, "invalid shared log ring handle: " + handle);
+        return nullptr;
+    }
+    const std::string mappingName = "Local\\" + handle.substr(4);
+    HANDLE mapping = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, mappingName.c_str());
+    if (!mapping) {
+        setError(error, systemError("OpenFileMapping " + handle));
+        return nullptr;
+    }
+    ring->mapping_ = mapping;
+    void* view = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+    if (!view) {
+        setError(error, systemError("MapViewOfFile"));
+        return nullptr;
+    }
+    MEMORY_BASIC_INFORMATION info;
+    VirtualQuery(view, &info, sizeof(info));
+    ring->mappedSize_ = info.RegionSize;
+#else
+    int fd = -1;
+    if (handle.compare(0, 3, "fd:") == 0) {
+        // 经 /proc 重新打开创建者的描述符，子进程无需继承描述符
+        const size_t colon = handle.find(':', 3);
+        if (colon == std::string::npos) {
+            setError(error, "invalid shared log ring handle: " + handle);
+            return nullptr;
+        }
+        const std::string path = "/proc/" + handle.substr(3, colon - 3) + "/fd/" + handle.substr(colon + 1);
+        fd = open(path.c_str(), O_RDWR | O_CLOEXEC);
+        if (fd < 0) {
+            setError(error, systemError("open " + path));
+            return nullptr;
+        }
+    } else if (handle.compare(0, 4, "shm:") == 0) {
+        fd = shm_open(("/" + handle.substr(4)).c_str(), O_RDWR, 0600);
+        if (fd < 0) {
+            setError(error, systemError("shm_open " + handle.substr(4)));
+            return nullptr;
+        }
+    } else {
+        setError(error, "invalid shared log ring handle: " + handle);
+        return nullptr;
+    }
+    ring->fd_ = fd;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < kHeaderSize) {
+        setError(error, "shared log ring is not initialized: " + handle);
+        return nullptr;
+    }
+    ring->mappedSize_ = static_cast<size_t>(st.st_size);
+    void* view = mmap(nullptr, ring->mappedSize_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (view == MAP_FAILED) {
+        setError(error, systemError("mmap"));
+        return nullptr;
+    }
+#endif
+
+    ring->header_ = static_cast<Header*>(view);
+    ring->slots_ = static_cast<unsigned char*>(view) + kHeaderSize;
+    if (!ring->initialize(false, error)) {
+        return nullptr;
+    }
+    return ring;
+}
+
+std::unique_ptr<SharedLogRing> SharedLogRing::attachFromEnvironment(std::string* error) {
+    const char* handle = std::getenv(kEnvironmentVariable);
+    if (!handle || !*handle) {
+        setError(error, std::string(kEnvironmentVariable) + " is not set");
+        return nullptr;
+    }
+    return attach(handle, error);
+}
+
+SharedLogRing::~SharedLogRing() {
+#if defined(CP_PLATFORM_WINDOWS)
+    if (header_) UnmapViewOfFile(header_);
+    if (mapping_) CloseHandle(static_cast<HANDLE>(mapping_));
+#else
+    if (header_) munmap(header_, mappedSize_);
+    if (fd_ >= 0) close(fd_);
+    // 已打开的进程保留映射，删除名称只影响之后的 attach
+    if (!shmName_.empty()) shm_unlink(shmName_.c_str());
+#endif
+}
+
+bool SharedLogRing::initialize(bool creator, std::string* error) {
+    static_assert(sizeof(Header) <= kHeaderSize, "header does not fit in its reserved space");
+    if (creator) {
+        header_->capacity = capacity_;
+        header_->slotSize = sizeof(Slot);
+        header_->enqueuePos.store(0, std::memory_order_relaxed);
+        header_->dequeuePos.store(0, std::memory_order_relaxed);
+        header_->futexWord.store(0, std::memory_order_relaxed);
+        header_->readerWaiting.store(0, std::memory_order_relaxed);
+        header_->dropped.store(0, std::memory_order_relaxed);
+        for (size_t i = 0; i < capacity_; ++i) {
+            slotAt(i).sequence.store(i, std::memory_order_relaxed);
+            slotAt(i).writers.store(0, std::memory_order_relaxed);
+        }
+        header_->version = kRingVersion;
+        // magic 最后写入，attach 看到 magic 即说明其余字段已初始化
+        std::atomic_thread_fence(std::memory_order_release);
+        header_->magic = kRingMagic;
+        return true;
+    }
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (header_->magic != kRingMagic || header_->version != kRingVersion ||
+        header_->slotSize != sizeof(Slot)) {
+        setError(error, "incompatible shared log ring: " + handle_);
+        return false;
+    }
+    const uint64_t capacity = header_->capacity;
+    if (capacity == 0 || (capacity & (capacity - 1)) != 0 ||
+        kHeaderSize + capacity * sizeof(Slot) > mappedSize_) {
+        setError(error, "corrupted shared log ring: " + handle_);
+        return false;
+    }
+    capacity_ = static_cast<size_t>(capacity);
+    return true;
+}
+
+SharedLogRing::Slot& SharedLogRing::slotAt(uint64_t position) const {
+    return reinterpret_cast<Slot*>(slots_)[position & (capacity_ - 1)];
+}
+
+bool SharedLogRing::write(LogLevel level, std::chrono::system_clock::time_point time, std::string_view message) {
+    uint64_t position = header_->enqueuePos.load(std::memory_order_relaxed);
+    Slot* slot = nullptr;
+    for (;;) {
+        slot = &slotAt(position);
+        const uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+        const int64_t diff = static_cast<int64_t>(sequence - position);
+        if (diff == 0) {
+            if (header_->enqueuePos.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // 读取进程来不及处理，丢弃而不是阻塞写入进程
+            header_->dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            position = header_->enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    // 写入内容之前确认没有其他写入者，且读取端没有跳过这个槽位：
+    // 否则本次写入可能与停滞后恢复的写入者（或下一圈的写入者）互相覆盖
+    const uint64_t tag = position << kWriterCountBits;
+    uint64_t writers = slot->writers.load(std::memory_order_relaxed);
+    bool alone = false;
+    for (;;) {
+        alone = (writers & kWriterCountMask) == 0;
+        // 之前各圈遗留的写入者本次仍视为在写，但计数由本圈接管
+        const uint64_t desired = (writers & ~kWriterCountMask) == tag ? writers + 1 : tag | 1;
+        if (slot->writers.compare_exchange_weak(writers, desired, std::memory_order_seq_cst,
+                                                std::memory_order_relaxed)) {
+            break;
+        }
+    }
+    const bool exclusive = alone && slot->sequence.load(std::memory_order_seq_cst) == position;
+    if (exclusive) {
+        const size_t length = std::min(message.size(), kMaxMessageSize);
+        slot->timeNs = std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+        slot->processId = currentProcessId();
+        slot->threadId = currentThreadId();
+        slot->level = static_cast<uint8_t>(level);
+        slot->length = static_cast<uint16_t>(length);
+        std::memcpy(slot->text, message.data(), length);
+    }
+    // 计数已被之后的圈接管时不再递减
+    writers = slot->writers.load(std::memory_order_relaxed);
+    while ((writers & ~kWriterCountMask) == tag && (writers & kWriterCountMask) != 0 &&
+           !slot->writers.compare_exchange_weak(writers, writers - 1, std::memory_order_release,
+                                                std::memory_order_relaxed)) {
+    }
+
+    // 读取端可能因超时跳过了这个槽位（已计入丢弃条数），此时记录作废
+    uint64_t expected = position;
+    const uint64_t published = exclusive ? position + 1 : (position + 1) | kDiscardedRecord;
+    if (!slot->sequence.compare_exchange_strong(expected, published, std::memory_order_release,
+                                                std::memory_order_relaxed)) {
+        return false;
+    }
+    if (!exclusive) {
+        header_->dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (header_->readerWaiting.load(std::memory_order_relaxed)) {
+        wakeReader();
+    }
+    return exclusive;
+}
+
+size_t SharedLogRing::drain(std::vector<SharedLogRecord>& out, size_t maxRecords) {
+    size_t count = 0;
+    uint64_t position = header_->dequeuePos.load(std::memory_order_relaxed);
+    while (count < maxRecords) {
+        Slot& slot = slotAt(position);
+        const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence == ((position + 1) | kDiscardedRecord)) {
+            // 写入者已计入丢弃条数
+            slot.sequence.store(position + capacity_, std::memory_order_release);
+            ++position;
+            header_->dequeuePos.store(position, std::memory_order_relaxed);
+            continue;
+        }
+        if (sequence != position + 1) {
+            if (sequence != position ||
+                header_->enqueuePos.load(std::memory_order_relaxed) == position) {
+                break;  // 没有更多日志
+            }
+            // 槽位已被占用但尚未发布：写入进程可能在写入中途退出，等待超时后跳过
+            const auto now = std::chrono::steady_clock::now();
+            if (stalledPosition_ != position) {
+                stalledPosition_ = position;
+                stalledSince_ = now;
+                break;
+            }
+            if (now - stalledSince_ < kStalledSlotTimeout) {
+                break;
+            }
+            uint64_t expected = position;
+            if (!slot.sequence.compare_exchange_strong(expected, position + capacity_, std::memory_order_acq_rel)) {
+                continue;  // 写入进程恰好完成发布，重新读取
+            }
+            header_->dropped.fetch_add(1, std::memory_order_relaxed);
+            ++position;
+            header_->dequeuePos.store(position, std::memory_order_relaxed);
+            continue;
+        }
+
+        SharedLogRecord record;
+        record.level = static_cast<LogLevel>(std::min<uint8_t>(slot.level, static_cast<uint8_t>(LogLevel::FATAL)));
+        record.time = std::chrono::system_clock::time_point(
+            std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(slot.timeNs)));
+        record.processId = slot.processId;
+        record.threadId = slot.threadId;
+        record.message.assign(slot.text, std::min<size_t>(slot.length, kMaxMessageSize));
+        out.push_back(std::move(record));
+
+        slot.sequence.store(position + capacity_, std::memory_order_release);
+        ++position;
+        header_->dequeuePos.store(position, std::memory_order_relaxed);
+        ++count;
+    }
+    return count;
+}
+
+bool SharedLogRing::hasUnread() const {
+    const uint64_t position = header_->dequeuePos.load(std::memory_order_relaxed);
+    return header_->enqueuePos.load(std::memory_order_acquire) != position;
+}
+
+bool SharedLogRing::waitForData(std::chrono::milliseconds timeout) {
+    auto hasData = [this]() { return hasUnread(); };
+    if (hasData()) {
+        return true;
+    }
+
+#if defined(CP_PLATFORM_LINUX)
+    // 先取 futex 值再声明等待并复查，写入者在复查之后发布必然改变 futex 值
+    const uint32_t observed = header_->futexWord.load(std::memory_order_acquire);
+    header_->readerWaiting.store(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!hasData()) {
+        futexWait(&header_->futexWord, observed, timeout);
+    }
+    header_->readerWaiting.store(0, std::memory_order_relaxed);
+#else
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!hasData() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+#endif
+    return hasData();
+}
+
+bool SharedLogRing::waitForAny(const std::vector<std::shared_ptr<SharedLogRing>>& rings,
+                               std::chrono::milliseconds timeout) {
+    if (rings.size() == 1) {
+        return rings.front()->waitForData(timeout);
+    }
+    auto anyData = [&rings]() {
+        return std::any_of(rings.begin(), rings.end(),
+                           [](const std::shared_ptr<SharedLogRing>& ring) { return ring->hasUnread(); });
+    };
+    if (anyData()) {
+        return true;
+    }
+
+#if defined(CP_PLATFORM_LINUX) && defined(SYS_futex_waitv)
+    // futex_waitv（Linux 5.16+）同时等待所有日志环的 futex，与 waitForData 一样先取值再声明等待并复查
+    if (!rings.empty() && rings.size() <= FUTEX_WAITV_MAX) {
+        std::vector<struct futex_waitv> waiters(rings.size());
+        for (size_t i = 0; i < rings.size(); ++i) {
+            Header* header = rings[i]->header_;
+            waiters[i].val = header->futexWord.load(std::memory_order_acquire);
+            waiters[i].uaddr = reinterpret_cast<uintptr_t>(&header->futexWord);
+            waiters[i].flags = FUTEX_32;
+            header->readerWaiting.store(1, std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        long result = 0;
+        if (!anyData()) {
+            struct timespec deadline;
+            clock_gettime(CLOCK_MONOTONIC, &deadline);
+            deadline.tv_sec += static_cast<time_t>(timeout.count() / 1000);
+            deadline.tv_nsec += static_cast<long>(timeout.count() % 1000) * 1000000;
+            if (deadline.tv_nsec >= 1000000000) {
+                deadline.tv_sec += 1;
+                deadline.tv_nsec -= 1000000000;
+            }
+            result = syscall(SYS_futex_waitv, waiters.data(), static_cast<unsigned>(waiters.size()), 0,
+                             &deadline, CLOCK_MONOTONIC);
+        }
+        for (const auto& ring : rings) {
+            ring->header_->readerWaiting.store(0, std::memory_order_relaxed);
+        }
+        if (result >= 0 || errno != ENOSYS) {
+            return anyData();
+        }
+    }
+#endif
+
+    // 内核不支持时轮询
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!anyData() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(kMultiRingPoll);
+    }
+    return anyData();
+}
+
+void SharedLogRing::wakeReader() {
+    header_->futexWord.fetch_add(1, std::memory_order_release);
+#if defined(CP_PLATFORM_LINUX)
+    futexWakeAll(&header_->futexWord);
+#endif
+}
+
+uint64_t SharedLogRing::getDroppedCount() const {
+    return header_->dropped.load(std::memory_order_relaxed);
+}
+
+// ================ SharedLogRingSink ================
+
+SharedLogRingSink::SharedLogRingSink(std::shared_ptr<SharedLogRing> ring, const LogSinkOptions& options)
+    : LogSink(options), ring_(std::move(ring)) {}
+
+SharedLogRingSink::~SharedLogRingSink() {
+    stop();
+}
+
+void SharedLogRingSink::writeEntry(const LogEntry& entry) {
+    if (!ring_) return;
+    if (entry.fields.empty()) {
+        ring_->write(entry.level, entry.time, entry.message);
+        return;
+    }
+    // 日志环只传递文本，结构化字段以 "key=value" 附在消息后
+    buffer_.assign(entry.message);
+    Internal::appendLogFieldsText(buffer_, entry.fields);
+    ring_->write(entry.level, entry.time, buffer_);
+}
+
+} // namespace CorePlatform
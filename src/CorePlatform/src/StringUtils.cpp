@@ -1,4 +1,5 @@
 #include "CorePlatform/StringUtils.h"
+#include "CorePlatform/TimeUtils.h"
 #include <cstring>
 #include <regex>
 #include <random>
@@ -96,6 +97,83 @@ bool StringUtils::endsWith(const std::string& str, const std::string& suffix) {
     return std::equal(suffix.rbegin(), suffix.rend(), str.rbegin());
 }
 
+namespace {
+
+// 匹配 pattern[p] 处的一个元素（普通字符、?、[...]、\x），匹配时把 p 移到该元素之后
+bool matchGlobElement(std::string_view pattern, size_t& p, char ch) {
+    const char c = pattern[p];
+    if (c == '?') {
+        ++p;
+        return true;
+    }
+    if (c == '\\' && p + 1 < pattern.size()) {
+        if (pattern[p + 1] != ch) return false;
+        p += 2;
+        return true;
+    }
+    if (c == '[') {
+        size_t i = p + 1;
+        const bool negate = i < pattern.size() && (pattern[i] == '!' || pattern[i] == '^');
+        if (negate) ++i;
+        bool matched = false;
+        // 紧跟在 [ 或 [! 之后的 ] 是普通字符
+        for (bool first = true; i < pattern.size() && (first || pattern[i] != ']'); first = false) {
+            const unsigned char low = static_cast<unsigned char>(pattern[i]);
+            if (i + 2 < pattern.size() && pattern[i + 1] == '-' && pattern[i + 2] != ']') {
+                const unsigned char high = static_cast<unsigned char>(pattern[i + 2]);
+                matched |= low <= static_cast<unsigned char>(ch) && static_cast<unsigned char>(ch) <= high;
+                i += 3;
+            } else {
+                matched |= low == static_cast<unsigned char>(ch);
+                ++i;
+            }
+        }
+        if (i < pattern.size()) {
+            if (matched == negate) return false;
+            p = i + 1;
+            return true;
+        }
+        // 没有闭合的 [ 按普通字符处理
+    }
+    if (c != ch) return false;
+    ++p;
+    return true;
+}
+
+} // 匿名命名空间
+
+bool StringUtils::matchGlob(std::string_view pattern, std::string_view text) {
+    // 只需记住最近的一个 *：失败时让它多吞一个字符重试，最坏 O(模式长度 × 文本长度)
+    size_t p = 0;
+    size_t t = 0;
+    size_t starPattern = std::string_view::npos;
+    size_t starText = 0;
+    while (t < text.size()) {
+        if (p < pattern.size()) {
+            if (pattern[p] == '*') {
+                starPattern = ++p;
+                starText = t;
+                continue;
+            }
+            size_t next = p;
+            if (matchGlobElement(pattern, next, text[t])) {
+                p = next;
+                ++t;
+                continue;
+            }
+        }
+        if (starPattern == std::string_view::npos) {
+            return false;
+        }
+        p = starPattern;
+        t = ++starText;
+    }
+    while (p < pattern.size() && pattern[p] == '*') {
+        ++p;
+    }
+    return p == pattern.size();
+}
+
 std::vector<std::string> StringUtils::split(
     const std::string& str, 
     const std::string& delimiter
@@ -618,22 +696,8 @@ std::string StringUtils::decToHex(uint32_t dec, bool prefix, int minLength) {
 // ====================== 时间戳 ======================
 
 std::string StringUtils::currentTimestamp() {
-    auto now = std::chrono::system_clock::now();
-    auto in_time_t = std::chrono::system_clock::to_time_t(now);
-    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-        now.time_since_epoch()) % 1000;
-    
-    std::tm bt;
-#ifdef _WIN32
-    localtime_s(&bt, &in_time_t);
-#else
-    localtime_r(&in_time_t, &bt);
-#endif
-    
-    std::stringstream ss;
-    ss << std::put_time(&bt, "%Y-%m-%d %H:%M:%S");
-    ss << '.' << std::setfill('0') << std::setw(3) << ms.count();
-    return ss.str();
+    return TimeUtils::formatTimestamp(std::chrono::system_clock::now(),
+                                      TimestampFormat::LocalMillis);
 }
 
 } // namespace CorePlatform
\ No newline at end of file
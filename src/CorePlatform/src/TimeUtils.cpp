@@ -4,6 +4,9 @@
 #include <thread>
 #include <iomanip>
 #include <sstream>
+#include <cstring>
+#include <climits>
+#include <cstdint>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -14,6 +17,84 @@
 
 namespace CorePlatform {
 
+namespace {
+
+// 按秒缓存的 "YYYY-MM-DD HH:MM:SS" 前缀
+struct SecondCache {
+    int64_t second = INT64_MIN;
+    char text[19];
+};
+
+inline void write2(char* p, unsigned value) {
+    p[0] = static_cast<char>('0' + value / 10);
+    p[1] = static_cast<char>('0' + value % 10);
+}
+
+inline void writeDigits(char* p, unsigned value, int width) {
+    for (int i = width - 1; i >= 0; --i) {
+        p[i] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+}
+
+void writeDateTime(char* p, int year, unsigned month, unsigned day,
+                   unsigned hour, unsigned minute, unsigned second) {
+    writeDigits(p, static_cast<unsigned>(year < 0 ? 0 : year % 10000), 4);
+    p[4] = '-';
+    write2(p + 5, month);
+    p[7] = '-';
+    write2(p + 8, day);
+    p[10] = ' ';
+    write2(p + 11, hour);
+    p[13] = ':';
+    write2(p + 14, minute);
+    p[16] = ':';
+    write2(p + 17, second);
+}
+
+// 由 1970-01-01 起的天数计算公历日期（Howard Hinnant 的 civil_from_days 算法）
+void civilFromDays(int64_t days, int& year, unsigned& month, unsigned& day) {
+    days += 719468;
+    const int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    const unsigned doe = static_cast<unsigned>(days - era * 146097);
+    const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const unsigned mp = (5 * doy + 2) / 153;
+    day = doy - (153 * mp + 2) / 5 + 1;
+    month = mp < 10 ? mp + 3 : mp - 9;
+    year = static_cast<int>(static_cast<int64_t>(yoe) + era * 400 + (month <= 2 ? 1 : 0));
+}
+
+void fillLocalPrefix(SecondCache& cache, int64_t second) {
+    std::time_t t = static_cast<std::time_t>(second);
+    std::tm bt{};
+#ifdef _WIN32
+    localtime_s(&bt, &t);
+#else
+    localtime_r(&t, &bt);
+#endif
+    writeDateTime(cache.text, bt.tm_year + 1900,
+                  static_cast<unsigned>(bt.tm_mon + 1), static_cast<unsigned>(bt.tm_mday),
+                  static_cast<unsigned>(bt.tm_hour), static_cast<unsigned>(bt.tm_min),
+                  static_cast<unsigned>(bt.tm_sec));
+    cache.second = second;
+}
+
+void fillUtcPrefix(SecondCache& cache, int64_t second) {
+    const int64_t days = (second >= 0 ? second : second - 86399) / 86400;
+    const unsigned secOfDay = static_cast<unsigned>(second - days * 86400);
+    int year = 0;
+    unsigned month = 0;
+    unsigned day = 0;
+    civilFromDays(days, year, month, day);
+    writeDateTime(cache.text, year, month, day,
+                  secOfDay / 3600, secOfDay / 60 % 60, secOfDay % 60);
+    cache.text[10] = 'T';
+    cache.second = second;
+}
+
+} // 匿名命名空间
+
 // ====================== 时间等待 ======================
 
 void TimeUtils::sleep(int milliseconds) {
@@ -118,22 +199,57 @@ std::string TimeUtils::currentDateTime() {
 }
 
 std::string TimeUtils::currentDateTimeMillis() {
-    auto now = std::chrono::system_clock::now();
-    auto in_time_t = std::chrono::system_clock::to_time_t(now);
-    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-        now.time_since_epoch()) % 1000;
-    
-    std::tm bt;
-#ifdef _WIN32
-    localtime_s(&bt, &in_time_t);
-#else
-    localtime_r(&in_time_t, &bt);
-#endif
-    
-    std::stringstream ss;
-    ss << std::put_time(&bt, "%Y-%m-%d %H:%M:%S");
-    ss << '.' << std::setfill('0') << std::setw(3) << ms.count();
-    return ss.str();
+    return formatTimestamp(std::chrono::system_clock::now(), TimestampFormat::LocalMillis);
+}
+
+// ====================== 时间戳格式化引擎 ======================
+
+size_t TimeUtils::formatTimestamp(char* buffer,
+                                  std::chrono::system_clock::time_point time,
+                                  TimestampFormat format) {
+    thread_local SecondCache localCache;
+    thread_local SecondCache utcCache;
+
+    const auto micros = std::chrono::floor<std::chrono::microseconds>(time).time_since_epoch().count();
+    const int64_t second = (micros >= 0 ? micros : micros - 999999) / 1000000;
+    const unsigned fraction = static_cast<unsigned>(micros - second * 1000000);
+
+    const bool utc = format == TimestampFormat::UtcIso8601Millis ||
+                     format == TimestampFormat::UtcIso8601Micros;
+    SecondCache& cache = utc ? utcCache : localCache;
+    if (cache.second != second) {
+        if (utc) {
+            fillUtcPrefix(cache, second);
+        } else {
+            fillLocalPrefix(cache, second);
+        }
+    }
+
+    memcpy(buffer, cache.text, sizeof(cache.text));
+    size_t length = sizeof(cache.text);
+    buffer[length++] = '.';
+
+    const bool micro = format == TimestampFormat::LocalMicros ||
+                       format == TimestampFormat::UtcIso8601Micros;
+    if (micro) {
+        writeDigits(buffer + length, fraction, 6);
+        length += 6;
+    } else {
+        writeDigits(buffer + length, fraction / 1000, 3);
+        length += 3;
+    }
+    if (utc) {
+        buffer[length++] = 'Z';
+    }
+    buffer[length] = '\0';
+    return length;
+}
+
+std::string TimeUtils::formatTimestamp(std::chrono::system_clock::time_point time,
+                                       TimestampFormat format) {
+    char buffer[kMaxTimestampLength];
+    const size_t length = formatTimestamp(buffer, time, format);
+    return std::string(buffer, length);
 }
 
 // ====================== 计时器实现 ======================
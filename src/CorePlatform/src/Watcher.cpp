@@ -0,0 +1,814 @@
+#include "CorePlatform/FileSystem.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#if defined(CP_PLATFORM_WINDOWS)
+#include <windows.h>
+#elif defined(CP_PLATFORM_LINUX)
+#include <climits>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <sys/fanotify.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#endif
+
+namespace CorePlatform {
+
+namespace {
+
+// 按路径合并事件：读取线程合并一批内核事件，尚未投递的批次也用它与后续批次合并
+class EventCoalescer {
+public:
+    bool Empty() const { return count == 0; }
+
+    size_t Size() const { return count; }
+
+    // 并入另一个合并器已经合并好的事件
+    void Merge(const FileSystem::WatchEvent& event) {
+        switch (event.type) {
+            case FileSystem::WatchEventType::Rescan:
+                AddRescan(event.path);
+                break;
+            case FileSystem::WatchEventType::Renamed:
+                MoveFrom(0, event.oldPath, event.isDirectory);
+                MoveTo(0, event.path, event.isDirectory);
+                break;
+            default:
+                Add(event.type, event.path, event.isDirectory);
+                break;
+        }
+    }
+
+    void Add(FileSystem::WatchEventType type, const std::string& path, bool isDirectory) {
+        using Type = FileSystem::WatchEventType;
+        auto it = index.find(path);
+        if (it == index.end()) {
+            Append(type, path, std::string(), isDirectory);
+            return;
+        }
+        Pending& pending = events[it->second];
+        FileSystem::WatchEvent& event = pending.event;
+        event.isDirectory = isDirectory;
+        switch (type) {
+            case Type::Modified:
+                // 新建或改名后的修改不单独报告；删除后又出现说明被替换
+                if (event.type == Type::Deleted) {
+                    event.type = Type::Modified;
+                }
+                break;
+            case Type::Created:
+                event.type = event.type == Type::Deleted ? Type::Modified : event.type;
+                break;
+            case Type::Deleted:
+                if (event.type == Type::Created) {
+                    // 这一批中创建又删除的临时文件
+                    pending.removed = true;
+                    index.erase(it);
+                    --count;
+                } else if (event.type == Type::Renamed) {
+                    // 改名后删除，相当于删除原路径
+                    std::string oldPath = std::move(event.oldPath);
+                    size_t position = it->second;
+                    index.erase(it);
+                    event.type = Type::Deleted;
+                    event.path = oldPath;
+                    event.oldPath.clear();
+                    index.emplace(std::move(oldPath), position);
+                } else {
+                    event.type = Type::Deleted;
+                }
+                break;
+            default:
+                event.type = type;
+                break;
+        }
+    }
+
+    // 重命名的两半：MOVED_FROM 先按删除记录，配对的 MOVED_TO 到达时改为 Renamed
+    void MoveFrom(uint32_t cookie, const std::string& path, bool isDirectory) {
+        auto it = index.find(path);
+        Move move{path, false};
+        if (it != index.end()) {
+            const FileSystem::WatchEvent& event = events[it->second].event;
+            move.created = event.type == FileSystem::WatchEventType::Created;
+            // 连续改名时记录最初的路径，Add 会把它改为删除最初的路径
+            if (event.type == FileSystem::WatchEventType::Renamed) {
+                move.path = event.oldPath;
+            }
+        }
+        moves[cookie] = std::move(move);
+        Add(FileSystem::WatchEventType::Deleted, path, isDirectory);
+    }
+
+    void MoveTo(uint32_t cookie, const std::string& path, bool isDirectory) {
+        auto move = moves.find(cookie);
+        if (move == moves.end()) {
+            Add(FileSystem::WatchEventType::Created, path, isDirectory);
+            return;
+        }
+        std::string oldPath = std::move(move->second.path);
+        bool created = move->second.created;
+        moves.erase(move);
+        // 这一批中新建后改名（如先写临时文件再改名）：只报告最终的路径
+        if (created || oldPath == path) {
+            Add(FileSystem::WatchEventType::Created, path, isDirectory);
+            return;
+        }
+        auto old = index.find(oldPath);
+        if (old != index.end() && events[old->second].event.type == FileSystem::WatchEventType::Deleted) {
+            events[old->second].removed = true;
+            index.erase(old);
+            --count;
+        }
+        auto it = index.find(path);
+        if (it != index.end()) {
+            events[it->second].removed = true;
+            index.erase(it);
+            --count;
+        }
+        Append(FileSystem::WatchEventType::Renamed, path, oldPath, isDirectory);
+    }
+
+    // 一批中只报告一次
+    void AddRescan(const std::string& root) {
+        if (rescan) {
+            return;
+        }
+        events.push_back({{FileSystem::WatchEventType::Rescan, root, std::string(), true}, false});
+        ++count;
+        rescan = true;
+    }
+
+    std::vector<FileSystem::WatchEvent> Take() {
+        std::vector<FileSystem::WatchEvent> batch;
+        batch.reserve(count);
+        for (Pending& pending : events) {
+            if (!pending.removed) {
+                batch.push_back(std::move(pending.event));
+            }
+        }
+        events.clear();
+        index.clear();
+        moves.clear();
+        count = 0;
+        rescan = false;
+        return batch;
+    }
+
+private:
+    struct Pending {
+        FileSystem::WatchEvent event;
+        bool removed = false;
+    };
+
+    struct Move {
+        std::string path;
+        bool created = false;   // 改名前的路径是这一批中新建的
+    };
+
+    void Append(FileSystem::WatchEventType type, const std::string& path, const std::string& oldPath,
+                bool isDirectory) {
+        index[path] = events.size();
+        events.push_back({{type, path, oldPath, isDirectory}, false});
+        ++count;
+    }
+
+    std::vector<Pending> events;
+    std::unordered_map<std::string, size_t> index;     // 路径 -> events 中的位置
+    std::unordered_map<uint32_t, Move> moves;
+    size_t count = 0;
+    bool rescan = false;
+};
+
+#if defined(CP_PLATFORM_LINUX)
+constexpr uint32_t kInotifyMask = IN_CREATE | IN_DELETE | IN_MODIFY | IN_ATTRIB | IN_MOVED_FROM | IN_MOVED_TO |
+                                  IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR | IN_EXCL_UNLINK;
+
+constexpr size_t kEventBufferSize = 64 * 1024;
+
+std::string JoinPath(const std::string& dir, const char* name) {
+    return dir.back() == '/' ? dir + name : dir + "/" + name;
+}
+
+bool IsInside(const std::string& path, const std::string& dir) {
+    if (dir == "/") {
+        return path.size() > 1 && path[0] == '/';
+    }
+    return path.size() > dir.size() && path.compare(0, dir.size(), dir) == 0 && path[dir.size()] == '/';
+}
+#endif
+
+} // 匿名命名空间
+
+struct FileSystem::Watcher::State {
+    State(const std::string& root, const WatchOptions& options, WatchCallback callback)
+        : root(root), options(options), callback(std::move(callback)) {
+        // 去掉结尾的 '/'，根目录除外
+        while (this->root.size() > 1 && this->root.back() == '/') {
+            this->root.pop_back();
+        }
+    }
+
+    ~State() {
+        Stop();
+    }
+
+    bool Start() {
+#if defined(CP_PLATFORM_LINUX)
+        struct stat st;
+        if (stat(root.c_str(), &st) != 0) {
+            return false;
+        }
+        if (!S_ISDIR(st.st_mode)) {
+            errno = ENOTDIR;
+            return false;
+        }
+        wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (wakeFd < 0) {
+            return false;
+        }
+        if (!(options.useFanotify && StartFanotify()) && !StartInotify()) {
+            int error = errno;
+            CloseDescriptors();
+            errno = error;
+            return false;
+        }
+        try {
+            // 回调线程持有 mutex 之后才调用回调，此时两个线程对象都已赋值，回调中可以调用 Stop
+            std::lock_guard<std::mutex> lock(mutex);
+            callbackThread = std::thread([this] {
+                DeliverLoop();
+                // 在回调中停止：Watcher 已经放弃所有权，由回调线程释放
+                if (releaseOnExit) {
+                    delete this;
+                }
+            });
+            readerThread = std::thread([this] { ReadLoop(); });
+        } catch (const std::system_error& e) {
+            Stop();
+            errno = e.code().value();
+            return false;
+        }
+        return true;
+#elif defined(CP_PLATFORM_WINDOWS)
+        SetLastError(ERROR_CALL_NOT_IMPLEMENTED);
+        return false;
+#else
+        errno = ENOSYS;
+        return false;
+#endif
+    }
+
+    void Stop() {
+#if defined(CP_PLATFORM_LINUX)
+        if (readerThread.joinable()) {
+            uint64_t value = 1;
+            ssize_t written = write(wakeFd, &value, sizeof(value));
+            (void)written;
+            readerThread.join();
+        }
+#endif
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        cv.notify_all();
+        if (callbackThread.joinable()) {
+            callbackThread.join();
+        }
+#if defined(CP_PLATFORM_LINUX)
+        CloseDescriptors();
+#endif
+    }
+
+    bool InCallbackThread() const {
+        return std::this_thread::get_id() == callbackThread.get_id();
+    }
+
+    // 在回调中停止：不能等待自己，回调返回后回调线程退出并释放 State
+    void StopFromCallback() {
+        callbackThread.detach();
+        releaseOnExit = true;
+        Stop();
+    }
+
+    // 回调线程：投递读取线程交来的事件
+    void DeliverLoop() {
+        while (true) {
+            std::vector<WatchEvent> batch;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                cv.wait(lock, [this] { return stopping || !pending.Empty(); });
+                if (stopping) {
+                    return;
+                }
+                batch = pending.Take();
+            }
+            callback(batch);
+        }
+    }
+
+    void Deliver() {
+        std::vector<WatchEvent> batch = coalescer.Take();
+        if (batch.empty()) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            // 回调跟不上时与尚未投递的事件继续合并；仍然过多时只报告需要重新扫描
+            for (const WatchEvent& event : batch) {
+                pending.Merge(event);
+            }
+            if (pending.Size() > options.maxPendingEvents) {
+                pending.Take();
+                pending.AddRescan(root);
+            }
+        }
+        cv.notify_one();
+    }
+
+    std::string root;
+    const WatchOptions options;
+    const WatchCallback callback;
+    EventCoalescer coalescer;
+    std::atomic<size_t> watchCount{0};
+    bool fanotify = false;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    EventCoalescer pending;     // 尚未投递的事件
+    bool stopping = false;
+    bool releaseOnExit = false; // 只由回调线程读写
+    std::thread callbackThread;
+    std::thread readerThread;
+
+#if defined(CP_PLATFORM_LINUX)
+    void CloseDescriptors() {
+        for (int* fd : {&notifyFd, &wakeFd, &mountFd}) {
+            if (*fd >= 0) {
+                close(*fd);
+                *fd = -1;
+            }
+        }
+    }
+
+    // 读取线程：读取事件，第一个事件到达 latency 之后投递这一批
+    void ReadLoop() {
+        std::vector<char> buffer(kEventBufferSize);
+        std::chrono::steady_clock::time_point deadline;
+        struct pollfd fds[2] = {{notifyFd, POLLIN, 0}, {wakeFd, POLLIN, 0}};
+        while (true) {
+            int timeout = -1;
+            if (!coalescer.Empty()) {
+                auto remaining = std::chrono::ceil<std::chrono::milliseconds>(
+                    deadline - std::chrono::steady_clock::now());
+                timeout = static_cast<int>(std::max<int64_t>(0, remaining.count()));
+            }
+            int ready = poll(fds, 2, timeout);
+            if (ready < 0 && errno != EINTR) {
+                return;
+            }
+            if (fds[1].revents != 0) {
+                return;
+            }
+            if (ready > 0 && fds[0].revents != 0) {
+                bool wasEmpty = coalescer.Empty();
+                ReadEvents(buffer);
+                if (wasEmpty && !coalescer.Empty()) {
+                    deadline = std::chrono::steady_clock::now() + options.latency;
+                }
+            }
+            if (!coalescer.Empty() && std::chrono::steady_clock::now() >= deadline) {
+                FinishDirectoryMoves();
+                Deliver();
+            }
+        }
+    }
+
+    void ReadEvents(std::vector<char>& buffer) {
+        while (true) {
+            ssize_t n = read(notifyFd, buffer.data(), buffer.size());
+            if (n <= 0) {
+                return;
+            }
+            if (fanotify) {
+                HandleFanotifyEvents(buffer.data(), static_cast<size_t>(n));
+            } else {
+                HandleInotifyEvents(buffer.data(), static_cast<size_t>(n));
+            }
+        }
+    }
+
+    // ----- inotify：每个目录一个监视 -----
+
+    bool StartInotify() {
+        notifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (notifyFd < 0) {
+            return false;
+        }
+        fanotify = false;
+        if (!AddWatch(root)) {
+            return false;
+        }
+        AddTree(root, false);
+        return true;
+    }
+
+    bool AddWatch(const std::string& dir) {
+        int wd = inotify_add_watch(notifyFd, dir.c_str(), kInotifyMask);
+        if (wd < 0) {
+            return false;
+        }
+        // 同一目录再次添加返回同一个 wd，更新为当前路径
+        watchPaths[wd] = dir;
+        watchCount.store(watchPaths.size(), std::memory_order_relaxed);
+        return true;
+    }
+
+    // 监视 dir 下的所有子目录（dir 本身已监视）；report 为 true 时把其中的项报告为 Created
+    void AddTree(const std::string& dir, bool report) {
+        if (!options.recursive) {
+            return;
+        }
+        WalkOptions walkOptions;
+        walkOptions.files = report;
+        walkOptions.symlinks = report;
+        walkOptions.others = report;
+        Walker walker(dir, walkOptions);
+        WalkEntry entry;
+        while (walker.Next(entry)) {
+            std::string path(entry.path);
+            bool isDirectory = entry.type == FileType::Directory;
+            if (isDirectory) {
+                AddWatch(path);
+            }
+            if (report) {
+                coalescer.Add(WatchEventType::Created, path, isDirectory);
+            }
+        }
+    }
+
+    // 目录在监视范围内改名：更新它和所有子目录的监视路径
+    void RenameWatches(const std::string& oldPath, const std::string& newPath) {
+        for (auto& [wd, path] : watchPaths) {
+            if (path == oldPath) {
+                path = newPath;
+            } else if (IsInside(path, oldPath)) {
+                path = newPath + path.substr(oldPath.size());
+            }
+        }
+    }
+
+    // 没有配对的 MOVED_FROM：目录移出了监视范围，移除它的监视（收到 IN_IGNORED 时删除记录）
+    void FinishDirectoryMoves() {
+        for (const auto& [cookie, oldPath] : directoryMoves) {
+            for (const auto& [wd, path] : watchPaths) {
+                if (path == oldPath || IsInside(path, oldPath)) {
+                    inotify_rm_watch(notifyFd, wd);
+                }
+            }
+        }
+        directoryMoves.clear();
+    }
+
+    // 事件队列溢出：重新监视整个目录树（已监视的目录得到同一个 wd）
+    void Rescan() {
+        FinishDirectoryMoves();
+        coalescer.AddRescan(root);
+        if (!fanotify) {
+            AddWatch(root);
+            AddTree(root, false);
+        }
+    }
+
+    void HandleInotifyEvents(const char* buffer, size_t length) {
+        for (size_t offset = 0; offset < length;) {
+            const auto* event = reinterpret_cast<const struct inotify_event*>(buffer + offset);
+            offset += sizeof(struct inotify_event) + event->len;
+            HandleInotifyEvent(*event);
+        }
+    }
+
+    void HandleInotifyEvent(const struct inotify_event& event) {
+        if (event.mask & IN_Q_OVERFLOW) {
+            Rescan();
+            return;
+        }
+        auto it = watchPaths.find(event.wd);
+        if (it == watchPaths.end()) {
+            return;
+        }
+        if (event.mask & IN_IGNORED) {
+            watchPaths.erase(it);
+            watchCount.store(watchPaths.size(), std::memory_order_relaxed);
+            return;
+        }
+        const std::string& dir = it->second;
+        if (event.len == 0) {
+            // 目录本身的事件；子目录的变化已经由所在目录以名称报告
+            if (dir == root) {
+                if (event.mask & (IN_DELETE_SELF | IN_MOVE_SELF)) {
+                    coalescer.Add(WatchEventType::Deleted, root, true);
+                } else if (event.mask & IN_ATTRIB) {
+                    coalescer.Add(WatchEventType::Modified, root, true);
+                }
+            }
+            return;
+        }
+
+        std::string path = JoinPath(dir, event.name);
+        bool isDirectory = (event.mask & IN_ISDIR) != 0;
+        if (event.mask & IN_CREATE) {
+            coalescer.Add(WatchEventType::Created, path, isDirectory);
+            if (isDirectory && options.recursive && AddWatch(path)) {
+                AddTree(path, true);
+            }
+        }
+        if (event.mask & (IN_MODIFY | IN_ATTRIB)) {
+            coalescer.Add(WatchEventType::Modified, path, isDirectory);
+        }
+        if (event.mask & IN_DELETE) {
+            coalescer.Add(WatchEventType::Deleted, path, isDirectory);
+        }
+        if (event.mask & IN_MOVED_FROM) {
+            coalescer.MoveFrom(event.cookie, path, isDirectory);
+            if (isDirectory) {
+                directoryMoves[event.cookie] = path;
+            }
+        }
+        if (event.mask & IN_MOVED_TO) {
+            coalescer.MoveTo(event.cookie, path, isDirectory);
+            if (isDirectory) {
+                auto move = directoryMoves.find(event.cookie);
+                if (move != directoryMoves.end()) {
+                    RenameWatches(move->second, path);
+                    directoryMoves.erase(move);
+                } else if (options.recursive && AddWatch(path)) {
+                    // 从监视范围外移入
+                    AddTree(path, true);
+                }
+            }
+        }
+    }
+
+    // ----- fanotify：标记整个文件系统，事件携带目录的文件句柄和名称 -----
+
+    bool StartFanotify() {
+#ifdef FAN_REPORT_DFID_NAME
+        char resolved[PATH_MAX];
+        if (!realpath(root.c_str(), resolved)) {
+            return false;
+        }
+        int fd = fanotify_init(FAN_CLASS_NOTIF | FAN_REPORT_DFID_NAME | FAN_NONBLOCK | FAN_CLOEXEC,
+                               O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return false;
+        }
+        // 5.17 起的内核用 FAN_RENAME 在一个事件中同时报告新旧路径，更早的内核只能拿到不成对的 MOVED_FROM/MOVED_TO
+        const uint64_t mask = FAN_CREATE | FAN_DELETE | FAN_MODIFY | FAN_ATTRIB | FAN_ONDIR;
+        int dirFd = open(resolved, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        bool marked = false;
+        if (dirFd >= 0) {
+#ifdef FAN_RENAME
+            marked = fanotify_mark(fd, FAN_MARK_ADD | FAN_MARK_FILESYSTEM, mask | FAN_RENAME, AT_FDCWD, resolved) == 0;
+#endif
+            if (!marked) {
+                marked = fanotify_mark(fd, FAN_MARK_ADD | FAN_MARK_FILESYSTEM, mask | FAN_MOVED_FROM | FAN_MOVED_TO,
+                                       AT_FDCWD, resolved) == 0;
+            }
+            // 文件系统标记不报告 root 自身被删除或移走，另在 root 上添加 inode 标记
+            marked = marked && fanotify_mark(fd, FAN_MARK_ADD, FAN_DELETE_SELF | FAN_MOVE_SELF | FAN_ONDIR,
+                                             AT_FDCWD, resolved) == 0;
+        }
+        if (!marked) {
+            if (dirFd >= 0) {
+                close(dirFd);
+            }
+            close(fd);
+            return false;
+        }
+        notifyFd = fd;
+        mountFd = dirFd;
+        realRoot = resolved;
+        fanotify = true;
+        watchCount.store(1, std::memory_order_relaxed);
+        return true;
+#else
+        errno = ENOSYS;
+        return false;
+#endif
+    }
+
+#ifdef FAN_REPORT_DFID_NAME
+    // 由目录的文件句柄得到当前路径；目录已被删除时返回空字符串
+    std::string ResolveHandle(struct file_handle* handle) {
+        int fd = open_by_handle_at(mountFd, handle, O_PATH | O_CLOEXEC);
+        if (fd < 0) {
+            return std::string();
+        }
+        char link[64];
+        snprintf(link, sizeof(link), "/proc/self/fd/%d", fd);
+        char target[PATH_MAX];
+        ssize_t n = readlink(link, target, sizeof(target) - 1);
+        close(fd);
+        if (n <= 0) {
+            return std::string();
+        }
+        std::string path(target, static_cast<size_t>(n));
+        static constexpr std::string_view kDeleted = " (deleted)";
+        if (path.size() > kDeleted.size() && path.compare(path.size() - kDeleted.size(), kDeleted.size(), kDeleted) == 0) {
+            return std::string();
+        }
+        return path;
+    }
+#endif
+
+#ifdef FAN_REPORT_DFID_NAME
+    // 由事件中的目录句柄和名称得到 root 下的路径；已被删除、不在 root 下（或不递归时不是直接子项）返回空字符串
+    std::string RecordPath(const struct fanotify_event_info_fid* info, bool hasName,
+                           std::unordered_map<std::string, std::string>& resolved) {
+        auto* handle = reinterpret_cast<struct file_handle*>(const_cast<unsigned char*>(info->handle));
+        const char* name = hasName ? reinterpret_cast<const char*>(handle->f_handle + handle->handle_bytes) : nullptr;
+
+        std::string key(reinterpret_cast<const char*>(handle), sizeof(struct file_handle) + handle->handle_bytes);
+        auto cached = resolved.find(key);
+        if (cached == resolved.end()) {
+            cached = resolved.emplace(std::move(key), ResolveHandle(handle)).first;
+        }
+        const std::string& dir = cached->second;
+        if (dir.empty()) {
+            return std::string();
+        }
+        std::string full = name && std::strcmp(name, ".") != 0 ? JoinPath(dir, name) : dir;
+
+        // 只报告 root 下的项（root 本身被删除时也报告）；不递归时只报告直接子项
+        if (full != realRoot && !IsInside(full, realRoot)) {
+            return std::string();
+        }
+        if (!options.recursive && full != realRoot && dir != realRoot) {
+            return std::string();
+        }
+        return full == realRoot ? root : JoinPath(root, full.c_str() + realRoot.size() + (realRoot == "/" ? 0 : 1));
+    }
+#endif
+
+    void HandleFanotifyEvents(const char* buffer, size_t length) {
+#ifdef FAN_REPORT_DFID_NAME
+        // 同一批中同一目录的句柄只解析一次
+        std::unordered_map<std::string, std::string> resolved;
+        auto* metadata = reinterpret_cast<const struct fanotify_event_metadata*>(buffer);
+        auto remaining = static_cast<ssize_t>(length);
+        for (; FAN_EVENT_OK(metadata, remaining); metadata = FAN_EVENT_NEXT(metadata, remaining)) {
+            if (metadata->vers != FANOTIFY_METADATA_VERSION) {
+                return;
+            }
+            if (metadata->fd >= 0) {
+                close(metadata->fd);
+            }
+            if (metadata->mask & FAN_Q_OVERFLOW) {
+                Rescan();
+                continue;
+            }
+
+            // 一个事件可以带多条信息记录，FAN_RENAME 分别用 OLD_DFID_NAME 和 NEW_DFID_NAME 给出新旧位置
+            std::string path;
+            std::string oldPath;
+            const char* end = reinterpret_cast<const char*>(metadata) + metadata->event_len;
+            const char* record = reinterpret_cast<const char*>(metadata + 1);
+            while (record + sizeof(struct fanotify_event_info_header) <= end) {
+                auto* info = reinterpret_cast<const struct fanotify_event_info_fid*>(record);
+                if (info->hdr.len == 0) {
+                    break;
+                }
+                switch (info->hdr.info_type) {
+                    case FAN_EVENT_INFO_TYPE_DFID_NAME:
+#ifdef FAN_EVENT_INFO_TYPE_NEW_DFID_NAME
+                    case FAN_EVENT_INFO_TYPE_NEW_DFID_NAME:
+#endif
+                        path = RecordPath(info, true, resolved);
+                        break;
+                    case FAN_EVENT_INFO_TYPE_DFID:
+                        path = RecordPath(info, false, resolved);
+                        break;
+#ifdef FAN_EVENT_INFO_TYPE_OLD_DFID_NAME
+                    case FAN_EVENT_INFO_TYPE_OLD_DFID_NAME:
+                        oldPath = RecordPath(info, true, resolved);
+                        break;
+#endif
+                    default:
+                        break;
+                }
+                record += info->hdr.len;
+            }
+
+            bool isDirectory = (metadata->mask & FAN_ONDIR) != 0;
+#ifdef FAN_RENAME
+            if (metadata->mask & FAN_RENAME) {
+                // 移出或移入 root 时只有一端在范围内
+                if (!oldPath.empty() && !path.empty()) {
+                    coalescer.MoveFrom(0, oldPath, isDirectory);
+                    coalescer.MoveTo(0, path, isDirectory);
+                } else if (!oldPath.empty()) {
+                    coalescer.Add(WatchEventType::Deleted, oldPath, isDirectory);
+                } else if (!path.empty()) {
+                    coalescer.Add(WatchEventType::Created, path, isDirectory);
+                }
+                path.clear();
+            }
+#endif
+            if (!path.empty()) {
+                if (metadata->mask & (FAN_CREATE | FAN_MOVED_TO)) {
+                    coalescer.Add(WatchEventType::Created, path, isDirectory);
+                }
+                if (metadata->mask & (FAN_MODIFY | FAN_ATTRIB)) {
+                    coalescer.Add(WatchEventType::Modified, path, isDirectory);
+                }
+                if (metadata->mask & (FAN_DELETE | FAN_MOVED_FROM)) {
+                    coalescer.Add(WatchEventType::Deleted, path, isDirectory);
+                }
+            }
+            // 只有 root 带有 inode 标记；被删除或移走后句柄无法再解析到 root 下，直接报告
+            if (metadata->mask & (FAN_DELETE_SELF | FAN_MOVE_SELF)) {
+                coalescer.Add(WatchEventType::Deleted, root, true);
+            }
+        }
+#else
+        (void)buffer;
+        (void)length;
+#endif
+    }
+
+    int notifyFd = -1;
+    int wakeFd = -1;            // 通知读取线程退出
+    int mountFd = -1;           // fanotify：open_by_handle_at 使用的目录
+    std::string realRoot;       // fanotify：root 的绝对路径
+    std::unordered_map<int, std::string> watchPaths;           // inotify：wd -> 目录路径
+    std::unordered_map<uint32_t, std::string> directoryMoves;  // inotify：尚未配对的目录 MOVED_FROM
+#endif
+};
+
+FileSystem::Watcher::Watcher() = default;
+
+FileSystem::Watcher::~Watcher() {
+    Stop();
+}
+
+FileSystem::Watcher::Watcher(Watcher&& other) noexcept = default;
+
+FileSystem::Watcher& FileSystem::Watcher::operator=(Watcher&& other) noexcept {
+    if (this != &other) {
+        Stop();
+        state = std::move(other.state);
+    }
+    return *this;
+}
+
+bool FileSystem::Watcher::Start(const std::string& root, WatchCallback callback) {
+    return Start(root, WatchOptions(), std::move(callback));
+}
+
+bool FileSystem::Watcher::Start(const std::string& root, const WatchOptions& options, WatchCallback callback) {
+    Stop();
+    // 启动前赋值，回调中可以使用这个 Watcher
+    state = std::make_unique<State>(root, options, std::move(callback));
+    if (!state->Start()) {
+        int error = errno;
+        state.reset();
+        errno = error;
+        return false;
+    }
+    return true;
+}
+
+void FileSystem::Watcher::Stop() {
+    if (state && state->InCallbackThread()) {
+        state.release()->StopFromCallback();
+        return;
+    }
+    state.reset();
+}
+
+bool FileSystem::Watcher::IsRunning() const {
+    return state != nullptr;
+}
+
+bool FileSystem::Watcher::UsesFanotify() const {
+    return state && state->fanotify;
+}
+
+size_t FileSystem::Watcher::WatchCount() const {
+    return state ? state->watchCount.load(std::memory_order_relaxed) : 0;
+}
+
+} // namespace CorePlatform
@@ -1,5 +1,7 @@
 #include "CorePlatform/FileSystem.h"
 #include "CorePlatform/Windows/WindowsUtils.h"
+#include "CorePlatform/Internal/WorkQueue.h"
+#include "CorePlatform/StringUtils.h"
 #include <Windows.h>
 #include <winioctl.h>
 #include <fileapi.h>
@@ -10,10 +12,13 @@
 #include <cstring>
 #include <vector>
 #include <algorithm>
+#include <utility>
 #include <memory>
 #include <accctrl.h>
 #include <aclapi.h>
 #include <system_error>
+#include <atomic>
+#include <mutex>
 
 #pragma comment(lib, "Shlwapi.lib")
 
@@ -80,48 +85,476 @@ bool CreateDirectoryRecursive(const std::wstring& wpath) {
     return false;
 }
 
-// 递归删除目录
-bool DeleteDirectoryRecursive(const std::wstring& wpath) {
-    // 首先删除目录内容
-    WIN32_FIND_DATAW findData;
-    std::wstring searchPath = wpath + L"\\*";
-    HANDLE hFind = FindFirstFileW(searchPath.c_str(), &findData);
+// 以共享读方式打开文件，超过 MAX_PATH 的路径加长路径前缀
+HANDLE OpenForRead(const std::string& path) {
+    std::wstring wpath = WindowsUtils::UTF8ToWide(path);
+    if (wpath.size() >= MAX_PATH && wpath.substr(0, 4) != L"\\\\?\\") {
+        wpath = L"\\\\?\\" + wpath;
+    }
+    return CreateFileW(wpath.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                       NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+}
+
+// 关闭句柄，保留之前操作设置的错误码
+void CloseKeepingError(HANDLE handle) {
+    DWORD error = GetLastError();
+    CloseHandle(handle);
+    SetLastError(error);
+}
+
+// 单次 ReadFile/WriteFile 的字节数上限（DWORD）
+constexpr size_t kMaxIoChunk = 1u << 30;
+
+// 读满 size 字节或读到文件末尾，处理部分读取；返回读取的字节数，出错时返回 -1
+int64_t ReadFully(HANDLE handle, void* buffer, size_t size) {
+    size_t total = 0;
+    while (total < size) {
+        DWORD bytesRead = 0;
+        DWORD chunk = static_cast<DWORD>(std::min(size - total, kMaxIoChunk));
+        if (!::ReadFile(handle, static_cast<char*>(buffer) + total, chunk, &bytesRead, NULL)) {
+            return -1;
+        }
+        if (bytesRead == 0) {
+            break;
+        }
+        total += bytesRead;
+    }
+    return static_cast<int64_t>(total);
+}
+
+// 写出全部 size 字节，处理部分写入
+bool WriteFully(HANDLE handle, const void* data, size_t size) {
+    size_t total = 0;
+    while (total < size) {
+        DWORD bytesWritten = 0;
+        DWORD chunk = static_cast<DWORD>(std::min(size - total, kMaxIoChunk));
+        if (!::WriteFile(handle, static_cast<const char*>(data) + total, chunk, &bytesWritten, NULL)) {
+            return false;
+        }
+        if (bytesWritten == 0) {
+            SetLastError(ERROR_WRITE_FAULT);
+            return false;
+        }
+        total += bytesWritten;
+    }
+    return true;
+}
+
+// 读取整个文件到 buffer（std::vector<uint8_t> 或 std::string），容量足够时不分配内存
+template<typename Buffer>
+bool ReadWholeFile(const std::string& path, Buffer& buffer) {
+    HANDLE hFile = OpenForRead(path);
+    if (hFile == INVALID_HANDLE_VALUE) {
+        return false;
+    }
     
+    // 多留一个字节：读满说明文件在获取大小之后增长了，继续按块扩展
+    constexpr size_t kMinChunk = 4096;
+    LARGE_INTEGER fileSize;
+    size_t expected = 0;
+    if (GetFileSizeEx(hFile, &fileSize) && fileSize.QuadPart > 0) {
+        expected = static_cast<size_t>(fileSize.QuadPart) + 1;
+    } else {
+        expected = std::max(buffer.capacity(), kMinChunk);
+    }
+    buffer.resize(expected);
+    
+    size_t total = 0;
+    while (true) {
+        int64_t n = ReadFully(hFile, buffer.data() + total, buffer.size() - total);
+        if (n < 0) {
+            CloseKeepingError(hFile);
+            buffer.clear();
+            return false;
+        }
+        total += static_cast<size_t>(n);
+        if (total < buffer.size()) {
+            break;
+        }
+        buffer.resize(std::max(buffer.size() * 2, kMinChunk));
+    }
+    CloseHandle(hFile);
+    buffer.resize(total);
+    return true;
+}
+
+// CopyFileEx 的进度回调，转发给 CopyOptions::progress
+struct CopyProgressContext {
+    const FileSystem::CopyOptions* options;
+    uint64_t totalBytes = 0;
+};
+
+DWORD CALLBACK CopyProgressRoutine(LARGE_INTEGER totalFileSize, LARGE_INTEGER totalBytesTransferred,
+                                   LARGE_INTEGER, LARGE_INTEGER, DWORD, DWORD, HANDLE, HANDLE,
+                                   LPVOID data) {
+    auto* context = static_cast<CopyProgressContext*>(data);
+    context->totalBytes = static_cast<uint64_t>(totalFileSize.QuadPart);
+    if (context->options->progress &&
+        !context->options->progress(static_cast<uint64_t>(totalBytesTransferred.QuadPart),
+                                    context->totalBytes)) {
+        return PROGRESS_CANCEL;    // CopyFileEx 删除不完整的目标文件
+    }
+    return PROGRESS_CONTINUE;
+}
+
+// 目录树操作的共享状态：任务队列、计数和错误列表
+class TreeOperation {
+public:
+    explicit TreeOperation(const FileSystem::TreeOptions& options)
+        : options(options), queue(options.threads) {}
+
+    void AddError(const std::wstring& path, DWORD error) {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        errors.push_back({WindowsUtils::WideToUTF8(path),
+                          std::error_code(static_cast<int>(error), std::system_category())});
+        if (options.stopOnError) {
+            stopped.store(true, std::memory_order_relaxed);
+        }
+    }
+
+    // 汇总结果；有错误时返回 false，GetLastError() 为第一个错误
+    bool Finish(FileSystem::TreeResult* result) {
+        bool success = errors.empty();
+        if (!success) {
+            SetLastError(static_cast<DWORD>(errors.front().error.value()));
+        }
+        if (result) {
+            result->files = files.load();
+            result->directories = directories.load();
+            result->bytes = bytes.load();
+            result->errors = std::move(errors);
+        }
+        return success;
+    }
+
+    const FileSystem::TreeOptions& options;
+    Internal::WorkQueue queue;
+    std::atomic<uint64_t> files{0};
+    std::atomic<uint64_t> directories{0};
+    std::atomic<uint64_t> bytes{0};
+    std::atomic<bool> stopped{false};
+    std::mutex errorMutex;
+    std::vector<FileSystem::TreeError> errors;
+};
+
+// 目录树中的一个目录：它的内容（包括所有子目录）处理完之后才能删除它或设置它的时间
+struct TreeNode {
+    std::wstring source;
+    std::wstring dest;
+    TreeNode* parent = nullptr;
+    std::atomic<size_t> pending{1};     // 自身的扫描 + 尚未完成的子目录
+    std::atomic<bool> failed{false};    // 删除时：有内容没有删除，保留该目录
+    bool created = false;               // 复制时：目标目录已创建，完成后设置时间
+    FILETIME creationTime{};
+    FILETIME lastAccessTime{};
+    FILETIME lastWriteTime{};
+};
+
+// 真正的子目录；指向目录的符号链接和目录联接按链接本身处理，不进入
+bool IsPlainDirectory(const WIN32_FIND_DATAW& findData) {
+    return (findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) &&
+           !(findData.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT);
+}
+
+// 遍历目录项（跳过 "." 和 ".."），使用大缓冲区批量获取，不查询短文件名
+template<typename Visitor>
+bool ForEachDirectoryEntry(const std::wstring& path, Visitor&& visit) {
+    WIN32_FIND_DATAW findData;
+    std::wstring searchPath = path + L"\\*";
+    HANDLE hFind = FindFirstFileExW(searchPath.c_str(), FindExInfoBasic, &findData,
+                                    FindExSearchNameMatch, NULL, FIND_FIRST_EX_LARGE_FETCH);
     if (hFind == INVALID_HANDLE_VALUE) {
         return false;
     }
-    
-    bool success = true;
     do {
-        // 跳过 "." 和 ".."
-        if (wcscmp(findData.cFileName, L".") == 0 || 
-            wcscmp(findData.cFileName, L"..") == 0) {
-            continue;
+        if (wcscmp(findData.cFileName, L".") != 0 && wcscmp(findData.cFileName, L"..") != 0) {
+            visit(findData);
         }
-        
-        std::wstring fullPath = wpath + L"\\" + findData.cFileName;
-        
-        if (findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
-            // 递归删除子目录
-            if (!DeleteDirectoryRecursive(fullPath)) {
-                success = false;
+    } while (FindNextFileW(hFind, &findData) != 0);
+    FindClose(hFind);
+    return true;
+}
+
+// 删除文件或指向目录的链接，只读属性会阻止删除，先清除
+bool DeleteTreeEntry(const std::wstring& path, const WIN32_FIND_DATAW& findData) {
+    bool isDirectoryLink = (findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
+    auto remove = [&] {
+        return isDirectoryLink ? RemoveDirectoryW(path.c_str()) != 0 : DeleteFileW(path.c_str()) != 0;
+    };
+    if (remove()) {
+        return true;
+    }
+    if (GetLastError() == ERROR_ACCESS_DENIED && (findData.dwFileAttributes & FILE_ATTRIBUTE_READONLY) &&
+        SetFileAttributesW(path.c_str(), findData.dwFileAttributes & ~FILE_ATTRIBUTE_READONLY)) {
+        return remove();
+    }
+    return false;
+}
+
+// 完成目录的一项工作；最后一项完成时删除该目录，再向上通知父目录
+void FinishDeleteNode(TreeOperation& op, TreeNode* node) {
+    while (node && node->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        TreeNode* parent = node->parent;
+        bool failed = node->failed.load(std::memory_order_relaxed);
+        if (!failed) {
+            if (RemoveDirectoryW(node->source.c_str())) {
+                op.directories.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                op.AddError(node->source, GetLastError());
+                failed = true;
             }
-        } else {
-            // 删除文件
-            if (!DeleteFileW(fullPath.c_str())) {
-                success = false;
+        }
+        if (failed && parent) {
+            parent->failed.store(true, std::memory_order_relaxed);
+        }
+        delete node;
+        node = parent;
+    }
+}
+
+void DeleteTreeNode(TreeOperation& op, TreeNode* node) {
+    if (op.stopped.load(std::memory_order_relaxed)) {
+        node->failed.store(true, std::memory_order_relaxed);
+        FinishDeleteNode(op, node);
+        return;
+    }
+    bool listed = ForEachDirectoryEntry(node->source, [&](const WIN32_FIND_DATAW& findData) {
+        std::wstring path = node->source + L"\\" + findData.cFileName;
+        if (IsPlainDirectory(findData)) {
+            auto* child = new TreeNode;
+            child->source = std::move(path);
+            child->parent = node;
+            node->pending.fetch_add(1, std::memory_order_relaxed);
+            op.queue.push([&op, child] { DeleteTreeNode(op, child); });
+        } else if (DeleteTreeEntry(path, findData)) {
+            op.files.fetch_add(1, std::memory_order_relaxed);
+        } else if (GetLastError() != ERROR_FILE_NOT_FOUND) {
+            op.AddError(path, GetLastError());
+            node->failed.store(true, std::memory_order_relaxed);
+        }
+    });
+    if (!listed) {
+        op.AddError(node->source, GetLastError());
+        node->failed.store(true, std::memory_order_relaxed);
+    }
+    FinishDeleteNode(op, node);
+}
+
+// 完成目录的一项工作；最后一项完成时设置目标目录的时间（此后不再向其中写入），再向上通知父目录
+void FinishCopyNode(TreeOperation& op, TreeNode* node) {
+    while (node && node->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        if (node->created && op.options.copyMetadata) {
+            HANDLE hDir = CreateFileW(node->dest.c_str(), FILE_WRITE_ATTRIBUTES,
+                                      FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL,
+                                      OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS, NULL);
+            if (hDir == INVALID_HANDLE_VALUE ||
+                !SetFileTime(hDir, &node->creationTime, &node->lastAccessTime, &node->lastWriteTime)) {
+                op.AddError(node->dest, GetLastError());
+            }
+            if (hDir != INVALID_HANDLE_VALUE) {
+                CloseHandle(hDir);
             }
         }
-    } while (FindNextFileW(hFind, &findData) != 0);
+        TreeNode* parent = node->parent;
+        delete node;
+        node = parent;
+    }
+}
+
+void CopyTreeNode(TreeOperation& op, TreeNode* node) {
+    if (op.stopped.load(std::memory_order_relaxed)) {
+        FinishCopyNode(op, node);
+        return;
+    }
     
-    FindClose(hFind);
+    // CreateDirectoryEx 同时复制源目录的属性
+    if (!CreateDirectoryExW(node->source.c_str(), node->dest.c_str(), NULL)) {
+        DWORD error = GetLastError();
+        DWORD attributes = GetFileAttributesW(node->dest.c_str());
+        if (error != ERROR_ALREADY_EXISTS || attributes == INVALID_FILE_ATTRIBUTES ||
+            !(attributes & FILE_ATTRIBUTE_DIRECTORY)) {
+            op.AddError(node->dest, error == ERROR_ALREADY_EXISTS ? ERROR_DIRECTORY : error);
+            FinishCopyNode(op, node);
+            return;
+        }
+    }
+    node->created = true;
+    op.directories.fetch_add(1, std::memory_order_relaxed);
+    
+    // CopyFileEx 复制文件的属性和时间戳，符号链接复制为链接本身
+    DWORD copyFlags = COPY_FILE_COPY_SYMLINK | (op.options.overwrite ? 0 : COPY_FILE_FAIL_IF_EXISTS);
+    bool listed = ForEachDirectoryEntry(node->source, [&](const WIN32_FIND_DATAW& findData) {
+        std::wstring source = node->source + L"\\" + findData.cFileName;
+        std::wstring dest = node->dest + L"\\" + findData.cFileName;
+        if (IsPlainDirectory(findData)) {
+            auto* child = new TreeNode;
+            child->source = std::move(source);
+            child->dest = std::move(dest);
+            child->parent = node;
+            child->creationTime = findData.ftCreationTime;
+            child->lastAccessTime = findData.ftLastAccessTime;
+            child->lastWriteTime = findData.ftLastWriteTime;
+            node->pending.fetch_add(1, std::memory_order_relaxed);
+            op.queue.push([&op, child] { CopyTreeNode(op, child); });
+        } else if (CopyFileExW(source.c_str(), dest.c_str(), NULL, NULL, NULL, copyFlags)) {
+            op.files.fetch_add(1, std::memory_order_relaxed);
+            op.bytes.fetch_add((static_cast<uint64_t>(findData.nFileSizeHigh) << 32) | findData.nFileSizeLow,
+                               std::memory_order_relaxed);
+        } else {
+            op.AddError(source, GetLastError());
+        }
+    });
+    if (!listed) {
+        op.AddError(node->source, GetLastError());
+    }
+    FinishCopyNode(op, node);
+}
+
+// 完整路径 path 位于目录 directory 之内或就是该目录（不区分大小写）
+bool IsInsideDirectory(const std::wstring& directory, const std::wstring& path) {
+    wchar_t root[MAX_PATH];
+    wchar_t full[MAX_PATH];
+    DWORD rootLength = GetFullPathNameW(directory.c_str(), MAX_PATH, root, NULL);
+    DWORD fullLength = GetFullPathNameW(path.c_str(), MAX_PATH, full, NULL);
+    if (rootLength == 0 || rootLength >= MAX_PATH || fullLength == 0 || fullLength >= MAX_PATH) {
+        return false;
+    }
+    while (rootLength > 3 && (root[rootLength - 1] == L'\\' || root[rootLength - 1] == L'/')) {
+        root[--rootLength] = L'\0';
+    }
+    return fullLength >= rootLength && _wcsnicmp(root, full, rootLength) == 0 &&
+           (fullLength == rootLength || full[rootLength] == L'\\' || full[rootLength] == L'/');
+}
+
+// 由查找结果得到文件类型：重解析点（符号链接、目录联接）按符号链接处理，不进入
+FileSystem::FileType FindDataFileType(const WIN32_FIND_DATAW& findData) {
+    if (findData.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT) {
+        return FileSystem::FileType::Symlink;
+    }
+    if (findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+        return FileSystem::FileType::Directory;
+    }
+    return FileSystem::FileType::Regular;
+}
+
+// 项是否通过 WalkOptions 中的类型和文件名过滤
+bool WalkFilterMatches(const FileSystem::WalkOptions& options, FileSystem::FileType type, std::string_view name) {
+    switch (type) {
+        case FileSystem::FileType::Regular: if (!options.files) return false; break;
+        case FileSystem::FileType::Directory: if (!options.directories) return false; break;
+        case FileSystem::FileType::Symlink: if (!options.symlinks) return false; break;
+        default: if (!options.others) return false; break;
+    }
+    return options.pattern.empty() || StringUtils::matchGlob(options.pattern, name);
+}
+
+// 去掉末尾多余的路径分隔符（"C:\\" 这样的根目录保留）
+std::string TrimTrailingSeparators(const std::string& path) {
+    size_t end = path.find_last_not_of("\\/");
+    if (end == std::string::npos) {
+        return path.substr(0, 1);
+    }
+    if (path[end] == ':' && end + 1 < path.size()) {
+        ++end;
+    }
+    return path.substr(0, end + 1);
+}
+
+// 在目录中开始查找，使用大缓冲区批量获取，不查询短文件名
+HANDLE FindFirstInDirectory(const std::string& path, WIN32_FIND_DATAW& findData) {
+    std::wstring searchPath = WindowsUtils::UTF8ToWide(path);
+    if (searchPath.empty() || (searchPath.back() != L'\\' && searchPath.back() != L'/')) {
+        searchPath += L'\\';
+    }
+    searchPath += L'*';
+    return FindFirstFileExW(searchPath.c_str(), FindExInfoBasic, &findData,
+                            FindExSearchNameMatch, NULL, FIND_FIRST_EX_LARGE_FETCH);
+}
+
+// 多线程遍历：每个任务是一个目录，子目录作为新任务加入当前线程的队列
+struct WalkTask {
+    std::string path;
+    int depth = 0;
+};
+
+// ===== 文件元数据 =====
+
+// 批量获取元数据时每个任务处理的路径数
+constexpr size_t kStatBatchChunk = 64;
+
+// 失败时返回 false，原因见 GetLastError()
+// 属性、大小和时间来自 GetFileAttributesExW；链接数、文件索引和元数据修改时间需要打开文件，只在请求时获取
+bool StatFileInfo(const std::string& path, uint32_t fields, FileSystem::FileInfo& info) {
+    info = FileSystem::FileInfo();
+    std::wstring wpath = WindowsUtils::UTF8ToWide(path);
+    WIN32_FILE_ATTRIBUTE_DATA data;
+    if (!GetFileAttributesExW(wpath.c_str(), GetFileExInfoStandard, &data)) {
+        return false;
+    }
     
-    // 最后删除空目录
-    if (success) {
-        success = RemoveDirectoryW(wpath.c_str()) != 0;
+    if (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+        info.type = FileSystem::FileType::Directory;
+    } else if (data.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT) {
+        info.type = FileSystem::FileType::Other;
+        if (fields & FileSystem::InfoType) {
+            WIN32_FIND_DATAW findData;
+            HANDLE hFind = FindFirstFileW(wpath.c_str(), &findData);
+            if (hFind != INVALID_HANDLE_VALUE) {
+                FindClose(hFind);
+                if (findData.dwReserved0 == IO_REPARSE_TAG_SYMLINK) {
+                    info.type = FileSystem::FileType::Symlink;
+                }
+            }
+        }
+    } else {
+        info.type = FileSystem::FileType::Regular;
+    }
+    info.size = (static_cast<uint64_t>(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+    info.accessTime = FileTimeToTimePoint(data.ftLastAccessTime);
+    info.modificationTime = FileTimeToTimePoint(data.ftLastWriteTime);
+    info.creationTime = FileTimeToTimePoint(data.ftCreationTime);
+    
+    // 与 GetPermissions 相同
+    if (fields & FileSystem::InfoPermissions) {
+        info.permissions = static_cast<int>(FileSystem::Permissions::OWNER_READ);
+        if (!(data.dwFileAttributes & FILE_ATTRIBUTE_READONLY)) {
+            info.permissions |= static_cast<int>(FileSystem::Permissions::OWNER_WRITE);
+        }
+        std::string ext = FileSystem::GetFileExtension(path);
+        if (ext == "exe" || ext == "bat" || ext == "cmd" || ext == "com" ||
+            ext == "ps1" || ext == "vbs" || ext == "js") {
+            info.permissions |= static_cast<int>(FileSystem::Permissions::OWNER_EXEC);
+        }
     }
     
-    return success;
+    uint32_t available = fields & ~static_cast<uint32_t>(FileSystem::InfoOwner | FileSystem::InfoLinks |
+                                                         FileSystem::InfoInode | FileSystem::InfoChangeTime);
+    if (fields & (FileSystem::InfoLinks | FileSystem::InfoInode | FileSystem::InfoChangeTime)) {
+        // 打不开（如被独占）时不报告这些字段，其余字段仍然有效
+        HANDLE hFile = CreateFileW(wpath.c_str(), FILE_READ_ATTRIBUTES,
+                                   FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL, OPEN_EXISTING,
+                                   FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OPEN_REPARSE_POINT, NULL);
+        if (hFile != INVALID_HANDLE_VALUE) {
+            BY_HANDLE_FILE_INFORMATION handleInfo;
+            if (GetFileInformationByHandle(hFile, &handleInfo)) {
+                info.links = handleInfo.nNumberOfLinks;
+                info.device = handleInfo.dwVolumeSerialNumber;
+                info.inode = (static_cast<uint64_t>(handleInfo.nFileIndexHigh) << 32) | handleInfo.nFileIndexLow;
+                available |= fields & (FileSystem::InfoLinks | FileSystem::InfoInode);
+            }
+            FILE_BASIC_INFO basicInfo;
+            if (GetFileInformationByHandleEx(hFile, FileBasicInfo, &basicInfo, sizeof(basicInfo))) {
+                FILETIME changeTime;
+                changeTime.dwLowDateTime = basicInfo.ChangeTime.LowPart;
+                changeTime.dwHighDateTime = static_cast<DWORD>(basicInfo.ChangeTime.HighPart);
+                info.changeTime = FileTimeToTimePoint(changeTime);
+                available |= fields & FileSystem::InfoChangeTime;
+            }
+            CloseHandle(hFile);
+        }
+    }
+    info.fields = available;
+    return true;
 }
 
 } // 匿名命名空间
@@ -225,6 +658,44 @@ bool FileSystem::SetModificationTime(const std::string& path,
     return success;
 }
 
+bool FileSystem::GetFileInfo(const std::string& path, FileInfo& info, uint32_t fields) {
+    return StatFileInfo(path, fields, info);
+}
+
+bool FileSystem::GetFileInfos(std::span<const std::string> paths, std::vector<FileInfo>& infos,
+                              uint32_t fields, unsigned threads, std::vector<std::error_code>* errors) {
+    infos.assign(paths.size(), FileInfo());
+    if (errors) {
+        errors->assign(paths.size(), std::error_code());
+    }
+    
+    // 每个任务写入不同的元素，不需要加锁
+    std::atomic<bool> success{true};
+    auto statRange = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            if (!StatFileInfo(paths[i], fields, infos[i])) {
+                success.store(false, std::memory_order_relaxed);
+                if (errors) {
+                    (*errors)[i] = std::error_code(static_cast<int>(GetLastError()), std::system_category());
+                }
+            }
+        }
+    };
+    
+    if (threads == 1 || paths.size() <= kStatBatchChunk) {
+        statRange(0, paths.size());
+        return success.load(std::memory_order_relaxed);
+    }
+    
+    Internal::WorkQueue queue(threads);
+    for (size_t begin = 0; begin < paths.size(); begin += kStatBatchChunk) {
+        size_t end = std::min(begin + kStatBatchChunk, paths.size());
+        queue.push([&statRange, begin, end] { statRange(begin, end); });
+    }
+    queue.run();
+    return success.load(std::memory_order_relaxed);
+}
+
 std::vector<uint8_t> FileSystem::ReadFile(const std::string& path) {
     // 转换路径为宽字符串
     std::wstring wpath = WindowsUtils::UTF8ToWide(path);
@@ -301,7 +772,22 @@ std::vector<uint8_t> FileSystem::ReadFile(const std::string& path) {
     return buffer;
 }
 
-bool FileSystem::WriteFile(const std::string& path, const std::vector<uint8_t>& data) {
+bool FileSystem::ReadFile(const std::string& path, std::vector<uint8_t>& buffer) {
+    return ReadWholeFile(path, buffer);
+}
+
+int64_t FileSystem::ReadFile(const std::string& path, std::span<uint8_t> buffer) {
+    HANDLE hFile = OpenForRead(path);
+    if (hFile == INVALID_HANDLE_VALUE) {
+        return -1;
+    }
+    
+    int64_t bytesRead = ReadFully(hFile, buffer.data(), buffer.size());
+    CloseKeepingError(hFile);
+    return bytesRead;
+}
+
+bool FileSystem::WriteFile(const std::string& path, std::span<const uint8_t> data) {
     std::wstring wpath = WindowsUtils::UTF8ToWide(path);
     HANDLE hFile = CreateFileW(wpath.c_str(), GENERIC_WRITE, 0, 
                               NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
@@ -310,14 +796,12 @@ bool FileSystem::WriteFile(const std::string& path, const std::vector<uint8_t>&
         return false;
     }
     
-    DWORD bytesWritten = 0;
-    bool success = ::WriteFile(hFile, data.data(), static_cast<DWORD>(data.size()), &bytesWritten, NULL) != 0;
-    CloseHandle(hFile);
-    
-    return success && (bytesWritten == data.size());
+    bool success = WriteFully(hFile, data.data(), data.size());
+    CloseKeepingError(hFile);
+    return success;
 }
 
-bool FileSystem::AppendFile(const std::string& path, const std::vector<uint8_t>& data) {
+bool FileSystem::AppendFile(const std::string& path, std::span<const uint8_t> data) {
     std::wstring wpath = WindowsUtils::UTF8ToWide(path);
     HANDLE hFile = CreateFileW(wpath.c_str(), FILE_APPEND_DATA, 
                               FILE_SHARE_READ | FILE_SHARE_WRITE, 
@@ -327,21 +811,25 @@ bool FileSystem::AppendFile(const std::string& path, const std::vector<uint8_t>&
         return false;
     }
     
-    DWORD bytesWritten = 0;
-    bool success = ::WriteFile(hFile, data.data(), static_cast<DWORD>(data.size()), &bytesWritten, NULL) != 0;
-    CloseHandle(hFile);
-    
-    return success && (bytesWritten == data.size());
+    bool success = WriteFully(hFile, data.data(), data.size());
+    CloseKeepingError(hFile);
+    return success;
 }
 
 std::string FileSystem::ReadTextFile(const std::string& path) {
-    auto data = ReadFile(path);
-    return std::string(data.begin(), data.end());
+    std::string content;
+    if (!ReadTextFile(path, content)) {
+        return "";
+    }
+    return content;
+}
+
+bool FileSystem::ReadTextFile(const std::string& path, std::string& content) {
+    return ReadWholeFile(path, content);
 }
 
-bool FileSystem::WriteTextFile(const std::string& path, const std::string& content) {
-    std::vector<uint8_t> data(content.begin(), content.end());
-    return WriteFile(path, data);
+bool FileSystem::WriteTextFile(const std::string& path, std::string_view content) {
+    return WriteFile(path, std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(content.data()), content.size()));
 }
 
 bool FileSystem::RemoveFile(const std::string& path) {
@@ -350,9 +838,28 @@ bool FileSystem::RemoveFile(const std::string& path) {
 }
 
 bool FileSystem::DuplicateFile(const std::string& from, const std::string& to, bool overwrite) {
+    CopyOptions options;
+    options.overwrite = overwrite;
+    return DuplicateFile(from, to, options);
+}
+
+bool FileSystem::DuplicateFile(const std::string& from, const std::string& to,
+                               const CopyOptions& options, CopyResult* result) {
+    // CopyFileEx 自行选择复制方式（ReFS 上克隆数据块），并总是复制属性和时间戳；
+    // allowReflink、allowKernelCopy 和 preserveSparse 在 Windows 上不起作用
     std::wstring wfrom = WindowsUtils::UTF8ToWide(from);
     std::wstring wto = WindowsUtils::UTF8ToWide(to);
-    return CopyFileW(wfrom.c_str(), wto.c_str(), overwrite ? FALSE : TRUE) != 0;
+    CopyProgressContext context{&options};
+    DWORD flags = options.overwrite ? 0 : COPY_FILE_FAIL_IF_EXISTS;
+    if (!CopyFileExW(wfrom.c_str(), wto.c_str(), CopyProgressRoutine, &context, NULL, flags)) {
+        return false;
+    }
+    if (result) {
+        result->method = context.totalBytes > 0 ? CopyMethod::System : CopyMethod::None;
+        result->bytesCopied = context.totalBytes;
+        result->totalBytes = context.totalBytes;
+    }
+    return true;
 }
 
 bool FileSystem::RelocateFile(const std::string& from, const std::string& to) {
@@ -379,37 +886,316 @@ bool FileSystem::DeleteDirectory(const std::string& path) {
 }
 
 bool FileSystem::DeleteDirectoriesRecursive(const std::string& path) {
+    // DeleteTree 也会删除单个文件，这里只接受目录
     std::wstring wpath = WindowsUtils::UTF8ToWide(path);
-    return DeleteDirectoryRecursive(wpath);
+    WIN32_FIND_DATAW findData{};
+    findData.dwFileAttributes = GetFileAttributesW(wpath.c_str());
+    if (findData.dwFileAttributes == INVALID_FILE_ATTRIBUTES) {
+        return false;
+    }
+    if (!IsPlainDirectory(findData)) {
+        SetLastError(ERROR_DIRECTORY);
+        return false;
+    }
+    TreeOptions options;
+    options.threads = 1;
+    return DeleteTree(path, options);
 }
 
-bool FileSystem::ListDirectory(const std::string& path, std::vector<std::string>& entries) {
-    std::wstring wpath = WindowsUtils::UTF8ToWide(path);
-    std::wstring searchPath = wpath + L"\\*";
+bool FileSystem::CopyTree(const std::string& from, const std::string& to,
+                          const TreeOptions& options, TreeResult* result) {
+    if (result) {
+        *result = TreeResult();
+    }
+    std::wstring wfrom = WindowsUtils::UTF8ToWide(from);
+    std::wstring wto = WindowsUtils::UTF8ToWide(to);
+    WIN32_FILE_ATTRIBUTE_DATA data;
+    if (!GetFileAttributesExW(wfrom.c_str(), GetFileExInfoStandard, &data)) {
+        return false;
+    }
+    if (!(data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)) {
+        SetLastError(ERROR_DIRECTORY);
+        return false;
+    }
+    if (IsInsideDirectory(wfrom, wto)) {
+        SetLastError(ERROR_INVALID_PARAMETER);
+        return false;
+    }
     
-    WIN32_FIND_DATAW findData;
-    HANDLE hFind = FindFirstFileW(searchPath.c_str(), &findData);
+    TreeOperation op(options);
+    auto* root = new TreeNode;
+    root->source = wfrom;
+    root->dest = wto;
+    root->creationTime = data.ftCreationTime;
+    root->lastAccessTime = data.ftLastAccessTime;
+    root->lastWriteTime = data.ftLastWriteTime;
+    op.queue.push([&op, root] { CopyTreeNode(op, root); });
+    op.queue.run();
+    return op.Finish(result);
+}
+
+bool FileSystem::CopyTree(const std::string& from, const std::string& to) {
+    return CopyTree(from, to, TreeOptions());
+}
+
+bool FileSystem::DeleteTree(const std::string& path, const TreeOptions& options, TreeResult* result) {
+    if (result) {
+        *result = TreeResult();
+    }
+    std::wstring wpath = WindowsUtils::UTF8ToWide(path);
+    WIN32_FIND_DATAW findData{};
+    findData.dwFileAttributes = GetFileAttributesW(wpath.c_str());
+    if (findData.dwFileAttributes == INVALID_FILE_ATTRIBUTES) {
+        return false;
+    }
+    if (!IsPlainDirectory(findData)) {
+        if (!DeleteTreeEntry(wpath, findData)) {
+            return false;
+        }
+        if (result) {
+            result->files = 1;
+        }
+        return true;
+    }
     
-    if (hFind == INVALID_HANDLE_VALUE) {
+    TreeOperation op(options);
+    auto* root = new TreeNode;
+    root->source = wpath;
+    op.queue.push([&op, root] { DeleteTreeNode(op, root); });
+    op.queue.run();
+    return op.Finish(result);
+}
+
+// ===== 目录遍历 =====
+
+struct FileSystem::Walker::State {
+    // 一层正在读取的目录；data 中是下一项（FindFirstFileEx 已经返回了第一项）
+    struct Frame {
+        HANDLE find = INVALID_HANDLE_VALUE;
+        WIN32_FIND_DATAW data;
+        bool hasData = false;
+        DWORD error = ERROR_NO_MORE_FILES;  // FindNextFile 失败的原因
+        size_t pathLength = 0;      // 该目录在 path 中的长度
+        int depth = 0;              // root 为 0
+    };
+
+    WalkOptions options;
+    std::string path;
+    std::vector<std::unique_ptr<Frame>> frames;
+    std::vector<TreeError> errors;
+    bool pendingDescend = false;                    // 上一次返回的目录，下一次 Next 时进入
+    int pendingDepth = 0;
+
+    ~State() {
+        for (const auto& frame : frames) {
+            FindClose(frame->find);
+        }
+    }
+
+    void AddError(const std::string& errorPath, DWORD error) {
+        errors.push_back({errorPath, std::error_code(static_cast<int>(error), std::system_category())});
+    }
+
+    // 进入 path 所指的目录
+    void Enter(int depth) {
+        auto frame = std::make_unique<Frame>();
+        frame->find = FindFirstInDirectory(path, frame->data);
+        if (frame->find == INVALID_HANDLE_VALUE) {
+            AddError(path, GetLastError());
+            return;
+        }
+        frame->hasData = true;
+        frame->pathLength = path.size();
+        frame->depth = depth;
+        frames.push_back(std::move(frame));
+    }
+
+    bool Next(WalkEntry& entry) {
+        if (pendingDescend) {
+            pendingDescend = false;
+            Enter(pendingDepth);
+        }
+        while (!frames.empty()) {
+            Frame& frame = *frames.back();
+            if (!frame.hasData) {
+                if (frame.error != ERROR_NO_MORE_FILES) {
+                    AddError(path.substr(0, frame.pathLength), frame.error);
+                }
+                FindClose(frame.find);
+                frames.pop_back();
+                continue;
+            }
+            const WIN32_FIND_DATAW& data = frame.data;
+            const bool isDot = wcscmp(data.cFileName, L".") == 0 || wcscmp(data.cFileName, L"..") == 0;
+            const FileType type = FindDataFileType(data);
+            std::string name = isDot ? std::string() : WindowsUtils::WideToUTF8(data.cFileName);
+            frame.hasData = FindNextFileW(frame.find, &frame.data) != 0;
+            if (!frame.hasData) {
+                frame.error = GetLastError();
+            }
+            if (isDot) {
+                continue;
+            }
+            
+            path.resize(frame.pathLength);
+            if (path.back() != '\\' && path.back() != '/') {
+                path += '\\';
+            }
+            path += name;
+            const int depth = frame.depth + 1;
+            const bool descend = type == FileType::Directory && (options.maxDepth < 0 || depth < options.maxDepth);
+            
+            if (WalkFilterMatches(options, type, name)) {
+                entry.path = path;
+                entry.name = std::string_view(path).substr(path.size() - name.size());
+                entry.type = type;
+                entry.depth = depth;
+                pendingDescend = descend;
+                pendingDepth = depth;
+                return true;
+            }
+            if (descend) {
+                Enter(depth);
+            }
+        }
         return false;
     }
+};
+
+FileSystem::Walker::Walker(const std::string& root) : Walker(root, WalkOptions()) {}
+
+FileSystem::Walker::Walker(const std::string& root, const WalkOptions& options)
+    : state(std::make_unique<State>()) {
+    state->options = options;
+    state->path = TrimTrailingSeparators(root);
+    if (options.maxDepth != 0) {
+        state->Enter(0);
+    }
+}
+
+FileSystem::Walker::~Walker() = default;
+FileSystem::Walker::Walker(Walker&& other) noexcept = default;
+FileSystem::Walker& FileSystem::Walker::operator=(Walker&& other) noexcept = default;
+
+bool FileSystem::Walker::Next(WalkEntry& entry) {
+    return state && state->Next(entry);
+}
+
+void FileSystem::Walker::SkipSubtree() {
+    if (state) {
+        state->pendingDescend = false;
+    }
+}
+
+const std::vector<FileSystem::TreeError>& FileSystem::Walker::Errors() const {
+    static const std::vector<TreeError> kNoErrors;
+    return state ? state->errors : kNoErrors;
+}
+
+bool FileSystem::Walk(const std::string& root, const WalkOptions& options, const WalkVisitor& visitor,
+                      std::vector<TreeError>* errors) {
+    if (options.threads == 1) {
+        Walker walker(root, options);
+        WalkEntry entry;
+        while (walker.Next(entry)) {
+            WalkAction action = visitor(entry);
+            if (action == WalkAction::Stop) {
+                break;
+            }
+            if (action == WalkAction::SkipSubtree) {
+                walker.SkipSubtree();
+            }
+        }
+        if (errors) {
+            *errors = walker.Errors();
+        }
+        return walker.Errors().empty();
+    }
     
-    entries.clear();
-    do {
-        // 跳过 "." 和 ".."
-        if (wcscmp(findData.cFileName, L".") == 0 || 
-            wcscmp(findData.cFileName, L"..") == 0) {
-            continue;
+    Internal::WorkStealingPool<WalkTask> pool(options.threads);
+    std::vector<std::string> paths(pool.threadCount());
+    std::mutex errorMutex;
+    std::vector<TreeError> walkErrors;
+    auto addError = [&](const std::string& path, DWORD error) {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        walkErrors.push_back({path, std::error_code(static_cast<int>(error), std::system_category())});
+    };
+    
+    pool.push(0, WalkTask{TrimTrailingSeparators(root), 0});
+    if (options.maxDepth == 0) {
+        pool.stop();
+    }
+    pool.run([&](unsigned worker, WalkTask& task) {
+        WIN32_FIND_DATAW data;
+        HANDLE hFind = FindFirstInDirectory(task.path, data);
+        if (hFind == INVALID_HANDLE_VALUE) {
+            addError(task.path, GetLastError());
+            return;
         }
+        std::string& path = paths[worker];
+        const int depth = task.depth + 1;
         
-        entries.push_back(WindowsUtils::WideToUTF8(findData.cFileName));
-    } while (FindNextFileW(hFind, &findData) != 0);
+        do {
+            if (wcscmp(data.cFileName, L".") == 0 || wcscmp(data.cFileName, L"..") == 0) {
+                continue;
+            }
+            std::string name = WindowsUtils::WideToUTF8(data.cFileName);
+            path.assign(task.path);
+            if (path.back() != '\\' && path.back() != '/') {
+                path += '\\';
+            }
+            path += name;
+            const FileType type = FindDataFileType(data);
+            bool descend = type == FileType::Directory && (options.maxDepth < 0 || depth < options.maxDepth);
+            
+            if (WalkFilterMatches(options, type, name)) {
+                WalkEntry entry;
+                entry.path = path;
+                entry.name = std::string_view(path).substr(path.size() - name.size());
+                entry.type = type;
+                entry.depth = depth;
+                WalkAction action = visitor(entry);
+                if (action == WalkAction::Stop) {
+                    pool.stop();
+                    break;
+                }
+                if (action == WalkAction::SkipSubtree) {
+                    descend = false;
+                }
+            }
+            if (descend) {
+                pool.push(worker, WalkTask{path, depth});
+            }
+        } while (!pool.stopped() && FindNextFileW(hFind, &data) != 0);
+        
+        DWORD error = GetLastError();
+        if (!pool.stopped() && error != ERROR_NO_MORE_FILES) {
+            addError(task.path, error);
+        }
+        FindClose(hFind);
+    });
     
-    FindClose(hFind);
-    return true;
+    bool success = walkErrors.empty();
+    if (errors) {
+        *errors = std::move(walkErrors);
+    }
+    return success;
 }
 
-bool FileSystem::ListDirectoryRecursive(const std::string& path, std::vector<std::string>& entries) {
+void FileSystem::DirectoryEntry::LoadStatus() const {
+    if (statusLoaded) {
+        return;
+    }
+    statusLoaded = true;
+    WIN32_FILE_ATTRIBUTE_DATA data;
+    std::wstring wpath = WindowsUtils::UTF8ToWide(path);
+    if (GetFileAttributesExW(wpath.c_str(), GetFileExInfoStandard, &data)) {
+        size = (static_cast<uint64_t>(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+        modificationTime = FileTimeToTimePoint(data.ftLastWriteTime);
+    }
+}
+
+bool FileSystem::ListDirectory(const std::string& path, std::vector<std::string>& entries) {
     std::wstring wpath = WindowsUtils::UTF8ToWide(path);
     std::wstring searchPath = wpath + L"\\*";
     
@@ -420,6 +1206,7 @@ bool FileSystem::ListDirectoryRecursive(const std::string& path, std::vector<std
         return false;
     }
     
+    entries.clear();
     do {
         // 跳过 "." 和 ".."
         if (wcscmp(findData.cFileName, L".") == 0 || 
@@ -427,23 +1214,24 @@ bool FileSystem::ListDirectoryRecursive(const std::string& path, std::vector<std
             continue;
         }
         
-        std::wstring fullPath = wpath + L"\\" + findData.cFileName;
-        std::string utf8Path = WindowsUtils::WideToUTF8(fullPath);
-        entries.push_back(utf8Path);
-        
-        if (findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
-            // 递归处理子目录
-            std::vector<std::string> subEntries;
-            if (ListDirectoryRecursive(utf8Path, subEntries)) {
-                entries.insert(entries.end(), subEntries.begin(), subEntries.end());
-            }
-        }
+        entries.push_back(WindowsUtils::WideToUTF8(findData.cFileName));
     } while (FindNextFileW(hFind, &findData) != 0);
     
     FindClose(hFind);
     return true;
 }
 
+bool FileSystem::ListDirectoryRecursive(const std::string& path, std::vector<std::string>& entries) {
+    Walker walker(path);
+    WalkEntry entry;
+    while (walker.Next(entry)) {
+        entries.emplace_back(entry.path);
+    }
+    // 与之前一致：只有根目录无法打开时失败，跳过无法读取的子目录
+    const std::vector<TreeError>& errors = walker.Errors();
+    return errors.empty() || errors.front().path != TrimTrailingSeparators(path);
+}
+
 // ===== 符号链接操作 =====
 
 bool FileSystem::CreateSymlink(const std::string& target, const std::string& linkPath) {
@@ -808,4 +1596,163 @@ bool FileSystem::RemovePermissions(const std::string& path, int permissions) {
     return SetPermissions(path, current & ~permissions);
 }
 
+// ===== 内存映射文件 =====
+
+FileSystem::MappedFile::MappedFile(const std::string& path) {
+    Open(path, MapOptions());
+}
+
+FileSystem::MappedFile::MappedFile(const std::string& path, const MapOptions& options) {
+    Open(path, options);
+}
+
+FileSystem::MappedFile::~MappedFile() {
+    Close();
+}
+
+FileSystem::MappedFile::MappedFile(MappedFile&& other) noexcept {
+    *this = std::move(other);
+}
+
+FileSystem::MappedFile& FileSystem::MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        Close();
+        data = std::exchange(other.data, nullptr);
+        mappedSize = std::exchange(other.mappedSize, 0);
+        mappedLength = std::exchange(other.mappedLength, 0);
+        mapMode = other.mapMode;
+        isOpen = std::exchange(other.isOpen, false);
+        hugePages = std::exchange(other.hugePages, false);
+        fileHandle = std::exchange(other.fileHandle, nullptr);
+        mappingHandle = std::exchange(other.mappingHandle, nullptr);
+    }
+    return *this;
+}
+
+bool FileSystem::MappedFile::Open(const std::string& path) {
+    return Open(path, MapOptions());
+}
+
+bool FileSystem::MappedFile::Open(const std::string& path, const MapOptions& options) {
+    Close();
+
+    // 大页只能用于页面文件支持的映射，文件映射忽略 hugePages 选项
+    const bool writable = options.mode == MapMode::ReadWrite;
+    std::wstring wpath = WindowsUtils::UTF8ToWide(path);
+    HANDLE hFile = CreateFileW(wpath.c_str(), writable ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ,
+                               FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL,
+                               writable ? OPEN_ALWAYS : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (hFile == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(hFile, &fileSize)) {
+        const DWORD error = GetLastError();
+        CloseHandle(hFile);
+        SetLastError(error);
+        return false;
+    }
+    uint64_t size = static_cast<uint64_t>(fileSize.QuadPart);
+    if (writable && options.size > size) {
+        // 按更大的大小创建映射时文件随之扩展
+        size = options.size;
+    }
+    if (size > SIZE_MAX) {
+        CloseHandle(hFile);
+        SetLastError(ERROR_FILE_TOO_LARGE);
+        return false;
+    }
+
+    mapMode = options.mode;
+    mappedSize = static_cast<size_t>(size);
+    mappedLength = mappedSize;
+    if (mappedSize == 0) {
+        // 不能为空文件创建映射，直接视为已打开
+        CloseHandle(hFile);
+        isOpen = true;
+        return true;
+    }
+
+    DWORD protect = PAGE_READONLY;
+    DWORD access = FILE_MAP_READ;
+    if (options.mode == MapMode::ReadWrite) {
+        protect = PAGE_READWRITE;
+        access = FILE_MAP_WRITE;
+    } else if (options.mode == MapMode::CopyOnWrite) {
+        protect = PAGE_WRITECOPY;
+        access = FILE_MAP_COPY;
+    }
+    HANDLE hMapping = CreateFileMappingW(hFile, NULL, protect,
+                                         static_cast<DWORD>(size >> 32), static_cast<DWORD>(size), NULL);
+    if (!hMapping) {
+        const DWORD error = GetLastError();
+        CloseHandle(hFile);
+        SetLastError(error);
+        return false;
+    }
+    void* view = MapViewOfFile(hMapping, access, 0, 0, mappedSize);
+    if (!view) {
+        const DWORD error = GetLastError();
+        CloseHandle(hMapping);
+        CloseHandle(hFile);
+        mappedSize = 0;
+        mappedLength = 0;
+        SetLastError(error);
+        return false;
+    }
+
+    data = static_cast<uint8_t*>(view);
+    fileHandle = hFile;
+    mappingHandle = hMapping;
+    isOpen = true;
+    if (options.advice != MapAdvice::Normal) {
+        Advise(options.advice);
+    }
+    return true;
+}
+
+void FileSystem::MappedFile::Close() {
+    if (data) {
+        UnmapViewOfFile(data);
+    }
+    if (mappingHandle) {
+        CloseHandle(static_cast<HANDLE>(mappingHandle));
+    }
+    if (fileHandle) {
+        CloseHandle(static_cast<HANDLE>(fileHandle));
+    }
+    data = nullptr;
+    fileHandle = nullptr;
+    mappingHandle = nullptr;
+    mappedSize = 0;
+    mappedLength = 0;
+    isOpen = false;
+    hugePages = false;
+}
+
+bool FileSystem::MappedFile::Advise(MapAdvice advice, size_t offset, size_t length) {
+    if (!data || offset >= mappedSize) {
+        return isOpen;
+    }
+    // Windows 只支持预读提示，其余提示没有对应的接口
+    if (advice != MapAdvice::WillNeed) {
+        return true;
+    }
+    WIN32_MEMORY_RANGE_ENTRY range;
+    range.VirtualAddress = data + offset;
+    range.NumberOfBytes = std::min(length, mappedSize - offset);
+    return PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0) != FALSE;
+}
+
+bool FileSystem::MappedFile::Flush(bool wait) {
+    if (!data || mapMode != MapMode::ReadWrite) {
+        return isOpen;
+    }
+    if (!FlushViewOfFile(data, 0)) {
+        return false;
+    }
+    return !wait || FlushFileBuffers(static_cast<HANDLE>(fileHandle));
+}
+
 } // namespace CorePlatform
\ No newline at end of file
@@ -5,7 +5,21 @@
 #include <vector>
 #include <fstream>
 #include <thread>
+#include <mutex>
+#include <condition_variable>
 #include <chrono>
+#include <array>
+#include <cstring>
+#include <algorithm>
+
+#if !CP_PLATFORM_WINDOWS
+#include <climits>
+#include <csignal>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 namespace CP = CorePlatform;
 namespace CPPT = CorePlatformTest;
@@ -178,6 +192,132 @@ TEST_F(FileSystemTest, MoveAndCopyOperations) {
     EXPECT_FALSE(CP::FileSystem::DuplicateFile(sourcePath, destPath, false));
 }
 
+// 复制引擎：进度、取消、回退到缓冲区复制和复制元数据
+TEST_F(FileSystemTest, CopyEngineProgressAndOptions) {
+    std::string sourcePath = CreateTestFilePath("copy_source.bin");
+    std::string destPath = CreateTestFilePath("copy_dest.bin");
+    
+    std::vector<uint8_t> data(3 * 1024 * 1024 + 123);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<uint8_t>((i * 31) ^ (i >> 12));
+    }
+    ASSERT_TRUE(CP::FileSystem::WriteFile(sourcePath, data));
+    
+    // 1. 默认方式复制，进度单调递增并以总大小结束
+    std::vector<std::pair<uint64_t, uint64_t>> reports;
+    CP::FileSystem::CopyOptions options;
+    options.progress = [&](uint64_t copied, uint64_t total) {
+        reports.emplace_back(copied, total);
+        return true;
+    };
+    CP::FileSystem::CopyResult result;
+    ASSERT_TRUE(CP::FileSystem::DuplicateFile(sourcePath, destPath, options, &result));
+    EXPECT_NE(result.method, CP::FileSystem::CopyMethod::None);
+    EXPECT_EQ(result.totalBytes, data.size());
+    EXPECT_EQ(result.bytesCopied, data.size());
+    EXPECT_EQ(CP::FileSystem::ReadFile(destPath), data);
+    ASSERT_FALSE(reports.empty());
+    for (size_t i = 1; i < reports.size(); ++i) {
+        EXPECT_LE(reports[i - 1].first, reports[i].first);
+    }
+    EXPECT_EQ(reports.back().first, data.size());
+    EXPECT_EQ(reports.back().second, data.size());
+    
+    // 2. 目标已存在且不允许覆盖；覆盖自身
+    EXPECT_FALSE(CP::FileSystem::DuplicateFile(sourcePath, destPath, options));
+    options.overwrite = true;
+    EXPECT_FALSE(CP::FileSystem::DuplicateFile(sourcePath, sourcePath, options));
+    EXPECT_EQ(CP::FileSystem::ReadFile(sourcePath), data);
+    
+    // 3. 禁止克隆和内核复制，使用小缓冲区分多次复制
+    reports.clear();
+    options.allowReflink = false;
+    options.allowKernelCopy = false;
+    options.bufferSize = 64 * 1024;
+    ASSERT_TRUE(CP::FileSystem::DuplicateFile(sourcePath, destPath, options, &result));
+    EXPECT_EQ(CP::FileSystem::ReadFile(destPath), data);
+#if !CP_PLATFORM_WINDOWS
+    EXPECT_EQ(result.method, CP::FileSystem::CopyMethod::Buffered);
+    EXPECT_GT(reports.size(), data.size() / options.bufferSize);
+#endif
+    
+    // 4. 进度回调取消复制，不留下不完整的目标文件
+    ASSERT_TRUE(CP::FileSystem::RemoveFile(destPath));
+    options.progress = [](uint64_t, uint64_t) { return false; };
+    EXPECT_FALSE(CP::FileSystem::DuplicateFile(sourcePath, destPath, options));
+#if !CP_PLATFORM_WINDOWS
+    EXPECT_EQ(errno, ECANCELED);
+#endif
+    EXPECT_FALSE(CP::FileSystem::Exists(destPath));
+    
+    // 5. 复制修改时间和权限位
+    options.progress = nullptr;
+    options.copyMetadata = true;
+    auto modified = std::chrono::system_clock::now() - std::chrono::hours(48);
+    ASSERT_TRUE(CP::FileSystem::SetModificationTime(sourcePath, modified));
+#if !CP_PLATFORM_WINDOWS
+    ASSERT_EQ(chmod(sourcePath.c_str(), 0640), 0);
+#endif
+    ASSERT_TRUE(CP::FileSystem::DuplicateFile(sourcePath, destPath, options));
+    auto sourceTime = CP::FileSystem::GetModificationTime(sourcePath);
+    auto destTime = CP::FileSystem::GetModificationTime(destPath);
+    EXPECT_LT(std::chrono::abs(sourceTime - destTime), std::chrono::seconds(2));
+#if !CP_PLATFORM_WINDOWS
+    EXPECT_EQ(CP::FileSystem::GetPermissions(destPath) & 0777, 0640);
+#endif
+}
+
+#if !CP_PLATFORM_WINDOWS
+// 稀疏文件：超过 2GB 的文件只复制数据段，目标保持稀疏
+TEST_F(FileSystemTest, CopyEnginePreservesSparseFiles) {
+    std::string sourcePath = CreateTestFilePath("sparse_source.img");
+    std::string destPath = CreateTestFilePath("sparse_dest.img");
+    
+    constexpr off_t kFileSize = 3LL * 1024 * 1024 * 1024;
+    constexpr off_t kMiddle = 2LL * 1024 * 1024 * 1024 + 4096;
+    std::vector<char> head(4096, 'H');
+    std::vector<char> middle(8192, 'M');
+    int fd = open(sourcePath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    ASSERT_NE(fd, -1);
+    ASSERT_EQ(pwrite(fd, head.data(), head.size(), 0), static_cast<ssize_t>(head.size()));
+    ASSERT_EQ(pwrite(fd, middle.data(), middle.size(), kMiddle), static_cast<ssize_t>(middle.size()));
+    ASSERT_EQ(ftruncate(fd, kFileSize), 0);
+    close(fd);
+    
+    struct stat sourceStat;
+    ASSERT_EQ(stat(sourcePath.c_str(), &sourceStat), 0);
+    if (sourceStat.st_blocks * 512 >= 1024 * 1024) {
+        GTEST_SKIP() << "temporary directory does not support sparse files";
+    }
+    
+    CP::FileSystem::CopyOptions options;
+    options.allowReflink = false;
+    CP::FileSystem::CopyResult result;
+    ASSERT_TRUE(CP::FileSystem::DuplicateFile(sourcePath, destPath, options, &result));
+    EXPECT_EQ(result.totalBytes, static_cast<uint64_t>(kFileSize));
+    EXPECT_LT(result.bytesCopied, 1024u * 1024u);
+    
+    struct stat destStat;
+    ASSERT_EQ(stat(destPath.c_str(), &destStat), 0);
+    EXPECT_EQ(destStat.st_size, kFileSize);
+    EXPECT_LT(destStat.st_blocks * 512, 1024 * 1024);
+    
+    fd = open(destPath.c_str(), O_RDONLY);
+    ASSERT_NE(fd, -1);
+    std::vector<char> buffer(middle.size() + 8192);
+    ASSERT_EQ(pread(fd, buffer.data(), head.size(), 0), static_cast<ssize_t>(head.size()));
+    EXPECT_TRUE(std::equal(head.begin(), head.end(), buffer.begin()));
+    ASSERT_EQ(pread(fd, buffer.data(), buffer.size(), kMiddle - 4096), static_cast<ssize_t>(buffer.size()));
+    EXPECT_TRUE(std::all_of(buffer.begin(), buffer.begin() + 4096, [](char c) { return c == 0; }));
+    EXPECT_TRUE(std::equal(middle.begin(), middle.end(), buffer.begin() + 4096));
+    EXPECT_TRUE(std::all_of(buffer.begin() + 4096 + middle.size(), buffer.end(), [](char c) { return c == 0; }));
+    char last = 'x';
+    ASSERT_EQ(pread(fd, &last, 1, kFileSize - 1), 1);
+    EXPECT_EQ(last, 0);
+    close(fd);
+}
+#endif
+
 // 目录遍历测试
 TEST_F(FileSystemTest, DirectoryEnumeration) {
     // 创建测试目录结构
@@ -231,6 +371,362 @@ TEST_F(FileSystemTest, DirectoryEnumeration) {
     EXPECT_EQ(allEntries.size(), files.size() + dirs.size());
 }
 
+// 目录树中所有项相对于 root 的路径，排序后返回
+static std::vector<std::string> ListTreeRelative(const std::string& root) {
+    std::vector<std::string> entries;
+    CP::FileSystem::ListDirectoryRecursive(root, entries);
+    for (std::string& entry : entries) {
+        entry = entry.substr(root.size() + 1);
+    }
+    std::sort(entries.begin(), entries.end());
+    return entries;
+}
+
+// 创建 fanout^depth 个目录、每个目录若干文件的测试目录树，返回文件数
+static size_t CreateTestTree(const std::string& root, int depth, int fanout, int filesPerDir) {
+    size_t files = 0;
+    for (int f = 0; f < filesPerDir; ++f) {
+        std::string path = root + "/file" + std::to_string(f) + ".txt";
+        EXPECT_TRUE(CP::FileSystem::WriteTextFile(path, path + std::string(static_cast<size_t>(f) * 100, 'x')));
+        ++files;
+    }
+    if (depth > 0) {
+        for (int d = 0; d < fanout; ++d) {
+            std::string dir = root + "/dir" + std::to_string(d);
+            EXPECT_TRUE(CP::FileSystem::NewDirectory(dir));
+            files += CreateTestTree(dir, depth - 1, fanout, filesPerDir);
+        }
+    }
+    return files;
+}
+
+// 并行复制目录树
+TEST_F(FileSystemTest, CopyTreeParallel) {
+    std::string source = CreateTestSubDir("tree_source");
+    std::string dest = tempDir->GetPath() + "/tree_dest";
+    size_t fileCount = CreateTestTree(source, 3, 4, 5);
+    ASSERT_TRUE(CP::FileSystem::NewDirectory(source + "/empty"));
+    auto modified = std::chrono::system_clock::now() - std::chrono::hours(24);
+    ASSERT_TRUE(CP::FileSystem::SetModificationTime(source + "/dir1/file2.txt", modified));
+#if !CP_PLATFORM_WINDOWS
+    ASSERT_TRUE(CP::FileSystem::CreateSymlink("dir0/file1.txt", source + "/link"));
+    ASSERT_EQ(chmod((source + "/empty").c_str(), 0555), 0);
+    ++fileCount;
+#endif
+    
+    CP::FileSystem::TreeOptions options;
+    options.threads = 4;
+    CP::FileSystem::TreeResult result;
+    ASSERT_TRUE(CP::FileSystem::CopyTree(source, dest, options, &result));
+    EXPECT_TRUE(result.errors.empty());
+    EXPECT_EQ(result.files, fileCount);
+    EXPECT_EQ(result.directories, 1u + 4u + 16u + 64u + 1u);
+    
+    // 结构、内容和元数据一致
+    auto sourceEntries = ListTreeRelative(source);
+    ASSERT_EQ(ListTreeRelative(dest), sourceEntries);
+    for (const std::string& entry : sourceEntries) {
+        if (CP::FileSystem::IsRegularFile(source + "/" + entry) && !CP::FileSystem::IsSymlink(source + "/" + entry)) {
+            EXPECT_EQ(CP::FileSystem::ReadTextFile(dest + "/" + entry),
+                      CP::FileSystem::ReadTextFile(source + "/" + entry)) << entry;
+        }
+    }
+    auto copiedTime = CP::FileSystem::GetModificationTime(dest + "/dir1/file2.txt");
+    EXPECT_LT(std::chrono::abs(copiedTime - modified), std::chrono::seconds(2));
+#if !CP_PLATFORM_WINDOWS
+    EXPECT_TRUE(CP::FileSystem::IsSymlink(dest + "/link"));
+    EXPECT_EQ(CP::FileSystem::ReadSymlink(dest + "/link"), "dir0/file1.txt");
+    EXPECT_EQ(CP::FileSystem::GetPermissions(dest + "/empty") & 0777, 0555);
+    
+    // 复制到自身内部
+    EXPECT_FALSE(CP::FileSystem::CopyTree(source, source + "/dir0/nested", options));
+    EXPECT_EQ(errno, EINVAL);
+    EXPECT_FALSE(CP::FileSystem::Exists(source + "/dir0/nested"));
+
+    // 目标中的子目录是符号链接时不跟随，不会写到树外
+    std::string outside = CreateTestSubDir("tree_copy_outside");
+    std::string linkedDest = tempDir->GetPath() + "/tree_linked_dest";
+    ASSERT_TRUE(CP::FileSystem::NewDirectory(linkedDest));
+    ASSERT_TRUE(CP::FileSystem::CreateSymlink(outside, linkedDest + "/dir0"));
+    EXPECT_FALSE(CP::FileSystem::CopyTree(source, linkedDest, options, &result));
+    ASSERT_EQ(result.errors.size(), 1u);
+    EXPECT_EQ(result.errors[0].path, linkedDest + "/dir0");
+    EXPECT_TRUE(ListTreeRelative(outside).empty());
+#endif
+    
+    // 再次复制：不覆盖时每个文件都记为错误，覆盖时成功
+    ASSERT_TRUE(CP::FileSystem::WriteTextFile(source + "/dir2/file0.txt", "changed"));
+    EXPECT_FALSE(CP::FileSystem::CopyTree(source, dest, options, &result));
+    EXPECT_EQ(result.errors.size(), fileCount);
+    options.overwrite = true;
+    EXPECT_TRUE(CP::FileSystem::CopyTree(source, dest, options, &result));
+    EXPECT_EQ(CP::FileSystem::ReadTextFile(dest + "/dir2/file0.txt"), "changed");
+}
+
+// 并行删除目录树，不跟随符号链接
+TEST_F(FileSystemTest, DeleteTreeParallel) {
+    std::string root = CreateTestSubDir("tree_delete");
+    size_t fileCount = CreateTestTree(root, 3, 5, 4);
+    std::string outside = CreateTestSubDir("tree_outside");
+    ASSERT_TRUE(CP::FileSystem::WriteTextFile(outside + "/keep.txt", "keep"));
+#if !CP_PLATFORM_WINDOWS
+    ASSERT_TRUE(CP::FileSystem::CreateSymlink(outside, root + "/dir0/outside_link"));
+    ++fileCount;
+#endif
+    
+    CP::FileSystem::TreeOptions options;
+    options.threads = 4;
+    CP::FileSystem::TreeResult result;
+    ASSERT_TRUE(CP::FileSystem::DeleteTree(root, options, &result));
+    EXPECT_TRUE(result.errors.empty());
+    EXPECT_EQ(result.files, fileCount);
+    EXPECT_EQ(result.directories, 1u + 5u + 25u + 125u);
+    EXPECT_FALSE(CP::FileSystem::Exists(root));
+    EXPECT_EQ(CP::FileSystem::ReadTextFile(outside + "/keep.txt"), "keep");
+    
+    // 单个文件和不存在的路径
+    std::string file = CreateTestFilePath("single.txt");
+    ASSERT_TRUE(CP::FileSystem::WriteTextFile(file, "x"));
+    EXPECT_TRUE(CP::FileSystem::DeleteTree(file, options));
+    EXPECT_FALSE(CP::FileSystem::Exists(file));
+    EXPECT_FALSE(CP::FileSystem::DeleteTree(file, options));
+    
+    // 原有接口使用同一实现
+    std::string legacy = CreateTestSubDir("tree_legacy");
+    CreateTestTree(legacy, 2, 3, 2);
+    EXPECT_TRUE(CP::FileSystem::DeleteDirectoriesRecursive(legacy));
+    EXPECT_FALSE(CP::FileSystem::Exists(legacy));
+    
+    // 原有接口只删除目录：传入文件时失败，文件保持不变
+    std::string regular = CreateTestFilePath("not_a_dir.txt");
+    ASSERT_TRUE(CP::FileSystem::WriteTextFile(regular, "keep"));
+    EXPECT_FALSE(CP::FileSystem::DeleteDirectoriesRecursive(regular));
+#if !CP_PLATFORM_WINDOWS
+    EXPECT_EQ(errno, ENOTDIR);
+#endif
+    EXPECT_EQ(CP::FileSystem::ReadTextFile(regular), "keep");
+}
+
+// 目录遍历：过滤、深度限制、跳过子树和提前结束
+TEST_F(FileSystemTest, WalkerFiltersAndControl) {
+    std::string root = CreateTestSubDir("walk_tree");
+    CreateTestTree(root, 2, 3, 3);
+    ASSERT_TRUE(CP::FileSystem::WriteTextFile(root + "/dir1/app.log", "log"));
+    ASSERT_TRUE(CP::FileSystem::WriteTextFile(root + "/dir2/dir0/old.log", "log"));
+    
+    // 默认返回所有项，与 ListDirectoryRecursive 一致
+    std::vector<std::string> walked;
+    CP::FileSystem::WalkEntry entry;
+    CP::FileSystem::Walker walker(root + "/");
+    while (walker.Next(entry)) {
+        EXPECT_EQ(entry.path.substr(entry.path.size() - entry.name.size()), entry.name);
+        EXPECT_EQ(entry.depth, static_cast<int>(std::count_if(entry.path.begin() + root.size(), entry.path.end(),
+                                                              [](char c) { return c == '/' || c == '\\'; })));
+        walked.push_back(std::string(entry.path.substr(root.size() + 1)));
+    }
+    EXPECT_TRUE(walker.Errors().empty());
+    std::sort(walked.begin(), walked.end());
+    EXPECT_EQ(walked, ListTreeRelative(root));
+    
+    // glob 和类型过滤：不返回目录但仍然进入
+    CP::FileSystem::WalkOptions options;
+    options.pattern = "*.log";
+    options.directories = false;
+    walked.clear();
+    EXPECT_TRUE(CP::FileSystem::Walk(root, options, [&](const CP::FileSystem::WalkEntry& e) {
+        EXPECT_EQ(e.type, CP::FileSystem::FileType::Regular);
+        walked.push_back(std::string(e.name));
+        return CP::FileSystem::WalkAction::Continue;
+    }));
+    std::sort(walked.begin(), walked.end());
+    EXPECT_EQ(walked, (std::vector<std::string>{"app.log", "old.log"}));
+    
+    // 深度限制
+    options = CP::FileSystem::WalkOptions();
+    options.maxDepth = 1;
+    size_t count = 0;
+    EXPECT_TRUE(CP::FileSystem::Walk(root, options, [&](const CP::FileSystem::WalkEntry& e) {
+        EXPECT_EQ(e.depth, 1);
+        ++count;
+        return CP::FileSystem::WalkAction::Continue;
+    }));
+    EXPECT_EQ(count, 3u + 3u);
+    
+    // 跳过子树
+    options = CP::FileSystem::WalkOptions();
+    walked.clear();
+    EXPECT_TRUE(CP::FileSystem::Walk(root, options, [&](const CP::FileSystem::WalkEntry& e) {
+        walked.push_back(std::string(e.path.substr(root.size() + 1)));
+        return e.name == "dir0" ? CP::FileSystem::WalkAction::SkipSubtree : CP::FileSystem::WalkAction::Continue;
+    }));
+    for (const std::string& path : walked) {
+        EXPECT_EQ(path.find("dir0" CP_PATH_SEPARATOR_STR), std::string::npos) << path;
+    }
+    EXPECT_NE(std::find(walked.begin(), walked.end(), "dir1" CP_PATH_SEPARATOR_STR "file0.txt"), walked.end());
+    
+    // 提前结束
+    count = 0;
+    EXPECT_TRUE(CP::FileSystem::Walk(root, options, [&](const CP::FileSystem::WalkEntry&) {
+        return ++count == 5 ? CP::FileSystem::WalkAction::Stop : CP::FileSystem::WalkAction::Continue;
+    }));
+    EXPECT_EQ(count, 5u);
+    
+    // 根目录不存在
+    std::vector<CP::FileSystem::TreeError> errors;
+    EXPECT_FALSE(CP::FileSystem::Walk(root + "/missing", options,
+                                      [](const CP::FileSystem::WalkEntry&) { return CP::FileSystem::WalkAction::Continue; },
+                                      &errors));
+    ASSERT_EQ(errors.size(), 1u);
+    EXPECT_EQ(errors[0].error, std::errc::no_such_file_or_directory);
+}
+
+// 多线程遍历与单线程遍历结果一致
+TEST_F(FileSystemTest, WalkParallelMatchesSerial) {
+    std::string root = CreateTestSubDir("walk_parallel");
+    CreateTestTree(root, 3, 4, 6);
+#if !CP_PLATFORM_WINDOWS
+    ASSERT_TRUE(CP::FileSystem::CreateSymlink(root, root + "/dir0/loop"));
+#endif
+    
+    CP::FileSystem::WalkOptions options;
+    std::vector<std::string> serial;
+    EXPECT_TRUE(CP::FileSystem::Walk(root, options, [&](const CP::FileSystem::WalkEntry& e) {
+        serial.emplace_back(e.path);
+        return CP::FileSystem::WalkAction::Continue;
+    }));
+    
+    options.threads = 4;
+    std::mutex mutex;
+    std::vector<std::string> parallel;
+    EXPECT_TRUE(CP::FileSystem::Walk(root, options, [&](const CP::FileSystem::WalkEntry& e) {
+        std::lock_guard<std::mutex> lock(mutex);
+        parallel.emplace_back(e.path);
+        return CP::FileSystem::WalkAction::Continue;
+    }));
+    
+    std::sort(serial.begin(), serial.end());
+    std::sort(parallel.begin(), parallel.end());
+    size_t expected = (4u + 16u + 64u) + (1u + 4u + 16u + 64u) * 6u;
+#if !CP_PLATFORM_WINDOWS
+    expected += 1;    // 符号链接本身，不跟随
+#endif
+    EXPECT_EQ(serial.size(), expected);
+    EXPECT_EQ(parallel, serial);
+    
+#if !CP_PLATFORM_WINDOWS
+    // 路径超过 PATH_MAX 的深层目录：子目录相对于父目录描述符打开，与单线程遍历一样能走到底
+    std::string deep = CreateTestSubDir("walk_deep");
+    const std::string component(200, 'd');
+    int fd = open(deep.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    ASSERT_NE(fd, -1);
+    constexpr int kLevels = 30;
+    for (int i = 0; i < kLevels; i++) {
+        ASSERT_EQ(mkdirat(fd, component.c_str(), 0755), 0);
+        int child = openat(fd, component.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        close(fd);
+        ASSERT_NE(child, -1);
+        fd = child;
+    }
+    close(fd);
+    
+    std::vector<CP::FileSystem::TreeError> errors;
+    size_t longest = 0;
+    int deepest = 0;
+    EXPECT_TRUE(CP::FileSystem::Walk(deep, options, [&](const CP::FileSystem::WalkEntry& e) {
+        std::lock_guard<std::mutex> lock(mutex);
+        longest = std::max(longest, e.path.size());
+        deepest = std::max(deepest, e.depth);
+        return CP::FileSystem::WalkAction::Continue;
+    }, &errors));
+    EXPECT_TRUE(errors.empty());
+    EXPECT_EQ(deepest, kLevels);
+    EXPECT_GT(longest, static_cast<size_t>(PATH_MAX));
+    
+    CP::FileSystem::TreeOptions treeOptions;
+    EXPECT_TRUE(CP::FileSystem::DeleteTree(deep, treeOptions));
+#endif
+}
+
+// 目录迭代器按需返回目录项，支持提前结束和跳过子树
+TEST_F(FileSystemTest, DirectoryIteratorsStreamEntries) {
+    static_assert(std::input_iterator<CP::FileSystem::DirectoryIterator>);
+    static_assert(std::input_iterator<CP::FileSystem::RecursiveDirectoryIterator>);
+    
+    std::string root = CreateTestSubDir("dir_iterators");
+    CreateTestTree(root, 2, 3, 3);
+    
+    // 单层：与 ListDirectory 一致，大小按需读取
+    std::vector<std::string> names;
+    for (const auto& entry : CP::FileSystem::DirectoryIterator(root)) {
+        EXPECT_EQ(entry.Depth(), 1);
+        EXPECT_EQ(entry.Path(), root + CP_PATH_SEPARATOR_STR + std::string(entry.Name()));
+        if (entry.IsRegularFile()) {
+            EXPECT_EQ(entry.Size(), CP::FileSystem::GetFileSize(entry.Path()));
+            EXPECT_NE(entry.ModificationTime(), std::chrono::system_clock::time_point());
+        } else {
+            EXPECT_TRUE(entry.IsDirectory());
+        }
+        names.emplace_back(entry.Name());
+    }
+    std::vector<std::string> listed;
+    EXPECT_TRUE(CP::FileSystem::ListDirectory(root, listed));
+    std::sort(names.begin(), names.end());
+    std::sort(listed.begin(), listed.end());
+    EXPECT_EQ(names, listed);
+    
+    // 递归：与 ListDirectoryRecursive 一致
+    std::vector<std::string> walked;
+    for (const auto& entry : CP::FileSystem::RecursiveDirectoryIterator(root)) {
+        walked.push_back(entry.Path().substr(root.size() + 1));
+    }
+    std::sort(walked.begin(), walked.end());
+    EXPECT_EQ(walked, ListTreeRelative(root));
+    
+    // 跳过子树
+    const std::string skipped = root + CP_PATH_SEPARATOR_STR "dir1" CP_PATH_SEPARATOR_STR;
+    size_t count = 0;
+    CP::FileSystem::RecursiveDirectoryIterator it(root);
+    for (; it != CP::FileSystem::RecursiveDirectoryIterator(); ++it) {
+        EXPECT_FALSE(it->Path().starts_with(skipped));
+        if (it.Depth() == 1 && it->Name() == "dir1") {
+            it.SkipSubtree();
+        }
+        ++count;
+    }
+    EXPECT_EQ(count, walked.size() - (3u + 3u + 3u * 3u));    // dir1 下的文件、子目录和子目录中的文件
+    EXPECT_TRUE(it.Errors().empty());
+    
+    // 提前结束，目录项可以复制后继续使用
+    std::vector<CP::FileSystem::DirectoryEntry> firstTwo;
+    for (const auto& entry : CP::FileSystem::RecursiveDirectoryIterator(root)) {
+        firstTwo.push_back(entry);
+        if (firstTwo.size() == 2) {
+            break;
+        }
+    }
+    ASSERT_EQ(firstTwo.size(), 2u);
+    EXPECT_TRUE(CP::FileSystem::Exists(firstTwo[0].Path()));
+    EXPECT_NE(firstTwo[0].Path(), firstTwo[1].Path());
+    
+    // 过滤
+    CP::FileSystem::WalkOptions options;
+    options.directories = false;
+    options.pattern = "file1.txt";
+    count = 0;
+    for (const auto& entry : CP::FileSystem::RecursiveDirectoryIterator(root, options)) {
+        EXPECT_EQ(entry.Name(), "file1.txt");
+        EXPECT_EQ(entry.Size(), entry.Path().size() + 100u);
+        ++count;
+    }
+    EXPECT_EQ(count, 1u + 3u + 9u);
+    
+    // 根目录不存在
+    CP::FileSystem::DirectoryIterator missing(root + "/missing");
+    EXPECT_TRUE(missing == CP::FileSystem::DirectoryIterator());
+    ASSERT_EQ(missing.Errors().size(), 1u);
+    EXPECT_EQ(missing.Errors()[0].error, std::errc::no_such_file_or_directory);
+}
+
 // 特殊文件类型测试
 TEST_F(FileSystemTest, SpecialFileTypes) {
     std::string filePath = CreateTestFilePath("normal.txt");
@@ -430,4 +926,618 @@ TEST_F(FileSystemTest, FileTimestamps) {
     auto updatedTime = CP::FileSystem::GetModificationTime(filePath);
     auto diff = std::chrono::duration_cast<std::chrono::seconds>(updatedTime - newTime);
     EXPECT_LT(std::abs(diff.count()), 2); // 允许2秒误差
-}
\ No newline at end of file
+}
+
+// 一次调用获取元数据，批量获取与逐个获取结果一致
+TEST_F(FileSystemTest, FileInfoAndBatch) {
+    std::string filePath = CreateTestFilePath("info.txt");
+    auto beforeCreation = std::chrono::system_clock::now() - std::chrono::seconds(1);
+    ASSERT_TRUE(CP::FileSystem::WriteTextFile(filePath, "file info"));
+    
+    CP::FileSystem::FileInfo info;
+    ASSERT_TRUE(CP::FileSystem::GetFileInfo(filePath, info));
+    EXPECT_TRUE(info.Has(CP::FileSystem::InfoBasic));
+    EXPECT_EQ(info.type, CP::FileSystem::FileType::Regular);
+    EXPECT_EQ(info.size, 9u);
+    EXPECT_EQ(info.modificationTime, CP::FileSystem::GetModificationTime(filePath));
+    
+    // 只返回请求的字段
+    ASSERT_TRUE(CP::FileSystem::GetFileInfo(filePath, info, CP::FileSystem::InfoSize));
+    EXPECT_EQ(info.fields, static_cast<uint32_t>(CP::FileSystem::InfoSize));
+    
+    ASSERT_TRUE(CP::FileSystem::GetFileInfo(filePath, info, CP::FileSystem::InfoAll));
+    EXPECT_TRUE(info.Has(CP::FileSystem::InfoType | CP::FileSystem::InfoSize | CP::FileSystem::InfoPermissions));
+    EXPECT_EQ(info.permissions, CP::FileSystem::GetPermissions(filePath));
+#if !CP_PLATFORM_WINDOWS
+    EXPECT_TRUE(info.Has(CP::FileSystem::InfoLinks | CP::FileSystem::InfoOwner | CP::FileSystem::InfoInode));
+    EXPECT_EQ(info.links, 1u);
+    EXPECT_EQ(info.uid, static_cast<uint32_t>(getuid()));
+#endif
+    
+    // 修改时间改变后，创建时间（文件系统记录时）保持不变
+    ASSERT_TRUE(CP::FileSystem::SetModificationTime(filePath, beforeCreation - std::chrono::hours(24)));
+    CP::FileSystem::FileInfo updated;
+    ASSERT_TRUE(CP::FileSystem::GetFileInfo(filePath, updated, CP::FileSystem::InfoAll));
+    EXPECT_LT(updated.modificationTime, beforeCreation);
+    if (updated.Has(CP::FileSystem::InfoCreationTime)) {
+        EXPECT_EQ(updated.creationTime, info.creationTime);
+        EXPECT_GE(updated.creationTime, beforeCreation);
+        EXPECT_EQ(CP::FileSystem::GetCreationTime(filePath), updated.creationTime);
+    }
+    
+    EXPECT_FALSE(CP::FileSystem::GetFileInfo(CreateTestFilePath("missing.txt"), info));
+    EXPECT_EQ(info.fields, 0u);
+    
+#if !CP_PLATFORM_WINDOWS
+    // 不跟随符号链接
+    std::string linkPath = CreateTestFilePath("info_link");
+    ASSERT_TRUE(CP::FileSystem::CreateSymlink(filePath, linkPath));
+    ASSERT_TRUE(CP::FileSystem::GetFileInfo(linkPath, info));
+    EXPECT_EQ(info.type, CP::FileSystem::FileType::Symlink);
+#endif
+    
+    // 批量：多于一个任务的路径数，其中夹杂不存在的路径
+    std::string root = CreateTestSubDir("info_batch");
+    CreateTestTree(root, 2, 4, 10);
+    std::vector<std::string> paths;
+    ASSERT_TRUE(CP::FileSystem::ListDirectoryRecursive(root, paths));
+    for (size_t i = 0; i < paths.size(); i += 50) {
+        paths.insert(paths.begin() + static_cast<std::ptrdiff_t>(i), root + "/missing" + std::to_string(i));
+    }
+    ASSERT_GT(paths.size(), 200u);
+    
+    std::vector<CP::FileSystem::FileInfo> infos;
+    std::vector<std::error_code> errors;
+    EXPECT_FALSE(CP::FileSystem::GetFileInfos(paths, infos, CP::FileSystem::InfoBasic, 4, &errors));
+    ASSERT_EQ(infos.size(), paths.size());
+    ASSERT_EQ(errors.size(), paths.size());
+    for (size_t i = 0; i < paths.size(); ++i) {
+        if (paths[i].find("missing") != std::string::npos) {
+            EXPECT_EQ(infos[i].fields, 0u);
+            EXPECT_EQ(errors[i], std::errc::no_such_file_or_directory);
+            continue;
+        }
+        EXPECT_FALSE(errors[i]);
+        EXPECT_EQ(infos[i].type, CP::FileSystem::GetFileType(paths[i]));
+        if (infos[i].type == CP::FileSystem::FileType::Regular) {
+            EXPECT_EQ(infos[i].size, CP::FileSystem::GetFileSize(paths[i]));
+        }
+    }
+    
+    paths.erase(std::remove_if(paths.begin(), paths.end(),
+                               [](const std::string& path) { return path.find("missing") != std::string::npos; }),
+                paths.end());
+    EXPECT_TRUE(CP::FileSystem::GetFileInfos(paths, infos));
+    EXPECT_EQ(infos.size(), paths.size());
+}
+
+// 元数据缓存：命中不访问文件系统，按 ttl 和变化通知失效
+TEST_F(FileSystemTest, MetadataCacheHitsAndInvalidation) {
+    std::string filePath = CreateTestFilePath("cached.txt");
+    ASSERT_TRUE(CP::FileSystem::WriteTextFile(filePath, "12345"));
+    
+    // 不监视变化：ttl 内返回缓存的结果
+    CP::FileSystem::MetadataCacheOptions options;
+    options.watchChanges = false;
+    options.ttl = std::chrono::hours(1);
+    {
+        CP::FileSystem::MetadataCache cache(options);
+        EXPECT_EQ(cache.GetFileSize(filePath), 5u);
+        EXPECT_TRUE(cache.Exists(filePath));
+        EXPECT_EQ(cache.GetFileType(filePath), CP::FileSystem::FileType::Regular);
+        auto stats = cache.Stats();
+        EXPECT_EQ(stats.misses, 1u);
+        EXPECT_EQ(stats.hits, 2u);
+        EXPECT_EQ(stats.entries, 1u);
+        
+        ASSERT_TRUE(CP::FileSystem::WriteTextFile(filePath, "1234567"));
+        EXPECT_EQ(cache.GetFileSize(filePath), 5u);
+        cache.Invalidate(filePath);
+        EXPECT_EQ(cache.GetFileSize(filePath), 7u);
+        
+        // 不存在的结果同样缓存
+        std::string missing = CreateTestFilePath("not_yet.txt");
+        EXPECT_FALSE(cache.Exists(missing));
+        ASSERT_TRUE(CP::FileSystem::WriteTextFile(missing, "x"));
+        EXPECT_FALSE(cache.Exists(missing));
+        EXPECT_EQ(cache.Stats().expirations, 0u);
+        
+        cache.Clear();
+        EXPECT_EQ(cache.Stats().entries, 0u);
+    }
+    
+    // 过期后重新获取：ttl 为 1 毫秒，等待只需保证超过 ttl，不依赖查询本身的耗时
+    options.ttl = std::chrono::milliseconds(1);
+    {
+        CP::FileSystem::MetadataCache cache(options);
+        std::string later = CreateTestFilePath("later.txt");
+        EXPECT_FALSE(cache.Exists(later));
+        ASSERT_TRUE(CP::FileSystem::WriteTextFile(later, "x"));
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        EXPECT_TRUE(cache.Exists(later));
+        auto stats = cache.Stats();
+        EXPECT_EQ(stats.expirations, 1u);
+        EXPECT_EQ(stats.misses, 2u);
+        EXPECT_EQ(stats.hits, 0u);
+    }
+    
+#if CP_PLATFORM_LINUX
+    // inotify 失效：ttl 很长，变化在通知到达后可见
+    auto eventually = [](const std::function<bool()>& condition) {
+        for (int i = 0; i < 200; ++i) {
+            if (condition()) {
+                return true;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return false;
+    };
+    
+    options = CP::FileSystem::MetadataCacheOptions();
+    options.ttl = std::chrono::hours(1);
+    CP::FileSystem::MetadataCache cache(options);
+    std::string dir = CreateTestSubDir("cache_watch");
+    std::string newFile = dir + "/new.txt";
+    
+    EXPECT_FALSE(cache.Exists(newFile));
+    auto dirTime = cache.GetModificationTime(dir);
+    EXPECT_GE(cache.Stats().watches, 2u);      // dir 所在的目录和 dir 本身
+    ASSERT_TRUE(CP::FileSystem::SetModificationTime(dir, dirTime - std::chrono::hours(1)));
+    EXPECT_TRUE(eventually([&] { return cache.GetModificationTime(dir) != dirTime; }));
+    dirTime = cache.GetModificationTime(dir);
+    
+    ASSERT_TRUE(CP::FileSystem::WriteTextFile(newFile, "abc"));
+    EXPECT_TRUE(eventually([&] { return cache.Exists(newFile); }));
+    EXPECT_TRUE(eventually([&] { return cache.GetModificationTime(dir) != dirTime; }));
+    EXPECT_EQ(cache.GetFileSize(newFile), 3u);
+    
+    ASSERT_TRUE(CP::FileSystem::AppendFile(newFile, std::vector<uint8_t>{'d', 'e'}));
+    EXPECT_TRUE(eventually([&] { return cache.GetFileSize(newFile) == 5u; }));
+    
+    ASSERT_TRUE(CP::FileSystem::DeleteTree(dir, CP::FileSystem::TreeOptions()));
+    EXPECT_TRUE(eventually([&] { return !cache.Exists(newFile); }));
+    EXPECT_TRUE(eventually([&] { return !cache.Exists(dir); }));
+    
+    // 稳定后反复查询全部命中
+    auto before = cache.Stats();
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_FALSE(cache.Exists(newFile));
+    }
+    auto after = cache.Stats();
+    EXPECT_EQ(after.hits - before.hits, 100u);
+    EXPECT_EQ(after.misses, before.misses);
+    EXPECT_GT(after.invalidations, 0u);
+#endif
+}
+
+// 收集 Watcher 投递的事件
+class WatchEventCollector {
+public:
+    CP::FileSystem::WatchCallback Callback() {
+        return [this](const std::vector<CP::FileSystem::WatchEvent>& events) {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++batches;
+            received.insert(received.end(), events.begin(), events.end());
+            cv.notify_all();
+        };
+    }
+    
+    // 等待 path 的 type 事件，返回收到的所有事件中 path 的事件数
+    bool WaitFor(CP::FileSystem::WatchEventType type, const std::string& path) {
+        std::unique_lock<std::mutex> lock(mutex);
+        return cv.wait_for(lock, std::chrono::seconds(5), [&] { return Count(type, path) > 0; });
+    }
+    
+    size_t Count(CP::FileSystem::WatchEventType type, const std::string& path) const {
+        return static_cast<size_t>(std::count_if(received.begin(), received.end(),
+            [&](const CP::FileSystem::WatchEvent& e) { return e.type == type && e.path == path; }));
+    }
+    
+    size_t CountPath(const std::string& path) {
+        std::lock_guard<std::mutex> lock(mutex);
+        return static_cast<size_t>(std::count_if(received.begin(), received.end(),
+            [&](const CP::FileSystem::WatchEvent& e) { return e.path == path; }));
+    }
+    
+    std::vector<CP::FileSystem::WatchEvent> Events() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return received;
+    }
+    
+    void Reset() {
+        std::lock_guard<std::mutex> lock(mutex);
+        received.clear();
+    }
+    
+    size_t batches = 0;
+    
+private:
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<CP::FileSystem::WatchEvent> received;
+};
+
+// 递归监视，按路径合并事件
+TEST_F(FileSystemTest, WatcherCoalescesRecursiveEvents) {
+    std::string root = CreateTestSubDir("watch_root");
+    ASSERT_TRUE(CP::FileSystem::NewDirectory(root + "/sub"));
+    using Type = CP::FileSystem::WatchEventType;
+    
+    WatchEventCollector collector;
+    CP::FileSystem::Watcher watcher;
+    CP::FileSystem::WatchOptions options;
+    options.latency = std::chrono::milliseconds(100);
+#if !CP_PLATFORM_LINUX
+    EXPECT_FALSE(watcher.Start(root, options, collector.Callback()));
+#else
+    EXPECT_FALSE(watcher.Start(root + "/missing", options, collector.Callback()));
+    EXPECT_EQ(errno, ENOENT);
+    ASSERT_TRUE(watcher.Start(root, options, collector.Callback()));
+    EXPECT_TRUE(watcher.IsRunning());
+    EXPECT_FALSE(watcher.UsesFanotify());
+    EXPECT_EQ(watcher.WatchCount(), 2u);
+    
+    // 创建后多次写入：只有一个 Created
+    std::string file = root + "/sub/burst.txt";
+    ASSERT_TRUE(CP::FileSystem::WriteTextFile(file, "x"));
+    for (int i = 0; i < 20; ++i) {
+        ASSERT_TRUE(CP::FileSystem::AppendFile(file, std::vector<uint8_t>{'x'}));
+    }
+    // 创建后立即删除的临时文件不报告
+    std::string temp = root + "/sub/temp.txt";
+    ASSERT_TRUE(CP::FileSystem::WriteTextFile(temp, "tmp"));
+    ASSERT_TRUE(CP::FileSystem::RemoveFile(temp));
+    ASSERT_TRUE(collector.WaitFor(Type::Created, file));
+    EXPECT_EQ(collector.CountPath(file), 1u);
+    EXPECT_EQ(collector.CountPath(temp), 0u);
+    
+    // 新建的子目录自动加入监视，其中立即创建的文件也被报告
+    collector.Reset();
+    std::string deep = root + "/new/deep";
+    ASSERT_TRUE(CP::FileSystem::NewDirectory(root + "/new"));
+    ASSERT_TRUE(CP::FileSystem::NewDirectory(deep));
+    ASSERT_TRUE(CP::FileSystem::WriteTextFile(deep + "/inner.txt", "inner"));
+    ASSERT_TRUE(collector.WaitFor(Type::Created, deep + "/inner.txt"));
+    EXPECT_TRUE(collector.WaitFor(Type::Created, root + "/new"));
+    EXPECT_TRUE(collector.WaitFor(Type::Created, deep));
+    
+    // 新目录中的后续修改
+    collector.Reset();
+    ASSERT_TRUE(CP::FileSystem::AppendFile(deep + "/inner.txt", std::vector<uint8_t>{'!'}));
+    EXPECT_TRUE(collector.WaitFor(Type::Modified, deep + "/inner.txt"));
+    
+    // 重命名报告为一个 Renamed；改名后的目录中的事件使用新路径
+    collector.Reset();
+    ASSERT_TRUE(CP::FileSystem::RelocateFile(root + "/new", root + "/moved"));
+    ASSERT_TRUE(collector.WaitFor(Type::Renamed, root + "/moved"));
+    auto events = collector.Events();
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0].oldPath, root + "/new");
+    EXPECT_TRUE(events[0].isDirectory);
+    ASSERT_TRUE(CP::FileSystem::RemoveFile(root + "/moved/deep/inner.txt"));
+    EXPECT_TRUE(collector.WaitFor(Type::Deleted, root + "/moved/deep/inner.txt"));
+    
+    // 停止后不再投递
+    watcher.Stop();
+    EXPECT_FALSE(watcher.IsRunning());
+    collector.Reset();
+    ASSERT_TRUE(CP::FileSystem::WriteTextFile(root + "/after.txt", "x"));
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    EXPECT_TRUE(collector.Events().empty());
+#endif
+}
+
+#if CP_PLATFORM_LINUX
+// fanotify 需要 CAP_SYS_ADMIN，没有权限时回退到 inotify
+TEST_F(FileSystemTest, WatcherFanotifyOrFallback) {
+    std::string root = CreateTestSubDir("watch_fanotify");
+    ASSERT_TRUE(CP::FileSystem::NewDirectory(root + "/sub"));
+    using Type = CP::FileSystem::WatchEventType;
+    
+    WatchEventCollector collector;
+    CP::FileSystem::Watcher watcher;
+    CP::FileSystem::WatchOptions options;
+    options.useFanotify = true;
+    options.latency = std::chrono::milliseconds(20);
+    ASSERT_TRUE(watcher.Start(root + "/", options, collector.Callback()));
+    if (!watcher.UsesFanotify()) {
+        GTEST_LOG_(INFO) << "fanotify unavailable, using inotify";
+    }
+    
+    std::string file = root + "/sub/fan.txt";
+    ASSERT_TRUE(CP::FileSystem::WriteTextFile(file, "fan"));
+    ASSERT_TRUE(collector.WaitFor(Type::Created, file));
+    EXPECT_EQ(collector.CountPath(file), 1u);
+    
+    // root 以外的变化不报告
+    std::string outside = CreateTestFilePath("outside.txt");
+    ASSERT_TRUE(CP::FileSystem::WriteTextFile(outside, "x"));
+    ASSERT_TRUE(CP::FileSystem::RemoveFile(file));
+    ASSERT_TRUE(collector.WaitFor(Type::Deleted, file));
+    EXPECT_EQ(collector.CountPath(outside), 0u);
+    
+    // 移动 Watcher 后继续工作
+    CP::FileSystem::Watcher moved = std::move(watcher);
+    EXPECT_TRUE(moved.IsRunning());
+    ASSERT_TRUE(CP::FileSystem::NewDirectory(root + "/sub/dir"));
+    EXPECT_TRUE(collector.WaitFor(Type::Created, root + "/sub/dir"));
+    
+    // 两种后端都把重命名报告为一个 Renamed
+    collector.Reset();
+    ASSERT_TRUE(CP::FileSystem::WriteTextFile(root + "/sub/old.txt", "x"));
+    ASSERT_TRUE(collector.WaitFor(Type::Created, root + "/sub/old.txt"));
+    collector.Reset();
+    ASSERT_TRUE(CP::FileSystem::RelocateFile(root + "/sub/old.txt", root + "/new.txt"));
+    ASSERT_TRUE(collector.WaitFor(Type::Renamed, root + "/new.txt"));
+    auto events = collector.Events();
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0].oldPath, root + "/sub/old.txt");
+    EXPECT_FALSE(events[0].isDirectory);
+    
+    // root 自身被移走时报告 root 的 Deleted
+    collector.Reset();
+    ASSERT_TRUE(CP::FileSystem::RelocateFile(root, root + "_gone"));
+    EXPECT_TRUE(collector.WaitFor(Type::Deleted, root));
+    moved.Stop();
+    ASSERT_TRUE(CP::FileSystem::RelocateFile(root + "_gone", root));
+}
+#endif
+
+#if CP_PLATFORM_LINUX
+// 回调较慢时后续批次与尚未投递的事件合并，过多时改为 Rescan；可以在回调中停止
+TEST_F(FileSystemTest, WatcherMergesPendingEvents) {
+    std::string root = CreateTestSubDir("watch_pending");
+    using Type = CP::FileSystem::WatchEventType;
+    
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool release = false;
+    std::vector<std::vector<CP::FileSystem::WatchEvent>> batches;
+    auto waitBatches = [&](size_t count) {
+        std::unique_lock<std::mutex> lock(mutex);
+        return cv.wait_for(lock, std::chrono::seconds(5), [&] { return batches.size() >= count; });
+    };
+    auto setRelease = [&](bool value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        release = value;
+        cv.notify_all();
+    };
+    
+    CP::FileSystem::Watcher watcher;
+    CP::FileSystem::WatchOptions options;
+    options.latency = std::chrono::milliseconds(20);
+    options.maxPendingEvents = 8;
+    ASSERT_TRUE(watcher.Start(root, options, [&](const std::vector<CP::FileSystem::WatchEvent>& events) {
+        std::unique_lock<std::mutex> lock(mutex);
+        batches.push_back(events);
+        cv.notify_all();
+        cv.wait(lock, [&] { return release; });
+    }));
+    
+    // 第一批的回调阻塞期间，分属多个批次的创建、修改和删除合并为一批
+    ASSERT_TRUE(CP::FileSystem::WriteTextFile(root + "/first.txt", "x"));
+    ASSERT_TRUE(waitBatches(1));
+    std::string temp = root + "/temp.txt";
+    std::string kept = root + "/kept.txt";
+    ASSERT_TRUE(CP::FileSystem::WriteTextFile(temp, "x"));
+    ASSERT_TRUE(CP::FileSystem::WriteTextFile(kept, "x"));
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    ASSERT_TRUE(CP::FileSystem::AppendFile(kept, std::vector<uint8_t>{'y'}));
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    ASSERT_TRUE(CP::FileSystem::RemoveFile(temp));
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    setRelease(true);
+    ASSERT_TRUE(waitBatches(2));
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ASSERT_EQ(batches[1].size(), 1u);
+        EXPECT_EQ(batches[1][0].type, Type::Created);
+        EXPECT_EQ(batches[1][0].path, kept);
+    }
+    
+    // 尚未投递的事件超过 maxPendingEvents 时只报告 Rescan
+    setRelease(false);
+    ASSERT_TRUE(CP::FileSystem::WriteTextFile(root + "/block.txt", "x"));
+    ASSERT_TRUE(waitBatches(3));
+    for (int i = 0; i < 20; ++i) {
+        ASSERT_TRUE(CP::FileSystem::WriteTextFile(root + "/many" + std::to_string(i) + ".txt", "x"));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    setRelease(true);
+    ASSERT_TRUE(waitBatches(4));
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ASSERT_FALSE(batches[3].empty());
+        EXPECT_EQ(batches[3][0].type, Type::Rescan);
+        EXPECT_EQ(batches[3][0].path, root);
+        EXPECT_LE(batches[3].size(), options.maxPendingEvents + 1);
+    }
+    
+    // 在回调中停止
+    CP::FileSystem::Watcher stopping;
+    bool stopped = false;
+    ASSERT_TRUE(stopping.Start(root, options, [&](const std::vector<CP::FileSystem::WatchEvent>&) {
+        stopping.Stop();
+        std::lock_guard<std::mutex> lock(mutex);
+        stopped = true;
+        cv.notify_all();
+    }));
+    ASSERT_TRUE(CP::FileSystem::WriteTextFile(root + "/stop.txt", "x"));
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        ASSERT_TRUE(cv.wait_for(lock, std::chrono::seconds(5), [&] { return stopped; }));
+    }
+    EXPECT_FALSE(stopping.IsRunning());
+}
+#endif
+
+// 内存映射文件测试
+TEST_F(FileSystemTest, MappedFileModes) {
+    std::string filePath = CreateTestFilePath("mapped.bin");
+    std::string content = "0123456789abcdef";
+    ASSERT_TRUE(CP::FileSystem::WriteTextFile(filePath, content));
+    
+    // 1. 只读映射
+    CP::FileSystem::MappedFile readOnly(filePath);
+    ASSERT_TRUE(readOnly.IsOpen());
+    EXPECT_EQ(readOnly.Size(), content.size());
+    EXPECT_EQ(readOnly.Text(), content);
+    EXPECT_EQ(readOnly.Bytes().size(), content.size());
+    EXPECT_EQ(readOnly.MutableData(), nullptr);
+    EXPECT_TRUE(readOnly.MutableBytes().empty());
+    EXPECT_TRUE(readOnly.Advise(CP::FileSystem::MapAdvice::Random, 4, 100));
+    EXPECT_TRUE(readOnly.Advise(CP::FileSystem::MapAdvice::WillNeed));
+    
+    // 2. 写时复制：修改只在映射中可见
+    CP::FileSystem::MapOptions options;
+    options.mode = CP::FileSystem::MapMode::CopyOnWrite;
+    options.advice = CP::FileSystem::MapAdvice::Sequential;
+    CP::FileSystem::MappedFile privateCopy(filePath, options);
+    ASSERT_TRUE(privateCopy.IsOpen());
+    ASSERT_NE(privateCopy.MutableData(), nullptr);
+    privateCopy.MutableBytes()[0] = 'X';
+    EXPECT_EQ(privateCopy.Text()[0], 'X');
+    EXPECT_TRUE(privateCopy.Flush());
+    privateCopy.Close();
+    EXPECT_FALSE(privateCopy.IsOpen());
+    EXPECT_EQ(CP::FileSystem::ReadTextFile(filePath), content);
+    
+    // 3. 读写映射：修改写回文件，其他映射立即可见
+    options.mode = CP::FileSystem::MapMode::ReadWrite;
+    options.hugePages = true;  // 普通文件上只是请求，映射仍然成功
+    CP::FileSystem::MappedFile readWrite(filePath, options);
+    ASSERT_TRUE(readWrite.IsOpen());
+    readWrite.MutableBytes()[1] = 'Y';
+    EXPECT_TRUE(readWrite.Flush());
+    EXPECT_EQ(readOnly.Text()[1], 'Y');
+    EXPECT_EQ(CP::FileSystem::ReadTextFile(filePath), "0Y23456789abcdef");
+    
+    // 4. 移动后由新对象负责解除映射
+    CP::FileSystem::MappedFile moved(std::move(readWrite));
+    EXPECT_FALSE(readWrite.IsOpen());
+    ASSERT_TRUE(moved.IsOpen());
+    EXPECT_EQ(moved.Size(), content.size());
+    moved = CP::FileSystem::MappedFile();
+    EXPECT_FALSE(moved.IsOpen());
+    
+    // 5. 读写映射可以创建并扩展文件
+    std::string newPath = CreateTestFilePath("mapped_new.bin");
+    options.size = 8192;
+    CP::FileSystem::MappedFile created(newPath, options);
+    ASSERT_TRUE(created.IsOpen());
+    EXPECT_EQ(created.Size(), 8192u);
+    memcpy(created.MutableData() + 8000, "tail", 4);
+    created.Close();
+    EXPECT_EQ(CP::FileSystem::GetFileSize(newPath), 8192u);
+    EXPECT_EQ(CP::FileSystem::ReadTextFile(newPath).substr(8000, 4), "tail");
+    
+    // 6. 空文件和不存在的文件
+    std::string emptyPath = CreateTestFilePath("empty.bin");
+    ASSERT_TRUE(CP::FileSystem::WriteTextFile(emptyPath, ""));
+    CP::FileSystem::MappedFile empty(emptyPath);
+    EXPECT_TRUE(empty.IsOpen());
+    EXPECT_EQ(empty.Size(), 0u);
+    EXPECT_TRUE(empty.Text().empty());
+    
+    CP::FileSystem::MappedFile missing;
+    EXPECT_FALSE(missing.Open(CreateTestFilePath("missing.bin")));
+    EXPECT_FALSE(missing.IsOpen());
+}
+
+
+// 调用者缓冲区和 span/string_view 读写测试
+TEST_F(FileSystemTest, CallerBufferIO) {
+    std::string filePath = CreateTestFilePath("buffer.txt");
+    std::string content = "key=value\nstatus=running\n";
+    
+    // 1. 写入 string_view 的一部分，不需要构造新字符串
+    std::string_view view(content);
+    EXPECT_TRUE(CP::FileSystem::WriteTextFile(filePath, view.substr(0, 10)));
+    EXPECT_EQ(CP::FileSystem::ReadTextFile(filePath), "key=value\n");
+    std::array<uint8_t, 3> extra = {'a', 'b', '\n'};
+    EXPECT_TRUE(CP::FileSystem::AppendFile(filePath, std::span<const uint8_t>(extra)));
+    EXPECT_TRUE(CP::FileSystem::WriteTextFile(filePath, content));
+    
+    // 2. 复用缓冲区：容量足够时不重新分配
+    std::string text;
+    text.reserve(1024);
+    const char* textData = text.data();
+    for (int i = 0; i < 3; i++) {
+        ASSERT_TRUE(CP::FileSystem::ReadTextFile(filePath, text));
+        EXPECT_EQ(text, content);
+        EXPECT_EQ(text.data(), textData);
+    }
+    std::vector<uint8_t> bytes;
+    bytes.reserve(1024);
+    const uint8_t* bytesData = bytes.data();
+    ASSERT_TRUE(CP::FileSystem::ReadFile(filePath, bytes));
+    EXPECT_EQ(std::string(bytes.begin(), bytes.end()), content);
+    EXPECT_EQ(bytes.data(), bytesData);
+    
+    // 3. 固定大小的缓冲区只读取开头部分
+    std::array<uint8_t, 4> head{};
+    EXPECT_EQ(CP::FileSystem::ReadFile(filePath, std::span<uint8_t>(head)), 4);
+    EXPECT_EQ(std::string(head.begin(), head.end()), "key=");
+    std::array<uint8_t, 256> whole{};
+    EXPECT_EQ(CP::FileSystem::ReadFile(filePath, std::span<uint8_t>(whole)), static_cast<int64_t>(content.size()));
+    
+    // 4. 大文件和失败情况
+    std::vector<uint8_t> large(3 * 1024 * 1024 + 17);
+    for (size_t i = 0; i < large.size(); i++) large[i] = static_cast<uint8_t>(i * 31);
+    std::string largePath = CreateTestFilePath("large.bin");
+    EXPECT_TRUE(CP::FileSystem::WriteFile(largePath, std::span<const uint8_t>(large)));
+    ASSERT_TRUE(CP::FileSystem::ReadFile(largePath, bytes));
+    EXPECT_EQ(bytes, large);
+    
+    std::string missingPath = CreateTestFilePath("missing.txt");
+    text = "stale";
+    EXPECT_FALSE(CP::FileSystem::ReadTextFile(missingPath, text));
+    EXPECT_EQ(CP::FileSystem::ReadFile(missingPath, std::span<uint8_t>(head)), -1);
+    
+#if CP_PLATFORM_LINUX
+    // 5. /proc 文件的大小为 0，需要读到末尾
+    ASSERT_TRUE(CP::FileSystem::ReadTextFile("/proc/self/status", text));
+    EXPECT_NE(text.find("Pid:"), std::string::npos);
+#endif
+}
+
+#if !CP_PLATFORM_WINDOWS
+namespace {
+void IgnoreSignal(int) {}
+}
+
+// 管道分段到达的数据和被信号中断的读取都应读到末尾
+TEST_F(FileSystemTest, ReadFileHandlesPartialReadsAndEINTR) {
+    std::string fifoPath = CreateTestFilePath("status.fifo");
+    ASSERT_EQ(mkfifo(fifoPath.c_str(), 0600), 0);
+    
+    // 不设置 SA_RESTART，阻塞中的 read 会返回 EINTR
+    struct sigaction action {};
+    struct sigaction previous {};
+    action.sa_handler = IgnoreSignal;
+    sigemptyset(&action.sa_mask);
+    ASSERT_EQ(sigaction(SIGUSR1, &action, &previous), 0);
+    
+    const pthread_t reader = pthread_self();
+    std::thread writer([&] {
+        int fd = open(fifoPath.c_str(), O_WRONLY);
+        ASSERT_GE(fd, 0);
+        for (int i = 0; i < 5; i++) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            pthread_kill(reader, SIGUSR1);
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            std::string chunk = "chunk" + std::to_string(i) + ";";
+            ASSERT_EQ(write(fd, chunk.data(), chunk.size()), static_cast<ssize_t>(chunk.size()));
+        }
+        close(fd);
+    });
+    
+    std::string text;
+    bool ok = CP::FileSystem::ReadTextFile(fifoPath, text);
+    writer.join();
+    sigaction(SIGUSR1, &previous, nullptr);
+    
+    ASSERT_TRUE(ok) << strerror(errno);
+    EXPECT_EQ(text, "chunk0;chunk1;chunk2;chunk3;chunk4;");
+}
+#endif
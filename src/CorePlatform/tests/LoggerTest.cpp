@@ -1,10 +1,29 @@
 #include <gtest/gtest.h>
 #include "CorePlatform/Logger.h"
+#include "CorePlatform/CircularLogFile.h"
+#include "CorePlatform/Internal/LogSearch.h"
+#include "CorePlatform/Internal/LogTimeSearch.h"
+#include "CorePlatform/Internal/LogRotation.h"
+#include "CorePlatform/Internal/LogFileReader.h"
+#include "CorePlatform/Internal/BinaryLog.h"
+#include "CorePlatform/JsonUtils.h"
 #include "TestUtils.h"
 #include <thread>
 #include <future>
 #include <vector>
 #include <regex>
+#include <random>
+#include <limits>
+#include <algorithm>
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <sys/mman.h>
+#include <csignal>
+#endif
 
 using namespace CorePlatformTest;
 
@@ -22,12 +41,25 @@ protected:
     }
     
     void TearDown() override {
+        // 恢复同步模式，避免影响其他用例
+        CorePlatform::Logger::getInstance().setAsyncMode(false);
+        CorePlatform::Logger::getInstance().setRotationPolicy(CorePlatform::LogRotationPolicy());
+        CorePlatform::Logger::getInstance().clearSinks();
+        CorePlatform::Logger::getInstance().disableFlightRecorder();
+        if (sharedRing) {
+            CorePlatform::Logger::getInstance().detachSharedLogRing(sharedRing);
+            sharedRing.reset();
+        }
         // 清理临时目录
         tempDir.reset();
     }
     
     std::vector<std::string> ReadLogFileDirectly() {
-        std::ifstream file(logFilePath);
+        return ReadFileLines(logFilePath);
+    }
+    
+    static std::vector<std::string> ReadFileLines(const std::string& path) {
+        std::ifstream file(path);
         std::vector<std::string> lines;
         std::string line;
         while (std::getline(file, line)) {
@@ -38,6 +70,7 @@ protected:
     
     std::unique_ptr<TempDirectory> tempDir;
     std::string logFilePath;
+    std::shared_ptr<CorePlatform::SharedLogRing> sharedRing;
 };
 
 // 测试单例模式
@@ -250,4 +283,2037 @@ TEST_F(LoggerTest, LargeLogHandling) {
     ASSERT_EQ(logs.size(), 1);
     ASSERT_GT(logs[0].size(), 10*1024);
     ASSERT_TRUE(logs[0].find(largeMsg) != std::string::npos);
-}
\ No newline at end of file
+}
+
+// 测试异步模式：多线程写入后 flush，所有日志都应落盘
+TEST_F(LoggerTest, AsyncModeWritesAllRecords) {
+    CorePlatform::Logger& logger = CorePlatform::Logger::getInstance();
+    logger.setAsyncMode(true, 1024, CorePlatform::LogOverflowPolicy::Block);
+    ASSERT_TRUE(logger.isAsyncMode());
+    
+    constexpr int THREAD_COUNT = 8;
+    constexpr int LOGS_PER_THREAD = 500;
+    
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREAD_COUNT; t++) {
+        threads.emplace_back([&logger, t]() {
+            for (int i = 0; i < LOGS_PER_THREAD; i++) {
+                logger.info("Async thread " + std::to_string(t) + " log " + std::to_string(i));
+            }
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+    logger.flush();
+    
+    auto allLogs = logger.readAllLogs();
+    ASSERT_EQ(allLogs.size(), THREAD_COUNT * LOGS_PER_THREAD);
+    
+    // 同一线程的日志保持提交顺序
+    std::vector<int> lastSeen(THREAD_COUNT, -1);
+    std::regex entryPattern(R"(\[.+\] \[INFO\] Async thread (\d+) log (\d+))");
+    for (const auto& line : allLogs) {
+        std::smatch match;
+        ASSERT_TRUE(std::regex_match(line, match, entryPattern)) << line;
+        int threadId = std::stoi(match[1]);
+        int index = std::stoi(match[2]);
+        ASSERT_GT(index, lastSeen[threadId]);
+        lastSeen[threadId] = index;
+    }
+}
+
+// 测试异步模式的丢弃策略：写出条数与丢弃条数之和等于提交条数
+TEST_F(LoggerTest, AsyncOverflowDropPolicy) {
+    CorePlatform::Logger& logger = CorePlatform::Logger::getInstance();
+    const uint64_t droppedBefore = logger.getDroppedCount();
+    logger.setAsyncMode(true, 16, CorePlatform::LogOverflowPolicy::Drop);
+    
+    constexpr int TOTAL = 5000;
+    for (int i = 0; i < TOTAL; i++) {
+        logger.info("Drop policy log " + std::to_string(i));
+    }
+    logger.flush();
+    
+    auto allLogs = logger.readAllLogs();
+    const uint64_t dropped = logger.getDroppedCount() - droppedBefore;
+    EXPECT_EQ(allLogs.size() + dropped, static_cast<size_t>(TOTAL));
+}
+
+// 测试丢弃最旧策略：最后一条日志一定被保留
+TEST_F(LoggerTest, AsyncOverflowDropOldestPolicy) {
+    CorePlatform::Logger& logger = CorePlatform::Logger::getInstance();
+    logger.setAsyncMode(true, 16, CorePlatform::LogOverflowPolicy::DropOldest);
+    
+    constexpr int TOTAL = 5000;
+    for (int i = 0; i < TOTAL; i++) {
+        logger.info("Drop oldest log " + std::to_string(i));
+    }
+    logger.flush();
+    
+    auto allLogs = logger.readAllLogs();
+    ASSERT_FALSE(allLogs.empty());
+    VerifyLogEntry(allLogs, CorePlatform::LogLevel::INFO, "Drop oldest log " + std::to_string(TOTAL - 1));
+}
+
+// 测试关闭异步模式时会写完队列中剩余的日志
+TEST_F(LoggerTest, AsyncDisableDrainsQueue) {
+    CorePlatform::Logger& logger = CorePlatform::Logger::getInstance();
+    logger.setAsyncMode(true);
+    
+    for (int i = 0; i < 100; i++) {
+        logger.warn("Pending log " + std::to_string(i));
+    }
+    logger.setAsyncMode(false);
+    ASSERT_FALSE(logger.isAsyncMode());
+    
+    auto allLogs = logger.readAllLogs();
+    ASSERT_EQ(allLogs.size(), 100);
+    
+    // 切回同步模式后立即可见
+    logger.info("Sync again");
+    VerifyLogEntry(logger.readAllLogs(), CorePlatform::LogLevel::INFO, "Sync again");
+}
+
+// 测试格式化日志接口
+TEST_F(LoggerTest, FormattedLogging) {
+    CorePlatform::Logger& logger = CorePlatform::Logger::getInstance();
+    
+    std::string name = "worker";
+    logger.log(CorePlatform::LogLevel::INFO, "task {} finished in {} ms", 42, 3.5);
+    logger.warn("name={} ok={} ch={}", name, true, 'x');
+    logger.error("literal braces {{}} and {}", "value");
+    logger.info("no placeholders");
+    char buffer[16] = "array";
+    logger.info("from {}", buffer);
+    
+    auto logs = logger.readAllLogs();
+    ASSERT_EQ(logs.size(), 5);
+    VerifyLogEntry(logs, CorePlatform::LogLevel::INFO, "task 42 finished in 3.5 ms");
+    VerifyLogEntry(logs, CorePlatform::LogLevel::WARN, "name=worker ok=true ch=x");
+    VerifyLogEntry(logs, CorePlatform::LogLevel::ERR, "literal braces {} and value");
+    VerifyLogEntry(logs, CorePlatform::LogLevel::INFO, "no placeholders");
+    VerifyLogEntry(logs, CorePlatform::LogLevel::INFO, "from array");
+}
+
+// 测试格式串的编译期校验
+TEST_F(LoggerTest, FormatStringValidation) {
+    using CorePlatform::Internal::countLogPlaceholders;
+    static_assert(countLogPlaceholders("plain") == 0);
+    static_assert(countLogPlaceholders("{} and {}") == 2);
+    static_assert(countLogPlaceholders("{{}} {}") == 1);
+    static_assert(countLogPlaceholders("unclosed {") == -1);
+    static_assert(countLogPlaceholders("stray }") == -1);
+    static_assert(countLogPlaceholders("{:x}") == -1);
+    
+    // 占位符与参数个数一致时才能构造格式串
+    static_assert(std::is_constructible_v<CorePlatform::LogFormat<int>, const char (&)[3]>);
+}
+
+// 测试日志宏：级别被过滤时不对参数求值
+TEST_F(LoggerTest, MacroSkipsDisabledLevels) {
+    CorePlatform::Logger& logger = CorePlatform::Logger::getInstance();
+    logger.setLevel(CorePlatform::LogLevel::INFO);
+    
+    int evaluations = 0;
+    auto expensive = [&evaluations]() {
+        ++evaluations;
+        return evaluations;
+    };
+    
+    for (int i = 0; i < 1000; i++) {
+        CP_LOG_DEBUG("debug value {}", expensive());
+        CP_LOG_TRACE("trace value {}", expensive());
+    }
+    EXPECT_EQ(evaluations, 0);
+    
+    CP_LOG_INFO("info value {}", expensive());
+    CP_LOG_ERROR("error without args");
+    EXPECT_EQ(evaluations, 1);
+    
+    auto logs = logger.readAllLogs();
+    ASSERT_EQ(logs.size(), 2);
+    VerifyLogEntry(logs, CorePlatform::LogLevel::INFO, "info value 1");
+    VerifyLogEntry(logs, CorePlatform::LogLevel::ERR, "error without args");
+}
+
+// 测试日志时间戳格式切换
+TEST_F(LoggerTest, TimestampFormats) {
+    CorePlatform::Logger& logger = CorePlatform::Logger::getInstance();
+    
+    logger.setTimestampFormat(CorePlatform::TimestampFormat::LocalMicros);
+    logger.info("micro precision");
+    logger.setTimestampFormat(CorePlatform::TimestampFormat::UtcIso8601Millis);
+    logger.info("utc iso");
+    logger.setTimestampFormat(CorePlatform::TimestampFormat::LocalMillis);
+    
+    auto logs = logger.readAllLogs();
+    ASSERT_EQ(logs.size(), 2);
+    std::regex microPattern(R"(\[\d{4}-\d{2}-\d{2} \d{2}:\d{2}:\d{2}\.\d{6}\] \[INFO\] micro precision)");
+    std::regex isoPattern(R"(\[\d{4}-\d{2}-\d{2}T\d{2}:\d{2}:\d{2}\.\d{3}Z\] \[INFO\] utc iso)");
+    EXPECT_TRUE(std::regex_match(logs[0], microPattern)) << logs[0];
+    EXPECT_TRUE(std::regex_match(logs[1], isoPattern)) << logs[1];
+}
+
+// 测试索引随文件增长增量更新，以及末尾不完整行的处理
+TEST_F(LoggerTest, IncrementalIndexedReading) {
+    CorePlatform::Logger& logger = CorePlatform::Logger::getInstance();
+    
+    for (int i = 1; i <= 200; i++) {
+        logger.info("Indexed entry " + std::to_string(i));
+    }
+    auto range = logger.readLogsInRange(100, 102);
+    ASSERT_EQ(range.size(), 3);
+    VerifyLogEntry(range, CorePlatform::LogLevel::INFO, "Indexed entry 100");
+    
+    // 继续追加后，只需扫描新增部分即可读到新行
+    for (int i = 201; i <= 300; i++) {
+        logger.info("Indexed entry " + std::to_string(i));
+    }
+    range = logger.readLogsInRange(250, 251);
+    ASSERT_EQ(range.size(), 2);
+    VerifyLogEntry(range, CorePlatform::LogLevel::INFO, "Indexed entry 250");
+    VerifyLogEntry(range, CorePlatform::LogLevel::INFO, "Indexed entry 251");
+    ASSERT_EQ(logger.readAllLogs().size(), 300);
+    
+    // 外部写入一段没有换行符的内容：视为最后一行
+    {
+        std::ofstream raw(logFilePath, std::ios::app | std::ios::binary);
+        raw << "partial line without newline";
+    }
+    auto tail = logger.readLogsFromEnd(2);
+    ASSERT_EQ(tail.size(), 2);
+    VerifyLogEntry(tail, CorePlatform::LogLevel::INFO, "Indexed entry 300");
+    EXPECT_EQ(tail[1], "partial line without newline");
+    ASSERT_EQ(logger.readAllLogs().size(), 301);
+    
+    // 文件被截断后索引重建
+    {
+        std::ofstream truncate(logFilePath, std::ios::trunc | std::ios::binary);
+        truncate << "first\nsecond\n";
+    }
+    auto all = logger.readAllLogs();
+    ASSERT_EQ(all.size(), 2);
+    EXPECT_EQ(all[0], "first");
+    EXPECT_EQ(logger.readLogsFromEnd(1)[0], "second");
+    
+    // 截断后又写入更多内容（超过之前已索引的部分）：同样重建索引
+    {
+        std::ofstream rewrite(logFilePath, std::ios::trunc | std::ios::binary);
+        for (int i = 0; i < 100; i++) {
+            rewrite << "rewritten line " << i << "\n";
+        }
+    }
+    all = logger.readAllLogs();
+    ASSERT_EQ(all.size(), 100);
+    EXPECT_EQ(all[0], "rewritten line 0");
+    range = logger.readLogsInRange(50, 50);
+    ASSERT_EQ(range.size(), 1);
+    EXPECT_EQ(range[0], "rewritten line 49");
+    
+    // 日志文件被删除后与不存在时一样抛出异常，而不是返回已删除文件的旧内容
+    ASSERT_TRUE(std::filesystem::remove(logFilePath));
+    EXPECT_THROW(logger.readAllLogs(), std::runtime_error);
+    EXPECT_THROW(logger.readLogsFromEnd(1), std::runtime_error);
+}
+
+// 测试读取日志时不阻塞写入
+TEST_F(LoggerTest, ReadWhileLogging) {
+    CorePlatform::Logger& logger = CorePlatform::Logger::getInstance();
+    constexpr int TOTAL = 2000;
+    
+    std::atomic<bool> done{false};
+    std::thread writer([&]() {
+        for (int i = 0; i < TOTAL; i++) {
+            logger.info("Concurrent entry " + std::to_string(i));
+        }
+        done = true;
+    });
+    
+    size_t lastCount = 0;
+    while (!done) {
+        auto tail = logger.readLogsFromEnd(5);
+        ASSERT_LE(tail.size(), 5u);
+        size_t count = logger.readAllLogs().size();
+        ASSERT_GE(count, lastCount);
+        lastCount = count;
+    }
+    writer.join();
+    
+    ASSERT_EQ(logger.readAllLogs().size(), TOTAL);
+    auto last = logger.readLogsFromEnd(1);
+    ASSERT_EQ(last.size(), 1);
+    VerifyLogEntry(last, CorePlatform::LogLevel::INFO, "Concurrent entry " + std::to_string(TOTAL - 1));
+}
+
+// 测试搜索返回行号和偏移
+TEST_F(LoggerTest, SearchLogsReportsPositions) {
+    CorePlatform::Logger& logger = CorePlatform::Logger::getInstance();
+    
+    for (int i = 1; i <= 150; i++) {
+        if (i % 50 == 0) {
+            logger.warn("Disk QUOTA exceeded on volume " + std::to_string(i));
+        } else {
+            logger.info("Routine entry " + std::to_string(i));
+        }
+    }
+    
+    auto matches = logger.searchLogs("quota");
+    ASSERT_EQ(matches.size(), 3);
+    
+    // 偏移指向文件中的原始文本
+    std::ifstream file(logFilePath, std::ios::binary);
+    std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    for (size_t i = 0; i < matches.size(); i++) {
+        EXPECT_EQ(matches[i].lineNumber, (i + 1) * 50);
+        EXPECT_EQ(matches[i].length, 5u);
+        EXPECT_EQ(contents.substr(matches[i].offset, 5), "QUOTA");
+    }
+    
+    // 范围和数量限制
+    matches = logger.searchLogs("Quota", 60, -1);
+    ASSERT_EQ(matches.size(), 2);
+    EXPECT_EQ(matches[0].lineNumber, 100u);
+    ASSERT_EQ(logger.searchLogs("entry", 0, -1, 7).size(), 7);
+    ASSERT_EQ(logger.searchLogs("entry").size(), 147);
+    
+    // 同一行内的多处匹配互不重叠
+    logger.info("aaaa AAAA");
+    matches = logger.searchLogs("aa", -1, -1);
+    ASSERT_EQ(matches.size(), 4);
+    EXPECT_EQ(matches[0].lineNumber, 151u);
+    
+    // 关键词不会跨行匹配
+    ASSERT_TRUE(logger.searchLogs("150\n[").empty());
+    ASSERT_FALSE(logger.containsInLogs("volume 150\n"));
+}
+
+// 测试多关键词和正则搜索
+TEST_F(LoggerTest, SearchLogsMultiTermAndRegex) {
+    CorePlatform::Logger& logger = CorePlatform::Logger::getInstance();
+    
+    logger.info("user alice logged in");
+    logger.error("Connection reset by peer");
+    logger.info("user bob logged in");
+    logger.warn("Timeout after 30s");
+    
+    auto matches = logger.searchLogsAny({"TIMEOUT", "", "user", "reset"});
+    ASSERT_EQ(matches.size(), 4);
+    EXPECT_EQ(matches[0].termIndex, 2u);
+    EXPECT_EQ(matches[0].lineNumber, 1u);
+    EXPECT_EQ(matches[1].termIndex, 3u);
+    EXPECT_EQ(matches[1].lineNumber, 2u);
+    EXPECT_EQ(matches[2].termIndex, 2u);
+    EXPECT_EQ(matches[3].termIndex, 0u);
+    EXPECT_EQ(matches[3].lineNumber, 4u);
+    for (size_t i = 1; i < matches.size(); i++) {
+        EXPECT_LT(matches[i - 1].offset, matches[i].offset);
+    }
+    
+    matches = logger.searchLogsRegex("USER (\\w+) logged");
+    ASSERT_EQ(matches.size(), 2);
+    EXPECT_EQ(matches[1].lineNumber, 3u);
+    std::ifstream file(logFilePath, std::ios::binary);
+    std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    EXPECT_EQ(contents.substr(matches[1].offset, matches[1].length), "user bob logged");
+    
+    ASSERT_EQ(logger.searchLogsRegex("\\d+s$").size(), 1);
+    ASSERT_EQ(logger.searchLogsRegex("logged", 2, 3).size(), 1);
+    EXPECT_THROW(logger.searchLogsRegex("(unclosed"), std::regex_error);
+}
+
+// 测试向量化匹配器与朴素实现结果一致（覆盖不同长度、对齐和尾部）
+TEST(LogSearchTest, MatcherAgreesWithNaiveSearch) {
+    std::mt19937 rng(12345);
+    const std::string alphabet = "aAbB\xC3\xA4[]_ \n";
+    
+    auto naiveFind = [](const std::string& text, const std::string& pattern, size_t from) {
+        for (size_t i = from; i + pattern.size() <= text.size(); i++) {
+            bool equal = true;
+            for (size_t j = 0; j < pattern.size() && equal; j++) {
+                equal = CorePlatform::Internal::foldAsciiCase(text[i + j]) ==
+                        CorePlatform::Internal::foldAsciiCase(pattern[j]);
+            }
+            if (equal) return i;
+        }
+        return std::string::npos;
+    };
+    
+    for (int round = 0; round < 2000; round++) {
+        std::string text(rng() % 200, ' ');
+        for (char& ch : text) ch = alphabet[rng() % alphabet.size()];
+        std::string pattern(1 + rng() % 6, ' ');
+        for (char& ch : pattern) ch = alphabet[rng() % alphabet.size()];
+        
+        CorePlatform::Internal::CaseInsensitiveMatcher matcher(pattern);
+        const size_t from = text.empty() ? 0 : rng() % text.size();
+        ASSERT_EQ(matcher.find(text, from), naiveFind(text, pattern, from))
+            << "pattern=" << pattern << " text=" << text << " from=" << from
+            << " impl=" << CorePlatform::Internal::CaseInsensitiveMatcher::implementationName();
+    }
+    
+    CorePlatform::Internal::CaseInsensitiveMatcher empty("");
+    EXPECT_EQ(empty.find("abc", 3), 3u);
+    EXPECT_EQ(empty.find("abc", 4), std::string::npos);
+}
+
+// 测试按大小轮转，读取接口覆盖所有分段
+TEST_F(LoggerTest, SizeRotationCoversSegments) {
+    CorePlatform::Logger& logger = CorePlatform::Logger::getInstance();
+    CorePlatform::LogRotationPolicy policy;
+    policy.maxFileSize = 2000;
+    logger.setRotationPolicy(policy);
+    
+    for (int i = 1; i <= 200; i++) {
+        logger.info("Rotating entry " + std::to_string(i));
+    }
+    
+    auto segments = logger.getRotatedLogFiles();
+    ASSERT_GE(segments.size(), 4u);
+    for (const auto& segment : segments) {
+        EXPECT_LE(std::filesystem::file_size(segment), 2000u);
+    }
+    EXPECT_LE(std::filesystem::file_size(logFilePath), 2000u);
+    
+    auto all = logger.readAllLogs();
+    ASSERT_EQ(all.size(), 200);
+    for (int i = 0; i < 200; i++) {
+        ASSERT_NE(all[i].find("Rotating entry " + std::to_string(i + 1)), std::string::npos) << all[i];
+    }
+    
+    auto head = logger.readLogsFromBeginning(70);
+    ASSERT_EQ(head.size(), 70);
+    EXPECT_EQ(head, std::vector<std::string>(all.begin(), all.begin() + 70));
+    
+    auto tail = logger.readLogsFromEnd(90);
+    ASSERT_EQ(tail.size(), 90);
+    EXPECT_EQ(tail, std::vector<std::string>(all.end() - 90, all.end()));
+    
+    auto range = logger.readLogsInRange(25, 125);
+    ASSERT_EQ(range.size(), 101);
+    EXPECT_EQ(range, std::vector<std::string>(all.begin() + 24, all.begin() + 125));
+    
+    ASSERT_TRUE(logger.containsInLogs("ROTATING entry 1", 1, 1));
+    ASSERT_FALSE(logger.containsInLogs("entry 200", 1, 100));
+    
+    // 行号和偏移按“分段在前、当前文件在后”连续编号
+    std::string concatenated;
+    for (const auto& segment : segments) {
+        std::ifstream file(segment, std::ios::binary);
+        concatenated.append(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    {
+        std::ifstream file(logFilePath, std::ios::binary);
+        concatenated.append(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    auto matches = logger.searchLogs("entry 1");
+    ASSERT_EQ(matches.size(), 111);  // 1, 10-19, 100-199
+    EXPECT_EQ(matches.back().lineNumber, 199u);
+    for (const auto& match : matches) {
+        EXPECT_EQ(concatenated.substr(match.offset, match.length), "entry 1");
+    }
+    auto regexMatches = logger.searchLogsRegex("entry 150$");
+    ASSERT_EQ(regexMatches.size(), 1);
+    EXPECT_EQ(regexMatches[0].lineNumber, 150u);
+    EXPECT_EQ(concatenated.substr(regexMatches[0].offset, regexMatches[0].length), "entry 150");
+}
+
+// 测试按天轮转的时刻：用构造的本地时间代替系统时钟
+TEST_F(LoggerTest, DailyRotationBoundary) {
+    auto localTime = [](int year, int month, int day, int hour, int minute, int second) {
+        std::tm bt{};
+        bt.tm_year = year - 1900;
+        bt.tm_mon = month - 1;
+        bt.tm_mday = day;
+        bt.tm_hour = hour;
+        bt.tm_min = minute;
+        bt.tm_sec = second;
+        bt.tm_isdst = -1;
+        return std::chrono::system_clock::from_time_t(std::mktime(&bt));
+    };
+    using CorePlatform::Internal::nextDailyRotation;
+    
+    // 默认在本地零点，与何时开始计算无关
+    EXPECT_EQ(nextDailyRotation(localTime(2024, 3, 15, 23, 59, 59), 0), localTime(2024, 3, 16, 0, 0, 0));
+    EXPECT_EQ(nextDailyRotation(localTime(2024, 3, 15, 0, 0, 1), 0), localTime(2024, 3, 16, 0, 0, 0));
+    EXPECT_EQ(nextDailyRotation(localTime(2024, 3, 16, 0, 0, 0), 0), localTime(2024, 3, 17, 0, 0, 0));
+    // 跨月
+    EXPECT_EQ(nextDailyRotation(localTime(2024, 2, 29, 12, 0, 0), 0), localTime(2024, 3, 1, 0, 0, 0));
+    
+    // 指定时刻：当天尚未到达时在当天轮转
+    EXPECT_EQ(nextDailyRotation(localTime(2024, 3, 15, 5, 30, 0), 6), localTime(2024, 3, 15, 6, 0, 0));
+    EXPECT_EQ(nextDailyRotation(localTime(2024, 3, 15, 6, 0, 0), 6), localTime(2024, 3, 16, 6, 0, 0));
+    EXPECT_EQ(nextDailyRotation(localTime(2024, 3, 15, 23, 0, 0), 6), localTime(2024, 3, 16, 6, 0, 0));
+    EXPECT_EQ(nextDailyRotation(localTime(2024, 3, 15, 12, 0, 0), 99), localTime(2024, 3, 15, 23, 0, 0));
+    
+    // 重新打开前一天写过的文件：从文件的修改时间算起，第一次写入即轮转
+    CorePlatform::Logger& logger = CorePlatform::Logger::getInstance();
+    logger.info("written yesterday");
+    std::filesystem::last_write_time(logFilePath,
+                                     std::filesystem::file_time_type::clock::now() - std::chrono::hours(48));
+    ASSERT_TRUE(logger.setLogFile(logFilePath));
+    CorePlatform::LogRotationPolicy policy;
+    policy.daily = true;
+    logger.setRotationPolicy(policy);
+    logger.info("written today");
+    
+    const auto segments = logger.getRotatedLogFiles();
+    ASSERT_EQ(segments.size(), 1u);
+    const auto rotated = ReadFileLines(segments[0]);
+    ASSERT_EQ(rotated.size(), 1u);
+    VerifyLogEntry(rotated, CorePlatform::LogLevel::INFO, "written yesterday");
+    const auto current = ReadLogFileDirectly();
+    ASSERT_EQ(current.size(), 1u);
+    VerifyLogEntry(current, CorePlatform::LogLevel::INFO, "written today");
+    
+    // 同一天内继续写入不再轮转
+    logger.info("still today");
+    EXPECT_EQ(logger.getRotatedLogFiles().size(), 1u);
+}
+
+// 测试保留个数与后台压缩
+TEST_F(LoggerTest, RotationRetentionAndCompression) {
+    CorePlatform::Logger& logger = CorePlatform::Logger::getInstance();
+    CorePlatform::LogRotationPolicy policy;
+    policy.maxFileSize = 1000;
+    policy.maxFiles = 2;
+    policy.compress = true;
+    logger.setRotationPolicy(policy);
+    
+    for (int i = 1; i <= 150; i++) {
+        logger.info("Retained entry " + std::to_string(i));
+    }
+    
+    // 压缩和清理在后台进行，等待其完成（构建不支持 zlib 时分段保持未压缩）
+    const bool compressed = CorePlatform::Internal::logCompressionAvailable();
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    std::vector<std::string> segments;
+    while (std::chrono::steady_clock::now() < deadline) {
+        segments = logger.getRotatedLogFiles();
+        bool settled = segments.size() <= 2;
+        for (const auto& segment : segments) {
+            settled = settled && (!compressed || segment.substr(segment.size() - 3) == ".gz");
+        }
+        if (settled) break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_EQ(segments.size(), 2);
+    for (const auto& segment : segments) {
+        EXPECT_EQ(segment.substr(segment.size() - 3) == ".gz", compressed) << segment;
+    }
+    
+    // 读取透明地解压分段，内容为最新的连续日志
+    auto all = logger.readAllLogs();
+    ASSERT_FALSE(all.empty());
+    ASSERT_LT(all.size(), 150u);
+    const int firstEntry = 150 - static_cast<int>(all.size()) + 1;
+    for (size_t i = 0; i < all.size(); i++) {
+        ASSERT_NE(all[i].find("Retained entry " + std::to_string(firstEntry + static_cast<int>(i))),
+                  std::string::npos) << all[i];
+    }
+    ASSERT_TRUE(logger.containsInLogs("retained entry " + std::to_string(firstEntry), 1, 1));
+}
+
+// 测试压缩分段只在访问时解压，解压内容超过缓存上限时释放最久未访问的分段
+TEST_F(LoggerTest, CompressedSegmentsLoadLazily) {
+    if (!CorePlatform::Internal::logCompressionAvailable()) {
+        GTEST_SKIP() << "zlib not available";
+    }
+    
+    const std::string logPath = tempDir->CreateFilePath("lazy.log");
+    std::vector<CorePlatform::Internal::LogSegment> segments;
+    {
+        CorePlatform::Internal::LogMaintenanceWorker worker;
+        for (uint64_t sequence = 1; sequence <= 2; sequence++) {
+            const std::string segmentPath = CorePlatform::Internal::logSegmentPath(logPath, sequence);
+            std::ofstream out(segmentPath, std::ios::binary);
+            for (int i = 0; i < 100; i++) {
+                out << "segment " << sequence << " line " << i << "\n";
+            }
+            out << "segment " << sequence << " tail";
+            out.close();
+            worker.schedule(logPath, segmentPath, true, 0);
+        }
+        worker.waitIdle();
+        segments = CorePlatform::Internal::listLogSegments(logPath);
+    }
+    ASSERT_EQ(segments.size(), 2u);
+    ASSERT_TRUE(segments[0].compressed);
+    
+    // 上限只容得下一个分段
+    CorePlatform::Internal::LogSegmentCache cache(2000);
+    CorePlatform::Internal::LogSegmentReader first(segments[0], cache);
+    CorePlatform::Internal::LogSegmentReader second(segments[1], cache);
+    
+    // 统计行数不保留解压内容
+    EXPECT_EQ(first.lineCount(), 101u);
+    EXPECT_EQ(second.lineCount(), 101u);
+    EXPECT_EQ(cache.usedBytes(), 0u);
+    
+    CorePlatform::Internal::LogFileReader* reader = first.load();
+    ASSERT_NE(reader, nullptr);
+    EXPECT_EQ(reader->readLines(100, 101), std::vector<std::string>{"segment 1 tail"});
+    EXPECT_EQ(cache.usedBytes(), first.size());
+    
+    reader = second.load();
+    ASSERT_NE(reader, nullptr);
+    EXPECT_EQ(reader->readLines(0, 1), std::vector<std::string>{"segment 2 line 0"});
+    EXPECT_EQ(cache.usedBytes(), second.size());
+    
+    // 被释放的分段仍可定位行号，再次访问时重新解压
+    EXPECT_EQ(first.lineCount(), 101u);
+    reader = first.load();
+    ASSERT_NE(reader, nullptr);
+    EXPECT_EQ(reader->readLines(50, 51), std::vector<std::string>{"segment 1 line 50"});
+}
+
+// 测试异步模式下的轮转
+TEST_F(LoggerTest, AsyncModeRotation) {
+    CorePlatform::Logger& logger = CorePlatform::Logger::getInstance();
+    CorePlatform::LogRotationPolicy policy;
+    policy.maxFileSize = 4096;
+    logger.setRotationPolicy(policy);
+    logger.setAsyncMode(true, 1024);
+    
+    constexpr int TOTAL = 1000;
+    for (int i = 0; i < TOTAL; i++) {
+        logger.info("Async rotated entry {}", i);
+    }
+    logger.flush();
+    
+    EXPECT_GE(logger.getRotatedLogFiles().size(), 5u);
+    auto all = logger.readAllLogs();
+    ASSERT_EQ(all.size(), TOTAL);
+    VerifyLogEntry(std::vector<std::string>(all.end() - 1, all.end()),
+                   CorePlatform::LogLevel::INFO, "Async rotated entry " + std::to_string(TOTAL - 1));
+}
+
+// 测试二进制日志文件：记录参数原始字节，解码后与文本格式一致
+TEST_F(LoggerTest, BinaryFileFormatRoundTrip) {
+    CorePlatform::Logger& logger = CorePlatform::Logger::getInstance();
+    const std::string binaryPath = tempDir->CreateFilePath("test.cpblog");
+    ASSERT_TRUE(logger.setLogFile(binaryPath, CorePlatform::LogFileFormat::Binary));
+    
+    enum class Color : uint8_t { Red = 7 };
+    const char* nullText = nullptr;
+    const std::string owned = "owned string";
+    int marker = 0;
+    
+    logger.info("ints {} {} {} {}", -42, 7u, int64_t{-9000000000}, static_cast<unsigned char>(200));
+    logger.warn("floats {} {} {}", 1.5f, 0.1, 2.5L);
+    logger.error("text {} {} {} {{literal}}", owned, "literal", nullText);
+    logger.debug("filtered {}", 1);
+    logger.info("misc {} {} {} {} {}", true, 'x', Color::Red, nullptr, static_cast<const void*>(&marker));
+    logger.info("plain message");
+    CP_LOG_INFO("macro {}", 3);
+    logger.flush();
+    
+    // 读取接口不覆盖二进制文件
+    EXPECT_TRUE(logger.readAllLogs().empty());
+    
+    std::vector<std::string> lines;
+    std::string error;
+    ASSERT_TRUE(CorePlatform::Internal::decodeBinaryLog(binaryPath, lines,
+                                                        CorePlatform::TimestampFormat::LocalMillis, &error)) << error;
+    ASSERT_EQ(lines.size(), 6);
+    
+    std::string pointerText;
+    CorePlatform::Internal::appendLogArg(pointerText, static_cast<const void*>(&marker));
+    VerifyLogEntry(lines, CorePlatform::LogLevel::INFO, "ints -42 7 -9000000000 200");
+    VerifyLogEntry(lines, CorePlatform::LogLevel::WARN, "floats 1.5 0.1 2.5");
+    VerifyLogEntry(lines, CorePlatform::LogLevel::ERR, "text owned string literal (null) {literal}");
+    VerifyLogEntry(lines, CorePlatform::LogLevel::INFO, "misc true x 7 0x0 " + pointerText);
+    VerifyLogEntry(lines, CorePlatform::LogLevel::INFO, "plain message");
+    VerifyLogEntry(lines, CorePlatform::LogLevel::INFO, "macro 3");
+    
+    const std::regex pattern(R"(^\[\d{4}-\d{2}-\d{2} \d{2}:\d{2}:\d{2}\.\d{3}\] \[(INFO|WARN|ERROR)\] .+$)");
+    for (const auto& line : lines) {
+        EXPECT_TRUE(std::regex_match(line, pattern)) << line;
+    }
+    
+    // 可以切换回文本文件
+    ASSERT_TRUE(logger.setLogFile(logFilePath));
+    logger.info("back to text");
+    VerifyLogEntry(logger.readAllLogs(), CorePlatform::LogLevel::INFO, "back to text");
+    
+    // 再次切换到二进制文件：新文件只包含之后的记录，并带有完整的格式串字典
+    const std::string secondPath = tempDir->CreateFilePath("second.cpblog");
+    ASSERT_TRUE(logger.setLogFile(secondPath, CorePlatform::LogFileFormat::Binary));
+    logger.info("ints {} {} {} {}", 1, 2u, int64_t{3}, static_cast<unsigned char>(4));
+    logger.flush();
+    lines.clear();
+    ASSERT_TRUE(CorePlatform::Internal::decodeBinaryLog(secondPath, lines,
+                                                        CorePlatform::TimestampFormat::LocalMillis, &error)) << error;
+    ASSERT_EQ(lines.size(), 1);
+    VerifyLogEntry(lines, CorePlatform::LogLevel::INFO, "ints 1 2 3 4");
+}
+
+// 测试多线程、暂存缓冲区回绕和超大记录
+TEST_F(LoggerTest, BinaryFileFormatConcurrentAndLarge) {
+    CorePlatform::Logger& logger = CorePlatform::Logger::getInstance();
+    const std::string binaryPath = tempDir->CreateFilePath("concurrent.cpblog");
+    ASSERT_TRUE(logger.setLogFile(binaryPath, CorePlatform::LogFileFormat::Binary));
+    
+    constexpr int THREADS = 4;
+    constexpr int PER_THREAD = 3000;
+    const std::string payload(700, 'p');  // 每线程写入量超过暂存缓冲区容量，触发回绕
+    
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; t++) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < PER_THREAD; i++) {
+                logger.info("thread {} seq {} {}", t, i, payload);
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    
+    const std::string huge(CorePlatform::Internal::BinaryLogSink::kStagingCapacity + 10, 'h');
+    logger.info("huge {}", huge);
+    logger.flush();
+    
+    std::vector<std::string> lines;
+    ASSERT_TRUE(CorePlatform::Internal::decodeBinaryLog(binaryPath, lines));
+    ASSERT_EQ(lines.size(), THREADS * PER_THREAD + 1);
+    
+    // 每个线程内的顺序保持不变
+    std::vector<int> nextSeq(THREADS, 0);
+    const std::regex pattern(R"(thread (\d+) seq (\d+) p{700}$)");
+    for (const auto& line : lines) {
+        std::smatch match;
+        if (line.find("huge ") != std::string::npos) {
+            EXPECT_EQ(line.size() - line.find("huge ") - 5, huge.size());
+            continue;
+        }
+        ASSERT_TRUE(std::regex_search(line, match, pattern)) << line.substr(0, 80);
+        const int t = std::stoi(match[1]);
+        ASSERT_EQ(std::stoi(match[2]), nextSeq[t]);
+        nextSeq[t]++;
+    }
+}
+
+// 测试内存环形输出：级别过滤、容量覆盖和自定义格式
+TEST_F(LoggerTest, MemoryRingSinkKeepsRecentEntries) {
+    CorePlatform::LogSinkOptions options;
+    options.level = CorePlatform::LogLevel::WARN;
+    CorePlatform::MemoryRingSink ring(3, options);
+    ring.setFormatter([](std::string& out, const CorePlatform::LogEntry& entry) {
+        out += CorePlatform::logLevelName(entry.level);
+        out += ':';
+        out += entry.message;
+    });
+    
+    const auto now = std::chrono::system_clock::now();
+    ring.log(CorePlatform::LogLevel::INFO, now, "filtered");
+    for (int i = 1; i <= 5; i++) {
+        ring.log(CorePlatform::LogLevel::ERR, now, "error " + std::to_string(i));
+    }
+    EXPECT_EQ(ring.snapshot(), (std::vector<std::string>{"ERROR:error 3", "ERROR:error 4", "ERROR:error 5"}));
+    
+    // 恢复默认格式
+    ring.setFormatter(nullptr);
+    ring.clear();
+    ring.log(CorePlatform::LogLevel::WARN, now, "default format");
+    VerifyLogEntry(ring.snapshot(), CorePlatform::LogLevel::WARN, "default format");
+}
+
+// 测试多个输出同时生效，各自独立过滤
+TEST_F(LoggerTest, MultipleSinksReceiveEntries) {
+    CorePlatform::Logger& logger = CorePlatform::Logger::getInstance();
+    
+    auto everything = std::make_shared<CorePlatform::MemoryRingSink>(100);
+    CorePlatform::LogSinkOptions errorOptions;
+    errorOptions.level = CorePlatform::LogLevel::ERR;
+    errorOptions.asynchronous = true;
+    errorOptions.flushInterval = std::chrono::milliseconds(50);
+    auto errorsOnly = std::make_shared<CorePlatform::MemoryRingSink>(100, errorOptions);
+    
+    CorePlatform::LogSinkOptions fileOptions;
+    fileOptions.asynchronous = true;
+    fileOptions.flushInterval = std::chrono::milliseconds(20);
+    const std::string sinkPath = tempDir->CreateFilePath("sink/extra.log");
+    auto file = std::make_shared<CorePlatform::FileSink>(sinkPath, fileOptions);
+    ASSERT_TRUE(file->isOpen());
+    
+    logger.addSink(everything);
+    logger.addSink(errorsOnly);
+    logger.addSink(file);
+    logger.addSink(file);  // 重复添加被忽略
+    EXPECT_EQ(logger.getSinks().size(), 3);
+    
+    logger.debug("below global level");
+    logger.info("info {}", 1);
+    logger.error("error {}", 2);
+    logger.warn("plain warning");
+    logger.flush();
+    
+    VerifyLogEntry(everything->snapshot(), CorePlatform::LogLevel::INFO, "info 1");
+    VerifyLogEntry(everything->snapshot(), CorePlatform::LogLevel::ERR, "error 2");
+    VerifyLogEntry(everything->snapshot(), CorePlatform::LogLevel::WARN, "plain warning");
+    EXPECT_EQ(everything->snapshot().size(), 3);
+    ASSERT_EQ(errorsOnly->snapshot().size(), 1);
+    VerifyLogEntry(errorsOnly->snapshot(), CorePlatform::LogLevel::ERR, "error 2");
+    
+    std::ifstream in(sinkPath);
+    std::vector<std::string> fileLines;
+    for (std::string line; std::getline(in, line);) {
+        fileLines.push_back(line);
+    }
+    EXPECT_EQ(fileLines, everything->snapshot());
+    
+    // 内置的日志文件不受影响
+    VerifyLogEntry(logger.readAllLogs(), CorePlatform::LogLevel::INFO, "info 1");
+    
+    EXPECT_TRUE(logger.removeSink(errorsOnly));
+    EXPECT_FALSE(logger.removeSink(errorsOnly));
+    logger.error("after remove");
+    logger.flush();
+    EXPECT_EQ(errorsOnly->snapshot().size(), 1);
+    VerifyLogEntry(everything->snapshot(), CorePlatform::LogLevel::ERR, "after remove");
+    
+    logger.clearSinks();
+    EXPECT_TRUE(logger.getSinks().empty());
+    logger.info("after clear");
+    VerifyLogEntry(everything->snapshot(), CorePlatform::LogLevel::INFO, "after clear", 0);
+}
+
+// 写入时阻塞的输出，用于模拟慢速终端
+class BlockingSink : public CorePlatform::LogSink {
+public:
+    explicit BlockingSink(const CorePlatform::LogSinkOptions& options) : LogSink(options) {}
+    ~BlockingSink() override {
+        release();
+        stop();
+    }
+    
+    void release() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        released_ = true;
+        cv_.notify_all();
+    }
+    
+    size_t written() const { return written_.load(); }
+    
+protected:
+    void write(CorePlatform::LogLevel, std::string_view) override {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return released_; });
+        written_++;
+    }
+    
+private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool released_ = false;
+    std::atomic<size_t> written_{0};
+};
+
+// 测试异步输出独立排队：阻塞的输出不拖慢调用线程和其他输出
+TEST_F(LoggerTest, SlowSinkDoesNotBlockOthers) {
+    CorePlatform::Logger& logger = CorePlatform::Logger::getInstance();
+    
+    CorePlatform::LogSinkOptions slowOptions;
+    slowOptions.asynchronous = true;
+    slowOptions.queueCapacity = 8;
+    slowOptions.overflowPolicy = CorePlatform::LogOverflowPolicy::Drop;
+    auto slow = std::make_shared<BlockingSink>(slowOptions);
+    auto ring = std::make_shared<CorePlatform::MemoryRingSink>(1000);
+    logger.addSink(slow);
+    logger.addSink(ring);
+    
+    constexpr int COUNT = 200;
+    for (int i = 0; i < COUNT; i++) {
+        logger.info("message {}", i);
+    }
+    EXPECT_EQ(ring->snapshot().size(), COUNT);
+    EXPECT_GT(slow->getDroppedCount(), 0);
+    
+    slow->release();
+    logger.flush();
+    EXPECT_EQ(slow->written() + slow->getDroppedCount(), COUNT);
+    logger.clearSinks();
+}
+
+#ifndef _WIN32
+// 测试 syslog / journald 输出发送的数据报格式
+TEST_F(LoggerTest, SyslogSinkSendsDatagrams) {
+    const std::string socketPath = tempDir->CreateFilePath("log.sock");
+    const int server = socket(AF_UNIX, SOCK_DGRAM, 0);
+    ASSERT_GE(server, 0);
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    ASSERT_LT(socketPath.size(), sizeof(addr.sun_path));
+    std::strcpy(addr.sun_path, socketPath.c_str());
+    ASSERT_EQ(bind(server, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)), 0);
+    
+    auto receive = [server]() {
+        char buffer[4096];
+        const ssize_t n = recv(server, buffer, sizeof(buffer), 0);
+        return n > 0 ? std::string(buffer, static_cast<size_t>(n)) : std::string();
+    };
+    const std::string pid = std::to_string(getpid());
+    const auto now = std::chrono::system_clock::now();
+    
+    CorePlatform::SyslogSink::Config config;
+    config.ident = "cptest";
+    config.socketPath = socketPath;
+    {
+        CorePlatform::SyslogSink sink(config);
+        ASSERT_TRUE(sink.isOpen());
+        sink.log(CorePlatform::LogLevel::INFO, now, "hello syslog");
+        sink.log(CorePlatform::LogLevel::ERR, now, "failure");
+        EXPECT_EQ(receive(), "<14>cptest[" + pid + "]: hello syslog");
+        EXPECT_EQ(receive(), "<11>cptest[" + pid + "]: failure");
+    }
+    
+    config.protocol = CorePlatform::SyslogSink::Protocol::Journald;
+    {
+        CorePlatform::SyslogSink sink(config);
+        ASSERT_TRUE(sink.isOpen());
+        sink.log(CorePlatform::LogLevel::WARN, now, "hello journal");
+        std::string datagram = receive();
+        EXPECT_NE(datagram.find("PRIORITY=4\n"), std::string::npos);
+        EXPECT_NE(datagram.find("SYSLOG_IDENTIFIER=cptest\n"), std::string::npos);
+        EXPECT_NE(datagram.find("MESSAGE=hello journal\n"), std::string::npos);
+        
+        // 多行消息使用带长度的二进制字段
+        sink.log(CorePlatform::LogLevel::INFO, now, "line1\nline2");
+        datagram = receive();
+        const std::string binaryField = std::string("MESSAGE\n") + std::string("\x0b\0\0\0\0\0\0\0", 8) + "line1\nline2\n";
+        EXPECT_NE(datagram.find(binaryField), std::string::npos);
+    }
+    close(server);
+    
+    // 套接字不存在时忽略日志
+    config.socketPath = tempDir->CreateFilePath("missing.sock");
+    CorePlatform::SyslogSink missing(config);
+    EXPECT_FALSE(missing.isOpen());
+    missing.log(CorePlatform::LogLevel::ERR, now, "dropped");
+    EXPECT_EQ(missing.getDroppedCount(), 1u);
+    
+    // 守护进程启动后，退避期内不重新连接，期满后的日志重新连接并送达
+    const int restarted = socket(AF_UNIX, SOCK_DGRAM, 0);
+    ASSERT_GE(restarted, 0);
+    std::strcpy(addr.sun_path, config.socketPath.c_str());
+    ASSERT_EQ(bind(restarted, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)), 0);
+    timeval timeout{5, 0};
+    setsockopt(restarted, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    missing.log(CorePlatform::LogLevel::ERR, now, "backing off");
+    EXPECT_FALSE(missing.isOpen());
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    missing.log(CorePlatform::LogLevel::ERR, now, "reconnected");
+    EXPECT_TRUE(missing.isOpen());
+    char buffer[256];
+    const ssize_t n = recv(restarted, buffer, sizeof(buffer), 0);
+    const std::string datagram = n > 0 ? std::string(buffer, static_cast<size_t>(n)) : std::string();
+    EXPECT_NE(datagram.find("MESSAGE=reconnected\n"), std::string::npos);
+    close(restarted);
+}
+
+// 测试守护进程来不及接收时 syslog 输出不阻塞，丢弃的日志计入丢弃数；超长 journald 日志通过 memfd 传递
+TEST_F(LoggerTest, SyslogSinkDoesNotBlockWhenDaemonIsBehind) {
+    const std::string socketPath = tempDir->CreateFilePath("slow.sock");
+    const int server = socket(AF_UNIX, SOCK_DGRAM, 0);
+    ASSERT_GE(server, 0);
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    ASSERT_LT(socketPath.size(), sizeof(addr.sun_path));
+    std::strcpy(addr.sun_path, socketPath.c_str());
+    ASSERT_EQ(bind(server, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)), 0);
+    const auto now = std::chrono::system_clock::now();
+    
+    CorePlatform::SyslogSink::Config config;
+    config.ident = "cptest";
+    config.socketPath = socketPath;
+    {
+        // 接收端从不读取，接收队列满后的日志被丢弃而不是阻塞写入线程
+        CorePlatform::SyslogSink sink(config);
+        ASSERT_TRUE(sink.isOpen());
+        const size_t COUNT = 5000;
+        const std::string message(512, 'x');
+        for (size_t i = 0; i < COUNT; ++i) {
+            sink.log(CorePlatform::LogLevel::INFO, now, message);
+        }
+        EXPECT_GT(sink.getDroppedCount(), 0u);
+        
+        size_t received = 0;
+        char buffer[1024];
+        while (recv(server, buffer, sizeof(buffer), MSG_DONTWAIT) > 0) {
+            ++received;
+        }
+        EXPECT_EQ(received + sink.getDroppedCount(), COUNT);
+    }
+    
+#if defined(__linux__)
+    config.protocol = CorePlatform::SyslogSink::Protocol::Journald;
+    {
+        CorePlatform::SyslogSink sink(config);
+        ASSERT_TRUE(sink.isOpen());
+        int sendBuffer = 0;
+        socklen_t length = sizeof(sendBuffer);
+        ASSERT_EQ(getsockopt(server, SOL_SOCKET, SO_SNDBUF, &sendBuffer, &length), 0);
+        const std::string message(static_cast<size_t>(sendBuffer) * 4, 'y');
+        sink.log(CorePlatform::LogLevel::INFO, now, message);
+        EXPECT_EQ(sink.getDroppedCount(), 0u);
+        
+        // 数据报本身为空，日志内容在随附的 memfd 中
+        char payload[16];
+        iovec iov{payload, sizeof(payload)};
+        alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))] = {};
+        msghdr header{};
+        header.msg_iov = &iov;
+        header.msg_iovlen = 1;
+        header.msg_control = control;
+        header.msg_controllen = sizeof(control);
+        ASSERT_EQ(recvmsg(server, &header, MSG_DONTWAIT), 0);
+        cmsghdr* cmsg = CMSG_FIRSTHDR(&header);
+        ASSERT_NE(cmsg, nullptr);
+        ASSERT_EQ(cmsg->cmsg_type, SCM_RIGHTS);
+        int memfd = -1;
+        std::memcpy(&memfd, CMSG_DATA(cmsg), sizeof(int));
+        ASSERT_GE(memfd, 0);
+        
+        std::string content;
+        char chunk[65536];
+        ssize_t n = 0;
+        while ((n = pread(memfd, chunk, sizeof(chunk), static_cast<off_t>(content.size()))) > 0) {
+            content.append(chunk, static_cast<size_t>(n));
+        }
+        close(memfd);
+        EXPECT_NE(content.find("SYSLOG_IDENTIFIER=cptest\n"), std::string::npos);
+        EXPECT_NE(content.find("MESSAGE=" + message + "\n"), std::string::npos);
+    }
+#endif
+    close(server);
+}
+#endif
+
+// 测试模块日志器的层级继承
+TEST_F(LoggerTest, NamedLoggerLevelInheritance) {
+    CorePlatform::Logger& logger = CorePlatform::Logger::getInstance();
+    CorePlatform::NamedLogger& plugin = logger.getLogger("hier.plugin.ExamplePlugin");
+    CorePlatform::NamedLogger& fs = logger.getLogger("hier.fs");
+    
+    EXPECT_EQ(&plugin, &logger.getLogger("hier.plugin.ExamplePlugin"));
+    ASSERT_NE(plugin.parent(), nullptr);
+    EXPECT_EQ(plugin.parent()->name(), "hier.plugin");
+    EXPECT_EQ(plugin.parent()->parent(), &logger.getLogger("hier"));
+    EXPECT_EQ(logger.getLogger("hier").parent(), nullptr);
+    EXPECT_EQ(plugin.getEffectiveLevel(), CorePlatform::LogLevel::INFO);
+    
+    plugin.debug("hidden {}", 1);
+    logger.getLogger("hier.plugin").setLevel(CorePlatform::LogLevel::DEBUG);
+    EXPECT_TRUE(plugin.isEnabled(CorePlatform::LogLevel::DEBUG));
+    EXPECT_FALSE(fs.isEnabled(CorePlatform::LogLevel::DEBUG));
+    EXPECT_FALSE(logger.isEnabled(CorePlatform::LogLevel::DEBUG));
+    
+    plugin.debug("visible {}", 2);
+    fs.debug("fs hidden");
+    fs.warn("fs warning {}", 3);
+    CP_MODULE_LOG_DEBUG("hier.plugin.ExamplePlugin", "macro {}", 4);
+    
+    auto logs = logger.readAllLogs();
+    VerifyLogEntry(logs, CorePlatform::LogLevel::DEBUG, "hidden", 0);
+    VerifyLogEntry(logs, CorePlatform::LogLevel::DEBUG, "[hier.plugin.ExamplePlugin] visible 2");
+    VerifyLogEntry(logs, CorePlatform::LogLevel::DEBUG, "[hier.plugin.ExamplePlugin] macro 4");
+    VerifyLogEntry(logs, CorePlatform::LogLevel::WARN, "[hier.fs] fs warning 3");
+    
+    // 子模块单独设置的级别优先于父模块
+    plugin.setLevel(CorePlatform::LogLevel::ERR);
+    EXPECT_FALSE(plugin.isEnabled(CorePlatform::LogLevel::WARN));
+    CorePlatform::LogLevel explicitLevel;
+    ASSERT_TRUE(plugin.getExplicitLevel(explicitLevel));
+    EXPECT_EQ(explicitLevel, CorePlatform::LogLevel::ERR);
+    
+    // 恢复继承后跟随根级别变化
+    plugin.resetLevel();
+    logger.getLogger("hier.plugin").resetLevel();
+    EXPECT_FALSE(plugin.getExplicitLevel(explicitLevel));
+    logger.setLevel(CorePlatform::LogLevel::TRACE);
+    EXPECT_EQ(plugin.getEffectiveLevel(), CorePlatform::LogLevel::TRACE);
+    EXPECT_EQ(fs.getEffectiveLevel(), CorePlatform::LogLevel::TRACE);
+    logger.setLevel(CorePlatform::LogLevel::INFO);
+    EXPECT_EQ(plugin.getEffectiveLevel(), CorePlatform::LogLevel::INFO);
+}
+
+// 测试从配置文件加载级别
+TEST_F(LoggerTest, LoadLevelConfig) {
+    CorePlatform::Logger& logger = CorePlatform::Logger::getInstance();
+    const std::string configPath = tempDir->CreateFilePath("levels.conf");
+    auto writeConfig = [&](const std::string& content) {
+        std::ofstream out(configPath, std::ios::trunc);
+        out << content;
+    };
+    
+    writeConfig("# levels\n"
+                "[logging]\n"
+                "log.level = warn\n"
+                "log.level.cfg.net = DEBUG   ; inline comment\n"
+                "log.level.cfg.plugin.ExamplePlugin = TRACE\n"
+                "other.key = ignored\n");
+    std::string error;
+    ASSERT_TRUE(logger.loadLevelConfig(configPath, &error)) << error;
+    EXPECT_EQ(logger.getLevel(), CorePlatform::LogLevel::WARN);
+    EXPECT_EQ(logger.getLogger("cfg.net").getEffectiveLevel(), CorePlatform::LogLevel::DEBUG);
+    EXPECT_EQ(logger.getLogger("cfg.net.http").getEffectiveLevel(), CorePlatform::LogLevel::DEBUG);
+    EXPECT_EQ(logger.getLogger("cfg.plugin.ExamplePlugin").getEffectiveLevel(), CorePlatform::LogLevel::TRACE);
+    EXPECT_EQ(logger.getLogger("cfg.plugin").getEffectiveLevel(), CorePlatform::LogLevel::WARN);
+    
+    // 无效配置不做任何修改
+    writeConfig("log.level = INFO\nlog.level.cfg.net = LOUD\n");
+    EXPECT_FALSE(logger.loadLevelConfig(configPath, &error));
+    EXPECT_NE(error.find(":2:"), std::string::npos);
+    EXPECT_EQ(logger.getLevel(), CorePlatform::LogLevel::WARN);
+    EXPECT_EQ(logger.getLogger("cfg.net").getEffectiveLevel(), CorePlatform::LogLevel::DEBUG);
+    
+    // 重新加载时未出现的模块恢复继承
+    writeConfig("log.level = INFO\n");
+    ASSERT_TRUE(logger.loadLevelConfig(configPath, &error)) << error;
+    EXPECT_EQ(logger.getLogger("cfg.net").getEffectiveLevel(), CorePlatform::LogLevel::INFO);
+    EXPECT_EQ(logger.getLogger("cfg.plugin.ExamplePlugin").getEffectiveLevel(), CorePlatform::LogLevel::INFO);
+    
+    EXPECT_FALSE(logger.loadLevelConfig(tempDir->CreateFilePath("missing.conf")));
+}
+
+// 测试配置文件中的飞行记录器开关：未出现时不改变，级别不变时保留记录
+TEST_F(LoggerTest, LoadLevelConfigFlightRecorder) {
+    CorePlatform::Logger& logger = CorePlatform::Logger::getInstance();
+    const std::string configPath = tempDir->CreateFilePath("flight.conf");
+    const std::string dumpPath = tempDir->CreateFilePath("config_flight.log");
+    auto writeConfig = [&](const std::string& content) {
+        std::ofstream out(configPath, std::ios::trunc);
+        out << content;
+    };
+    
+    std::string error;
+    writeConfig("log.level = INFO\nlog.flight_recorder = debug\n");
+    ASSERT_TRUE(logger.loadLevelConfig(configPath, &error)) << error;
+    EXPECT_TRUE(logger.isFlightRecorderEnabled());
+    EXPECT_TRUE(logger.isEnabled(CorePlatform::LogLevel::DEBUG));
+    EXPECT_FALSE(logger.isEnabled(CorePlatform::LogLevel::TRACE));
+    logger.debug("kept across reload");
+    
+    ASSERT_TRUE(logger.loadLevelConfig(configPath, &error)) << error;
+    ASSERT_TRUE(logger.dumpFlightRecorder(dumpPath));
+    VerifyLogEntry(ReadFileLines(dumpPath), CorePlatform::LogLevel::DEBUG, "kept across reload");
+    
+    writeConfig("log.level = INFO\n");
+    ASSERT_TRUE(logger.loadLevelConfig(configPath, &error)) << error;
+    EXPECT_TRUE(logger.isFlightRecorderEnabled());
+    
+    writeConfig("log.flight_recorder = verbose\n");
+    EXPECT_FALSE(logger.loadLevelConfig(configPath, &error));
+    EXPECT_NE(error.find(":1:"), std::string::npos);
+    EXPECT_TRUE(logger.isFlightRecorderEnabled());
+    
+    writeConfig("log.flight_recorder = off\n");
+    ASSERT_TRUE(logger.loadLevelConfig(configPath, &error)) << error;
+    EXPECT_FALSE(logger.isFlightRecorderEnabled());
+    EXPECT_FALSE(logger.isEnabled(CorePlatform::LogLevel::DEBUG));
+}
+
+// 测试令牌桶：突发额度用完后按速率放行
+TEST_F(LoggerTest, RateLimiterTokenBucket) {
+    CorePlatform::LogRateLimiter limiter(__FILE__, __LINE__, CorePlatform::LogLevel::ERR, 10, 3);
+    const int64_t start = 1000000000;
+    
+    EXPECT_TRUE(limiter.tryAcquire(start));
+    EXPECT_TRUE(limiter.tryAcquire(start));
+    EXPECT_TRUE(limiter.tryAcquire(start));
+    EXPECT_FALSE(limiter.tryAcquire(start));
+    EXPECT_FALSE(limiter.tryAcquire(start + 50000000));
+    // 100ms 补充一个令牌
+    EXPECT_TRUE(limiter.tryAcquire(start + 100000000));
+    EXPECT_FALSE(limiter.tryAcquire(start + 100000000));
+    EXPECT_EQ(limiter.takeSuppressed(), 3);
+    EXPECT_EQ(limiter.takeSuppressed(), 0);
+    
+    // 长时间空闲后最多恢复 burst 个令牌
+    const int64_t later = start + 10000000000LL;
+    int allowed = 0;
+    for (int i = 0; i < 10; i++) {
+        allowed += limiter.tryAcquire(later) ? 1 : 0;
+    }
+    EXPECT_EQ(allowed, 3);
+    EXPECT_EQ(limiter.getTotalSuppressed(), 10);
+}
+
+// 测试已析构的调用点会从登记链表摘除，flush() 不再访问它
+TEST_F(LoggerTest, DestroyedThrottleSiteIsUnregistered) {
+    CorePlatform::Logger& logger = CorePlatform::Logger::getInstance();
+    
+    {
+        // 文件名放在堆上，模拟随插件卸载而失效的 __FILE__
+        std::string file = "unloaded_plugin.cpp";
+        auto sampler = std::make_unique<CorePlatform::LogSampler>(
+            file.c_str(), 7, CorePlatform::LogLevel::WARN, 10);
+        for (int i = 0; i < 5; i++) {
+            sampler->tryAcquire();
+        }
+        EXPECT_EQ(sampler->getTotalSuppressed(), 4);
+    }
+    
+    CorePlatform::LogSampler survivor(__FILE__, __LINE__, CorePlatform::LogLevel::WARN, 10);
+    for (int i = 0; i < 3; i++) {
+        survivor.tryAcquire();
+    }
+    logger.flush();
+    
+    auto logs = logger.readAllLogs();
+    VerifyLogEntry(logs, CorePlatform::LogLevel::WARN, "unloaded_plugin.cpp", 0);
+    VerifyLogEntry(logs, CorePlatform::LogLevel::WARN, "suppressed 2 messages from LoggerTest.cpp:");
+}
+
+// 测试限流和采样输出的日志条数及抑制摘要
+TEST_F(LoggerTest, RateLimitedAndSampledMacros) {
+    CorePlatform::Logger& logger = CorePlatform::Logger::getInstance();
+    
+    // 条数用本地调用点检查：宏展开的静态调用点在进程内一直存在，重复运行用例时状态不会重置
+    {
+        CorePlatform::LogRateLimiter limiter(__FILE__, __LINE__, CorePlatform::LogLevel::ERR, 0.001, 5);
+        const int64_t now = 1000000000;
+        int allowed = 0;
+        for (int i = 0; i < 1000; i++) {
+            allowed += limiter.tryAcquire(now) ? 1 : 0;
+        }
+        EXPECT_EQ(allowed, 5);
+        EXPECT_EQ(limiter.getTotalSuppressed(), 995u);
+        
+        CorePlatform::LogSampler sampler(__FILE__, __LINE__, CorePlatform::LogLevel::WARN, 100);
+        std::vector<int> sampled;
+        for (int i = 0; i < 1000; i++) {
+            if (sampler.tryAcquire()) {
+                sampled.push_back(i);
+            }
+        }
+        ASSERT_EQ(sampled.size(), 10u);
+        EXPECT_EQ(sampled.back(), 900);
+        EXPECT_EQ(sampler.getTotalSuppressed(), 990u);
+        
+        // flush() 补报尚未报告的抑制条数
+        logger.flush();
+        auto logs = logger.readAllLogs();
+        VerifyLogEntry(logs, CorePlatform::LogLevel::ERR, "suppressed 995 messages from LoggerTest.cpp:");
+        VerifyLogEntry(logs, CorePlatform::LogLevel::WARN, "suppressed 990 messages from LoggerTest.cpp:");
+    }
+    
+    // 宏：限流的调用点最多放行 burst 条，采样的调用点每 100 条放行一条
+    const auto countContaining = [&](const std::string& part) {
+        const auto logs = logger.readAllLogs();
+        return std::count_if(logs.begin(), logs.end(),
+                             [&](const std::string& line) { return line.find(part) != std::string::npos; });
+    };
+    for (int i = 0; i < 1000; i++) {
+        CP_LOG_RATE_LIMITED(CorePlatform::LogLevel::ERR, 0.001, 5, "stuck loop {}", i);
+    }
+    for (int i = 0; i < 1000; i++) {
+        CP_LOG_EVERY_N(CorePlatform::LogLevel::WARN, 100, "sampled {}", i);
+    }
+    logger.flush();
+    EXPECT_LE(countContaining("stuck loop"), 5);
+    VerifyLogEntry(logger.readAllLogs(), CorePlatform::LogLevel::WARN, "sampled", 10);
+    
+    // 级别被过滤时不计入限流
+    logger.setLevel(CorePlatform::LogLevel::FATAL);
+    for (int i = 0; i < 10; i++) {
+        CP_LOG_EVERY_N(CorePlatform::LogLevel::WARN, 2, "filtered {}", i);
+    }
+    logger.setLevel(CorePlatform::LogLevel::INFO);
+    logger.flush();
+    VerifyLogEntry(logger.readAllLogs(), CorePlatform::LogLevel::WARN, "filtered", 0);
+}
+
+// 测试飞行记录器：低于磁盘级别的日志只保留在内存中，导出时按时间合并
+TEST_F(LoggerTest, FlightRecorderKeepsTraceBelowDiskLevel) {
+    CorePlatform::Logger& logger = CorePlatform::Logger::getInstance();
+    const std::string dumpPath = tempDir->CreateFilePath("flight.log");
+    
+    EXPECT_FALSE(logger.dumpFlightRecorder(dumpPath));
+    CorePlatform::FlightRecorderOptions options;
+    options.recordsPerThread = 16;
+    options.installCrashHandler = false;
+    logger.enableFlightRecorder(options);
+    EXPECT_TRUE(logger.isFlightRecorderEnabled());
+    EXPECT_TRUE(logger.isEnabled(CorePlatform::LogLevel::TRACE));
+    
+    logger.trace("flight trace {}", 1);
+    CP_LOG_DEBUG("flight debug {}", 2);
+    logger.getLogger("flight.module").trace("module trace");
+    logger.info("flight info");
+    logger.flush();
+    
+    // 磁盘只写 INFO 及以上
+    auto logs = logger.readAllLogs();
+    VerifyLogEntry(logs, CorePlatform::LogLevel::TRACE, "flight trace", 0);
+    VerifyLogEntry(logs, CorePlatform::LogLevel::DEBUG, "flight debug", 0);
+    VerifyLogEntry(logs, CorePlatform::LogLevel::TRACE, "module trace", 0);
+    VerifyLogEntry(logs, CorePlatform::LogLevel::INFO, "flight info");
+    
+    ASSERT_TRUE(logger.dumpFlightRecorder(dumpPath));
+    auto dumped = ReadFileLines(dumpPath);
+    ASSERT_EQ(dumped.size(), 4u);
+    EXPECT_NE(dumped[0].find("[TRACE]"), std::string::npos);
+    EXPECT_NE(dumped[0].find("flight trace 1"), std::string::npos);
+    EXPECT_NE(dumped[1].find("flight debug 2"), std::string::npos);
+    EXPECT_NE(dumped[2].find("[flight.module] module trace"), std::string::npos);
+    EXPECT_NE(dumped[3].find("[INFO]"), std::string::npos);
+    
+    // 超过容量后只保留每个线程最近的记录
+    for (int i = 0; i < 100; i++) {
+        logger.trace("wrap {}", i);
+    }
+    ASSERT_TRUE(logger.dumpFlightRecorder(dumpPath));
+    dumped = ReadFileLines(dumpPath);
+    ASSERT_EQ(dumped.size(), 16u);
+    EXPECT_NE(dumped.front().find("wrap 84"), std::string::npos);
+    EXPECT_NE(dumped.back().find("wrap 99"), std::string::npos);
+    
+    // 停用后门槛恢复为根级别
+    logger.disableFlightRecorder();
+    EXPECT_FALSE(logger.isEnabled(CorePlatform::LogLevel::TRACE));
+    EXPECT_FALSE(logger.getLogger("flight.module").isEnabled(CorePlatform::LogLevel::TRACE));
+    
+    // 再次启用时复用记录器但不保留之前的记录，导出使用配置的时间戳格式
+    logger.enableFlightRecorder(options);
+    logger.trace("after reenable");
+    logger.setTimestampFormat(CorePlatform::TimestampFormat::UtcIso8601Millis);
+    ASSERT_TRUE(logger.dumpFlightRecorder(dumpPath));
+    logger.setTimestampFormat(CorePlatform::TimestampFormat::LocalMillis);
+    dumped = ReadFileLines(dumpPath);
+    ASSERT_EQ(dumped.size(), 1u);
+    const std::regex utcPattern(R"(^\[\d{4}-\d{2}-\d{2}T\d{2}:\d{2}:\d{2}\.\d{3}Z\] \[TRACE\] \[\d+\] .*after reenable$)");
+    EXPECT_TRUE(std::regex_match(dumped[0], utcPattern)) << dumped[0];
+}
+
+// 测试多线程写入和信号安全导出
+TEST_F(LoggerTest, FlightRecorderMultiThreadDump) {
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 200;
+    CorePlatform::FlightRecorder recorder(64, CorePlatform::LogLevel::DEBUG);
+    
+    // 线程退出后缓冲区会被新线程复用，全部写完之前保持所有线程存活
+    std::atomic<int> finished{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; t++) {
+        threads.emplace_back([&recorder, &finished, t]() {
+            for (int i = 0; i < kPerThread; i++) {
+                recorder.record(CorePlatform::LogLevel::INFO, std::chrono::system_clock::now(),
+                                "thread " + std::to_string(t) + " message " + std::to_string(i));
+            }
+            recorder.record(CorePlatform::LogLevel::TRACE, std::chrono::system_clock::now(), "filtered");
+            finished.fetch_add(1);
+            while (finished.load() < kThreads) {
+                std::this_thread::yield();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    
+    const std::string dumpPath = tempDir->CreateFilePath("threads.log");
+    ASSERT_TRUE(recorder.dump(dumpPath));
+    auto dumped = ReadFileLines(dumpPath);
+    EXPECT_EQ(dumped.size(), static_cast<size_t>(kThreads * 64));
+    for (int t = 0; t < kThreads; t++) {
+        const std::string last = "thread " + std::to_string(t) + " message " + std::to_string(kPerThread - 1);
+        EXPECT_EQ(std::count_if(dumped.begin(), dumped.end(), [&](const std::string& line) {
+            return line.find(last) != std::string::npos;
+        }), 1);
+    }
+    
+    // 超长消息被截断
+    recorder.record(CorePlatform::LogLevel::ERR, std::chrono::system_clock::now(), std::string(1000, 'x'));
+    const std::string safePath = tempDir->CreateFilePath("signal-safe.log");
+    ASSERT_TRUE(recorder.dumpSignalSafe(safePath.c_str()));
+    auto safeLines = ReadFileLines(safePath);
+    EXPECT_EQ(safeLines.size(), static_cast<size_t>(kThreads * 64));
+    std::regex linePattern(R"(^\[\d{4}-\d{2}-\d{2}T\d{2}:\d{2}:\d{2}\.\d{3}Z\] \[(INFO|ERROR)\] \[\d+\] .+$)");
+    for (const auto& line : safeLines) {
+        EXPECT_TRUE(std::regex_match(line, linePattern)) << line;
+    }
+    const std::string truncated(CorePlatform::FlightRecorder::kMaxMessageSize, 'x');
+    auto it = std::find_if(safeLines.begin(), safeLines.end(), [&](const std::string& line) {
+        return line.find("[ERROR]") != std::string::npos;
+    });
+    ASSERT_NE(it, safeLines.end());
+    EXPECT_EQ(it->substr(it->size() - truncated.size() - 1), " " + truncated);
+}
+
+// 测试 FATAL 日志触发导出
+TEST_F(LoggerTest, FlightRecorderDumpsOnFatal) {
+    CorePlatform::Logger& logger = CorePlatform::Logger::getInstance();
+    CorePlatform::FlightRecorderOptions options;
+    options.dumpPath = tempDir->CreateFilePath("fatal.flight");
+    options.installCrashHandler = false;
+    logger.enableFlightRecorder(options);
+    
+    logger.debug("before fatal");
+    logger.fatal("fatal happened");
+    
+    auto dumped = ReadFileLines(options.dumpPath);
+    ASSERT_EQ(dumped.size(), 2u);
+    EXPECT_NE(dumped[0].find("before fatal"), std::string::npos);
+    EXPECT_NE(dumped[1].find("[FATAL]"), std::string::npos);
+}
+
+#ifndef _WIN32
+// 测试崩溃信号处理函数导出记录后仍以原信号终止
+TEST_F(LoggerTest, FlightRecorderDumpsOnCrashSignal) {
+    const std::string dumpPath = tempDir->CreateFilePath("crash.flight");
+    
+    const pid_t pid = fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+        CorePlatform::Logger& logger = CorePlatform::Logger::getInstance();
+        CorePlatform::FlightRecorderOptions options;
+        options.dumpPath = dumpPath;
+        logger.enableFlightRecorder(options);
+        logger.trace("last words before abort");
+        std::abort();
+    }
+    
+    int status = 0;
+    ASSERT_EQ(waitpid(pid, &status, 0), pid);
+    ASSERT_TRUE(WIFSIGNALED(status));
+    EXPECT_EQ(WTERMSIG(status), SIGABRT);
+    
+    auto dumped = ReadFileLines(dumpPath);
+    ASSERT_EQ(dumped.size(), 1u);
+    EXPECT_NE(dumped[0].find("[TRACE]"), std::string::npos);
+    EXPECT_NE(dumped[0].find("last words before abort"), std::string::npos);
+}
+
+// 递归直到栈溢出（深度上限只是为了让编译器不把它视为无限递归）
+int overflowStack(int depth) {
+    volatile char frame[1024];
+    frame[0] = static_cast<char>(depth);
+    if (depth == std::numeric_limits<int>::max()) return frame[0];
+    return overflowStack(depth + 1) + frame[0];
+}
+
+// 测试栈溢出时处理函数在备用信号栈上运行，仍能导出
+TEST_F(LoggerTest, FlightRecorderDumpsOnStackOverflow) {
+    const std::string dumpPath = tempDir->CreateFilePath("overflow.flight");
+    
+    const pid_t pid = fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+        CorePlatform::Logger& logger = CorePlatform::Logger::getInstance();
+        CorePlatform::FlightRecorderOptions options;
+        options.dumpPath = dumpPath;
+        logger.enableFlightRecorder(options);
+        logger.trace("last words before overflow");
+        _exit(overflowStack(0));
+    }
+    
+    int status = 0;
+    ASSERT_EQ(waitpid(pid, &status, 0), pid);
+    ASSERT_TRUE(WIFSIGNALED(status));
+    EXPECT_EQ(WTERMSIG(status), SIGSEGV);
+    
+    auto dumped = ReadFileLines(dumpPath);
+    ASSERT_EQ(dumped.size(), 1u);
+    EXPECT_NE(dumped[0].find("last words before overflow"), std::string::npos);
+}
+#endif
+
+#ifndef _WIN32
+// 测试共享日志环：跨映射写入和读取、队列满时丢弃
+TEST_F(LoggerTest, SharedLogRingWriteAndDrain) {
+    std::string error;
+    auto ring = CorePlatform::SharedLogRing::create(8, "", &error);
+    ASSERT_NE(ring, nullptr) << error;
+    EXPECT_EQ(ring->capacity(), 8u);
+    EXPECT_FALSE(ring->waitForData(std::chrono::milliseconds(1)));
+    EXPECT_EQ(CorePlatform::SharedLogRing::attach("bogus", &error), nullptr);
+    
+    // 另一份映射代表子进程
+    auto writer = CorePlatform::SharedLogRing::attach(ring->handle(), &error);
+    ASSERT_NE(writer, nullptr) << error;
+    const auto start = std::chrono::system_clock::now();
+    for (int i = 0; i < 10; i++) {
+        const bool written = writer->write(CorePlatform::LogLevel::WARN, start + std::chrono::milliseconds(i),
+                                           "record " + std::to_string(i));
+        EXPECT_EQ(written, i < 8);
+    }
+    EXPECT_EQ(ring->getDroppedCount(), 2u);
+    EXPECT_TRUE(ring->waitForData(std::chrono::milliseconds(0)));
+    
+    std::vector<CorePlatform::SharedLogRecord> records;
+    EXPECT_EQ(ring->drain(records, 3), 3u);
+    EXPECT_EQ(ring->drain(records), 5u);
+    ASSERT_EQ(records.size(), 8u);
+    for (int i = 0; i < 8; i++) {
+        EXPECT_EQ(records[i].message, "record " + std::to_string(i));
+        EXPECT_EQ(records[i].level, CorePlatform::LogLevel::WARN);
+        EXPECT_EQ(records[i].processId, static_cast<int64_t>(getpid()));
+        EXPECT_EQ(records[i].time, start + std::chrono::milliseconds(i));
+    }
+    
+    // 读出后槽位可以继续使用，超长消息被截断
+    EXPECT_TRUE(writer->write(CorePlatform::LogLevel::ERR, start, std::string(1000, 'y')));
+    records.clear();
+    EXPECT_EQ(ring->drain(records), 1u);
+    EXPECT_EQ(records[0].message, std::string(CorePlatform::SharedLogRing::kMaxMessageSize, 'y'));
+}
+
+// 测试同时等待多个日志环：空闲时等到超时，任一日志环写入后被唤醒
+TEST_F(LoggerTest, SharedLogRingWaitForAny) {
+    std::vector<std::shared_ptr<CorePlatform::SharedLogRing>> rings;
+    for (int i = 0; i < 3; i++) {
+        rings.push_back(CorePlatform::SharedLogRing::create(8));
+        ASSERT_NE(rings.back(), nullptr);
+    }
+    
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(CorePlatform::SharedLogRing::waitForAny(rings, std::chrono::milliseconds(100)));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(100));
+    
+    auto writer = CorePlatform::SharedLogRing::attach(rings[2]->handle());
+    ASSERT_NE(writer, nullptr);
+    std::thread thread([&writer]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        writer->write(CorePlatform::LogLevel::INFO, std::chrono::system_clock::now(), "wake");
+    });
+    start = std::chrono::steady_clock::now();
+    EXPECT_TRUE(CorePlatform::SharedLogRing::waitForAny(rings, std::chrono::seconds(10)));
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+    thread.join();
+    
+    std::vector<CorePlatform::SharedLogRecord> records;
+    EXPECT_EQ(rings[2]->drain(records), 1u);
+    EXPECT_FALSE(CorePlatform::SharedLogRing::waitForAny(rings, std::chrono::milliseconds(0)));
+}
+
+// 测试写入进程在写入中途退出：读取端超时后跳过该槽位，之后的写入只受影响一圈
+TEST_F(LoggerTest, SharedLogRingRecoversFromAbandonedWrite) {
+    std::string error;
+    auto ring = CorePlatform::SharedLogRing::create(2, "", &error);
+    ASSERT_NE(ring, nullptr) << error;
+    
+    // 子进程从不可读的内存复制消息，在占用槽位并登记为写入者之后崩溃
+    const pid_t pid = fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+        signal(SIGSEGV, SIG_DFL);
+        auto writer = CorePlatform::SharedLogRing::attach(ring->handle());
+        void* page = mmap(nullptr, 4096, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (writer && page != MAP_FAILED) {
+            writer->write(CorePlatform::LogLevel::INFO, std::chrono::system_clock::now(),
+                          std::string_view(static_cast<const char*>(page), 16));
+        }
+        _exit(0);
+    }
+    int status = 0;
+    ASSERT_EQ(waitpid(pid, &status, 0), pid);
+    ASSERT_TRUE(WIFSIGNALED(status));
+    
+    std::vector<CorePlatform::SharedLogRecord> records;
+    EXPECT_EQ(ring->drain(records), 0u);
+    std::this_thread::sleep_for(CorePlatform::SharedLogRing::kStalledSlotTimeout + std::chrono::milliseconds(50));
+    EXPECT_EQ(ring->drain(records), 0u);
+    EXPECT_EQ(ring->getDroppedCount(), 1u);
+    
+    // 下一圈写入该槽位的记录作废，之后恢复正常
+    const auto now = std::chrono::system_clock::now();
+    EXPECT_TRUE(ring->write(CorePlatform::LogLevel::INFO, now, "lap 1 a"));
+    EXPECT_FALSE(ring->write(CorePlatform::LogLevel::INFO, now, "lap 1 b"));
+    EXPECT_EQ(ring->drain(records), 1u);
+    for (int lap = 2; lap <= 4; lap++) {
+        const std::string prefix = "lap " + std::to_string(lap);
+        EXPECT_TRUE(ring->write(CorePlatform::LogLevel::INFO, now, prefix + " a"));
+        EXPECT_TRUE(ring->write(CorePlatform::LogLevel::INFO, now, prefix + " b"));
+        EXPECT_EQ(ring->drain(records), 2u);
+    }
+    EXPECT_EQ(ring->getDroppedCount(), 2u);
+    ASSERT_EQ(records.size(), 7u);
+    EXPECT_EQ(records.back().message, "lap 4 b");
+}
+
+// 测试父进程收集多个子进程写入共享日志环的日志，并按时间合并写入日志文件
+TEST_F(LoggerTest, SharedLogRingCollectsFromChildProcesses) {
+    constexpr int kChildren = 3;
+    constexpr int kPerChild = 200;
+    CorePlatform::Logger& logger = CorePlatform::Logger::getInstance();
+    
+    std::string error;
+    sharedRing = CorePlatform::SharedLogRing::create(1024, "", &error);
+    ASSERT_NE(sharedRing, nullptr) << error;
+    logger.attachSharedLogRing(sharedRing);
+    ASSERT_EQ(setenv(sharedRing->environmentEntry().first.c_str(), sharedRing->handle().c_str(), 1), 0);
+    
+    std::vector<pid_t> children;
+    for (int c = 0; c < kChildren; c++) {
+        const pid_t pid = fork();
+        ASSERT_GE(pid, 0);
+        if (pid == 0) {
+            // 子进程只通过共享日志环输出，不使用继承来的 Logger 状态
+            auto ring = CorePlatform::SharedLogRing::attachFromEnvironment();
+            if (!ring) _exit(2);
+            CorePlatform::SharedLogRingSink sink(std::move(ring));
+            for (int i = 0; i < kPerChild; i++) {
+                sink.log(CorePlatform::LogLevel::INFO, std::chrono::system_clock::now(),
+                         "child " + std::to_string(c) + " message " + std::to_string(i));
+                if (i % 50 == 0) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            sink.log(CorePlatform::LogLevel::DEBUG, std::chrono::system_clock::now(), "filtered by parent level");
+            _exit(0);
+        }
+        children.push_back(pid);
+    }
+    for (pid_t pid : children) {
+        int status = 0;
+        ASSERT_EQ(waitpid(pid, &status, 0), pid);
+        ASSERT_TRUE(WIFEXITED(status));
+        EXPECT_EQ(WEXITSTATUS(status), 0);
+    }
+    unsetenv(CorePlatform::SharedLogRing::kEnvironmentVariable);
+    
+    // 收集线程在合并窗口之后自动写出，无需 flush()
+    std::vector<std::string> logs;
+    for (int attempt = 0; attempt < 200; attempt++) {
+        logs = ReadLogFileDirectly();
+        if (logs.size() >= static_cast<size_t>(kChildren * kPerChild)) break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    logger.flush();
+    logs = ReadLogFileDirectly();
+    ASSERT_EQ(logs.size(), static_cast<size_t>(kChildren * kPerChild));
+    EXPECT_EQ(sharedRing->getDroppedCount(), 0u);
+    
+    // 每个子进程的日志完整且带有进程号，整体按时间非递减
+    for (int c = 0; c < kChildren; c++) {
+        const std::string prefix = "[pid " + std::to_string(children[c]) + "] child " + std::to_string(c) + " message ";
+        VerifyLogEntry(logs, CorePlatform::LogLevel::INFO, prefix, kPerChild);
+    }
+    VerifyLogEntry(logs, CorePlatform::LogLevel::DEBUG, "filtered by parent level", 0);
+    for (size_t i = 1; i < logs.size(); i++) {
+        EXPECT_LE(logs[i - 1].substr(0, 25), logs[i].substr(0, 25)) << i;
+    }
+    
+    EXPECT_TRUE(logger.detachSharedLogRing(sharedRing));
+    EXPECT_FALSE(logger.detachSharedLogRing(sharedRing));
+    sharedRing.reset();
+}
+#endif
+
+// 测试按时间二分查找：与逐行扫描的结果一致，续行归属前一条日志
+TEST_F(LoggerTest, LogTimeSearchMatchesLinearScan) {
+    using namespace std::chrono;
+    const system_clock::time_point base = system_clock::now();
+    
+    for (CorePlatform::TimestampFormat format : {CorePlatform::TimestampFormat::LocalMillis,
+                                                 CorePlatform::TimestampFormat::UtcIso8601Micros}) {
+        // 每 3 ms 一条日志，部分日志带续行，部分时间戳重复
+        std::string contents;
+        std::vector<system_clock::time_point> lineTimes;  // 续行记录其所属日志的时间
+        system_clock::time_point time = base;
+        for (int i = 0; i < 20000; i++) {
+            if (i % 5 != 0) time += milliseconds(3);
+            contents += '[' + CorePlatform::TimeUtils::formatTimestamp(time, format) + "] [INFO] entry " +
+                        std::to_string(i) + '\n';
+            lineTimes.push_back(time);
+            if (i % 7 == 0) {
+                contents += "    continuation of " + std::to_string(i) + '\n';
+                lineTimes.push_back(time);
+            }
+        }
+        const std::string_view view(contents);
+        
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<int> offsetMs(-100, 50000);
+        for (int round = 0; round < 200; round++) {
+            system_clock::time_point from = base + milliseconds(offsetMs(rng));
+            system_clock::time_point to = base + milliseconds(offsetMs(rng));
+            if (to < from) std::swap(from, to);
+            
+            // 逐行扫描的期望结果（时间戳精度为毫秒）
+            const auto floorMs = [](system_clock::time_point t) { return floor<milliseconds>(t); };
+            size_t expectedLines = 0;
+            for (const auto& lineTime : lineTimes) {
+                if (floorMs(lineTime) >= floorMs(from) && floorMs(lineTime) < floorMs(to)) {
+                    expectedLines++;
+                }
+            }
+            
+            const std::string_view slice = CorePlatform::Internal::sliceByTime(
+                view, CorePlatform::Internal::LogTimeBound(from), CorePlatform::Internal::LogTimeBound(to));
+            const size_t lines = static_cast<size_t>(std::count(slice.begin(), slice.end(), '\n'));
+            EXPECT_EQ(lines, expectedLines) << "round " << round;
+            if (!slice.empty()) {
+                EXPECT_EQ(slice.front(), '[');
+                EXPECT_TRUE(slice.data() == view.data() || slice.data()[-1] == '\n');
+            }
+        }
+    }
+    
+    // 没有时间戳的内容
+    EXPECT_TRUE(CorePlatform::Internal::sliceByTime("plain text\nno timestamps\n",
+        CorePlatform::Internal::LogTimeBound(system_clock::time_point{}),
+        CorePlatform::Internal::LogTimeBound(system_clock::now())).empty());
+    EXPECT_TRUE(CorePlatform::Internal::logLineTimestamp("[2024-01-01 00:00:00] [INFO] short").empty());
+    EXPECT_EQ(CorePlatform::Internal::logLineTimestamp("[2024-01-01T00:00:00.000Z] [INFO] x"),
+              "2024-01-01T00:00:00.000Z");
+}
+
+// 测试查询时间的解析
+TEST_F(LoggerTest, ParseLogTime) {
+    using namespace std::chrono;
+    system_clock::time_point parsed;
+    
+    ASSERT_TRUE(CorePlatform::Internal::parseLogTime("2024-03-05T10:02:30.25Z", parsed));
+    EXPECT_EQ(parsed, sys_days(year{2024} / 3 / 5) + hours(10) + minutes(2) + seconds(30) + milliseconds(250));
+    
+    // 只有时间时取 now 所在的日期
+    const system_clock::time_point now = sys_days(year{2024} / 3 / 5) + hours(18);
+    ASSERT_TRUE(CorePlatform::Internal::parseLogTime("10:02Z", parsed, now));
+    EXPECT_EQ(parsed, sys_days(year{2024} / 3 / 5) + hours(10) + minutes(2));
+    
+    // 本地时间与日志中的本地时间戳一致
+    ASSERT_TRUE(CorePlatform::Internal::parseLogTime("2024-03-05 10:02:30.123", parsed));
+    EXPECT_EQ(CorePlatform::TimeUtils::formatTimestamp(parsed), "2024-03-05 10:02:30.123");
+    ASSERT_TRUE(CorePlatform::Internal::parseLogTime(" 23:59 ", parsed));
+    EXPECT_EQ(CorePlatform::TimeUtils::formatTimestamp(parsed).substr(0, 10),
+              CorePlatform::TimeUtils::formatTimestamp(system_clock::now()).substr(0, 10));
+    
+    for (const char* invalid : {"", "10", "10:2", "25:00", "10:00:", "10:00:00.", "2024-13-01 10:00",
+                                "2024-02-30 10:00Z", "2024-03-05", "10:00:00.1234567890", "yesterday"}) {
+        EXPECT_FALSE(CorePlatform::Internal::parseLogTime(invalid, parsed)) << invalid;
+    }
+}
+
+// 测试按时间范围读取日志，覆盖轮转分段
+TEST_F(LoggerTest, ReadLogsInTimeRangeAcrossSegments) {
+    CorePlatform::Logger& logger = CorePlatform::Logger::getInstance();
+    CorePlatform::LogRotationPolicy policy;
+    policy.maxFileSize = 4096;
+    policy.compress = true;
+    logger.setRotationPolicy(policy);
+    
+    // 三批日志之间间隔几毫秒，保证毫秒精度的时间戳能区分批次；
+    // 较早的一批与查询范围间隔超过修改时间的比较余量，其分段可以按修改时间跳过
+    auto writeBatch = [&logger](const char* name, int count, std::chrono::milliseconds pause) {
+        for (int i = 0; i < count; i++) {
+            logger.info("{} entry {}", name, i);
+        }
+        std::this_thread::sleep_for(pause);
+    };
+    writeBatch("before", 200, std::chrono::milliseconds(2500));
+    const auto from = std::chrono::system_clock::now();
+    writeBatch("inside", 150, std::chrono::milliseconds(5));
+    const auto to = std::chrono::system_clock::now();
+    writeBatch("after", 200, std::chrono::milliseconds(5));
+    logger.flush();
+    
+    // 等待后台压缩完成
+    const bool compressed = CorePlatform::Internal::logCompressionAvailable();
+    std::vector<std::string> segments;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (std::chrono::steady_clock::now() < deadline) {
+        segments = logger.getRotatedLogFiles();
+        if (!compressed || std::all_of(segments.begin(), segments.end(), [](const std::string& segment) {
+                return segment.substr(segment.size() - 3) == ".gz";
+            })) {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_GE(segments.size(), 4u);
+    
+    const uint64_t readsBefore = CorePlatform::Internal::compressedLogSegmentReads();
+    auto logs = logger.readLogsInTimeRange(from, to);
+    const uint64_t reads = CorePlatform::Internal::compressedLogSegmentReads() - readsBefore;
+    ASSERT_EQ(logs.size(), 150u);
+    EXPECT_NE(logs.front().find("inside entry 0"), std::string::npos);
+    EXPECT_NE(logs.back().find("inside entry 149"), std::string::npos);
+    VerifyLogEntry(logs, CorePlatform::LogLevel::INFO, "inside entry", 150);
+    
+    // 只有包含范围内日志的压缩分段被完整解压
+    if (compressed) {
+        uint64_t overlapping = 0;
+        for (const auto& segment : segments) {
+            std::string contents;
+            ASSERT_TRUE(CorePlatform::Internal::readCompressedLogSegment(segment, contents));
+            overlapping += contents.find("inside entry") != std::string::npos ? 1 : 0;
+        }
+        EXPECT_LT(overlapping, segments.size());
+        EXPECT_EQ(reads, overlapping);
+    }
+    
+    logs = logger.readLogsInTimeRange(from, to, 10);
+    ASSERT_EQ(logs.size(), 10u);
+    EXPECT_NE(logs.back().find("inside entry 9"), std::string::npos);
+    
+    EXPECT_EQ(logger.readLogsInTimeRange(from, std::chrono::system_clock::now() + std::chrono::hours(1)).size(), 350u);
+    EXPECT_TRUE(logger.readLogsInTimeRange(to, from).empty());
+}
+
+// 测试 JSON 字符串转义：控制字符、引号和非法 UTF-8
+TEST_F(LoggerTest, JsonStringEscaping) {
+    auto escape = [](std::string_view text) {
+        std::string out;
+        CorePlatform::Internal::appendJsonString(out, text);
+        return out;
+    };
+    
+    EXPECT_EQ(escape("plain"), "\"plain\"");
+    EXPECT_EQ(escape(""), "\"\"");
+    EXPECT_EQ(escape("a\"b\\c\nd\te\r\x01\x1f"), "\"a\\\"b\\\\c\\nd\\te\\r\\u0001\\u001f\"");
+    EXPECT_EQ(escape(std::string_view("nul\0x", 5)), "\"nul\\u0000x\"");
+    
+    // 合法的多字节序列原样保留
+    EXPECT_EQ(escape("日志 \xF0\x9F\x98\x80 \xC3\xA9"), "\"日志 \xF0\x9F\x98\x80 \xC3\xA9\"");
+    // 过长编码、代理区、截断序列、超出范围和孤立的后续字节被替换
+    EXPECT_EQ(escape("\xC0\x80"), "\"\\ufffd\\ufffd\"");
+    EXPECT_EQ(escape("\xED\xA0\x80"), "\"\\ufffd\\ufffd\\ufffd\"");
+    EXPECT_EQ(escape("ab\xE6\x97"), "\"ab\\ufffd\\ufffd\"");
+    EXPECT_EQ(escape("\xF4\x90\x80\x80"), "\"\\ufffd\\ufffd\\ufffd\\ufffd\"");
+    EXPECT_EQ(escape("\x80z"), "\"\\ufffdz\"");
+    
+    // 结果总能被标准 JSON 解析器读回
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> byte(0, 255);
+    for (int round = 0; round < 200; round++) {
+        std::string random(static_cast<size_t>(round % 40), '\0');
+        for (char& ch : random) ch = static_cast<char>(byte(rng));
+        EXPECT_NO_THROW({ auto parsed = nlohmann::json::parse(escape(random)); (void)parsed; }) << round;
+    }
+}
+
+// 测试结构化日志：添加的 JSON Lines 输出收到字段，文本输出附加 key=value
+TEST_F(LoggerTest, StructuredLoggingJsonLines) {
+    CorePlatform::Logger& logger = CorePlatform::Logger::getInstance();
+    const std::string jsonPath = tempDir->CreateFilePath("structured.jsonl");
+    auto jsonSink = std::make_shared<CorePlatform::JsonLinesSink>(jsonPath);
+    CorePlatform::LogSinkOptions asyncOptions;
+    asyncOptions.asynchronous = true;
+    auto asyncSink = std::make_shared<CorePlatform::JsonLinesSink>(tempDir->CreateFilePath("async.jsonl"), asyncOptions);
+    auto ringSink = std::make_shared<CorePlatform::MemoryRingSink>(8);
+    logger.addSink(jsonSink);
+    logger.addSink(asyncSink);
+    logger.addSink(ringSink);
+    
+    const std::string path = "/api/v1/items";
+    logger.logFields(CorePlatform::LogLevel::INFO, "request done", {
+        {"status", 200}, {"path", path}, {"ms", 12.5}, {"cached", false},
+        {"bytes", uint64_t{18446744073709551615ull}}, {"delta", -3},
+        {"note", "say \"hi\"\nnext"}, {"severity", CorePlatform::LogLevel::WARN},
+        {"ratio", std::numeric_limits<double>::quiet_NaN()}, {"empty", ""}});
+    logger.info("plain {}", 1);
+    CP_LOG_FIELDS(CorePlatform::LogLevel::DEBUG, "filtered", {"never", 1});
+    logger.getLogger("net.http").logFields(CorePlatform::LogLevel::WARN, "slow", {{"ms", 1500}});
+    
+    // 异步输出在排队时复制字段，调用返回后原数据可以失效
+    for (int i = 0; i < 100; i++) {
+        const std::string value = "value-" + std::to_string(i) + std::string(static_cast<size_t>(i % 20), 'x');
+        logger.logFields(CorePlatform::LogLevel::INFO, "batch", {{"i", i}, {"v", value}});
+    }
+    logger.flush();
+    jsonSink->flush();
+    asyncSink->flush();
+    
+    const auto jsonLines = ReadFileLines(jsonPath);
+    ASSERT_EQ(jsonLines.size(), 103u);
+    const auto first = nlohmann::json::parse(jsonLines[0]);
+    EXPECT_EQ(first["level"], "INFO");
+    EXPECT_EQ(first["msg"], "request done");
+    EXPECT_EQ(first["status"], 200);
+    EXPECT_EQ(first["path"], path);
+    EXPECT_EQ(first["ms"], 12.5);
+    EXPECT_EQ(first["cached"], false);
+    EXPECT_EQ(first["bytes"].get<uint64_t>(), 18446744073709551615ull);
+    EXPECT_EQ(first["delta"], -3);
+    EXPECT_EQ(first["note"], "say \"hi\"\nnext");
+    EXPECT_EQ(first["severity"], 3);  // 枚举按底层整数记录
+    EXPECT_TRUE(first["ratio"].is_null());
+    EXPECT_EQ(first["empty"], "");
+    const std::string time = first["time"];
+    EXPECT_EQ(time.size(), 27u);
+    EXPECT_EQ(time.back(), 'Z');
+    
+    const auto plain = nlohmann::json::parse(jsonLines[1]);
+    EXPECT_EQ(plain["msg"], "plain 1");
+    EXPECT_EQ(plain.size(), 3u);
+    const auto named = nlohmann::json::parse(jsonLines[2]);
+    EXPECT_EQ(named["msg"], "[net.http] slow");
+    EXPECT_EQ(named["ms"], 1500);
+    
+    const auto asyncLines = ReadFileLines(tempDir->CreateFilePath("async.jsonl"));
+    ASSERT_EQ(asyncLines.size(), 103u);
+    for (int i = 0; i < 100; i++) {
+        const auto record = nlohmann::json::parse(asyncLines[static_cast<size_t>(i) + 3]);
+        EXPECT_EQ(record["i"], i);
+        EXPECT_EQ(record["v"], "value-" + std::to_string(i) + std::string(static_cast<size_t>(i % 20), 'x'));
+    }
+    
+    // 文本输出：日志文件和其他输出的默认格式附加 key=value
+    auto logs = ReadLogFileDirectly();
+    VerifyLogEntry(logs, CorePlatform::LogLevel::INFO,
+                   "request done status=200 path=/api/v1/items ms=12.5 cached=false bytes=18446744073709551615 "
+                   "delta=-3 note=\"say \\\"hi\\\"\\nnext\" severity=3 ratio=null empty=\"\"");
+    VerifyLogEntry(logs, CorePlatform::LogLevel::WARN, "[net.http] slow ms=1500");
+    VerifyLogEntry(logs, CorePlatform::LogLevel::DEBUG, "filtered", 0);
+    const auto recent = ringSink->snapshot();
+    ASSERT_FALSE(recent.empty());
+    EXPECT_NE(recent.back().find("] [INFO] batch i=99 v=value-99"), std::string::npos);
+    
+    logger.removeSink(jsonSink);
+    logger.removeSink(asyncSink);
+    logger.removeSink(ringSink);
+}
+
+// 测试环形日志文件回绕后按时间顺序读出，重新打开后从文件头恢复并继续写入
+TEST_F(LoggerTest, CircularLogFileWrapsInOrder) {
+    const std::string path = tempDir->CreateFilePath("ring.log");
+    std::string error;
+    auto file = CorePlatform::CircularLogFile::open(path, 4096, &error);
+    ASSERT_NE(file, nullptr) << error;
+    EXPECT_EQ(std::filesystem::file_size(path), CorePlatform::CircularLogFile::kHeaderSize + 4096);
+    EXPECT_TRUE(file->readAllLines().empty());
+    
+    // 长度不一的行，覆盖时会切断旧行
+    auto lineFor = [](int i) { return "line " + std::to_string(i) + " " + std::string(i % 37, 'x'); };
+    for (int i = 0; i < 2000; i++) {
+        file->append(lineFor(i));
+    }
+    EXPECT_GT(file->wrapCount(), 10u);
+    EXPECT_EQ(std::filesystem::file_size(path), CorePlatform::CircularLogFile::kHeaderSize + 4096);
+    
+    auto checkTail = [&](const std::vector<std::string>& lines, int last) {
+        ASSERT_FALSE(lines.empty());
+        const int first = last - static_cast<int>(lines.size()) + 1;
+        for (size_t k = 0; k < lines.size(); k++) {
+            ASSERT_EQ(lines[k], lineFor(first + static_cast<int>(k))) << "at " << k;
+        }
+    };
+    const auto lines = file->readAllLines();
+    checkTail(lines, 1999);
+    // 至少保留了容量减去一条最长日志的内容
+    size_t bytes = 0;
+    for (const auto& line : lines) bytes += line.size() + 1;
+    EXPECT_LE(bytes, 4096u);
+    EXPECT_GT(bytes, 4096u - 2 * (lineFor(36).size() + 1));
+    
+    const auto last = file->readLastLines(5);
+    ASSERT_EQ(last.size(), 5u);
+    checkTail(last, 1999);
+    EXPECT_EQ(file->readLastLines(100000), lines);
+    EXPECT_TRUE(file->readLastLines(0).empty());
+    
+    // 只读方式读取的内容与映射中的一致
+    std::string contents;
+    ASSERT_TRUE(file->sync());
+    ASSERT_TRUE(CorePlatform::CircularLogFile::readFile(path, contents, &error)) << error;
+    EXPECT_EQ(contents, file->readContents());
+    EXPECT_FALSE(CorePlatform::CircularLogFile::readFile(logFilePath, contents));
+    
+    // 重新打开后继续写入
+    const uint64_t wraps = file->wrapCount();
+    file.reset();
+    file = CorePlatform::CircularLogFile::open(path, 4096, &error);
+    ASSERT_NE(file, nullptr) << error;
+    EXPECT_EQ(file->wrapCount(), wraps);
+    checkTail(file->readAllLines(), 1999);
+    for (int i = 2000; i < 2100; i++) {
+        file->append(lineFor(i));
+    }
+    checkTail(file->readAllLines(), 2099);
+    
+    // 超长日志被截断为整个数据区，随后的日志覆盖它
+    file->append(std::string(10000, 'z'));
+    EXPECT_EQ(file->readAllLines(), std::vector<std::string>{std::string(4095, 'z')});
+    file->append("after");
+    EXPECT_EQ(file->readAllLines(), std::vector<std::string>{"after"});
+    
+    // 容量不同时重新初始化
+    file.reset();
+    file = CorePlatform::CircularLogFile::open(path, 8192, &error);
+    ASSERT_NE(file, nullptr) << error;
+    EXPECT_EQ(file->wrapCount(), 0u);
+    EXPECT_TRUE(file->readAllLines().empty());
+    
+    // 多行日志的换行被转义：回绕后最旧的一条仍从记录开头开始，不会从某条日志的中间行开始
+    auto multiLine = [](int i) { return "multi " + std::to_string(i) + "\nsecond\n" + std::string(i % 41, 'y'); };
+    auto escapedFor = [&](int i) { return "multi " + std::to_string(i) + "\\nsecond\\n" + std::string(i % 41, 'y'); };
+    for (int i = 0; i < 1000; i++) {
+        file->append(multiLine(i));
+    }
+    EXPECT_GT(file->wrapCount(), 0u);
+    const auto records = file->readAllLines();
+    ASSERT_FALSE(records.empty());
+    const int firstRecord = 1000 - static_cast<int>(records.size());
+    for (size_t k = 0; k < records.size(); k++) {
+        ASSERT_EQ(records[k], escapedFor(firstRecord + static_cast<int>(k))) << "at " << k;
+    }
+}
+
+// 测试通过 Logger 写入环形日志文件输出
+TEST_F(LoggerTest, CircularFileSinkWithLogger) {
+    CorePlatform::Logger& logger = CorePlatform::Logger::getInstance();
+    const std::string path = tempDir->CreateFilePath("sink.ring");
+    auto file = CorePlatform::CircularLogFile::open(path, 16 * 1024);
+    ASSERT_NE(file, nullptr);
+    
+    CorePlatform::LogSinkOptions options;
+    options.flushInterval = std::chrono::milliseconds(100);
+    auto sink = std::make_shared<CorePlatform::CircularFileSink>(std::move(file), options);
+    logger.addSink(sink);
+    for (int i = 0; i < 1000; i++) {
+        logger.info("ring message " + std::to_string(i));
+    }
+    logger.flush();
+    
+    const auto lines = sink->file()->readLastLines(3);
+    ASSERT_EQ(lines.size(), 3u);
+    VerifyLogEntry(lines, CorePlatform::LogLevel::INFO, "ring message 997");
+    VerifyLogEntry(lines, CorePlatform::LogLevel::INFO, "ring message 999");
+    
+    // 文件按日志格式保存，可以按时间查找
+    std::string contents;
+    ASSERT_TRUE(CorePlatform::CircularLogFile::readFile(path, contents));
+    const auto now = std::chrono::system_clock::now();
+    const std::string_view slice = CorePlatform::Internal::sliceByTime(
+        contents, CorePlatform::Internal::LogTimeBound(now - std::chrono::minutes(1)),
+        CorePlatform::Internal::LogTimeBound(now + std::chrono::minutes(1)));
+    EXPECT_EQ(slice.size(), contents.size());
+}
+
+#ifndef _WIN32
+// 测试写入进程在任意时刻被杀死后，文件仍能按顺序读出完整的日志行
+TEST_F(LoggerTest, CircularLogFileSurvivesKilledWriter) {
+    const std::string path = tempDir->CreateFilePath("killed.ring");
+    for (int round = 0; round < 5; round++) {
+        const pid_t pid = fork();
+        ASSERT_GE(pid, 0);
+        if (pid == 0) {
+            auto file = CorePlatform::CircularLogFile::open(path, 8192);
+            if (!file) _exit(2);
+            // 接着上一轮的序号写入
+            const auto last = file->readLastLines(1);
+            for (uint64_t i = last.empty() ? 0 : std::stoull(last[0].substr(4)) + 1;; i++) {
+                file->append("seq " + std::to_string(i) + std::string(i % 53, '.'));
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(20 + round * 7));
+        kill(pid, SIGKILL);
+        int status = 0;
+        waitpid(pid, &status, 0);
+        
+        auto file = CorePlatform::CircularLogFile::open(path, 8192);
+        ASSERT_NE(file, nullptr);
+        const auto lines = file->readAllLines();
+        ASSERT_FALSE(lines.empty());
+        uint64_t previous = 0;
+        for (size_t k = 0; k < lines.size(); k++) {
+            ASSERT_EQ(lines[k].compare(0, 4, "seq "), 0) << lines[k];
+            const uint64_t seq = std::stoull(lines[k].substr(4));
+            ASSERT_EQ(lines[k], "seq " + std::to_string(seq) + std::string(seq % 53, '.'));
+            if (k > 0) {
+                ASSERT_EQ(seq, previous + 1);
+            }
+            previous = seq;
+        }
+    }
+}
+#endif
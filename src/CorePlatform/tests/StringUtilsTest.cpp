@@ -67,6 +67,31 @@ TEST(StringUtilsTest, EndsWith) {
     EXPECT_FALSE(StringUtils::endsWith("Short", "TooLong"));
 }
 
+TEST(StringUtilsTest, MatchGlob) {
+    EXPECT_TRUE(StringUtils::matchGlob("*.log", "app.log"));
+    EXPECT_TRUE(StringUtils::matchGlob("*.log", ".log"));
+    EXPECT_FALSE(StringUtils::matchGlob("*.log", "app.log.1"));
+    EXPECT_TRUE(StringUtils::matchGlob("*.log*", "app.log.1"));
+    EXPECT_TRUE(StringUtils::matchGlob("a?c", "abc"));
+    EXPECT_FALSE(StringUtils::matchGlob("a?c", "ac"));
+    EXPECT_TRUE(StringUtils::matchGlob("core.[0-9]*", "core.1234"));
+    EXPECT_FALSE(StringUtils::matchGlob("core.[0-9]*", "core.x"));
+    EXPECT_TRUE(StringUtils::matchGlob("[!a-c]x", "dx"));
+    EXPECT_FALSE(StringUtils::matchGlob("[^a-c]x", "bx"));
+    EXPECT_TRUE(StringUtils::matchGlob("[]]", "]"));
+    EXPECT_TRUE(StringUtils::matchGlob("\\*", "*"));
+    EXPECT_FALSE(StringUtils::matchGlob("\\*", "a"));
+    EXPECT_TRUE(StringUtils::matchGlob("[abc", "[abc"));
+    EXPECT_TRUE(StringUtils::matchGlob("", ""));
+    EXPECT_FALSE(StringUtils::matchGlob("", "a"));
+    EXPECT_TRUE(StringUtils::matchGlob("*", ""));
+    EXPECT_TRUE(StringUtils::matchGlob("*a*b*c*", "xxaxxbxxcxx"));
+    EXPECT_FALSE(StringUtils::matchGlob("*a*b*c*", "xxaxxcxxbxx"));
+    EXPECT_TRUE(StringUtils::matchGlob("测试*.txt", "测试文件.txt"));
+    // 大量 * 时不会指数回溯
+    EXPECT_FALSE(StringUtils::matchGlob("a*a*a*a*a*a*a*a*b", std::string(10000, 'a')));
+}
+
 TEST(StringUtilsTest, Split) {
     std::vector<std::string> expected = {"a", "b", "c"};
     EXPECT_EQ(StringUtils::split("a,b,c", ","), expected);
@@ -2,6 +2,8 @@
 #include <gtest/gtest.h>
 #include <thread>
 #include <regex>
+#include <cstring>
+#include <cstdio>
 
 using namespace CorePlatform;
 
@@ -201,4 +203,62 @@ TEST(TimeUtilsTest, ThreadSafety) {
                 << "Threads " << i << " and " << j << " have large time difference";
         }
     }
-}
\ No newline at end of file
+}
+
+// 测试时间戳格式化引擎（UTC/ISO-8601）
+TEST(TimeUtilsTest, FormatTimestampUtc) {
+    using namespace std::chrono;
+    // 2024-02-29 12:34:56 UTC
+    system_clock::time_point tp{seconds(1709210096) + microseconds(789012)};
+    
+    EXPECT_EQ(TimeUtils::formatTimestamp(tp, TimestampFormat::UtcIso8601Millis),
+              "2024-02-29T12:34:56.789Z");
+    EXPECT_EQ(TimeUtils::formatTimestamp(tp, TimestampFormat::UtcIso8601Micros),
+              "2024-02-29T12:34:56.789012Z");
+    
+    // 同一秒内只改写小数部分
+    EXPECT_EQ(TimeUtils::formatTimestamp(tp + milliseconds(5), TimestampFormat::UtcIso8601Millis),
+              "2024-02-29T12:34:56.794Z");
+    // 跨秒、跨日后缓存失效
+    EXPECT_EQ(TimeUtils::formatTimestamp(tp + hours(12), TimestampFormat::UtcIso8601Millis),
+              "2024-03-01T00:34:56.789Z");
+    
+    // 纪元之前的时间
+    system_clock::time_point before{milliseconds(-1)};
+    EXPECT_EQ(TimeUtils::formatTimestamp(before, TimestampFormat::UtcIso8601Millis),
+              "1969-12-31T23:59:59.999Z");
+    
+    // 缓冲区版本
+    char buffer[TimeUtils::kMaxTimestampLength];
+    size_t length = TimeUtils::formatTimestamp(buffer, tp, TimestampFormat::UtcIso8601Micros);
+    EXPECT_EQ(length, std::strlen(buffer));
+    EXPECT_STREQ(buffer, "2024-02-29T12:34:56.789012Z");
+}
+
+// 测试时间戳格式化引擎（本地时间）与 strftime 结果一致
+TEST(TimeUtilsTest, FormatTimestampLocal) {
+    using namespace std::chrono;
+    auto now = system_clock::now();
+    
+    for (int i = 0; i < 5; i++) {
+        auto tp = now + seconds(i * 3601) + microseconds(i * 123457);
+        std::time_t t = system_clock::to_time_t(tp);
+        std::tm bt{};
+#ifdef _WIN32
+        localtime_s(&bt, &t);
+#else
+        localtime_r(&t, &bt);
+#endif
+        char expected[32];
+        std::strftime(expected, sizeof(expected), "%Y-%m-%d %H:%M:%S", &bt);
+        
+        auto micros = duration_cast<microseconds>(tp.time_since_epoch()).count() % 1000000;
+        char fraction[16];
+        std::snprintf(fraction, sizeof(fraction), ".%06lld", static_cast<long long>(micros));
+        
+        EXPECT_EQ(TimeUtils::formatTimestamp(tp, TimestampFormat::LocalMicros),
+                  std::string(expected) + fraction);
+        EXPECT_EQ(TimeUtils::formatTimestamp(tp, TimestampFormat::LocalMillis),
+                  std::string(expected) + std::string(fraction, 4));
+    }
+}
@@ -0,0 +1,73 @@
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "CorePlatform/Internal/BinaryLog.h"
+
+namespace {
+
+void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [--utc] [--micros] <binary-log> [output]\n"
+              << "  Decode a binary log written with LogFileFormat::Binary into\n"
+              << "  \"[time] [LEVEL] message\" lines, ordered by timestamp.\n"
+              << "  --utc     print timestamps as ISO 8601 UTC\n"
+              << "  --micros  print microsecond precision\n";
+}
+
+} // 匿名命名空间
+
+int main(int argc, char* argv[]) {
+    bool utc = false;
+    bool micros = false;
+    std::vector<std::string> positional;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--utc") == 0) {
+            utc = true;
+        } else if (std::strcmp(argv[i], "--micros") == 0) {
+            micros = true;
+        } else if (std::strcmp(argv[i], "-h") == 0 || std::strcmp(argv[i], "--help") == 0) {
+            printUsage(argv[0]);
+            return 0;
+        } else {
+            positional.emplace_back(argv[i]);
+        }
+    }
+    if (positional.empty() || positional.size() > 2) {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    CorePlatform::TimestampFormat format = CorePlatform::TimestampFormat::LocalMillis;
+    if (utc) {
+        format = micros ? CorePlatform::TimestampFormat::UtcIso8601Micros
+                        : CorePlatform::TimestampFormat::UtcIso8601Millis;
+    } else if (micros) {
+        format = CorePlatform::TimestampFormat::LocalMicros;
+    }
+
+    std::vector<std::string> lines;
+    std::string error;
+    const bool ok = CorePlatform::Internal::decodeBinaryLog(positional[0], lines, format, &error);
+
+    std::ofstream outputFile;
+    if (positional.size() == 2) {
+        outputFile.open(positional[1], std::ios::out | std::ios::trunc);
+        if (!outputFile) {
+            std::cerr << "Unable to open output file: " << positional[1] << "\n";
+            return 1;
+        }
+    }
+    std::ostream& out = outputFile.is_open() ? outputFile : std::cout;
+    for (const auto& line : lines) {
+        out << line << '\n';
+    }
+    out.flush();
+
+    if (!ok) {
+        std::cerr << positional[0] << ": " << error << "\n";
+        return 1;
+    }
+    return 0;
+}
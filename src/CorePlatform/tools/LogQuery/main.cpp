@@ -0,0 +1,139 @@
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "CorePlatform/CircularLogFile.h"
+#include "CorePlatform/Internal/LogFileReader.h"
+#include "CorePlatform/Internal/LogRotation.h"
+#include "CorePlatform/Internal/LogTimeSearch.h"
+
+namespace {
+
+void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [--from TIME] [--to TIME] [--max N] [--count] <log-file>\n"
+              << "  Print the lines of a text log and its rotated segments whose timestamps\n"
+              << "  fall in [from, to). Both bounds are found by binary search, so the cost\n"
+              << "  does not grow with the size of the files. Circular log files are read in\n"
+              << "  chronological order.\n"
+              << "  TIME     \"YYYY-MM-DD HH:MM[:SS[.fff]]\" or \"HH:MM[:SS[.fff]]\" (today),\n"
+              << "           local time unless it ends with 'Z' (UTC)\n"
+              << "  --max N  stop after N lines\n"
+              << "  --count  print only the number of matching lines\n";
+}
+
+// 打开一个分段：压缩分段解压到内存，其余直接映射
+std::unique_ptr<CorePlatform::Internal::LogFileReader> openSegment(const std::string& path, bool compressed) {
+    using CorePlatform::Internal::LogFileReader;
+    if (compressed) {
+        std::string contents;
+        if (!CorePlatform::Internal::readCompressedLogSegment(path, contents)) {
+            return nullptr;
+        }
+        return LogFileReader::fromBuffer(path, std::move(contents));
+    }
+    auto reader = std::make_unique<LogFileReader>(path);
+    try {
+        reader->refresh();
+    } catch (const std::runtime_error&) {
+        return nullptr;
+    }
+    return reader;
+}
+
+} // 匿名命名空间
+
+int main(int argc, char* argv[]) {
+    using Clock = std::chrono::system_clock;
+
+    // 未指定的边界覆盖所有可能出现的时间（system_clock 以纳秒计时只能表示到 2262 年）
+    Clock::time_point from{};
+    Clock::time_point to = std::chrono::sys_days(std::chrono::year{2200} / 1 / 1);
+    size_t maxLines = 0;
+    bool countOnly = false;
+    std::vector<std::string> positional;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "-h" || arg == "--help") {
+            printUsage(argv[0]);
+            return 0;
+        } else if (arg == "--count") {
+            countOnly = true;
+        } else if (arg == "--from" || arg == "--to" || arg == "--max") {
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for " << arg << "\n";
+                return 2;
+            }
+            const std::string value = argv[++i];
+            bool ok = true;
+            if (arg == "--max") {
+                try {
+                    maxLines = std::stoull(value);
+                } catch (const std::exception&) {
+                    ok = false;
+                }
+            } else {
+                ok = CorePlatform::Internal::parseLogTime(value, arg == "--from" ? from : to);
+            }
+            if (!ok) {
+                std::cerr << "Invalid value for " << arg << ": " << value << "\n";
+                return 2;
+            }
+        } else {
+            positional.push_back(arg);
+        }
+    }
+    if (positional.size() != 1) {
+        printUsage(argv[0]);
+        return 2;
+    }
+    const std::string& logPath = positional[0];
+
+    std::vector<std::unique_ptr<CorePlatform::Internal::LogFileReader>> segments;
+    std::string circular;
+    if (CorePlatform::CircularLogFile::readFile(logPath, circular)) {
+        // 环形日志文件没有轮转分段，按时间顺序展开后查找
+        segments.push_back(CorePlatform::Internal::LogFileReader::fromBuffer(logPath, std::move(circular)));
+    } else {
+        for (const auto& segment : CorePlatform::Internal::listLogSegments(logPath)) {
+            if (auto reader = openSegment(segment.path, segment.compressed)) {
+                segments.push_back(std::move(reader));
+            } else {
+                std::cerr << "Skipping unreadable segment: " << segment.path << "\n";
+            }
+        }
+        if (auto reader = openSegment(logPath, false)) {
+            segments.push_back(std::move(reader));
+        } else if (segments.empty()) {
+            std::cerr << "Unable to open log file: " << logPath << "\n";
+            return 1;
+        }
+    }
+
+    const CorePlatform::Internal::LogTimeBound fromBound(from);
+    const CorePlatform::Internal::LogTimeBound toBound(to);
+    uint64_t matched = 0;
+    for (const auto& reader : segments) {
+        std::string_view view = CorePlatform::Internal::sliceByTime(reader->contents(), fromBound, toBound);
+        while (!view.empty() && (maxLines == 0 || matched < maxLines)) {
+            const size_t newline = view.find('\n');
+            const std::string_view line = view.substr(0, newline);
+            if (!countOnly) {
+                // 直接输出映射中的内容，不复制到字符串
+                fwrite(line.data(), 1, line.size(), stdout);
+                fputc('\n', stdout);
+            }
+            ++matched;
+            view.remove_prefix(newline == std::string_view::npos ? view.size() : newline + 1);
+        }
+    }
+    if (countOnly) {
+        printf("%llu\n", static_cast<unsigned long long>(matched));
+    }
+    fflush(stdout);
+    return 0;
+}
@@ -1,6 +1,7 @@
 #include <iostream>
 #include "version_iHelper.h" // 自动生成的头文件
 #include "CorePlatform/Windows/UAC.h"
+#include "CorePlatform/Logger.h"
 
 void perform_admin_operation() {
     // 尝试写入需要管理员权限的位置
@@ -44,6 +45,16 @@ int main(const int argc, const char* argv[])
     std::cout << " " << iHelper_COPYRIGHT << "\n";
     std::cout << "====================================\n\n";
 
+    // 日志配置：--log-config <文件> 设置日志级别，log.flight_recorder 启用飞行记录器（崩溃或 FATAL 时导出最近的日志）
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::string(argv[i]) == "--log-config") {
+            std::string error;
+            if (!CorePlatform::Logger::getInstance().loadLevelConfig(argv[i + 1], &error)) {
+                std::cerr << "加载日志配置失败: " << error << std::endl;
+            }
+        }
+    }
+
     // 检查并处理 UAC 设置
     if (!CorePlatform::check_uac_settings()) {
         std::cerr << "权限不足，操作已取消。" << std::endl;